@@ -434,8 +434,11 @@ QCPAxis::QCPAxis(QCPAxisRect *parent, AxisType type) :
   mGrid(new QCPGrid(this)),
   mAxisPainter(new QCPAxisPainterPrivate(parent->parentPlot())),
   mTicker(new QCPAxisTicker),
+  mScaleTransform(new QCPScaleTransform),
   mCachedMarginValid(false),
-  mCachedMargin(0)
+  mCachedMargin(0),
+  mLogSpanRange(0, 0),
+  mLogSpan(0)
 {
   setParent(parent);
   mGrid->setVisible(false);
@@ -555,6 +558,9 @@ QCPLineEnding QCPAxis::upperEnding() const
   QCPAxisTickerLog via \ref setTicker. See the documentation of \ref QCPAxisTickerLog about the
   details of logarithmic axis tick creation.
   
+  With \ref stCustom, the coordinate transformation is defined by the transform set with \ref
+  setScaleTransform, e.g. a symmetric logarithmic or probability scale.
+  
   \ref setNumberPrecision
 */
 void QCPAxis::setScaleType(QCPAxis::ScaleType type)
@@ -562,8 +568,8 @@ void QCPAxis::setScaleType(QCPAxis::ScaleType type)
   if (mScaleType != type)
   {
     mScaleType = type;
-    if (mScaleType == stLogarithmic)
-      setRange(mRange.sanitizedForLogScale());
+    if (mScaleType != stLinear)
+      setRange(sanitizedRange(mRange));
     mCachedMarginValid = false;
     emit scaleTypeChanged(mScaleType);
   }
@@ -584,13 +590,7 @@ void QCPAxis::setRange(const QCPRange &range)
   
   if (!QCPRange::validRange(range)) return;
   QCPRange oldRange = mRange;
-  if (mScaleType == stLogarithmic)
-  {
-    mRange = range.sanitizedForLogScale();
-  } else
-  {
-    mRange = range.sanitizedForLinScale();
-  }
+  mRange = sanitizedRange(range);
   emit rangeChanged(mRange);
   emit rangeChanged(mRange, oldRange);
 }
@@ -656,13 +656,7 @@ void QCPAxis::setRange(double lower, double upper)
   QCPRange oldRange = mRange;
   mRange.lower = lower;
   mRange.upper = upper;
-  if (mScaleType == stLogarithmic)
-  {
-    mRange = mRange.sanitizedForLogScale();
-  } else
-  {
-    mRange = mRange.sanitizedForLinScale();
-  }
+  mRange = sanitizedRange(mRange);
   emit rangeChanged(mRange);
   emit rangeChanged(mRange, oldRange);
 }
@@ -699,13 +693,7 @@ void QCPAxis::setRangeLower(double lower)
   
   QCPRange oldRange = mRange;
   mRange.lower = lower;
-  if (mScaleType == stLogarithmic)
-  {
-    mRange = mRange.sanitizedForLogScale();
-  } else
-  {
-    mRange = mRange.sanitizedForLinScale();
-  }
+  mRange = sanitizedRange(mRange);
   emit rangeChanged(mRange);
   emit rangeChanged(mRange, oldRange);
 }
@@ -721,13 +709,7 @@ void QCPAxis::setRangeUpper(double upper)
   
   QCPRange oldRange = mRange;
   mRange.upper = upper;
-  if (mScaleType == stLogarithmic)
-  {
-    mRange = mRange.sanitizedForLogScale();
-  } else
-  {
-    mRange = mRange.sanitizedForLinScale();
-  }
+  mRange = sanitizedRange(mRange);
   emit rangeChanged(mRange);
   emit rangeChanged(mRange, oldRange);
 }
@@ -768,6 +750,30 @@ void QCPAxis::setTicker(QSharedPointer<QCPAxisTicker> ticker)
   // no need to invalidate margin cache here because produced tick labels are checked for changes in setupTickVector
 }
 
+/*!
+  Sets the coordinate transform that is used if the scale type is \ref stCustom (see \ref
+  setScaleType). The axis maps coordinates linearly to pixels in the domain of the transform. The
+  current axis range is restricted to the domain of \a transform, if necessary.
+  
+  Transforms are managed with QSharedPointer, like axis tickers, so one transform can be shared by
+  multiple axes. QCustomPlot provides \ref QCPScaleTransformSymLog, \ref QCPScaleTransformSqrt,
+  \ref QCPScaleTransformProbability and \ref QCPScaleTransformBroken, or you can subclass \ref
+  QCPScaleTransform.
+  
+  The default transform is the identity, i.e. \ref stCustom without setting a transform behaves
+  like \ref stLinear.
+*/
+void QCPAxis::setScaleTransform(QSharedPointer<QCPScaleTransform> transform)
+{
+  if (transform)
+  {
+    mScaleTransform = transform;
+    if (mScaleType == stCustom)
+      setRange(sanitizedRange(mRange));
+  } else
+    qDebug() << Q_FUNC_INFO << "can not set 0 as scale transform";
+}
+
 /*!
   Sets whether tick marks are displayed.
 
@@ -1297,6 +1303,9 @@ void QCPAxis::setUpperEnding(const QCPLineEnding &ending)
   
   If the scale type is \ref stLogarithmic, the range bounds are multiplied by \a diff. This
   corresponds to an apparent "linear" move in logarithmic scaling by a distance of log(diff).
+  
+  If the scale type is \ref stCustom, \a diff is added in the domain of the scale transform (see
+  \ref QCPScaleTransform::movedRange).
 */
 void QCPAxis::moveRange(double diff)
 {
@@ -1305,6 +1314,9 @@ void QCPAxis::moveRange(double diff)
   {
     mRange.lower += diff;
     mRange.upper += diff;
+  } else if (mScaleType == stCustom)
+  {
+    mRange = mScaleTransform->movedRange(mRange, diff);
   } else // mScaleType == stLogarithmic
   {
     mRange.lower *= diff;
@@ -1347,6 +1359,11 @@ void QCPAxis::scaleRange(double factor, double center)
     newRange.upper = (mRange.upper-center)*factor + center;
     if (QCPRange::validRange(newRange))
       mRange = newRange.sanitizedForLinScale();
+  } else if (mScaleType == stCustom)
+  {
+    QCPRange newRange = mScaleTransform->scaledRange(mRange, factor, center);
+    if (QCPRange::validRange(newRange))
+      mRange = newRange;
   } else // mScaleType == stLogarithmic
   {
     if ((mRange.upper < 0 && center < 0) || (mRange.upper > 0 && center > 0)) // make sure center has same sign as range
@@ -1394,6 +1411,17 @@ void QCPAxis::setScaleRatio(const QCPAxis *otherAxis, double ratio)
   setRange(range().center(), newRangeSize, Qt::AlignCenter);
 }
 
+/*!
+  Changes the range of this axis to \a range in a smooth animation lasting \a duration
+  milliseconds. If \a duration is -1, the default of the axis rect is used.
+  
+  This is a convenience function for \ref QCPAxisRect::animateRange, see there for details.
+*/
+void QCPAxis::animateRange(const QCPRange &range, int duration)
+{
+  mAxisRect->animateRange(this, range, duration);
+}
+
 /*!
   Changes the axis range such that all plottables associated with this axis are fully visible in
   that dimension.
@@ -1432,7 +1460,7 @@ void QCPAxis::rescale(bool onlyVisiblePlottables)
     if (!QCPRange::validRange(newRange)) // likely due to range being zero (plottable has only constant data in this axis dimension), shift current range to at least center the plottable
     {
       double center = (newRange.lower+newRange.upper)*0.5; // upper and lower should be equal anyway, but just to make sure, incase validRange returned false for other reason
-      if (mScaleType == stLinear)
+      if (mScaleType != stLogarithmic)
       {
         newRange.lower = center-mRange.size()/2.0;
         newRange.upper = center+mRange.size()/2.0;
@@ -1451,6 +1479,17 @@ void QCPAxis::rescale(bool onlyVisiblePlottables)
 */
 double QCPAxis::pixelToCoord(double value) const
 {
+  if (mScaleType == stCustom)
+  {
+    double fraction = orientation() == Qt::Horizontal ? (value-mAxisRect->left())/(double)mAxisRect->width() : (mAxisRect->bottom()-value)/(double)mAxisRect->height();
+    if (mRangeReversed)
+      fraction = 1.0-fraction;
+    double transformedLower, transformedUpper;
+    if (transformedRange(transformedLower, transformedUpper))
+      return mScaleTransform->inverseTransform(transformedLower+fraction*(transformedUpper-transformedLower));
+    else
+      return mRange.lower+fraction*mRange.size();
+  }
   if (orientation() == Qt::Horizontal)
   {
     if (mScaleType == stLinear)
@@ -1462,9 +1501,9 @@ double QCPAxis::pixelToCoord(double value) const
     } else // mScaleType == stLogarithmic
     {
       if (!mRangeReversed)
-        return qPow(mRange.upper/mRange.lower, (value-mAxisRect->left())/(double)mAxisRect->width())*mRange.lower;
+        return qExp(logSpan()*(value-mAxisRect->left())/(double)mAxisRect->width())*mRange.lower;
       else
-        return qPow(mRange.upper/mRange.lower, (mAxisRect->left()-value)/(double)mAxisRect->width())*mRange.upper;
+        return qExp(logSpan()*(mAxisRect->left()-value)/(double)mAxisRect->width())*mRange.upper;
     }
   } else // orientation() == Qt::Vertical
   {
@@ -1477,9 +1516,9 @@ double QCPAxis::pixelToCoord(double value) const
     } else // mScaleType == stLogarithmic
     {
       if (!mRangeReversed)
-        return qPow(mRange.upper/mRange.lower, (mAxisRect->bottom()-value)/(double)mAxisRect->height())*mRange.lower;
+        return qExp(logSpan()*(mAxisRect->bottom()-value)/(double)mAxisRect->height())*mRange.lower;
       else
-        return qPow(mRange.upper/mRange.lower, (value-mAxisRect->bottom())/(double)mAxisRect->height())*mRange.upper;
+        return qExp(logSpan()*(value-mAxisRect->bottom())/(double)mAxisRect->height())*mRange.upper;
     }
   }
 }
@@ -1489,6 +1528,20 @@ double QCPAxis::pixelToCoord(double value) const
 */
 double QCPAxis::coordToPixel(double value) const
 {
+  if (mScaleType == stCustom)
+  {
+    double transformedLower, transformedUpper, fraction;
+    if (transformedRange(transformedLower, transformedUpper))
+      fraction = (mScaleTransform->transform(value)-transformedLower)/(transformedUpper-transformedLower);
+    else
+      fraction = (value-mRange.lower)/mRange.size();
+    if (mRangeReversed)
+      fraction = 1.0-fraction;
+    if (orientation() == Qt::Horizontal)
+      return mAxisRect->left()+fraction*mAxisRect->width();
+    else
+      return mAxisRect->bottom()-fraction*mAxisRect->height();
+  }
   if (orientation() == Qt::Horizontal)
   {
     if (mScaleType == stLinear)
@@ -1506,9 +1559,9 @@ double QCPAxis::coordToPixel(double value) const
       else
       {
         if (!mRangeReversed)
-          return qLn(value/mRange.lower)/qLn(mRange.upper/mRange.lower)*mAxisRect->width()+mAxisRect->left();
+          return qLn(value/mRange.lower)/logSpan()*mAxisRect->width()+mAxisRect->left();
         else
-          return qLn(mRange.upper/value)/qLn(mRange.upper/mRange.lower)*mAxisRect->width()+mAxisRect->left();
+          return qLn(mRange.upper/value)/logSpan()*mAxisRect->width()+mAxisRect->left();
       }
     }
   } else // orientation() == Qt::Vertical
@@ -1528,14 +1581,77 @@ double QCPAxis::coordToPixel(double value) const
       else
       {
         if (!mRangeReversed)
-          return mAxisRect->bottom()-qLn(value/mRange.lower)/qLn(mRange.upper/mRange.lower)*mAxisRect->height();
+          return mAxisRect->bottom()-qLn(value/mRange.lower)/logSpan()*mAxisRect->height();
         else
-          return mAxisRect->bottom()-qLn(mRange.upper/value)/qLn(mRange.upper/mRange.lower)*mAxisRect->height();
+          return mAxisRect->bottom()-qLn(mRange.upper/value)/logSpan()*mAxisRect->height();
       }
     }
   }
 }
 
+/*!
+  Transforms the \a count pixel coordinates \a pixels to axis coordinates, writing the results to
+  \a coords. \a pixels and \a coords may point to the same array.
+  
+  This is equivalent to calling \ref pixelToCoord for every pixel coordinate, but for linear and
+  custom scales (\ref stLinear, \ref stCustom), the mapping to the linear domain is calculated
+  only once, and a custom scale transform is applied to the whole batch via \ref
+  QCPScaleTransform::inverseTransformMany.
+  
+  \see coordsToPixels
+*/
+void QCPAxis::pixelsToCoords(const double *pixels, double *coords, int count) const
+{
+  if (mScaleType == stLogarithmic)
+  {
+    for (int i=0; i<count; ++i)
+      coords[i] = pixelToCoord(pixels[i]);
+    return;
+  }
+  double lower = mRange.lower, upper = mRange.upper;
+  const bool custom = mScaleType == stCustom && transformedRange(lower, upper);
+  const double lowerPixel = coordToPixel(mRange.lower);
+  const double valuesPerPixel = (upper-lower)/(coordToPixel(mRange.upper)-lowerPixel);
+  for (int i=0; i<count; ++i)
+    coords[i] = lower+(pixels[i]-lowerPixel)*valuesPerPixel;
+  if (custom)
+    mScaleTransform->inverseTransformMany(coords, coords, count);
+}
+
+/*!
+  Transforms the \a count axis coordinates \a coords to pixel coordinates, writing the results to
+  \a pixels. \a coords and \a pixels may point to the same array.
+  
+  This is equivalent to calling \ref coordToPixel for every coordinate, but for linear and custom
+  scales (\ref stLinear, \ref stCustom), the mapping from the linear domain is calculated only
+  once, and a custom scale transform is applied to the whole batch via \ref
+  QCPScaleTransform::transformMany. Plottables use this method to transform their data in
+  batches.
+  
+  \see pixelsToCoords
+*/
+void QCPAxis::coordsToPixels(const double *coords, double *pixels, int count) const
+{
+  if (mScaleType == stLogarithmic)
+  {
+    for (int i=0; i<count; ++i)
+      pixels[i] = coordToPixel(coords[i]);
+    return;
+  }
+  double lower = mRange.lower, upper = mRange.upper;
+  const bool custom = mScaleType == stCustom && transformedRange(lower, upper);
+  const double lowerPixel = coordToPixel(mRange.lower);
+  const double pixelsPerValue = (coordToPixel(mRange.upper)-lowerPixel)/(upper-lower);
+  const double *values = coords;
+  if (custom)
+  {
+    mScaleTransform->transformMany(coords, pixels, count);
+    values = pixels;
+  }
+  for (int i=0; i<count; ++i)
+    pixels[i] = lowerPixel+(values[i]-lower)*pixelsPerValue;
+}
+
 /*!
   Returns the part of the axis that is hit by \a pos (in pixels). The return value of this function
   is independent of the user-selectable parts defined with \ref setSelectableParts. Further, this
@@ -1760,6 +1876,10 @@ void QCPAxis::mouseMoveEvent(QMouseEvent *event, const QPointF &startPos)
     {
       const double diff = pixelToCoord(startPixel) / pixelToCoord(currentPixel);
       setRange(mDragStartRange.lower*diff, mDragStartRange.upper*diff);
+    } else if (mScaleType == QCPAxis::stCustom)
+    {
+      const double diff = mScaleTransform->transform(pixelToCoord(startPixel)) - mScaleTransform->transform(pixelToCoord(currentPixel));
+      setRange(mScaleTransform->movedRange(mDragStartRange, diff));
     }
     
     if (mParentPlot->noAntialiasingOnDrag())
@@ -1913,9 +2033,86 @@ void QCPAxis::setupTickVectors()
   
   QVector<QString> oldLabels = mTickVectorLabels;
   mTicker->generate(mRange, mParentPlot->locale(), mNumberFormatChar, mNumberPrecision, mTickVector, mSubTicks ? &mSubTickVector : 0, mTickLabels ? &mTickVectorLabels : 0);
+  if (mScaleType == stCustom) // remove ticks in parts of the axis that the scale transform doesn't display
+  {
+    int kept = 0;
+    for (int i=0; i<mTickVector.size(); ++i)
+    {
+      if (!mScaleTransform->isVisible(mTickVector.at(i)))
+        continue;
+      mTickVector[kept] = mTickVector.at(i);
+      if (mTickLabels && i < mTickVectorLabels.size())
+        mTickVectorLabels[kept] = mTickVectorLabels.at(i);
+      ++kept;
+    }
+    mTickVector.resize(kept);
+    if (mTickLabels)
+      mTickVectorLabels.resize(kept);
+    kept = 0;
+    for (int i=0; i<mSubTickVector.size(); ++i)
+    {
+      if (mScaleTransform->isVisible(mSubTickVector.at(i)))
+        mSubTickVector[kept++] = mSubTickVector.at(i);
+    }
+    mSubTickVector.resize(kept);
+  }
   mCachedMarginValid &= mTickVectorLabels == oldLabels; // if labels have changed, margin might have changed, too
 }
 
+/*! \internal
+  
+  Returns the natural logarithm of the ratio of the range bounds, which is the span of the range in
+  the logarithmic domain used by \ref coordToPixel and \ref pixelToCoord for \ref stLogarithmic
+  scales. The value is cached and only recalculated when the range changed, so the transformation of
+  a coordinate costs a single logarithm (or exponential).
+*/
+double QCPAxis::logSpan() const
+{
+  if (mRange != mLogSpanRange)
+  {
+    mLogSpanRange = mRange;
+    mLogSpan = qLn(mRange.upper/mRange.lower);
+  }
+  return mLogSpan;
+}
+
+/*! \internal
+  
+  Writes the bounds of the axis range, transformed with the scale transform of \ref stCustom
+  scales, to \a lower and \a upper, and returns true.
+  
+  If the transformed range is empty or not finite, e.g. for a \ref QCPScaleTransformBroken whose
+  gap contains the entire range, returns false without changing \a lower and \a upper. The
+  coordinate transformations then map the range linearly, instead of dividing by a zero span.
+*/
+bool QCPAxis::transformedRange(double &lower, double &upper) const
+{
+  const double transformedLower = mScaleTransform->transform(mRange.lower);
+  const double transformedUpper = mScaleTransform->transform(mRange.upper);
+  const double span = transformedUpper-transformedLower;
+  if (span == 0 || !qIsFinite(span))
+    return false;
+  lower = transformedLower;
+  upper = transformedUpper;
+  return true;
+}
+
+/*! \internal
+  
+  Returns \a range sanitized for the current scale type: Logarithmic scales must not span zero
+  (\ref QCPRange::sanitizedForLogScale), custom scales are restricted to the domain of their
+  transform (\ref QCPScaleTransform::sanitizedRange).
+*/
+QCPRange QCPAxis::sanitizedRange(const QCPRange &range) const
+{
+  if (mScaleType == stLogarithmic)
+    return range.sanitizedForLogScale();
+  else if (mScaleType == stCustom)
+    return mScaleTransform->sanitizedRange(range.sanitizedForLinScale());
+  else
+    return range.sanitizedForLinScale();
+}
+
 /*! \internal
   
   Returns the pen that is used to draw the axis base line. Depending on the selection state, this
@@ -33,6 +33,7 @@
 #include "../layout.h"
 #include "../lineending.h"
 #include "axisticker.h"
+#include "scaletransform.h"
 
 class QCPPainter;
 class QCustomPlot;
@@ -170,6 +171,7 @@ public:
   */
   enum ScaleType { stLinear       ///< Linear scaling
                    ,stLogarithmic ///< Logarithmic scaling with correspondingly transformed axis coordinates (possibly also \ref setTicker to a \ref QCPAxisTickerLog instance).
+                   ,stCustom      ///< Scaling defined by the transform set with \ref setScaleTransform, e.g. a \ref QCPScaleTransformSymLog instance.
                  };
   Q_ENUMS(ScaleType)
   /*!
@@ -195,6 +197,7 @@ public:
   const QCPRange range() const { return mRange; }
   bool rangeReversed() const { return mRangeReversed; }
   QSharedPointer<QCPAxisTicker> ticker() const { return mTicker; }
+  QSharedPointer<QCPScaleTransform> scaleTransform() const { return mScaleTransform; }
   bool ticks() const { return mTicks; }
   bool tickLabels() const { return mTickLabels; }
   int tickLabelPadding() const;
@@ -242,6 +245,7 @@ public:
   void setRangeUpper(double upper);
   void setRangeReversed(bool reversed);
   void setTicker(QSharedPointer<QCPAxisTicker> ticker);
+  void setScaleTransform(QSharedPointer<QCPScaleTransform> transform);
   void setTicks(bool show);
   void setTickLabels(bool show);
   void setTickLabelPadding(int padding);
@@ -289,9 +293,12 @@ public:
   void scaleRange(double factor);
   void scaleRange(double factor, double center);
   void setScaleRatio(const QCPAxis *otherAxis, double ratio=1.0);
+  void animateRange(const QCPRange &range, int duration=-1);
   void rescale(bool onlyVisiblePlottables=false);
   double pixelToCoord(double value) const;
   double coordToPixel(double value) const;
+  void pixelsToCoords(const double *pixels, double *coords, int count) const;
+  void coordsToPixels(const double *coords, double *pixels, int count) const;
   SelectablePart getPartAt(const QPointF &pos) const;
   QList<QCPAbstractPlottable*> plottables() const;
   QList<QCPGraph*> graphs() const;
@@ -349,6 +356,7 @@ protected:
   QCPGrid *mGrid;
   QCPAxisPainterPrivate *mAxisPainter;
   QSharedPointer<QCPAxisTicker> mTicker;
+  QSharedPointer<QCPScaleTransform> mScaleTransform;
   QVector<double> mTickVector;
   QVector<QString> mTickVectorLabels;
   QVector<double> mSubTickVector;
@@ -357,6 +365,8 @@ protected:
   bool mDragging;
   QCPRange mDragStartRange;
   QCP::AntialiasedElements mAADragBackup, mNotAADragBackup;
+  mutable QCPRange mLogSpanRange;
+  mutable double mLogSpan;
   
   // introduced virtual methods:
   virtual int calculateMargin();
@@ -376,6 +386,9 @@ protected:
   
   // non-virtual methods:
   void setupTickVectors();
+  double logSpan() const;
+  bool transformedRange(double &lower, double &upper) const;
+  QCPRange sanitizedRange(const QCPRange &range) const;
   QPen getBasePen() const;
   QPen getTickPen() const;
   QPen getSubTickPen() const;
@@ -0,0 +1,258 @@
+/***************************************************************************
+**                                                                        **
+**  QCustomPlot, an easy to use, modern plotting widget for Qt            **
+**  Copyright (C) 2011-2017 Emanuel Eichhammer                            **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+****************************************************************************
+**           Author: Emanuel Eichhammer                                   **
+**  Website/Contact: http://www.qcustomplot.com/                          **
+**             Date: 04.09.17                                             **
+**          Version: 2.0.0                                                **
+****************************************************************************/
+
+#include "axislinkgroup.h"
+
+#include "axis.h"
+#include "../core.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////// QCPAxisLinkGroup
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*! \class QCPAxisLinkGroup
+  \brief Keeps the ranges of a group of axes synchronized, possibly across multiple plots
+  
+  Axes are commonly synchronized by connecting the \ref QCPAxis::rangeChanged signal of each axis
+  to the \ref QCPAxis::setRange slot of the others. For larger numbers of axes, e.g. a dashboard of
+  many plots sharing a time axis, this gets expensive: Every link forwards the change separately,
+  each forwarded change is emitted again through the links of the receiving axis, and every plot
+  is replotted once per incoming change.
+  
+  A QCPAxisLinkGroup instead listens to the range changes of all its member axes (\ref addAxis).
+  When the range of a member changes, the new range is applied to all other members in a single
+  pass, while changes caused by this pass are not propagated again. If \ref setAutoReplot is
+  enabled (the default), each affected QCustomPlot then receives one queued replot (\ref
+  QCustomPlot::rpQueuedReplot), so all plots are redrawn at most once per event loop iteration. The
+  plot of the axis that caused the change isn't replotted by the group, since whoever changed that
+  axis (e.g. a range drag by the user) takes care of it.
+  
+  \code
+  QCPAxisLinkGroup *timeAxes = new QCPAxisLinkGroup(this);
+  foreach (QCustomPlot *plot, plots)
+    timeAxes->addAxis(plot->xAxis);
+  \endcode
+  
+  The member axes still emit their own \ref QCPAxis::rangeChanged signals, and the group emits
+  \ref rangeChanged once per propagated change.
+*/
+
+/* start of documentation of signals */
+
+/*! \fn void QCPAxisLinkGroup::rangeChanged(const QCPRange &newRange)
+  
+  This signal is emitted after a range change of one of the member axes (or a call to \ref
+  setRange) was propagated to all members.
+*/
+
+/* end of documentation of signals */
+
+/*!
+  Creates an empty axis link group. Add axes with \ref addAxis.
+*/
+QCPAxisLinkGroup::QCPAxisLinkGroup(QObject *parent) :
+  QObject(parent),
+  mAutoReplot(true),
+  mPropagating(false)
+{
+}
+
+QCPAxisLinkGroup::~QCPAxisLinkGroup()
+{
+  clear();
+}
+
+/*!
+  Sets whether the group replots the QCustomPlot instances of the member axes it changed. The
+  replots are queued (\ref QCustomPlot::rpQueuedReplot), so multiple changes within one event loop
+  iteration cause only one replot per plot.
+  
+  If disabled, replotting is left to the user.
+*/
+void QCPAxisLinkGroup::setAutoReplot(bool enabled)
+{
+  mAutoReplot = enabled;
+}
+
+/*!
+  Returns the member axes of this group.
+  
+  \see addAxis, removeAxis
+*/
+QList<QCPAxis*> QCPAxisLinkGroup::axes() const
+{
+  QList<QCPAxis*> result;
+  for (int i=0; i<mAxes.size(); ++i)
+  {
+    if (!mAxes.at(i).isNull())
+      result.append(mAxes.at(i).data());
+  }
+  return result;
+}
+
+/*!
+  Returns the number of member axes of this group.
+*/
+int QCPAxisLinkGroup::axisCount() const
+{
+  return axes().size();
+}
+
+/*!
+  Returns whether \a axis is a member of this group.
+*/
+bool QCPAxisLinkGroup::hasAxis(QCPAxis *axis) const
+{
+  return axis && mAxes.contains(axis);
+}
+
+/*!
+  Adds \a axis to this group. If the group already has members, the range of \a axis is set to
+  their range.
+  
+  Returns false if \a axis is 0 or already a member of this group.
+  
+  \see removeAxis
+*/
+bool QCPAxisLinkGroup::addAxis(QCPAxis *axis)
+{
+  if (!axis)
+  {
+    qDebug() << Q_FUNC_INFO << "passed axis is zero";
+    return false;
+  }
+  if (hasAxis(axis))
+  {
+    qDebug() << Q_FUNC_INFO << "axis is already a member of this group:" << reinterpret_cast<quintptr>(axis);
+    return false;
+  }
+  
+  const QList<QCPAxis*> members = axes();
+  if (!members.isEmpty() && axis->range() != members.first()->range())
+  {
+    axis->setRange(members.first()->range());
+    if (mAutoReplot && axis->parentPlot())
+      axis->parentPlot()->replot(QCustomPlot::rpQueuedReplot);
+  }
+  mAxes.append(axis);
+  connect(axis, SIGNAL(rangeChanged(QCPRange)), this, SLOT(axisRangeChanged(QCPRange)));
+  return true;
+}
+
+/*!
+  Removes \a axis from this group. Its range isn't changed.
+  
+  Returns false if \a axis isn't a member of this group.
+  
+  \see addAxis, clear
+*/
+bool QCPAxisLinkGroup::removeAxis(QCPAxis *axis)
+{
+  if (!hasAxis(axis))
+  {
+    qDebug() << Q_FUNC_INFO << "axis isn't a member of this group:" << reinterpret_cast<quintptr>(axis);
+    return false;
+  }
+  disconnect(axis, SIGNAL(rangeChanged(QCPRange)), this, SLOT(axisRangeChanged(QCPRange)));
+  mAxes.removeAll(axis);
+  return true;
+}
+
+/*!
+  Removes all member axes from this group.
+  
+  \see removeAxis
+*/
+void QCPAxisLinkGroup::clear()
+{
+  for (int i=0; i<mAxes.size(); ++i)
+  {
+    if (!mAxes.at(i).isNull())
+      disconnect(mAxes.at(i).data(), SIGNAL(rangeChanged(QCPRange)), this, SLOT(axisRangeChanged(QCPRange)));
+  }
+  mAxes.clear();
+}
+
+/*!
+  Sets the range of all member axes to \a range, and replots their QCustomPlot instances if \ref
+  setAutoReplot is enabled.
+*/
+void QCPAxisLinkGroup::setRange(const QCPRange &range)
+{
+  propagateRange(range, 0);
+}
+
+/*! \internal
+  
+  Sets the range of all member axes except \a source to \a range. Range changes of the members
+  which happen during this pass are not propagated again (see \ref axisRangeChanged).
+  
+  If \ref setAutoReplot is enabled, queues one replot for each QCustomPlot that holds a changed
+  member axis, except the QCustomPlot of \a source.
+*/
+void QCPAxisLinkGroup::propagateRange(const QCPRange &range, QCPAxis *source)
+{
+  if (mPropagating)
+    return;
+  mPropagating = true;
+  
+  QList<QCustomPlot*> changedPlots;
+  for (int i=mAxes.size()-1; i>=0; --i)
+  {
+    QCPAxis *axis = mAxes.at(i).data();
+    if (!axis)
+    {
+      mAxes.removeAt(i); // axis was deleted
+      continue;
+    }
+    if (axis == source || axis->range() == range)
+      continue;
+    axis->setRange(range);
+    if (axis->parentPlot() && !changedPlots.contains(axis->parentPlot()))
+      changedPlots.append(axis->parentPlot());
+  }
+  if (source)
+    changedPlots.removeAll(source->parentPlot());
+  
+  mPropagating = false;
+  emit rangeChanged(range);
+  if (mAutoReplot)
+  {
+    foreach (QCustomPlot *plot, changedPlots)
+      plot->replot(QCustomPlot::rpQueuedReplot);
+  }
+}
+
+/*! \internal
+  
+  Connected to the \ref QCPAxis::rangeChanged signal of all member axes. Propagates the new range
+  of the sending axis to the other members.
+*/
+void QCPAxisLinkGroup::axisRangeChanged(const QCPRange &newRange)
+{
+  if (mPropagating) // range change caused by the propagation itself
+    return;
+  propagateRange(newRange, qobject_cast<QCPAxis*>(sender()));
+}
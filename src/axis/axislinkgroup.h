@@ -0,0 +1,79 @@
+/***************************************************************************
+**                                                                        **
+**  QCustomPlot, an easy to use, modern plotting widget for Qt            **
+**  Copyright (C) 2011-2017 Emanuel Eichhammer                            **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+****************************************************************************
+**           Author: Emanuel Eichhammer                                   **
+**  Website/Contact: http://www.qcustomplot.com/                          **
+**             Date: 04.09.17                                             **
+**          Version: 2.0.0                                                **
+****************************************************************************/
+
+#ifndef QCP_AXISLINKGROUP_H
+#define QCP_AXISLINKGROUP_H
+
+#include "../global.h"
+#include "range.h"
+
+class QCPAxis;
+class QCustomPlot;
+
+class QCP_LIB_DECL QCPAxisLinkGroup : public QObject
+{
+  Q_OBJECT
+  /// \cond INCLUDE_QPROPERTIES
+  Q_PROPERTY(bool autoReplot READ autoReplot WRITE setAutoReplot)
+  /// \endcond
+public:
+  explicit QCPAxisLinkGroup(QObject *parent=0);
+  virtual ~QCPAxisLinkGroup();
+  
+  // getters:
+  bool autoReplot() const { return mAutoReplot; }
+  
+  // setters:
+  void setAutoReplot(bool enabled);
+  
+  // non-property methods:
+  QList<QCPAxis*> axes() const;
+  int axisCount() const;
+  bool hasAxis(QCPAxis *axis) const;
+  bool addAxis(QCPAxis *axis);
+  bool removeAxis(QCPAxis *axis);
+  void clear();
+  Q_SLOT void setRange(const QCPRange &range);
+  
+signals:
+  void rangeChanged(const QCPRange &newRange);
+  
+protected:
+  // property members:
+  bool mAutoReplot;
+  
+  // non-property members:
+  QList<QPointer<QCPAxis> > mAxes;
+  bool mPropagating;
+  
+  // non-virtual methods:
+  void propagateRange(const QCPRange &range, QCPAxis *source);
+  Q_SLOT void axisRangeChanged(const QCPRange &newRange);
+  
+private:
+  Q_DISABLE_COPY(QCPAxisLinkGroup)
+};
+
+#endif // QCP_AXISLINKGROUP_H
@@ -0,0 +1,541 @@
+/***************************************************************************
+**                                                                        **
+**  QCustomPlot, an easy to use, modern plotting widget for Qt            **
+**  Copyright (C) 2011-2017 Emanuel Eichhammer                            **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+****************************************************************************
+**           Author: Emanuel Eichhammer                                   **
+**  Website/Contact: http://www.qcustomplot.com/                          **
+**             Date: 04.09.17                                             **
+**          Version: 2.0.0                                                **
+****************************************************************************/
+
+#include "scaletransform.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////// QCPScaleTransform
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/*! \class QCPScaleTransform
+  \brief The base class of coordinate transforms for axes with a custom scale
+  
+  An axis with the scale type \ref QCPAxis::stCustom maps coordinates to pixels linearly in a
+  transformed domain, defined by the QCPScaleTransform set with \ref QCPAxis::setScaleTransform.
+  This allows nonlinear scales like \ref QCPScaleTransformSymLog "symmetric logarithmic", \ref
+  QCPScaleTransformSqrt "square root", \ref QCPScaleTransformProbability "probability" or \ref
+  QCPScaleTransformBroken "broken" axes, without transforming the data itself before passing it to
+  the plottables.
+  
+  The base class implements the identity transform. To create a custom scale, subclass it and
+  reimplement \ref transform and \ref inverseTransform. The transform must be strictly increasing
+  within its domain. Coordinates outside of the domain should be clamped to the domain, or
+  transformed to NaN, which plottables treat like missing data.
+  
+  Plottables transform large amounts of coordinates via \ref QCPAxis::coordsToPixels, which calls
+  the bulk methods \ref transformMany and \ref inverseTransformMany once per batch. The default
+  implementations call the virtual single-value methods per coordinate, so subclasses should
+  reimplement the bulk methods with a tight loop, as the transforms provided by QCustomPlot do.
+  
+  Like axis tickers, transforms are managed with QSharedPointer, so one transform can be shared by
+  multiple axes:
+  \code
+  QSharedPointer<QCPScaleTransformSymLog> symLog(new QCPScaleTransformSymLog(10));
+  customPlot->yAxis->setScaleType(QCPAxis::stCustom);
+  customPlot->yAxis->setScaleTransform(symLog);
+  \endcode
+  
+  The axis ticker isn't affected by the scale transform, except that ticks at coordinates which
+  aren't displayed (see \ref isVisible) are omitted. Depending on the transform, you may want to
+  set a ticker with an appropriate tick distribution, e.g. a \ref QCPAxisTickerFixed or \ref
+  QCPAxisTickerText.
+*/
+
+/*!
+  Creates an identity transform. Scale transforms are commonly created managed by a
+  QSharedPointer, which can then be passed to \ref QCPAxis::setScaleTransform.
+*/
+QCPScaleTransform::QCPScaleTransform()
+{
+}
+
+QCPScaleTransform::~QCPScaleTransform()
+{
+}
+
+/*!
+  Transforms the axis coordinate \a coord to the domain in which the axis is linear. The base
+  class implementation returns \a coord unchanged.
+  
+  \see inverseTransform, transformMany
+*/
+double QCPScaleTransform::transform(double coord) const
+{
+  return coord;
+}
+
+/*!
+  Transforms \a value from the linear domain back to an axis coordinate. This is the inverse of
+  \ref transform.
+*/
+double QCPScaleTransform::inverseTransform(double value) const
+{
+  return value;
+}
+
+/*!
+  Transforms the \a count axis coordinates \a coords to the linear domain, writing the results to
+  \a values. \a coords and \a values may point to the same array.
+  
+  The base class implementation calls \ref transform for every coordinate. Subclasses should
+  reimplement this method with a loop that doesn't dispatch virtually per coordinate.
+*/
+void QCPScaleTransform::transformMany(const double *coords, double *values, int count) const
+{
+  for (int i=0; i<count; ++i)
+    values[i] = transform(coords[i]);
+}
+
+/*!
+  Transforms the \a count values \a values from the linear domain back to axis coordinates,
+  writing the results to \a coords. \a values and \a coords may point to the same array.
+  
+  \see transformMany
+*/
+void QCPScaleTransform::inverseTransformMany(const double *values, double *coords, int count) const
+{
+  for (int i=0; i<count; ++i)
+    coords[i] = inverseTransform(values[i]);
+}
+
+/*!
+  Returns \a range restricted to the domain of the transform. The axis calls this method whenever
+  its range is set while the scale type is \ref QCPAxis::stCustom. The base class implementation
+  returns \a range unchanged.
+*/
+QCPRange QCPScaleTransform::sanitizedRange(const QCPRange &range) const
+{
+  return range;
+}
+
+/*!
+  Returns whether the axis coordinate \a coord is displayed on its own, i.e. doesn't lie in a part
+  of the axis that the transform removes. The axis omits ticks at coordinates that aren't visible.
+  The base class implementation returns true.
+  
+  \see QCPScaleTransformBroken
+*/
+bool QCPScaleTransform::isVisible(double coord) const
+{
+  Q_UNUSED(coord)
+  return true;
+}
+
+/*!
+  Returns \a range moved by \a diff in the linear domain of the transform. This is used for
+  dragging axes with a custom scale, so the range moves by the same pixel distance everywhere.
+*/
+QCPRange QCPScaleTransform::movedRange(const QCPRange &range, double diff) const
+{
+  return sanitizedRange(QCPRange(inverseTransform(transform(range.lower)+diff), inverseTransform(transform(range.upper)+diff)));
+}
+
+/*!
+  Returns \a range scaled by \a factor around the coordinate \a center, in the linear domain of
+  the transform. This is used for zooming axes with a custom scale.
+*/
+QCPRange QCPScaleTransform::scaledRange(const QCPRange &range, double factor, double center) const
+{
+  const double transformedCenter = transform(center);
+  return sanitizedRange(QCPRange(inverseTransform((transform(range.lower)-transformedCenter)*factor+transformedCenter),
+                                 inverseTransform((transform(range.upper)-transformedCenter)*factor+transformedCenter)));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////// QCPScaleTransformSymLog
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/*! \class QCPScaleTransformSymLog
+  \brief Symmetric logarithmic scale transform
+  
+  This transform is logarithmic for large absolute coordinates of both signs, and approximately
+  linear around zero, so unlike a logarithmic axis, it can display data that spans zero and
+  covers several orders of magnitude. A coordinate \c x is transformed to
+  <tt>sign(x)*log10(1+|x|/t)</tt>, where \c t is the linear threshold (\ref setLinearThreshold).
+*/
+
+/*!
+  Creates a symmetric logarithmic transform with the specified \a linearThreshold.
+*/
+QCPScaleTransformSymLog::QCPScaleTransformSymLog(double linearThreshold) :
+  mLinearThreshold(linearThreshold > 0 ? linearThreshold : 1.0)
+{
+}
+
+/*!
+  Sets the absolute coordinate below which the scale is approximately linear. Coordinates with a
+  much larger magnitude are scaled logarithmically. \a threshold must be greater than zero.
+  
+  If the transform is already used by an axis, replot afterwards to apply the change.
+*/
+void QCPScaleTransformSymLog::setLinearThreshold(double threshold)
+{
+  if (threshold > 0)
+    mLinearThreshold = threshold;
+  else
+    qDebug() << Q_FUNC_INFO << "linear threshold has to be greater than zero:" << threshold;
+}
+
+/* inherits documentation from base class */
+double QCPScaleTransformSymLog::transform(double coord) const
+{
+  const double magnitude = std::log10(1.0+qAbs(coord)/mLinearThreshold);
+  return coord < 0 ? -magnitude : magnitude;
+}
+
+/* inherits documentation from base class */
+double QCPScaleTransformSymLog::inverseTransform(double value) const
+{
+  const double magnitude = mLinearThreshold*(qPow(10.0, qAbs(value))-1.0);
+  return value < 0 ? -magnitude : magnitude;
+}
+
+/* inherits documentation from base class */
+void QCPScaleTransformSymLog::transformMany(const double *coords, double *values, int count) const
+{
+  const double thresholdInv = 1.0/mLinearThreshold;
+  for (int i=0; i<count; ++i)
+  {
+    const double magnitude = std::log10(1.0+qAbs(coords[i])*thresholdInv);
+    values[i] = coords[i] < 0 ? -magnitude : magnitude;
+  }
+}
+
+/* inherits documentation from base class */
+void QCPScaleTransformSymLog::inverseTransformMany(const double *values, double *coords, int count) const
+{
+  for (int i=0; i<count; ++i)
+    coords[i] = QCPScaleTransformSymLog::inverseTransform(values[i]);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////// QCPScaleTransformSqrt
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/*! \class QCPScaleTransformSqrt
+  \brief Square root scale transform
+  
+  This transform maps a coordinate \c x to <tt>sign(x)*sqrt(|x|)</tt>, which is e.g. useful for
+  data whose variance is proportional to its magnitude, like counting statistics.
+*/
+
+/*!
+  Creates a square root transform.
+*/
+QCPScaleTransformSqrt::QCPScaleTransformSqrt()
+{
+}
+
+/* inherits documentation from base class */
+double QCPScaleTransformSqrt::transform(double coord) const
+{
+  return coord < 0 ? -qSqrt(-coord) : qSqrt(coord);
+}
+
+/* inherits documentation from base class */
+double QCPScaleTransformSqrt::inverseTransform(double value) const
+{
+  return value < 0 ? -value*value : value*value;
+}
+
+/* inherits documentation from base class */
+void QCPScaleTransformSqrt::transformMany(const double *coords, double *values, int count) const
+{
+  for (int i=0; i<count; ++i)
+    values[i] = coords[i] < 0 ? -qSqrt(-coords[i]) : qSqrt(coords[i]);
+}
+
+/* inherits documentation from base class */
+void QCPScaleTransformSqrt::inverseTransformMany(const double *values, double *coords, int count) const
+{
+  for (int i=0; i<count; ++i)
+    coords[i] = values[i] < 0 ? -values[i]*values[i] : values[i]*values[i];
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////// QCPScaleTransformProbability
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/*! \class QCPScaleTransformProbability
+  \brief Normal probability scale transform
+  
+  This transform maps a probability \c p in the open interval (0, 1) to the quantile of the
+  standard normal distribution, as used for normal probability plots: The cumulative distribution
+  of normally distributed data appears as a straight line.
+  
+  Coordinates outside of the interval are clamped to it, and the axis range is restricted to it
+  (see \ref sanitizedRange).
+*/
+
+/*!
+  Creates a normal probability transform.
+*/
+QCPScaleTransformProbability::QCPScaleTransformProbability()
+{
+}
+
+/* inherits documentation from base class */
+double QCPScaleTransformProbability::transform(double coord) const
+{
+  return normalQuantile(coord);
+}
+
+/* inherits documentation from base class */
+double QCPScaleTransformProbability::inverseTransform(double value) const
+{
+  return normalCdf(value);
+}
+
+/* inherits documentation from base class */
+void QCPScaleTransformProbability::transformMany(const double *coords, double *values, int count) const
+{
+  for (int i=0; i<count; ++i)
+    values[i] = normalQuantile(coords[i]);
+}
+
+/* inherits documentation from base class */
+void QCPScaleTransformProbability::inverseTransformMany(const double *values, double *coords, int count) const
+{
+  for (int i=0; i<count; ++i)
+    coords[i] = normalCdf(values[i]);
+}
+
+/*!
+  Restricts \a range to probabilities between 1e-9 and 1-1e-9.
+*/
+QCPRange QCPScaleTransformProbability::sanitizedRange(const QCPRange &range) const
+{
+  const double limit = 1e-9;
+  QCPRange result(qBound(limit, range.lower, 1.0-limit), qBound(limit, range.upper, 1.0-limit));
+  if (result.lower >= result.upper)
+    result = QCPRange(limit, 1.0-limit);
+  return result;
+}
+
+/*!
+  Returns the quantile of the standard normal distribution at the probability \a p, i.e. the
+  inverse of \ref normalCdf. \a p is clamped to the interval [1e-12, 1-1e-12]. The relative error
+  is below 1.2e-9 (rational approximation by P. J. Acklam).
+*/
+double QCPScaleTransformProbability::normalQuantile(double p)
+{
+  if (qIsNaN(p))
+    return p;
+  p = qBound(1e-12, p, 1.0-1e-12);
+  static const double a[6] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02, 1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+  static const double b[5] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02, 6.680131188771972e+01, -1.328068155288572e+01};
+  static const double c[6] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00, -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+  static const double d[4] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00, 3.754408661907416e+00};
+  const double lowTail = 0.02425;
+  if (p < lowTail)
+  {
+    const double q = qSqrt(-2*qLn(p));
+    return (((((c[0]*q+c[1])*q+c[2])*q+c[3])*q+c[4])*q+c[5])/((((d[0]*q+d[1])*q+d[2])*q+d[3])*q+1);
+  } else if (p > 1-lowTail)
+  {
+    const double q = qSqrt(-2*qLn(1-p));
+    return -(((((c[0]*q+c[1])*q+c[2])*q+c[3])*q+c[4])*q+c[5])/((((d[0]*q+d[1])*q+d[2])*q+d[3])*q+1);
+  } else
+  {
+    const double q = p-0.5;
+    const double r = q*q;
+    return (((((a[0]*r+a[1])*r+a[2])*r+a[3])*r+a[4])*r+a[5])*q/(((((b[0]*r+b[1])*r+b[2])*r+b[3])*r+b[4])*r+1);
+  }
+}
+
+/*!
+  Returns the cumulative distribution function of the standard normal distribution at \a x. The
+  complementary error function is approximated with a fractional error below 1.2e-7.
+*/
+double QCPScaleTransformProbability::normalCdf(double x)
+{
+  const double z = qAbs(x)/M_SQRT2;
+  const double t = 1.0/(1.0+0.5*z);
+  const double erfc = t*qExp(-z*z-1.26551223+t*(1.00002368+t*(0.37409196+t*(0.09678418+t*(-0.18628806+t*(0.27886807+t*(-1.13520398+t*(1.48851587+t*(-0.82215223+t*0.17087277)))))))));
+  return x < 0 ? 0.5*erfc : 1.0-0.5*erfc;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////// QCPScaleTransformBroken
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/*! \class QCPScaleTransformBroken
+  \brief Scale transform that removes gaps from an otherwise linear axis
+  
+  This transform cuts out the coordinate ranges set with \ref setGaps or \ref addGap, so the
+  coordinates on both sides of a gap are displayed next to each other. This is useful for data
+  with long uninteresting stretches, e.g. time series with nights or weekends removed, or a few
+  outliers far away from the bulk of the data.
+  
+  Coordinates inside a gap are mapped to the position of the gap, and ticks inside a gap are
+  omitted (see \ref isVisible). Overlapping gaps are merged. If the axis range lies entirely inside
+  a gap, the axis displays the range linearly.
+*/
+
+/*!
+  Creates a broken axis transform without gaps, i.e. an identity transform.
+*/
+QCPScaleTransformBroken::QCPScaleTransformBroken()
+{
+}
+
+/*!
+  Sets the coordinate ranges that are removed from the axis. The order of \a gaps doesn't matter,
+  overlapping gaps are merged.
+  
+  If the transform is already used by an axis, replot afterwards to apply the change.
+*/
+void QCPScaleTransformBroken::setGaps(const QVector<QCPRange> &gaps)
+{
+  mGaps = gaps;
+  updateGapIndex();
+}
+
+/*!
+  Adds the coordinate range \a gap to the removed ranges.
+  
+  \see setGaps
+*/
+void QCPScaleTransformBroken::addGap(const QCPRange &gap)
+{
+  mGaps.append(gap);
+  updateGapIndex();
+}
+
+/*!
+  Removes all gaps, so the transform becomes the identity.
+*/
+void QCPScaleTransformBroken::clearGaps()
+{
+  mGaps.clear();
+  updateGapIndex();
+}
+
+/* inherits documentation from base class */
+double QCPScaleTransformBroken::transform(double coord) const
+{
+  const int i = int(std::upper_bound(mGapLowers.constBegin(), mGapLowers.constEnd(), coord)-mGapLowers.constBegin())-1;
+  if (i < 0)
+    return coord;
+  if (coord < mGaps.at(i).upper)
+    return mTransformedLowers.at(i);
+  return coord-mRemovedBefore.at(i)-mGaps.at(i).size();
+}
+
+/* inherits documentation from base class */
+double QCPScaleTransformBroken::inverseTransform(double value) const
+{
+  const int i = int(std::upper_bound(mTransformedLowers.constBegin(), mTransformedLowers.constEnd(), value)-mTransformedLowers.constBegin())-1;
+  if (i < 0)
+    return value;
+  return value+mRemovedBefore.at(i)+mGaps.at(i).size();
+}
+
+/*!
+  Returns false if \a coord lies in a gap, so no ticks are drawn where the gap collapses to a
+  single position. The upper bound of a gap is visible, it marks the position of the break.
+*/
+bool QCPScaleTransformBroken::isVisible(double coord) const
+{
+  const int i = int(std::upper_bound(mGapLowers.constBegin(), mGapLowers.constEnd(), coord)-mGapLowers.constBegin())-1;
+  return i < 0 || coord >= mGaps.at(i).upper;
+}
+
+/*!
+  Transforms the \a count coordinates \a coords. If the coordinates are ascending, as is the case
+  for the keys of most plottables, the gaps are tracked incrementally instead of being searched
+  for every coordinate.
+*/
+void QCPScaleTransformBroken::transformMany(const double *coords, double *values, int count) const
+{
+  const int gapCount = mGaps.size();
+  int gap = -1; // last gap with lower bound below or at the current coordinate
+  double previous = -std::numeric_limits<double>::max();
+  for (int i=0; i<count; ++i)
+  {
+    const double coord = coords[i];
+    if (!(coord >= previous)) // not ascending (or NaN), search again
+      gap = int(std::upper_bound(mGapLowers.constBegin(), mGapLowers.constEnd(), coord)-mGapLowers.constBegin())-1;
+    else
+    {
+      while (gap+1 < gapCount && mGapLowers.at(gap+1) <= coord)
+        ++gap;
+    }
+    previous = coord;
+    if (gap < 0)
+      values[i] = coord;
+    else if (coord < mGaps.at(gap).upper)
+      values[i] = mTransformedLowers.at(gap);
+    else
+      values[i] = coord-mRemovedBefore.at(gap)-mGaps.at(gap).size();
+  }
+}
+
+/*! \internal
+  
+  Sorts and merges the gaps, and updates the lookup vectors used by the transforms: the lower gap
+  bounds, the accumulated size of all gaps before each gap, and the transformed position of each
+  gap.
+*/
+void QCPScaleTransformBroken::updateGapIndex()
+{
+  QVector<QCPRange> gaps;
+  for (int i=0; i<mGaps.size(); ++i)
+  {
+    QCPRange gap = mGaps.at(i);
+    gap.normalize();
+    if (gap.size() > 0 && !qIsNaN(gap.size()))
+      gaps.append(gap);
+  }
+  std::sort(gaps.begin(), gaps.end(), QCPScaleTransformBroken::lowerLessThan);
+  mGaps.clear();
+  for (int i=0; i<gaps.size(); ++i)
+  {
+    if (!mGaps.isEmpty() && gaps.at(i).lower <= mGaps.last().upper)
+      mGaps.last().upper = qMax(mGaps.last().upper, gaps.at(i).upper);
+    else
+      mGaps.append(gaps.at(i));
+  }
+  
+  mGapLowers.resize(mGaps.size());
+  mRemovedBefore.resize(mGaps.size());
+  mTransformedLowers.resize(mGaps.size());
+  double removed = 0;
+  for (int i=0; i<mGaps.size(); ++i)
+  {
+    mGapLowers[i] = mGaps.at(i).lower;
+    mRemovedBefore[i] = removed;
+    mTransformedLowers[i] = mGaps.at(i).lower-removed;
+    removed += mGaps.at(i).size();
+  }
+}
+
+/*! \internal
+  
+  Orders gaps by their lower bound, used by \ref updateGapIndex.
+*/
+bool QCPScaleTransformBroken::lowerLessThan(const QCPRange &a, const QCPRange &b)
+{
+  return a.lower < b.lower;
+}
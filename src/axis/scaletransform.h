@@ -0,0 +1,140 @@
+/***************************************************************************
+**                                                                        **
+**  QCustomPlot, an easy to use, modern plotting widget for Qt            **
+**  Copyright (C) 2011-2017 Emanuel Eichhammer                            **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+****************************************************************************
+**           Author: Emanuel Eichhammer                                   **
+**  Website/Contact: http://www.qcustomplot.com/                          **
+**             Date: 04.09.17                                             **
+**          Version: 2.0.0                                                **
+****************************************************************************/
+
+#ifndef QCP_SCALETRANSFORM_H
+#define QCP_SCALETRANSFORM_H
+
+#include "../global.h"
+#include "range.h"
+
+class QCP_LIB_DECL QCPScaleTransform
+{
+public:
+  QCPScaleTransform();
+  virtual ~QCPScaleTransform();
+  
+  // introduced virtual methods:
+  virtual double transform(double coord) const;
+  virtual double inverseTransform(double value) const;
+  virtual void transformMany(const double *coords, double *values, int count) const;
+  virtual void inverseTransformMany(const double *values, double *coords, int count) const;
+  virtual QCPRange sanitizedRange(const QCPRange &range) const;
+  virtual bool isVisible(double coord) const;
+  
+  // non-virtual methods:
+  QCPRange movedRange(const QCPRange &range, double diff) const;
+  QCPRange scaledRange(const QCPRange &range, double factor, double center) const;
+};
+
+
+class QCP_LIB_DECL QCPScaleTransformSymLog : public QCPScaleTransform
+{
+public:
+  explicit QCPScaleTransformSymLog(double linearThreshold=1.0);
+  
+  // getters:
+  double linearThreshold() const { return mLinearThreshold; }
+  
+  // setters:
+  void setLinearThreshold(double threshold);
+  
+  // reimplemented virtual methods:
+  virtual double transform(double coord) const Q_DECL_OVERRIDE;
+  virtual double inverseTransform(double value) const Q_DECL_OVERRIDE;
+  virtual void transformMany(const double *coords, double *values, int count) const Q_DECL_OVERRIDE;
+  virtual void inverseTransformMany(const double *values, double *coords, int count) const Q_DECL_OVERRIDE;
+  
+protected:
+  // property members:
+  double mLinearThreshold;
+};
+
+
+class QCP_LIB_DECL QCPScaleTransformSqrt : public QCPScaleTransform
+{
+public:
+  QCPScaleTransformSqrt();
+  
+  // reimplemented virtual methods:
+  virtual double transform(double coord) const Q_DECL_OVERRIDE;
+  virtual double inverseTransform(double value) const Q_DECL_OVERRIDE;
+  virtual void transformMany(const double *coords, double *values, int count) const Q_DECL_OVERRIDE;
+  virtual void inverseTransformMany(const double *values, double *coords, int count) const Q_DECL_OVERRIDE;
+};
+
+
+class QCP_LIB_DECL QCPScaleTransformProbability : public QCPScaleTransform
+{
+public:
+  QCPScaleTransformProbability();
+  
+  // reimplemented virtual methods:
+  virtual double transform(double coord) const Q_DECL_OVERRIDE;
+  virtual double inverseTransform(double value) const Q_DECL_OVERRIDE;
+  virtual void transformMany(const double *coords, double *values, int count) const Q_DECL_OVERRIDE;
+  virtual void inverseTransformMany(const double *values, double *coords, int count) const Q_DECL_OVERRIDE;
+  virtual QCPRange sanitizedRange(const QCPRange &range) const Q_DECL_OVERRIDE;
+  
+  // static methods:
+  static double normalQuantile(double p);
+  static double normalCdf(double x);
+};
+
+
+class QCP_LIB_DECL QCPScaleTransformBroken : public QCPScaleTransform
+{
+public:
+  QCPScaleTransformBroken();
+  
+  // getters:
+  QVector<QCPRange> gaps() const { return mGaps; }
+  
+  // setters:
+  void setGaps(const QVector<QCPRange> &gaps);
+  
+  // non-property methods:
+  void addGap(const QCPRange &gap);
+  void clearGaps();
+  
+  // reimplemented virtual methods:
+  virtual double transform(double coord) const Q_DECL_OVERRIDE;
+  virtual double inverseTransform(double value) const Q_DECL_OVERRIDE;
+  virtual void transformMany(const double *coords, double *values, int count) const Q_DECL_OVERRIDE;
+  virtual bool isVisible(double coord) const Q_DECL_OVERRIDE;
+  
+protected:
+  // property members:
+  QVector<QCPRange> mGaps;
+  // non-property members:
+  QVector<double> mGapLowers;
+  QVector<double> mRemovedBefore;
+  QVector<double> mTransformedLowers;
+  
+  // non-virtual methods:
+  void updateGapIndex();
+  static bool lowerLessThan(const QCPRange &a, const QCPRange &b);
+};
+
+#endif // QCP_SCALETRANSFORM_H
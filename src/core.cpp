@@ -36,6 +36,29 @@
 #include "plottables/plottable-graph.h"
 #include "item.h"
 #include "selectionrect.h"
+#include "snapshot.h"
+#include "replotcoordinator.h"
+
+/*! \internal
+
+  Performs the rect selection test of a single plottable, so \ref QCustomPlot::processRectSelection
+  can test plottables with many data points concurrently.
+*/
+class QCPRectSelectionJob : public QRunnable
+{
+public:
+  QCPRectSelectionJob(const QCPPlottableInterface1D *plottable, const QRectF &rect) :
+    mPlottable(plottable),
+    mRect(rect)
+  {
+    setAutoDelete(false);
+  }
+  virtual void run() Q_DECL_OVERRIDE { mSelection = mPlottable->selectTestRect(mRect, true); }
+  
+  const QCPPlottableInterface1D *mPlottable;
+  QRectF mRect;
+  QCPDataSelection mSelection;
+};
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////// QCustomPlot
@@ -217,6 +240,16 @@
   \see selectedPlottables, selectedGraphs, selectedItems, selectedAxes, selectedLegends
 */
 
+/*! \fn void QCustomPlot::selectionChangeFinished(const QList<QCPAbstractPlottable*> &plottables, const QList<QCPAbstractItem*> &items)
+  
+  This signal is emitted when a selection change transaction ends (see \ref beginSelectionChange)
+  in which the selection state of at least one plottable or item has changed. \a plottables and \a
+  items contain the objects whose selection has changed during the transaction. The individual
+  selectionChanged signals of those objects are not emitted during a transaction.
+  
+  \see selectAll, QCP::phBatchSelectionChanges
+*/
+
 /*! \fn void QCustomPlot::beforeReplot()
   
   This signal is emitted immediately before a replot takes place (caused by a call to the slot \ref
@@ -367,11 +400,21 @@ QCustomPlot::QCustomPlot(QWidget *parent) :
   mSelectionRectMode(QCP::srmNone),
   mSelectionRect(0),
   mOpenGl(false),
+  mMouseMoveCoalescing(0),
   mMouseHasMoved(false),
   mMouseEventLayerable(0),
   mMouseSignalLayerable(0),
+  mMouseMoveTimer(new QTimer(this)),
+  mPendingMouseMove(QEvent::MouseMove, QPoint(), Qt::NoButton, Qt::NoButton, Qt::NoModifier),
+  mMouseMovePending(false),
   mReplotting(false),
   mReplotQueued(false),
+  mReplotDeferred(false),
+  mReplotCount(0),
+  mSelectionChangeDepth(0),
+  mReplotCoordinator(0),
+  mBlitAxisRect(0),
+  mBlitInvalidated(false),
   mOpenGlMultisamples(16),
   mOpenGlAntialiasedElementsBackup(QCP::aeNone),
   mOpenGlCacheLabelsBackup(true)
@@ -432,6 +475,8 @@ QCustomPlot::QCustomPlot(QWidget *parent) :
   legend->setLayer(QLatin1String("legend"));
   
   // create selection rect instance:
+  mMouseMoveTimer->setSingleShot(true);
+  connect(mMouseMoveTimer, SIGNAL(timeout()), this, SLOT(processPendingMouseMove()));
   mSelectionRect = new QCPSelectionRect(this);
   mSelectionRect->setLayer(QLatin1String("overlay"));
   
@@ -671,7 +716,13 @@ void QCustomPlot::setNoAntialiasingOnDrag(bool enabled)
 */
 void QCustomPlot::setPlottingHints(const QCP::PlottingHints &hints)
 {
+  const bool bufferTypeChanged = hints.testFlag(QCP::phFastAntialiasedLines) != mPlottingHints.testFlag(QCP::phFastAntialiasedLines);
   mPlottingHints = hints;
+  if (bufferTypeChanged && !mOpenGl) // recreate paint buffers with the appropriate type
+  {
+    mPaintBuffers.clear();
+    setupPaintBuffers();
+  }
 }
 
 /*!
@@ -850,6 +901,29 @@ void QCustomPlot::setOpenGl(bool enabled, int multisampling)
 #endif
 }
 
+/*!
+  Sets the minimum interval in \a milliseconds between two dispatched mouse move events. A value of
+  0 (the default) dispatches every mouse move event.
+  
+  Mice with high polling rates generate up to 1000 move events per second. If the application
+  replots or updates items (e.g. tracers) in reaction to the \ref mouseMove signal, or the user
+  drags axis ranges, each of these events costs a replot, and the events queue up faster than they
+  are processed. With a coalescing interval (typically around 16 ms, i.e. one frame), a move event
+  is dispatched immediately if the previous dispatch is longer ago than the interval. Otherwise only
+  the latest move event is remembered, and dispatched when the interval has passed. The \ref
+  mouseMove signal, range dragging, the selection rect and all other layerable mouse move handlers
+  then see at most one move per interval, always with the latest cursor position.
+  
+  Pending move events are dispatched before any mouse press, release, double click or wheel event,
+  so the order of the events is preserved.
+*/
+void QCustomPlot::setMouseMoveCoalescing(int milliseconds)
+{
+  mMouseMoveCoalescing = qMax(0, milliseconds);
+  if (mMouseMoveCoalescing == 0)
+    flushPendingMouseMove();
+}
+
 /*!
   Sets the viewport of this QCustomPlot. Usually users of QCustomPlot don't need to change the
   viewport manually.
@@ -1859,11 +1933,117 @@ QList<QCPLegend*> QCustomPlot::selectedLegends() const
 */
 void QCustomPlot::deselectAll()
 {
+  const bool batched = mPlottingHints.testFlag(QCP::phBatchSelectionChanges);
+  if (batched)
+    beginSelectionChange();
   foreach (QCPLayer *layer, mLayers)
   {
     foreach (QCPLayerable *layerable, layer->children())
       layerable->deselectEvent(0);
   }
+  if (batched)
+    endSelectionChange();
+}
+
+/*!
+  Selects all selectable plottables (with all their data points) and items of the QCustomPlot.
+  Axes and legends aren't affected.
+  
+  The selection is changed in one selection change transaction (see \ref beginSelectionChange), so
+  instead of the individual selectionChanged signals of the plottables and items, a single \ref
+  selectionChangeFinished signal is emitted, and a single replot is queued.
+  
+  Like \ref deselectAll, this function is not a user interaction and thus doesn't emit the \ref
+  selectionChangedByUser signal.
+  
+  \see deselectAll, QCPAbstractPlottable::setSelectable, QCPAbstractItem::setSelectable
+*/
+void QCustomPlot::selectAll()
+{
+  beginSelectionChange();
+  foreach (QCPAbstractPlottable *plottable, mPlottables)
+  {
+    if (plottable->selectable() == QCP::stNone)
+      continue;
+    QCPPlottableInterface1D *plottableInterface = plottable->interface1D();
+    const int dataCount = plottableInterface ? plottableInterface->dataCount() : 1;
+    if (dataCount > 0)
+      plottable->setSelection(QCPDataSelection(QCPDataRange(0, dataCount)));
+  }
+  foreach (QCPAbstractItem *item, mItems)
+  {
+    if (item->selectable())
+      item->setSelected(true);
+  }
+  endSelectionChange();
+}
+
+/*!
+  Starts a selection change transaction. Until the matching call to \ref endSelectionChange, the
+  selectionChanged signals of plottables and items (\ref QCPAbstractPlottable::selectionChanged,
+  \ref QCPAbstractItem::selectionChanged) are not emitted when their selection changes. Instead,
+  the changed objects are collected, and \ref endSelectionChange reports them in a single \ref
+  selectionChangeFinished signal and queues a single replot.
+  
+  This makes changing the selection of many objects at once (e.g. selecting thousands of
+  plottables) considerably faster, since connected code and replots only run once:
+  \code
+  customPlot->beginSelectionChange();
+  foreach (QCPGraph *graph, graphsToSelect)
+    graph->setSelection(QCPDataSelection(QCPDataRange(0, graph->dataCount())));
+  customPlot->endSelectionChange();
+  \endcode
+  
+  Transactions may be nested, only the outermost \ref endSelectionChange finishes the transaction.
+  Selection changes of axes and legends are not affected and still emit their individual signals.
+  
+  To perform the selection changes caused by user interaction and \ref deselectAll as transactions,
+  set the plotting hint \ref QCP::phBatchSelectionChanges (see \ref setPlottingHint).
+  
+  \see isChangingSelection, selectAll
+*/
+void QCustomPlot::beginSelectionChange()
+{
+  ++mSelectionChangeDepth;
+}
+
+/*!
+  Ends a selection change transaction started with \ref beginSelectionChange.
+  
+  When the outermost transaction ends and the selection of any plottable or item has changed during
+  the transaction, \ref selectionChangeFinished is emitted and a replot is queued (see \ref
+  rpQueuedReplot).
+*/
+void QCustomPlot::endSelectionChange()
+{
+  if (mSelectionChangeDepth <= 0)
+  {
+    qDebug() << Q_FUNC_INFO << "no selection change transaction in progress";
+    return;
+  }
+  if (--mSelectionChangeDepth > 0)
+    return;
+  
+  QList<QCPAbstractPlottable*> plottables;
+  for (int i=0; i<mSelectionChangedPlottables.size(); ++i)
+  {
+    if (mSelectionChangedPlottables.at(i))
+      plottables.append(mSelectionChangedPlottables.at(i).data());
+  }
+  QList<QCPAbstractItem*> items;
+  for (int i=0; i<mSelectionChangedItems.size(); ++i)
+  {
+    if (mSelectionChangedItems.at(i))
+      items.append(mSelectionChangedItems.at(i).data());
+  }
+  mSelectionChangedPlottables.clear();
+  mSelectionChangedItems.clear();
+  mSelectionChangedObjects.clear();
+  if (!plottables.isEmpty() || !items.isEmpty())
+  {
+    emit selectionChangeFinished(plottables, items);
+    replot(rpQueuedReplot);
+  }
 }
 
 /*!
@@ -1890,6 +2070,19 @@ void QCustomPlot::deselectAll()
   If a layer is in mode \ref QCPLayer::lmBuffered (\ref QCPLayer::setMode), it is also possible to
   replot only that specific layer via \ref QCPLayer::replot. See the documentation there for
   details.
+
+  If the plotting hint \ref QCP::phDeferHiddenReplots is set (\ref setPlottingHint) and the widget
+  currently isn't visible on screen, e.g. because it's in an inactive tab, in a minimized window or
+  scrolled out of a scroll area, the replot is skipped and the paint buffers are marked as
+  invalidated. Since a replot always draws the current state of the plot, any number of skipped
+  replots are then caught up by a single replot, when the widget is shown again (or its window is
+  restored), or, if it was scrolled out of view, by a queued replot scheduled when it is painted
+  the next time. Note that \ref beforeReplot and \ref afterReplot are only emitted for replots that
+  actually happen.
+
+  If this QCustomPlot was added to a \ref QCPReplotCoordinator, queued replots (\ref
+  rpQueuedReplot) are not scheduled for the next event loop iteration, but are handed to the
+  coordinator, which performs them together with those of the other plots in its next frame.
 */
 void QCustomPlot::replot(QCustomPlot::RefreshPriority refreshPriority)
 {
@@ -1898,32 +2091,17 @@ void QCustomPlot::replot(QCustomPlot::RefreshPriority refreshPriority)
     if (!mReplotQueued)
     {
       mReplotQueued = true;
-      QTimer::singleShot(0, this, SLOT(replot()));
+      if (mReplotCoordinator)
+        mReplotCoordinator->requestReplot(this);
+      else
+        QTimer::singleShot(0, this, SLOT(replot()));
     }
     return;
   }
   
-  if (mReplotting) // incase signals loop back to replot slot
+  if (!startReplot())
     return;
-  mReplotting = true;
-  mReplotQueued = false;
-  emit beforeReplot();
-  
-  updateLayout();
-  // draw all layered objects (grid, axes, plottables, items, legend,...) into their buffers:
-  setupPaintBuffers();
-  foreach (QCPLayer *layer, mLayers)
-    layer->drawToPaintBuffer();
-  for (int i=0; i<mPaintBuffers.size(); ++i)
-    mPaintBuffers.at(i)->setInvalidated(false);
-  
-  if ((refreshPriority == rpRefreshHint && mPlottingHints.testFlag(QCP::phImmediateRefresh)) || refreshPriority==rpImmediateRefresh)
-    repaint();
-  else
-    update();
-  
-  emit afterReplot();
-  mReplotting = false;
+  finishReplot(refreshPriority);
 }
 
 /*!
@@ -2212,10 +2390,22 @@ QSize QCustomPlot::sizeHint() const
   
   Event handler for when the QCustomPlot widget needs repainting. This does not cause a \ref replot, but
   draws the internal buffer on the widget surface.
+
+  An active selection rect which is drawn as an overlay (\ref QCPSelectionRect::setOverlay) is
+  painted on top of the buffers.
+
+  If a replot was deferred while the widget had an empty visible region, e.g. because it was
+  scrolled out of a scroll area (see \ref QCP::phDeferHiddenReplots), the widget receives no other
+  notification when it is scrolled back into view. In that case, the stale buffers are painted
+  and a queued replot (\ref rpQueuedReplot) is scheduled, which updates the widget once it is
+  done. The replot itself never happens inside the paint event. Replots deferred while the widget
+  was hidden or minimized are already caught up in \ref showEvent and \ref changeEvent.
 */
 void QCustomPlot::paintEvent(QPaintEvent *event)
 {
   Q_UNUSED(event);
+  if (mReplotDeferred) // exposed again, e.g. scrolled back into view, catch up on skipped replots
+    replot(rpQueuedReplot);
   QCPPainter painter(this);
   if (painter.isActive())
   {
@@ -2225,6 +2415,11 @@ void QCustomPlot::paintEvent(QPaintEvent *event)
     drawBackground(&painter);
     for (int bufferIndex = 0; bufferIndex < mPaintBuffers.size(); ++bufferIndex)
       mPaintBuffers.at(bufferIndex)->draw(&painter);
+    if (mSelectionRect && mSelectionRect->isActive() && mSelectionRect->overlay() && mSelectionRect->realVisibility())
+    {
+      mSelectionRect->applyDefaultAntialiasingHint(&painter);
+      mSelectionRect->drawSelection(&painter);
+    }
   }
 }
 
@@ -2241,6 +2436,33 @@ void QCustomPlot::resizeEvent(QResizeEvent *event)
   replot(rpQueuedRefresh); // queued refresh is important here, to prevent painting issues in some contexts (e.g. MDI subwindow)
 }
 
+/*! \internal
+  
+  Event handler for when the QCustomPlot widget is shown, e.g. because its tab became active or
+  its minimized window was restored. If replots were skipped while the widget was hidden (see \ref
+  QCP::phDeferHiddenReplots), they are caught up here by a single replot, so the paint buffers are
+  up to date when the widget is painted for the first time.
+*/
+void QCustomPlot::showEvent(QShowEvent *event)
+{
+  QWidget::showEvent(event);
+  if (mReplotDeferred)
+    replot(rpQueuedRefresh); // refresh with the paint that follows the show anyway
+}
+
+/*! \internal
+  
+  Event handler for state changes of the QCustomPlot widget. If the QCustomPlot is itself a top
+  level window, which is restored from being minimized, replots that were skipped in the meantime
+  (see \ref QCP::phDeferHiddenReplots) are caught up here.
+*/
+void QCustomPlot::changeEvent(QEvent *event)
+{
+  QWidget::changeEvent(event);
+  if (event->type() == QEvent::WindowStateChange && mReplotDeferred && !isMinimized())
+    replot(rpQueuedRefresh);
+}
+
 /*! \internal
   
  Event handler for when a double click occurs. Emits the \ref mouseDoubleClick signal, then
@@ -2252,6 +2474,7 @@ void QCustomPlot::resizeEvent(QResizeEvent *event)
 */
 void QCustomPlot::mouseDoubleClickEvent(QMouseEvent *event)
 {
+  flushPendingMouseMove(); // keep the event order intact
   emit mouseDoubleClick(event);
   mMouseHasMoved = false;
   mMousePressPos = event->pos();
@@ -2304,6 +2527,7 @@ void QCustomPlot::mouseDoubleClickEvent(QMouseEvent *event)
 */
 void QCustomPlot::mousePressEvent(QMouseEvent *event)
 {
+  flushPendingMouseMove(); // keep the event order intact
   emit mousePress(event);
   // save some state to tell in releaseEvent whether it was a click:
   mMouseHasMoved = false;
@@ -2344,6 +2568,10 @@ void QCustomPlot::mousePressEvent(QMouseEvent *event)
   
   Event handler for when the cursor is moved. Emits the \ref mouseMove signal.
 
+  If mouse move coalescing is enabled (\ref setMouseMoveCoalescing), events arriving shortly after
+  a dispatched one are held back, and only the latest of them is dispatched once the interval has
+  passed. The steps below are performed in \ref dispatchMouseMove.
+
   If the selection rect (\ref setSelectionRect) is currently active, the event is forwarded to it
   in order to update the rect geometry.
   
@@ -2353,6 +2581,28 @@ void QCustomPlot::mousePressEvent(QMouseEvent *event)
   \see mousePressEvent, mouseReleaseEvent
 */
 void QCustomPlot::mouseMoveEvent(QMouseEvent *event)
+{
+  if (mMouseMoveCoalescing > 0)
+  {
+    if (mMouseMoveTimer->isActive()) // a move was dispatched recently, only keep the latest one until the timer fires
+    {
+      mPendingMouseMove = *event; // copy keeps the sub-pixel positions and the event source
+      mMouseMovePending = true;
+      event->accept();
+      return;
+    }
+    mMouseMoveTimer->start(mMouseMoveCoalescing);
+  }
+  dispatchMouseMove(event);
+}
+
+/*! \internal
+  
+  Handles a mouse move event that passed the coalescing of \ref mouseMoveEvent (see \ref
+  setMouseMoveCoalescing): Emits the \ref mouseMove signal and forwards the event to the active
+  selection rect or the layerable with mouse capture focus.
+*/
+void QCustomPlot::dispatchMouseMove(QMouseEvent *event)
 {
   emit mouseMove(event);
   
@@ -2383,6 +2633,7 @@ void QCustomPlot::mouseMoveEvent(QMouseEvent *event)
 */
 void QCustomPlot::mouseReleaseEvent(QMouseEvent *event)
 {
+  flushPendingMouseMove(); // keep the event order intact
   emit mouseRelease(event);
   
   if (!mMouseHasMoved) // mouse hasn't moved (much) between press and release, so handle as click
@@ -2437,6 +2688,7 @@ void QCustomPlot::mouseReleaseEvent(QMouseEvent *event)
 */
 void QCustomPlot::wheelEvent(QWheelEvent *event)
 {
+  flushPendingMouseMove(); // keep the event order intact
   emit mouseWheel(event);
   // forward event to layerable under cursor:
   QList<QCPLayerable*> candidates = layerableListAt(event->pos(), false);
@@ -2615,7 +2867,9 @@ QCPAbstractPaintBuffer *QCustomPlot::createPaintBuffer()
     qDebug() << Q_FUNC_INFO << "OpenGL enabled even though no support for it compiled in, this shouldn't have happened. Falling back to pixmap paint buffer.";
     return new QCPPaintBufferPixmap(viewport().size(), mBufferDevicePixelRatio);
 #endif
-  } else
+  } else if (mPlottingHints.testFlag(QCP::phFastAntialiasedLines))
+    return new QCPPaintBufferImage(viewport().size(), mBufferDevicePixelRatio);
+  else
     return new QCPPaintBufferPixmap(viewport().size(), mBufferDevicePixelRatio);
 }
 
@@ -2640,6 +2894,300 @@ bool QCustomPlot::hasInvalidatedPaintBuffers()
   return false;
 }
 
+/*! \internal
+
+  Registers that the contents of \a axisRect were moved by the user since the last replot, e.g. by
+  dragging or zooming the axis ranges. \a transform maps the pixel positions of the previous frame
+  to the new ones, and \a axes are the axes whose ranges were changed accordingly. Subsequent calls
+  are accumulated until the next \ref replot, which then tries to reuse the previous frame via \ref
+  replotBlitted.
+
+  If different axis rects are registered before the next replot, the previous frame can't be
+  reused and the next replot redraws everything.
+
+  \see QCPAxisRect::setRangeDragBlitting, QCPAxisRect::setRangeZoomPreviewDelay
+*/
+void QCustomPlot::addPendingBlit(QCPAxisRect *axisRect, const QTransform &transform, const QList<QCPAxis*> &axes)
+{
+  if (mBlitAxisRect.isNull() && !mBlitInvalidated)
+  {
+    mBlitAxisRect = axisRect;
+    mBlitRect = axisRect->rect();
+    mBlitTransform = transform;
+    mBlitAxes.clear();
+  } else if (mBlitAxisRect.data() == axisRect)
+    mBlitTransform *= transform;
+  else
+  {
+    invalidatePendingBlit();
+    return;
+  }
+  foreach (QCPAxis *axis, axes)
+  {
+    if (!mBlitAxes.contains(axis))
+      mBlitAxes.append(axis);
+  }
+}
+
+/*! \internal
+
+  Makes sure the next \ref replot redraws all paint buffers entirely, even if movements were
+  registered with \ref addPendingBlit since the last replot. This is used when the plot changed
+  in a way that is not a mere movement of the axis rect contents.
+*/
+void QCustomPlot::invalidatePendingBlit()
+{
+  mBlitInvalidated = true;
+}
+
+/*! \internal
+
+  Returns whether a replot may currently be skipped, because \ref QCP::phDeferHiddenReplots is set
+  and the widget isn't visible on screen. The skipped replot is caught up by \ref showEvent or
+  \ref changeEvent once the widget is shown or restored, or queued by \ref paintEvent once it is
+  exposed again otherwise (e.g. scrolled back into view).
+*/
+bool QCustomPlot::isReplotDeferrable() const
+{
+  if (!mPlottingHints.testFlag(QCP::phDeferHiddenReplots))
+    return false;
+  return !isVisible() || window()->isMinimized() || visibleRegion().isEmpty();
+}
+
+/*! \internal
+
+  Performs the first part of a replot: emits \ref beforeReplot and updates the layout, so the axis
+  rects and axes have their final geometry. Returns false if a replot is already in progress, in
+  which case \ref finishReplot must not be called.
+
+  \ref replot simply calls this method followed by \ref finishReplot. The two are separate so a
+  \ref QCPReplotCoordinator can prepare the plottable geometry of several plots in between (see
+  \ref QCPAbstractPlottable::prepareDraw).
+*/
+bool QCustomPlot::startReplot()
+{
+  if (mReplotting) // incase signals loop back to replot slot
+    return false;
+  if (isReplotDeferrable())
+  {
+    mReplotQueued = false;
+    mReplotDeferred = true;
+    for (int i=0; i<mPaintBuffers.size(); ++i)
+      mPaintBuffers.at(i)->setInvalidated(); // makes layer replots fall back to a full replot
+    return false;
+  }
+  mReplotting = true;
+  mReplotQueued = false;
+  mReplotDeferred = false;
+  ++mReplotCount; // invalidates geometry that plottables cache for the duration of one replot
+  emit beforeReplot();
+  
+  updateLayout();
+  return true;
+}
+
+/*! \internal
+
+  Performs the second part of a replot started with \ref startReplot: draws all layers into their
+  paint buffers, refreshes the widget surface according to \a refreshPriority and emits \ref
+  afterReplot.
+*/
+void QCustomPlot::finishReplot(QCustomPlot::RefreshPriority refreshPriority)
+{
+  // draw all layered objects (grid, axes, plottables, items, legend,...) into their buffers:
+  if (!replotBlitted())
+  {
+    setupPaintBuffers();
+    foreach (QCPLayer *layer, mLayers)
+      layer->drawToPaintBuffer();
+  }
+  mBlitAxisRect = 0;
+  mBlitTransform.reset();
+  mBlitAxes.clear();
+  mBlitInvalidated = false;
+  for (int i=0; i<mPaintBuffers.size(); ++i)
+    mPaintBuffers.at(i)->setInvalidated(false);
+  
+  if ((refreshPriority == rpRefreshHint && mPlottingHints.testFlag(QCP::phImmediateRefresh)) || refreshPriority==rpImmediateRefresh)
+    repaint();
+  else
+    update();
+  
+  emit afterReplot();
+  mReplotting = false;
+}
+
+/*! \internal
+
+  Draws the layers into the paint buffers by reusing the previous frame, instead of redrawing
+  everything. This is possible if the ranges of an axis rect were dragged or zoomed with \ref
+  QCPAxisRect::setRangeDragBlitting or \ref QCPAxisRect::setRangeZoomPreviewDelay enabled, and the
+  resulting pixel transform was registered with \ref addPendingBlit.
+
+  Paint buffers whose visible layerables all move along with the changed axes (see \ref
+  movesWithBlit) reuse their contents: If the transform is a shift by whole pixels, the contents
+  are shifted and only the strip of the axis rect which was uncovered by the shift is drawn. Any
+  other transform (i.e. a zoom) produces a preview by scaling the previous contents. If a preview
+  was drawn this way, the axis rect schedules a regular replot for when the interaction is over
+  (see \ref QCPAxisRect::zoomPreviewDrawn). All other paint buffers, e.g. the one holding the axes
+  with their tick labels, are redrawn entirely.
+
+  Returns false without touching the paint buffers, if nothing is pending or the previous frame
+  can't be reused, e.g. because the axis rect geometry or the paint buffer configuration changed.
+  The caller then performs a regular full redraw.
+*/
+bool QCustomPlot::replotBlitted()
+{
+  if (mBlitAxisRect.isNull() || mBlitInvalidated || mBlitAxisRect.data()->rect() != mBlitRect)
+    return false;
+  if (mPaintBuffers.isEmpty() || hasInvalidatedPaintBuffers())
+    return false;
+  for (int i=0; i<mPaintBuffers.size(); ++i)
+  {
+    if (mPaintBuffers.at(i)->size() != mViewport.size())
+      return false;
+  }
+  const QPoint delta(qRound(mBlitTransform.dx()), qRound(mBlitTransform.dy()));
+  const bool shiftOnly = mBlitTransform.type() <= QTransform::TxTranslate && QPointF(delta) == QPointF(mBlitTransform.dx(), mBlitTransform.dy());
+  if (shiftOnly && (qAbs(delta.x()) >= mBlitRect.width() || qAbs(delta.y()) >= mBlitRect.height()))
+    return false;
+  
+  const QRegion exposedRegion = shiftOnly ? QRegion(mBlitRect).subtracted(QRegion(mBlitRect.translated(delta))) : QRegion();
+  bool warped = false;
+  for (int i=0; i<mPaintBuffers.size(); ++i)
+  {
+    QCPAbstractPaintBuffer *buffer = mPaintBuffers.at(i).data();
+    QList<QCPLayer*> bufferLayers;
+    bool reusable = true;
+    bool hasContent = false;
+    foreach (QCPLayer *layer, mLayers)
+    {
+      if (layer->mPaintBuffer.data() != buffer)
+        continue;
+      bufferLayers.append(layer);
+      foreach (QCPLayerable *child, layer->children())
+      {
+        if (child->realVisibility())
+        {
+          hasContent = true;
+          if (reusable && !movesWithBlit(child))
+            reusable = false;
+        }
+      }
+    }
+    if (reusable && shiftOnly && buffer->scroll(mBlitRect, delta))
+    {
+      if (!exposedRegion.isEmpty())
+      {
+        foreach (QCPLayer *layer, bufferLayers)
+          layer->drawToPaintBuffer(exposedRegion);
+      }
+    } else if (reusable && !shiftOnly && buffer->warp(mBlitRect, mBlitTransform))
+    {
+      if (hasContent)
+        warped = true;
+    } else
+    {
+      buffer->clear(Qt::transparent);
+      foreach (QCPLayer *layer, bufferLayers)
+        layer->drawToPaintBuffer();
+    }
+  }
+  if (warped) // the frame contains a scaled preview, the axis rect schedules the full quality replot
+    mBlitAxisRect.data()->zoomPreviewDrawn();
+  return true;
+}
+
+/*! \internal
+
+  Returns whether \a layerable is drawn exactly moved by the pending transform (see \ref
+  addPendingBlit), so its previous rendering may be reused by \ref replotBlitted. This is the case
+  for plottables and grids of the pending axis rect, if all their axes which are affected by the
+  transform were changed accordingly.
+*/
+bool QCustomPlot::movesWithBlit(const QCPLayerable *layerable) const
+{
+  QList<QCPAxis*> layerableAxes;
+  if (const QCPAbstractPlottable *plottable = qobject_cast<const QCPAbstractPlottable*>(layerable))
+    layerableAxes << plottable->keyAxis() << plottable->valueAxis();
+  else if (qobject_cast<const QCPGrid*>(layerable))
+    layerableAxes << qobject_cast<QCPAxis*>(layerable->parentLayerable());
+  else
+    return false;
+  
+  foreach (QCPAxis *axis, layerableAxes)
+  {
+    if (!axis || axis->axisRect() != mBlitAxisRect.data())
+      return false;
+    const bool moved = axis->orientation() == Qt::Horizontal ?
+          (mBlitTransform.m11() != 1 || mBlitTransform.dx() != 0) : (mBlitTransform.m22() != 1 || mBlitTransform.dy() != 0);
+    if (moved && !mBlitAxes.contains(axis))
+      return false;
+  }
+  return true;
+}
+
+/*! \internal
+  
+  Called when the mouse move coalescing interval has passed (see \ref setMouseMoveCoalescing). If
+  a move event was held back in the meantime, it is dispatched now and the interval starts anew.
+*/
+void QCustomPlot::processPendingMouseMove()
+{
+  if (!mMouseMovePending)
+    return;
+  QMouseEvent event(mPendingMouseMove); // local copy, receivers may cause further move events to be held back
+  mMouseMovePending = false;
+  mMouseMoveTimer->start(mMouseMoveCoalescing);
+  dispatchMouseMove(&event);
+}
+
+/*! \internal
+  
+  Immediately dispatches a mouse move event that is being held back by the mouse move coalescing
+  (see \ref setMouseMoveCoalescing), so it reaches its receivers before the next non-move mouse
+  event.
+*/
+void QCustomPlot::flushPendingMouseMove()
+{
+  mMouseMoveTimer->stop();
+  if (!mMouseMovePending)
+    return;
+  QMouseEvent event(mPendingMouseMove);
+  mMouseMovePending = false;
+  dispatchMouseMove(&event);
+}
+
+/*! \internal
+  
+  Called by \a plottable instead of emitting its selectionChanged signals, while a selection change
+  transaction is in progress (see \ref beginSelectionChange). The plottable is reported in the \ref
+  selectionChangeFinished signal at the end of the transaction.
+*/
+void QCustomPlot::registerSelectionChange(QCPAbstractPlottable *plottable)
+{
+  if (!mSelectionChangedObjects.contains(plottable))
+  {
+    mSelectionChangedObjects.insert(plottable);
+    mSelectionChangedPlottables.append(plottable);
+  }
+}
+
+/*! \internal
+  
+  Called by \a item instead of emitting its selectionChanged signal, while a selection change
+  transaction is in progress (see \ref beginSelectionChange). The item is reported in the \ref
+  selectionChangeFinished signal at the end of the transaction.
+*/
+void QCustomPlot::registerSelectionChange(QCPAbstractItem *item)
+{
+  if (!mSelectionChangedObjects.contains(item))
+  {
+    mSelectionChangedObjects.insert(item);
+    mSelectionChangedItems.append(item);
+  }
+}
+
 /*! \internal
 
   When \ref setOpenGl is set to true, this method is used to initialize OpenGL (create a context,
@@ -2758,7 +3306,9 @@ void QCustomPlot::legendRemoved(QCPLegend *legend)
   First, it determines which axis rect was the origin of the selection rect judging by the starting
   point of the selection. Then it goes through the plottables (\ref QCPAbstractPlottable1D to be
   precise) associated with that axis rect and finds the data points that are in \a rect. It does
-  this by querying their \ref QCPAbstractPlottable1D::selectTestRect method.
+  this by querying their \ref QCPAbstractPlottable1D::selectTestRect method. If the plotting hint
+  \ref QCP::phConcurrentRectSelection is set and the plottables hold many data points in total,
+  they are queried concurrently in a thread pool.
   
   Then, the actual selection is done by calling the plottables' \ref
   QCPAbstractPlottable::selectEvent, placing the found selected data points in the \a details
@@ -2770,6 +3320,9 @@ void QCustomPlot::legendRemoved(QCPLegend *legend)
 void QCustomPlot::processRectSelection(QRect rect, QMouseEvent *event)
 {
   bool selectionStateChanged = false;
+  const bool batched = mPlottingHints.testFlag(QCP::phBatchSelectionChanges);
+  if (batched)
+    beginSelectionChange();
   
   if (mInteractions.testFlag(QCP::iSelectPlottables))
   {
@@ -2778,15 +3331,44 @@ void QCustomPlot::processRectSelection(QRect rect, QMouseEvent *event)
     if (QCPAxisRect *affectedAxisRect = axisRectAt(rectF.topLeft()))
     {
       // determine plottables that were hit by the rect and thus are candidates for selection:
+      QList<QCPAbstractPlottable*> candidates;
+      QList<QCPRectSelectionJob*> jobs;
+      qint64 totalDataCount = 0;
       foreach (QCPAbstractPlottable *plottable, affectedAxisRect->plottables())
       {
         if (QCPPlottableInterface1D *plottableInterface = plottable->interface1D())
         {
-          QCPDataSelection dataSel = plottableInterface->selectTestRect(rectF, true);
-          if (!dataSel.isEmpty())
-            potentialSelections.insertMulti(dataSel.dataPointCount(), QPair<QCPAbstractPlottable*, QCPDataSelection>(plottable, dataSel));
+          candidates.append(plottable);
+          jobs.append(new QCPRectSelectionJob(plottableInterface, rectF));
+          totalDataCount += plottableInterface->dataCount();
         }
       }
+      const qint64 parallelThreshold = 1<<16; // number of data points below which threading overhead dominates
+      const int threadCount = qMin(QThread::idealThreadCount(), jobs.size());
+      if (mPlottingHints.testFlag(QCP::phConcurrentRectSelection) && threadCount > 1 && totalDataCount >= parallelThreshold)
+      {
+        // let the axes update their cached state on this thread, so the jobs only read them:
+        foreach (QCPAbstractPlottable *plottable, candidates)
+        {
+          if (plottable->keyAxis() && plottable->valueAxis())
+            plottable->coordsToPixels(plottable->keyAxis()->range().center(), plottable->valueAxis()->range().center());
+        }
+        QThreadPool pool;
+        pool.setMaxThreadCount(threadCount);
+        for (int i=0; i<jobs.size(); ++i)
+          pool.start(jobs.at(i));
+        pool.waitForDone();
+      } else
+      {
+        for (int i=0; i<jobs.size(); ++i)
+          jobs.at(i)->run();
+      }
+      for (int i=0; i<jobs.size(); ++i)
+      {
+        if (!jobs.at(i)->mSelection.isEmpty())
+          potentialSelections.insertMulti(jobs.at(i)->mSelection.dataPointCount(), QPair<QCPAbstractPlottable*, QCPDataSelection>(candidates.at(i), jobs.at(i)->mSelection));
+      }
+      qDeleteAll(jobs);
       
       if (!mInteractions.testFlag(QCP::iMultiSelect))
       {
@@ -2833,6 +3415,8 @@ void QCustomPlot::processRectSelection(QRect rect, QMouseEvent *event)
     }
   }
   
+  if (batched)
+    endSelectionChange();
   if (selectionStateChanged)
   {
     emit selectionChangedByUser();
@@ -2887,6 +3471,9 @@ void QCustomPlot::processPointSelection(QMouseEvent *event)
   QCPLayerable *clickedLayerable = layerableAt(event->pos(), true, &details);
   bool selectionStateChanged = false;
   bool additive = mInteractions.testFlag(QCP::iMultiSelect) && event->modifiers().testFlag(mMultiSelectModifier);
+  const bool batched = mPlottingHints.testFlag(QCP::phBatchSelectionChanges);
+  if (batched)
+    beginSelectionChange();
   // deselect all other layerables if not additive selection:
   if (!additive)
   {
@@ -2910,6 +3497,8 @@ void QCustomPlot::processPointSelection(QMouseEvent *event)
     clickedLayerable->selectEvent(event, additive, details, &selChanged);
     selectionStateChanged |= selChanged;
   }
+  if (batched)
+    endSelectionChange();
   if (selectionStateChanged)
   {
     emit selectionChangedByUser();
@@ -3122,6 +3711,36 @@ bool QCustomPlot::saveRastered(const QString &fileName, int width, int height, d
     return false;
 }
 
+/*!
+  Saves the axis rects, plottables (including their data) and items of this plot to the binary
+  snapshot file \a fileName. The snapshot can later be restored with \ref loadSnapshot, which is
+  much faster than regenerating or re-importing large data sets.
+
+  Returns true on success.
+
+  \see QCPSnapshot
+*/
+bool QCustomPlot::saveSnapshot(const QString &fileName)
+{
+  QCPSnapshot snapshot;
+  return snapshot.save(this, fileName);
+}
+
+/*!
+  Restores the snapshot file \a fileName previously written with \ref saveSnapshot. All plottables
+  and items currently in the plot are removed and replaced by the ones stored in the snapshot. Call
+  \ref replot afterwards to show the restored state.
+
+  Returns true on success.
+
+  \see QCPSnapshot
+*/
+bool QCustomPlot::loadSnapshot(const QString &fileName)
+{
+  QCPSnapshot snapshot;
+  return snapshot.load(this, fileName);
+}
+
 /*!
   Renders the plot to a pixmap and returns it.
   
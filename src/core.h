@@ -39,6 +39,7 @@ class QCPGraph;
 class QCPLegend;
 class QCPAbstractLegendItem;
 class QCPSelectionRect;
+class QCPReplotCoordinator;
 
 class QCP_LIB_DECL QCustomPlot : public QWidget
 {
@@ -54,6 +55,7 @@ class QCP_LIB_DECL QCustomPlot : public QWidget
   Q_PROPERTY(bool noAntialiasingOnDrag READ noAntialiasingOnDrag WRITE setNoAntialiasingOnDrag)
   Q_PROPERTY(Qt::KeyboardModifier multiSelectModifier READ multiSelectModifier WRITE setMultiSelectModifier)
   Q_PROPERTY(bool openGl READ openGl WRITE setOpenGl)
+  Q_PROPERTY(int mouseMoveCoalescing READ mouseMoveCoalescing WRITE setMouseMoveCoalescing)
   /// \endcond
 public:
   /*!
@@ -99,6 +101,8 @@ public:
   QCP::SelectionRectMode selectionRectMode() const { return mSelectionRectMode; }
   QCPSelectionRect *selectionRect() const { return mSelectionRect; }
   bool openGl() const { return mOpenGl; }
+  int mouseMoveCoalescing() const { return mMouseMoveCoalescing; }
+  QCPReplotCoordinator *replotCoordinator() const { return mReplotCoordinator; }
   
   // setters:
   void setViewport(const QRect &rect);
@@ -123,6 +127,7 @@ public:
   void setSelectionRectMode(QCP::SelectionRectMode mode);
   void setSelectionRect(QCPSelectionRect *selectionRect);
   void setOpenGl(bool enabled, int multisampling=16);
+  void setMouseMoveCoalescing(int milliseconds);
   
   // non-property methods:
   // plottable interface:
@@ -178,13 +183,19 @@ public:
   
   QList<QCPAxis*> selectedAxes() const;
   QList<QCPLegend*> selectedLegends() const;
+  Q_SLOT void selectAll();
   Q_SLOT void deselectAll();
+  void beginSelectionChange();
+  void endSelectionChange();
+  bool isChangingSelection() const { return mSelectionChangeDepth > 0; }
   
   bool savePdf(const QString &fileName, int width=0, int height=0, QCP::ExportPen exportPen=QCP::epAllowCosmetic, const QString &pdfCreator=QString(), const QString &pdfTitle=QString());
   bool savePng(const QString &fileName, int width=0, int height=0, double scale=1.0, int quality=-1, int resolution=96, QCP::ResolutionUnit resolutionUnit=QCP::ruDotsPerInch);
   bool saveJpg(const QString &fileName, int width=0, int height=0, double scale=1.0, int quality=-1, int resolution=96, QCP::ResolutionUnit resolutionUnit=QCP::ruDotsPerInch);
   bool saveBmp(const QString &fileName, int width=0, int height=0, double scale=1.0, int resolution=96, QCP::ResolutionUnit resolutionUnit=QCP::ruDotsPerInch);
   bool saveRastered(const QString &fileName, int width, int height, double scale, const char *format, int quality=-1, int resolution=96, QCP::ResolutionUnit resolutionUnit=QCP::ruDotsPerInch);
+  bool saveSnapshot(const QString &fileName);
+  bool loadSnapshot(const QString &fileName);
   QPixmap toPixmap(int width=0, int height=0, double scale=1.0);
   void toPainter(QCPPainter *painter, int width=0, int height=0);
   Q_SLOT void replot(QCustomPlot::RefreshPriority refreshPriority=QCustomPlot::rpRefreshHint);
@@ -209,6 +220,7 @@ signals:
   void legendDoubleClick(QCPLegend *legend,  QCPAbstractLegendItem *item, QMouseEvent *event);
   
   void selectionChangedByUser();
+  void selectionChangeFinished(const QList<QCPAbstractPlottable*> &plottables, const QList<QCPAbstractItem*> &items);
   void beforeReplot();
   void afterReplot();
   
@@ -237,6 +249,7 @@ protected:
   QCP::SelectionRectMode mSelectionRectMode;
   QCPSelectionRect *mSelectionRect;
   bool mOpenGl;
+  int mMouseMoveCoalescing;
   
   // non-property members:
   QList<QSharedPointer<QCPAbstractPaintBuffer> > mPaintBuffers;
@@ -246,8 +259,23 @@ protected:
   QPointer<QCPLayerable> mMouseSignalLayerable;
   QVariant mMouseEventLayerableDetails;
   QVariant mMouseSignalLayerableDetails;
+  QTimer *mMouseMoveTimer;
+  QMouseEvent mPendingMouseMove;
+  bool mMouseMovePending;
   bool mReplotting;
   bool mReplotQueued;
+  bool mReplotDeferred;
+  quint64 mReplotCount;
+  int mSelectionChangeDepth;
+  QList<QPointer<QCPAbstractPlottable> > mSelectionChangedPlottables;
+  QList<QPointer<QCPAbstractItem> > mSelectionChangedItems;
+  QSet<QObject*> mSelectionChangedObjects;
+  QCPReplotCoordinator *mReplotCoordinator;
+  QPointer<QCPAxisRect> mBlitAxisRect;
+  QRect mBlitRect;
+  QTransform mBlitTransform;
+  QList<QPointer<QCPAxis> > mBlitAxes;
+  bool mBlitInvalidated;
   int mOpenGlMultisamples;
   QCP::AntialiasedElements mOpenGlAntialiasedElementsBackup;
   bool mOpenGlCacheLabelsBackup;
@@ -262,6 +290,8 @@ protected:
   virtual QSize sizeHint() const Q_DECL_OVERRIDE;
   virtual void paintEvent(QPaintEvent *event) Q_DECL_OVERRIDE;
   virtual void resizeEvent(QResizeEvent *event) Q_DECL_OVERRIDE;
+  virtual void showEvent(QShowEvent *event) Q_DECL_OVERRIDE;
+  virtual void changeEvent(QEvent *event) Q_DECL_OVERRIDE;
   virtual void mouseDoubleClickEvent(QMouseEvent *event) Q_DECL_OVERRIDE;
   virtual void mousePressEvent(QMouseEvent *event) Q_DECL_OVERRIDE;
   virtual void mouseMoveEvent(QMouseEvent *event) Q_DECL_OVERRIDE;
@@ -276,6 +306,7 @@ protected:
   Q_SLOT virtual void processRectSelection(QRect rect, QMouseEvent *event);
   Q_SLOT virtual void processRectZoom(QRect rect, QMouseEvent *event);
   Q_SLOT virtual void processPointSelection(QMouseEvent *event);
+  virtual void dispatchMouseMove(QMouseEvent *event);
   
   // non-virtual methods:
   bool registerPlottable(QCPAbstractPlottable *plottable);
@@ -288,6 +319,17 @@ protected:
   void setupPaintBuffers();
   QCPAbstractPaintBuffer *createPaintBuffer();
   bool hasInvalidatedPaintBuffers();
+  void addPendingBlit(QCPAxisRect *axisRect, const QTransform &transform, const QList<QCPAxis*> &axes);
+  void invalidatePendingBlit();
+  bool isReplotDeferrable() const;
+  bool startReplot();
+  void finishReplot(QCustomPlot::RefreshPriority refreshPriority);
+  bool replotBlitted();
+  bool movesWithBlit(const QCPLayerable *layerable) const;
+  Q_SLOT void processPendingMouseMove();
+  void flushPendingMouseMove();
+  void registerSelectionChange(QCPAbstractPlottable *plottable);
+  void registerSelectionChange(QCPAbstractItem *item);
   bool setupOpenGl();
   void freeOpenGl();
   
@@ -298,6 +340,7 @@ protected:
   friend class QCPAbstractPlottable;
   friend class QCPGraph;
   friend class QCPAbstractItem;
+  friend class QCPReplotCoordinator;
 };
 Q_DECLARE_METATYPE(QCustomPlot::LayerInsertMode)
 Q_DECLARE_METATYPE(QCustomPlot::RefreshPriority)
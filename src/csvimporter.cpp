@@ -0,0 +1,553 @@
+/***************************************************************************
+**                                                                        **
+**  QCustomPlot, an easy to use, modern plotting widget for Qt            **
+**  Copyright (C) 2011-2017 Emanuel Eichhammer                            **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+****************************************************************************
+**           Author: Emanuel Eichhammer                                   **
+**  Website/Contact: http://www.qcustomplot.com/                          **
+**             Date: 04.09.17                                             **
+**          Version: 2.0.0                                                **
+****************************************************************************/
+
+#include "csvimporter.h"
+
+#include "plottables/plottable-graph.h"
+#include "plottables/plottable-curve.h"
+#include "plottables/plottable-financial.h"
+
+/*! \internal
+  
+  Parses the lines of one chunk of a delimited text buffer into column vectors. Instances are run
+  concurrently by \ref QCPCsvImporter::parseBuffer, one per chunk. Besides the values, the
+  sortedness and the first and last (non-NaN) value of each column are determined, so the results
+  of all chunks can be merged without another pass over the data.
+*/
+class QCPCsvChunkParser : public QRunnable
+{
+public:
+  QCPCsvChunkParser(const char *begin, const char *end, int columnCount, char delimiter) :
+    mBegin(begin),
+    mEnd(end),
+    mDelimiter(delimiter),
+    mColumns(columnCount),
+    mSorted(columnCount, true),
+    mFirst(columnCount, qQNaN()),
+    mLast(columnCount, qQNaN())
+  {
+    setAutoDelete(false);
+  }
+  
+  virtual void run() Q_DECL_OVERRIDE
+  {
+    const int columnCount = mColumns.size();
+    // count lines first (cheap compared to number parsing), so the column vectors never reallocate:
+    int lineCount = 0;
+    for (const char *p = mBegin; p < mEnd; ++lineCount)
+    {
+      const char *next = static_cast<const char*>(memchr(p, '\n', mEnd-p));
+      p = next ? next+1 : mEnd;
+    }
+    for (int c=0; c<columnCount; ++c)
+      mColumns[c].reserve(lineCount);
+    
+    const char *lineBegin = mBegin;
+    while (lineBegin < mEnd)
+    {
+      const char *lineEnd = static_cast<const char*>(memchr(lineBegin, '\n', mEnd-lineBegin));
+      if (!lineEnd)
+        lineEnd = mEnd;
+      const char *contentEnd = lineEnd;
+      if (contentEnd > lineBegin && contentEnd[-1] == '\r')
+        --contentEnd;
+      if (contentEnd > lineBegin) // empty lines are skipped
+      {
+        const char *field = lineBegin;
+        for (int c=0; c<columnCount; ++c)
+        {
+          double value = qQNaN(); // missing fields of short lines are NaN
+          if (field <= contentEnd)
+          {
+            const char *fieldEnd = static_cast<const char*>(memchr(field, mDelimiter, contentEnd-field));
+            if (!fieldEnd)
+              fieldEnd = contentEnd;
+            value = QCPCsvImporter::parseNumber(field, fieldEnd);
+            field = fieldEnd+1;
+          }
+          mColumns[c].append(value);
+          if (qIsNaN(value))
+          {
+            mSorted[c] = false; // NaN keys have no place in a sorted container
+          } else
+          {
+            if (value < mLast.at(c))
+              mSorted[c] = false;
+            if (qIsNaN(mFirst.at(c)))
+              mFirst[c] = value;
+            mLast[c] = value;
+          }
+        }
+      }
+      lineBegin = lineEnd+1;
+    }
+  }
+  
+  const char *mBegin, *mEnd;
+  char mDelimiter;
+  QVector<QVector<double> > mColumns;
+  QVector<bool> mSorted;
+  QVector<double> mFirst, mLast;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////// QCPCsvImporter
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*! \class QCPCsvImporter
+  \brief Loads numeric delimited text files (CSV) into column vectors for plottables
+
+  QCPCsvImporter reads files of delimiter-separated numbers, such as CSV exports of measurement
+  software, and provides the columns in the form expected by the \c setData methods of the
+  plottables. Compared to splitting the lines with QString and converting each field with \c
+  toDouble, it is orders of magnitude faster, making it feasible to load files of several gigabytes:
+
+  \li The file is memory-mapped and parsed in place, without conversion to QString.
+  \li The text is split into chunks at line boundaries, which are parsed concurrently on \ref
+  setThreadCount threads.
+  \li Numbers are converted with a fast parser (\ref parseNumber) which handles the common decimal
+  and exponential notations exactly, only falling back to the locale-independent Qt conversion for
+  unusual input.
+  \li The sortedness of each column is determined while parsing, so passing a column as keys to
+  \c setData can skip the sorting step (\ref isColumnSorted).
+
+  A typical use looks like this:
+  \code
+  QCPCsvImporter importer;
+  importer.setHeaderLines(1);
+  if (importer.load("recording.csv"))
+    importer.applyTo(customPlot->addGraph(), 0, importer.columnIndex("voltage"));
+  \endcode
+
+  The number of columns is determined by the first data line. Lines with fewer fields are padded
+  with NaN, surplus fields are ignored. Fields that aren't numbers (including empty fields) become
+  NaN, so they appear as gaps in line plots. Whitespace and double quotes around fields are
+  ignored, but quoted fields may not contain the delimiter. Empty lines are skipped.
+*/
+
+/*!
+  Creates a QCPCsvImporter with comma as delimiter, no header lines and as many threads as there
+  are processor cores.
+*/
+QCPCsvImporter::QCPCsvImporter() :
+  mDelimiter(','),
+  mHeaderLines(0),
+  mThreadCount(qMax(1, QThread::idealThreadCount())),
+  mRowCount(0)
+{
+}
+
+/*!
+  Sets the character that separates the fields of a line, e.g. ',', ';' or '\\t'.
+*/
+void QCPCsvImporter::setDelimiter(char delimiter)
+{
+  if (delimiter == '\n' || delimiter == '\r')
+  {
+    qDebug() << Q_FUNC_INFO << "line break characters can't be used as delimiter";
+    return;
+  }
+  mDelimiter = delimiter;
+}
+
+/*!
+  Sets the number of lines at the beginning of the file which are skipped before the data starts.
+  The last of these lines is interpreted as the column names, see \ref columnNames.
+*/
+void QCPCsvImporter::setHeaderLines(int lines)
+{
+  mHeaderLines = qMax(0, lines);
+}
+
+/*!
+  Sets the maximum number of threads that parse the text concurrently. Small inputs are always
+  parsed on fewer threads, so each thread processes at least about one megabyte.
+*/
+void QCPCsvImporter::setThreadCount(int count)
+{
+  mThreadCount = qMax(1, count);
+}
+
+/*!
+  Loads the delimited text file \a fileName, replacing previously loaded columns. Returns true on
+  success.
+
+  \see parse, applyTo
+*/
+bool QCPCsvImporter::load(const QString &fileName)
+{
+  clear();
+  QFile file(fileName);
+  if (!file.open(QIODevice::ReadOnly))
+  {
+    qDebug() << Q_FUNC_INFO << "Couldn't open file for reading:" << fileName << file.errorString();
+    return false;
+  }
+  if (file.size() == 0)
+    return true;
+  
+  if (const uchar *mapped = file.map(0, file.size()))
+  {
+    const char *begin = reinterpret_cast<const char*>(mapped);
+    const bool result = parseBuffer(begin, begin+file.size());
+    file.unmap(const_cast<uchar*>(mapped));
+    return result;
+  }
+  // file system doesn't support mapping, fall back to reading the whole file:
+  const QByteArray text = file.readAll();
+  return parseBuffer(text.constData(), text.constData()+text.size());
+}
+
+/*!
+  Parses the delimited text \a text, replacing previously loaded columns. Returns true on success.
+
+  \see load, applyTo
+*/
+bool QCPCsvImporter::parse(const QByteArray &text)
+{
+  clear();
+  return parseBuffer(text.constData(), text.constData()+text.size());
+}
+
+/*!
+  Removes all loaded columns and column names.
+*/
+void QCPCsvImporter::clear()
+{
+  mColumnNames.clear();
+  mColumns.clear();
+  mColumnSorted.clear();
+  mRowCount = 0;
+}
+
+/*!
+  Returns the index of the column with the header name \a name, or -1 if there is no such column.
+  Column names are only available if \ref setHeaderLines was set to at least one.
+*/
+int QCPCsvImporter::columnIndex(const QString &name) const
+{
+  return mColumnNames.indexOf(name);
+}
+
+/*!
+  Returns the values of the column with \a index. Since QVector is implicitly shared, this doesn't
+  copy the data.
+*/
+QVector<double> QCPCsvImporter::column(int index) const
+{
+  if (!isValidColumn(index))
+    return QVector<double>();
+  return mColumns.at(index);
+}
+
+/*!
+  Returns whether the values of the column with \a index are in ascending order. This is the \a
+  alreadySorted parameter to use when passing the column as keys to a plottable.
+
+  Columns containing NaN (e.g. from empty or non-numeric fields) are reported as unsorted, because
+  NaN keys would break the binary searches of the data container if the sorting step was skipped.
+*/
+bool QCPCsvImporter::isColumnSorted(int index) const
+{
+  if (!isValidColumn(index))
+    return false;
+  return mColumnSorted.at(index);
+}
+
+/*!
+  Replaces the data of \a graph with the columns \a keyColumn and \a valueColumn. Returns false if
+  one of the columns doesn't exist.
+*/
+bool QCPCsvImporter::applyTo(QCPGraph *graph, int keyColumn, int valueColumn) const
+{
+  if (!graph || !isValidColumn(keyColumn) || !isValidColumn(valueColumn))
+  {
+    qDebug() << Q_FUNC_INFO << "invalid graph or column index" << keyColumn << valueColumn;
+    return false;
+  }
+  graph->setData(mColumns.at(keyColumn), mColumns.at(valueColumn), mColumnSorted.at(keyColumn));
+  return true;
+}
+
+/*! \overload
+
+  Replaces the data of \a curve with the columns \a tColumn, \a keyColumn and \a valueColumn.
+  Returns false if one of the columns doesn't exist.
+*/
+bool QCPCsvImporter::applyTo(QCPCurve *curve, int tColumn, int keyColumn, int valueColumn) const
+{
+  if (!curve || !isValidColumn(tColumn) || !isValidColumn(keyColumn) || !isValidColumn(valueColumn))
+  {
+    qDebug() << Q_FUNC_INFO << "invalid curve or column index" << tColumn << keyColumn << valueColumn;
+    return false;
+  }
+  curve->setData(mColumns.at(tColumn), mColumns.at(keyColumn), mColumns.at(valueColumn), mColumnSorted.at(tColumn));
+  return true;
+}
+
+/*! \overload
+
+  Replaces the data of \a financial with the columns \a keyColumn, \a openColumn, \a highColumn, \a
+  lowColumn and \a closeColumn. Returns false if one of the columns doesn't exist.
+*/
+bool QCPCsvImporter::applyTo(QCPFinancial *financial, int keyColumn, int openColumn, int highColumn, int lowColumn, int closeColumn) const
+{
+  if (!financial || !isValidColumn(keyColumn) || !isValidColumn(openColumn) || !isValidColumn(highColumn) || !isValidColumn(lowColumn) || !isValidColumn(closeColumn))
+  {
+    qDebug() << Q_FUNC_INFO << "invalid financial plottable or column index";
+    return false;
+  }
+  financial->setData(mColumns.at(keyColumn), mColumns.at(openColumn), mColumns.at(highColumn), mColumns.at(lowColumn), mColumns.at(closeColumn), mColumnSorted.at(keyColumn));
+  return true;
+}
+
+/*!
+  Converts the text between \a begin and \a end to a double. Surrounding whitespace and double
+  quotes are ignored. Returns NaN if the text isn't a number.
+
+  Numbers in decimal or exponential notation with up to 19 significant digits and a decimal
+  exponent of at most 22 in magnitude (which covers practically all machine-written data) are
+  converted with a single exact floating point multiplication or division, which yields the
+  correctly rounded result. Other input, including "nan" and "inf", is passed to the
+  locale-independent QByteArray::toDouble.
+*/
+double QCPCsvImporter::parseNumber(const char *begin, const char *end)
+{
+  static const double powersOf10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+  while (begin < end && (*begin == ' ' || *begin == '\t' || *begin == '"'))
+    ++begin;
+  while (end > begin && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '"'))
+    --end;
+  if (begin == end)
+    return qQNaN();
+  
+  const char *p = begin;
+  bool negative = false;
+  if (*p == '-' || *p == '+')
+  {
+    negative = *p == '-';
+    ++p;
+  }
+  quint64 mantissa = 0;
+  int significantDigits = 0;
+  int exponent = 0;
+  bool hasDigits = false;
+  bool exact = true;
+  while (p < end && *p >= '0' && *p <= '9')
+  {
+    mantissa = mantissa*10 + (*p-'0');
+    if (mantissa > 0 && ++significantDigits > 19)
+      exact = false;
+    hasDigits = true;
+    ++p;
+  }
+  if (p < end && *p == '.')
+  {
+    ++p;
+    while (p < end && *p >= '0' && *p <= '9')
+    {
+      mantissa = mantissa*10 + (*p-'0');
+      if (mantissa > 0 && ++significantDigits > 19)
+        exact = false;
+      --exponent;
+      hasDigits = true;
+      ++p;
+    }
+  }
+  if (hasDigits && p < end && (*p == 'e' || *p == 'E'))
+  {
+    ++p;
+    bool negativeExponent = false;
+    if (p < end && (*p == '-' || *p == '+'))
+    {
+      negativeExponent = *p == '-';
+      ++p;
+    }
+    int explicitExponent = 0;
+    bool hasExponentDigits = false;
+    while (p < end && *p >= '0' && *p <= '9')
+    {
+      if (explicitExponent < 100000)
+        explicitExponent = explicitExponent*10 + (*p-'0');
+      hasExponentDigits = true;
+      ++p;
+    }
+    if (!hasExponentDigits)
+      exact = false;
+    exponent += negativeExponent ? -explicitExponent : explicitExponent;
+  }
+  
+  if (exact && hasDigits && p == end)
+  {
+    if (mantissa == 0)
+      return negative ? -0.0 : 0.0;
+    if (mantissa <= (Q_UINT64_C(1) << 53) && exponent >= -22 && exponent <= 22)
+    {
+      // both mantissa and power of ten are exactly representable, so a single operation rounds correctly:
+      double result = (double)mantissa;
+      result = exponent < 0 ? result/powersOf10[-exponent] : result*powersOf10[exponent];
+      return negative ? -result : result;
+    }
+  }
+  // slow path for unusual input:
+  bool ok = false;
+  const double result = QByteArray(begin, int(end-begin)).toDouble(&ok);
+  return ok ? result : qQNaN();
+}
+
+/*! \internal
+
+  Parses the text between \a begin and \a end: skips the header lines, determines the column names
+  and count, splits the remaining text into chunks at line boundaries, parses them concurrently
+  and concatenates the resulting columns.
+*/
+bool QCPCsvImporter::parseBuffer(const char *begin, const char *end)
+{
+  const char *dataBegin = skipLines(begin, end, mHeaderLines);
+  if (mHeaderLines > 0 && dataBegin > begin)
+  {
+    // the last header line holds the column names:
+    const char *nameEnd = dataBegin;
+    while (nameEnd > begin && (nameEnd[-1] == '\n' || nameEnd[-1] == '\r'))
+      --nameEnd;
+    const char *nameBegin = nameEnd;
+    while (nameBegin > begin && nameBegin[-1] != '\n')
+      --nameBegin;
+    const QList<QByteArray> names = QByteArray(nameBegin, int(nameEnd-nameBegin)).split(mDelimiter);
+    for (int i=0; i<names.size(); ++i)
+    {
+      QByteArray name = names.at(i).trimmed();
+      if (name.size() >= 2 && name.startsWith('"') && name.endsWith('"'))
+        name = name.mid(1, name.size()-2);
+      mColumnNames.append(QString::fromUtf8(name.constData(), name.size()));
+    }
+  }
+  
+  // determine column count from first non-empty data line:
+  const char *firstLine = dataBegin;
+  while (firstLine < end && (*firstLine == '\n' || *firstLine == '\r'))
+    ++firstLine;
+  if (firstLine == end)
+    return true; // no data
+  const char *firstLineEnd = static_cast<const char*>(memchr(firstLine, '\n', end-firstLine));
+  if (!firstLineEnd)
+    firstLineEnd = end;
+  const int columnCount = (int)std::count(firstLine, firstLineEnd, mDelimiter)+1;
+  
+  // split into chunks at line boundaries, each at least about one megabyte:
+  const qint64 size = end-firstLine;
+  const int chunkCount = (int)qBound((qint64)1, size/(1<<20), (qint64)mThreadCount);
+  QList<QCPCsvChunkParser*> parsers;
+  const char *chunkBegin = firstLine;
+  for (int i=1; i<=chunkCount && chunkBegin < end; ++i)
+  {
+    const char *chunkEnd = end;
+    if (i < chunkCount)
+    {
+      chunkEnd = qMax(chunkBegin, firstLine+size*i/chunkCount);
+      chunkEnd = static_cast<const char*>(memchr(chunkEnd, '\n', end-chunkEnd));
+      chunkEnd = chunkEnd ? chunkEnd+1 : end;
+    }
+    parsers.append(new QCPCsvChunkParser(chunkBegin, chunkEnd, columnCount, mDelimiter));
+    chunkBegin = chunkEnd;
+  }
+  if (parsers.size() == 1)
+  {
+    parsers.first()->run();
+  } else
+  {
+    QThreadPool pool;
+    pool.setMaxThreadCount(parsers.size());
+    for (int i=0; i<parsers.size(); ++i)
+      pool.start(parsers.at(i));
+    pool.waitForDone();
+  }
+  
+  // concatenate chunk results and merge sortedness:
+  qint64 rowCount = 0;
+  for (int i=0; i<parsers.size(); ++i)
+    rowCount += parsers.at(i)->mColumns.first().size();
+  bool result = true;
+  if (rowCount > std::numeric_limits<int>::max())
+  {
+    qDebug() << Q_FUNC_INFO << "Too many rows:" << rowCount;
+    result = false;
+  } else
+  {
+    mRowCount = (int)rowCount;
+    mColumns.resize(columnCount);
+    mColumnSorted.fill(true, columnCount);
+    for (int c=0; c<columnCount; ++c)
+    {
+      if (parsers.size() == 1)
+      {
+        mColumns[c] = parsers.first()->mColumns.at(c);
+        mColumnSorted[c] = parsers.first()->mSorted.at(c);
+        continue;
+      }
+      mColumns[c].resize(mRowCount);
+      double *target = mColumns[c].data();
+      double previousLast = qQNaN();
+      for (int i=0; i<parsers.size(); ++i)
+      {
+        const QCPCsvChunkParser *parser = parsers.at(i);
+        const QVector<double> &chunk = parser->mColumns.at(c);
+        if (!chunk.isEmpty())
+          memcpy(target, chunk.constData(), chunk.size()*sizeof(double));
+        target += chunk.size();
+        if (!parser->mSorted.at(c) || parser->mFirst.at(c) < previousLast)
+          mColumnSorted[c] = false;
+        if (!qIsNaN(parser->mLast.at(c)))
+          previousLast = parser->mLast.at(c);
+      }
+    }
+  }
+  qDeleteAll(parsers);
+  return result;
+}
+
+/*! \internal
+
+  Returns the position after the first \a count lines of the text between \a begin and \a end.
+*/
+const char *QCPCsvImporter::skipLines(const char *begin, const char *end, int count) const
+{
+  for (int i=0; i<count && begin < end; ++i)
+  {
+    const char *lineEnd = static_cast<const char*>(memchr(begin, '\n', end-begin));
+    begin = lineEnd ? lineEnd+1 : end;
+  }
+  return begin;
+}
+
+/*! \internal
+
+  Returns whether \a index is the index of a loaded column.
+*/
+bool QCPCsvImporter::isValidColumn(int index) const
+{
+  return index >= 0 && index < mColumns.size();
+}
@@ -0,0 +1,83 @@
+/***************************************************************************
+**                                                                        **
+**  QCustomPlot, an easy to use, modern plotting widget for Qt            **
+**  Copyright (C) 2011-2017 Emanuel Eichhammer                            **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+****************************************************************************
+**           Author: Emanuel Eichhammer                                   **
+**  Website/Contact: http://www.qcustomplot.com/                          **
+**             Date: 04.09.17                                             **
+**          Version: 2.0.0                                                **
+****************************************************************************/
+/*! \file */
+#ifndef QCP_CSVIMPORTER_H
+#define QCP_CSVIMPORTER_H
+
+#include "global.h"
+
+class QCPGraph;
+class QCPCurve;
+class QCPFinancial;
+
+class QCP_LIB_DECL QCPCsvImporter
+{
+public:
+  QCPCsvImporter();
+  
+  // getters:
+  char delimiter() const { return mDelimiter; }
+  int headerLines() const { return mHeaderLines; }
+  int threadCount() const { return mThreadCount; }
+  
+  // setters:
+  void setDelimiter(char delimiter);
+  void setHeaderLines(int lines);
+  void setThreadCount(int count);
+  
+  // non-property methods:
+  bool load(const QString &fileName);
+  bool parse(const QByteArray &text);
+  void clear();
+  int rowCount() const { return mRowCount; }
+  int columnCount() const { return mColumns.size(); }
+  QStringList columnNames() const { return mColumnNames; }
+  int columnIndex(const QString &name) const;
+  QVector<double> column(int index) const;
+  bool isColumnSorted(int index) const;
+  bool applyTo(QCPGraph *graph, int keyColumn, int valueColumn) const;
+  bool applyTo(QCPCurve *curve, int tColumn, int keyColumn, int valueColumn) const;
+  bool applyTo(QCPFinancial *financial, int keyColumn, int openColumn, int highColumn, int lowColumn, int closeColumn) const;
+  
+  static double parseNumber(const char *begin, const char *end);
+  
+protected:
+  // property members:
+  char mDelimiter;
+  int mHeaderLines;
+  int mThreadCount;
+  // non-property members:
+  QStringList mColumnNames;
+  QVector<QVector<double> > mColumns;
+  QVector<bool> mColumnSorted;
+  int mRowCount;
+  
+  // non-virtual methods:
+  bool parseBuffer(const char *begin, const char *end);
+  const char *skipLines(const char *begin, const char *end, int count) const;
+  bool isValidColumn(int index) const;
+};
+
+#endif // QCP_CSVIMPORTER_H
@@ -58,6 +58,10 @@
   sort. Failing to do so can not be detected by the container efficiently and will cause both
   rendering artifacts and potential data loss.
 
+  For data with many gaps (data points with NaN value, see \ref setGapIndexEnabled), the container
+  can maintain a sorted index of the gap positions while data is added and removed. Plottables then
+  find gaps (\ref findGap) by lookup instead of testing every data point.
+
   Implementing one-dimensional plottables that make use of a \ref QCPDataContainer<T> is usually
   done by subclassing from \ref QCPAbstractPlottable1D "QCPAbstractPlottable1D<T>", which
   introduces an according \a mDataContainer member and some convenience methods.
@@ -124,7 +128,8 @@
 
   You can manipulate the data points in-place through the non-const iterators, but great care must
   be taken when manipulating the sort key of a data point, see \ref sort, or the detailed
-  description of this class.
+  description of this class. Obtaining the iterators doesn't count as a change, so call \ref
+  markModified after changing data points in-place.
 */
 
 /*! \fn QCPDataContainer::iterator QCPDataContainer<DataType>::end() const
@@ -133,7 +138,51 @@
   
   You can manipulate the data points in-place through the non-const iterators, but great care must
   be taken when manipulating the sort key of a data point, see \ref sort, or the detailed
-  description of this class.
+  description of this class. Obtaining the iterators doesn't count as a change, so call \ref
+  markModified after changing data points in-place.
+*/
+
+/*! \fn quint64 QCPDataContainer<DataType>::revision() const
+  
+  Returns a counter that is increased by every operation that changes the data. Plottables use it
+  to validate data derived from the container, e.g. cached coordinate transforms, without
+  comparing the data itself.
+  
+  Changes made in-place through the non-const iterators (\ref begin, \ref end) aren't detected,
+  call \ref markModified after such changes.
+  
+  \see editRevision, frontRemovalCount
+*/
+
+/*! \fn quint64 QCPDataContainer<DataType>::editRevision() const
+  
+  Returns the \ref revision of the last change that wasn't a pure append at the end or a pure
+  removal at the front of the container.
+  
+  So if data derived from the container was built at revision \c r and \c editRevision is not
+  greater than \c r, the data points it was built from are still present unchanged and in the same
+  order: The first (\ref frontRemovalCount minus its value at revision \c r) of them were removed,
+  and any data points beyond them were appended. This allows updating the derived data
+  incrementally, e.g. for a rolling buffer that is fed with \ref add and trimmed with \ref
+  removeBefore.
+*/
+
+/*! \fn quint64 QCPDataContainer<DataType>::frontRemovalCount() const
+  
+  Returns the total number of data points that were removed at the front of the container with
+  \ref removeBefore or \ref remove, over the lifetime of the container.
+  
+  \see editRevision
+*/
+
+/*! \fn void QCPDataContainer<DataType>::markModified()
+  
+  Registers a change of the data that the container can't detect itself, i.e. an in-place change
+  of data points through the non-const iterators \ref begin and \ref end. This increases \ref
+  revision and \ref editRevision, so data derived from the container is rebuilt.
+  
+  \ref sort calls this method, so after changing sort keys in-place it isn't necessary to call it
+  again.
 */
 
 /*! \fn QCPDataContainer::const_iterator QCPDataContainer<DataType>::at(int index) const
@@ -146,6 +195,13 @@
   dataselection-accessing "data selection page" for an example.
 */
 
+/*! \fn bool QCPDataContainer<DataType>::gapIndexEnabled() const
+  
+  Returns whether the container maintains an index of its gaps.
+  
+  \see setGapIndexEnabled
+*/
+
 /*! \fn QCPDataRange QCPDataContainer::dataRange() const
 
   Returns a \ref QCPDataRange encompassing the entire data set of this container. This means the
@@ -161,11 +217,39 @@
 template <class DataType>
 QCPDataContainer<DataType>::QCPDataContainer() :
   mAutoSqueeze(true),
+  mGapIndexEnabled(false),
   mPreallocSize(0),
-  mPreallocIteration(0)
+  mPreallocIteration(0),
+  mRevision(0),
+  mEditRevision(0),
+  mFrontRemovalCount(0)
 {
 }
 
+/*!
+  Replaces the data of this container with a copy of the data in \a other.
+  
+  The \ref revision of this container increases beyond both its own and the revision of \a other,
+  and the change counts as an edit (see \ref editRevision). Data derived from this container
+  therefore can't mistake the copied data for data it was built from.
+*/
+template <class DataType>
+QCPDataContainer<DataType> &QCPDataContainer<DataType>::operator=(const QCPDataContainer<DataType> &other)
+{
+  if (&other != this)
+  {
+    mAutoSqueeze = other.mAutoSqueeze;
+    mGapIndexEnabled = other.mGapIndexEnabled;
+    mData = other.mData;
+    mPreallocSize = other.mPreallocSize;
+    mPreallocIteration = other.mPreallocIteration;
+    mGapKeys = other.mGapKeys;
+    mRevision = qMax(mRevision, other.mRevision);
+    markModified();
+  }
+  return *this;
+}
+
 /*!
   Sets whether the container automatically decides when to release memory from its post- and
   preallocation pools when data points are removed. By default this is enabled and for typical
@@ -185,6 +269,32 @@ void QCPDataContainer<DataType>::setAutoSqueeze(bool enabled)
   }
 }
 
+/*!
+  Sets whether the container maintains a sorted index of its gaps, i.e. the data points whose main
+  value (\a DataType::mainValue) is NaN.
+  
+  While enabled, the index is updated by all methods that add or remove data, at a cost
+  proportional to the number of added data points. \ref findGap then finds the next gap by binary
+  search instead of testing every data point, which plottables use to split their data into
+  connected segments, and to skip gaps when sampling data. This is worthwhile for data with few
+  or many gaps, when most of it is visible at once. By default the gap index is disabled.
+  
+  If you change main values of data points to or from NaN through the non-const iterators (\ref
+  begin, \ref end), call \ref rebuildGapIndex afterwards.
+*/
+template <class DataType>
+void QCPDataContainer<DataType>::setGapIndexEnabled(bool enabled)
+{
+  if (mGapIndexEnabled != enabled)
+  {
+    mGapIndexEnabled = enabled;
+    if (mGapIndexEnabled)
+      rebuildGapIndex();
+    else
+      mGapKeys = QVector<double>();
+  }
+}
+
 /*! \overload
   
   Replaces the current data in this container with the provided \a data.
@@ -210,11 +320,14 @@ void QCPDataContainer<DataType>::set(const QCPDataContainer<DataType> &data)
 template <class DataType>
 void QCPDataContainer<DataType>::set(const QVector<DataType> &data, bool alreadySorted)
 {
+  markModified();
   mData = data;
   mPreallocSize = 0;
   mPreallocIteration = 0;
   if (!alreadySorted)
-    sort();
+    sort(); // also rebuilds gap index
+  else
+    rebuildGapIndex();
 }
 
 /*! \overload
@@ -234,17 +347,23 @@ void QCPDataContainer<DataType>::add(const QCPDataContainer<DataType> &data)
   
   if (oldSize > 0 && !qcpLessThanSortKey<DataType>(*constBegin(), *(data.constEnd()-1))) // prepend if new data keys are all smaller than or equal to existing ones
   {
+    markModified();
     if (mPreallocSize < n)
       preallocateGrow(n);
     mPreallocSize -= n;
     std::copy(data.constBegin(), data.constEnd(), begin());
   } else // don't need to prepend, so append and merge if necessary
   {
+    ++mRevision;
     mData.resize(mData.size()+n);
     std::copy(data.constBegin(), data.constEnd(), end()-n);
     if (oldSize > 0 && !qcpLessThanSortKey<DataType>(*(constEnd()-n-1), *(constEnd()-n))) // if appended range keys aren't all greater than existing ones, merge the two partitions
+    {
+      markModified();
       std::inplace_merge(begin(), end()-n, end(), qcpLessThanSortKey<DataType>);
+    }
   }
+  addGapKeys(data.constBegin(), data.constEnd(), true);
 }
 
 /*!
@@ -271,19 +390,25 @@ void QCPDataContainer<DataType>::add(const QVector<DataType> &data, bool already
   
   if (alreadySorted && oldSize > 0 && !qcpLessThanSortKey<DataType>(*constBegin(), *(data.constEnd()-1))) // prepend if new data is sorted and keys are all smaller than or equal to existing ones
   {
+    markModified();
     if (mPreallocSize < n)
       preallocateGrow(n);
     mPreallocSize -= n;
     std::copy(data.constBegin(), data.constEnd(), begin());
   } else // don't need to prepend, so append and then sort and merge if necessary
   {
+    ++mRevision;
     mData.resize(mData.size()+n);
     std::copy(data.constBegin(), data.constEnd(), end()-n);
     if (!alreadySorted) // sort appended subrange if it wasn't already sorted
       std::sort(end()-n, end(), qcpLessThanSortKey<DataType>);
     if (oldSize > 0 && !qcpLessThanSortKey<DataType>(*(constEnd()-n-1), *(constEnd()-n))) // if appended range keys aren't all greater than existing ones, merge the two partitions
+    {
+      markModified();
       std::inplace_merge(begin(), end()-n, end(), qcpLessThanSortKey<DataType>);
+    }
   }
+  addGapKeys(data.constBegin(), data.constEnd(), alreadySorted);
 }
 
 /*! \overload
@@ -297,18 +422,23 @@ void QCPDataContainer<DataType>::add(const DataType &data)
 {
   if (isEmpty() || !qcpLessThanSortKey<DataType>(data, *(constEnd()-1))) // quickly handle appends if new data key is greater or equal to existing ones
   {
+    ++mRevision;
     mData.append(data);
   } else if (qcpLessThanSortKey<DataType>(data, *constBegin()))  // quickly handle prepends using preallocated space
   {
+    markModified();
     if (mPreallocSize < 1)
       preallocateGrow(1);
     --mPreallocSize;
     *begin() = data;
   } else // handle inserts, maintaining sorted keys
   {
+    markModified();
     QCPDataContainer<DataType>::iterator insertionPoint = std::lower_bound(begin(), end(), data, qcpLessThanSortKey<DataType>);
     mData.insert(insertionPoint, data);
   }
+  if (mGapIndexEnabled && qIsNaN(data.mainValue()))
+    mGapKeys.insert(std::upper_bound(mGapKeys.begin(), mGapKeys.end(), data.sortKey()), data.sortKey());
 }
 
 /*!
@@ -321,7 +451,13 @@ void QCPDataContainer<DataType>::removeBefore(double sortKey)
 {
   QCPDataContainer<DataType>::iterator it = begin();
   QCPDataContainer<DataType>::iterator itEnd = std::lower_bound(begin(), end(), DataType::fromSortKey(sortKey), qcpLessThanSortKey<DataType>);
+  if (itEnd == it)
+    return;
+  ++mRevision;
+  mFrontRemovalCount += itEnd-it;
   mPreallocSize += itEnd-it; // don't actually delete, just add it to the preallocated block (if it gets too large, squeeze will take care of it)
+  if (mGapIndexEnabled)
+    mGapKeys.erase(mGapKeys.begin(), std::lower_bound(mGapKeys.begin(), mGapKeys.end(), sortKey));
   if (mAutoSqueeze)
     performAutoSqueeze();
 }
@@ -336,7 +472,12 @@ void QCPDataContainer<DataType>::removeAfter(double sortKey)
 {
   QCPDataContainer<DataType>::iterator it = std::upper_bound(begin(), end(), DataType::fromSortKey(sortKey), qcpLessThanSortKey<DataType>);
   QCPDataContainer<DataType>::iterator itEnd = end();
+  if (it == itEnd)
+    return;
+  markModified();
   mData.erase(it, itEnd); // typically adds it to the postallocated block
+  if (mGapIndexEnabled)
+    mGapKeys.erase(std::upper_bound(mGapKeys.begin(), mGapKeys.end(), sortKey), mGapKeys.end());
   if (mAutoSqueeze)
     performAutoSqueeze();
 }
@@ -356,7 +497,20 @@ void QCPDataContainer<DataType>::remove(double sortKeyFrom, double sortKeyTo)
   
   QCPDataContainer<DataType>::iterator it = std::lower_bound(begin(), end(), DataType::fromSortKey(sortKeyFrom), qcpLessThanSortKey<DataType>);
   QCPDataContainer<DataType>::iterator itEnd = std::upper_bound(it, end(), DataType::fromSortKey(sortKeyTo), qcpLessThanSortKey<DataType>);
+  if (it == itEnd)
+    return;
+  if (it == begin()) // removal at the front, see editRevision
+  {
+    ++mRevision;
+    mFrontRemovalCount += itEnd-it;
+  } else
+    markModified();
   mData.erase(it, itEnd);
+  if (mGapIndexEnabled)
+  {
+    QVector<double>::iterator gapBegin = std::lower_bound(mGapKeys.begin(), mGapKeys.end(), sortKeyFrom);
+    mGapKeys.erase(gapBegin, std::upper_bound(gapBegin, mGapKeys.end(), sortKeyTo));
+  }
   if (mAutoSqueeze)
     performAutoSqueeze();
 }
@@ -376,10 +530,22 @@ void QCPDataContainer<DataType>::remove(double sortKey)
   QCPDataContainer::iterator it = std::lower_bound(begin(), end(), DataType::fromSortKey(sortKey), qcpLessThanSortKey<DataType>);
   if (it != end() && it->sortKey() == sortKey)
   {
+    if (mGapIndexEnabled && qIsNaN(it->mainValue()))
+    {
+      QVector<double>::iterator gapIt = std::lower_bound(mGapKeys.begin(), mGapKeys.end(), sortKey);
+      if (gapIt != mGapKeys.end() && *gapIt == sortKey)
+        mGapKeys.erase(gapIt);
+    }
     if (it == begin())
+    {
+      ++mRevision;
+      ++mFrontRemovalCount;
       ++mPreallocSize; // don't actually delete, just add it to the preallocated block (if it gets too large, squeeze will take care of it)
-    else
+    } else
+    {
+      markModified();
       mData.erase(it);
+    }
   }
   if (mAutoSqueeze)
     performAutoSqueeze();
@@ -393,9 +559,11 @@ void QCPDataContainer<DataType>::remove(double sortKey)
 template <class DataType>
 void QCPDataContainer<DataType>::clear()
 {
+  markModified();
   mData.clear();
   mPreallocIteration = 0;
   mPreallocSize = 0;
+  mGapKeys.clear();
 }
 
 /*!
@@ -408,11 +576,15 @@ void QCPDataContainer<DataType>::clear()
   is your responsibility to bring the container back into a sorted state before any other methods
   are called on it. This can be achieved by calling this method immediately after finishing the
   sort key manipulation.
+  
+  If the gap index is enabled (\ref setGapIndexEnabled), it is rebuilt as well.
 */
 template <class DataType>
 void QCPDataContainer<DataType>::sort()
 {
+  markModified();
   std::sort(begin(), end(), qcpLessThanSortKey<DataType>);
+  rebuildGapIndex();
 }
 
 /*!
@@ -731,6 +903,89 @@ void QCPDataContainer<DataType>::limitIteratorsToDataRange(const_iterator &begin
   end = constBegin()+iteratorRange.end();
 }
 
+/*!
+  Returns the number of gaps, i.e. data points with NaN main value, in the container.
+  
+  If the gap index is disabled (\ref setGapIndexEnabled), the data points are counted one by one.
+*/
+template <class DataType>
+int QCPDataContainer<DataType>::gapCount() const
+{
+  if (mGapIndexEnabled)
+    return mGapKeys.size();
+  int result = 0;
+  for (const_iterator it=constBegin(); it!=constEnd(); ++it)
+  {
+    if (qIsNaN(it->mainValue()))
+      ++result;
+  }
+  return result;
+}
+
+/*!
+  Returns an iterator to the first gap, i.e. data point with NaN main value, within the range
+  [\a begin, \a end). If there is no gap in the range, returns \a end.
+  
+  If the gap index is enabled (\ref setGapIndexEnabled), the gap is found with binary searches in
+  the index and the data, so a range without gaps is detected in logarithmic time. Otherwise the
+  data points are tested one by one.
+  
+  \see findGapEnd
+*/
+template <class DataType>
+typename QCPDataContainer<DataType>::const_iterator QCPDataContainer<DataType>::findGap(const_iterator begin, const_iterator end) const
+{
+  if (begin == end)
+    return end;
+  if (!mGapIndexEnabled)
+  {
+    for (const_iterator it=begin; it!=end; ++it)
+    {
+      if (qIsNaN(it->mainValue()))
+        return it;
+    }
+    return end;
+  }
+  
+  const double endKey = (end-1)->sortKey();
+  QVector<double>::const_iterator gapIt = std::lower_bound(mGapKeys.constBegin(), mGapKeys.constEnd(), begin->sortKey());
+  while (gapIt != mGapKeys.constEnd() && *gapIt <= endKey)
+  {
+    // the gap is among the data points with this sort key (usually the first one):
+    for (const_iterator it=std::lower_bound(begin, end, DataType::fromSortKey(*gapIt), qcpLessThanSortKey<DataType>); it != end && it->sortKey() == *gapIt; ++it)
+    {
+      if (qIsNaN(it->mainValue()))
+        return it;
+    }
+    ++gapIt; // gap with equal sort key lies before begin
+  }
+  return end;
+}
+
+/*!
+  Returns an iterator to the first data point at or after \a gap, up to \a end, whose main value
+  is not NaN. Together with \ref findGap, this allows iterating over the connected segments of
+  the data, skipping gaps that consist of multiple consecutive NaN data points.
+*/
+template <class DataType>
+typename QCPDataContainer<DataType>::const_iterator QCPDataContainer<DataType>::findGapEnd(const_iterator gap, const_iterator end) const
+{
+  while (gap != end && qIsNaN(gap->mainValue()))
+    ++gap;
+  return gap;
+}
+
+/*!
+  Rebuilds the gap index from the data, if it is enabled (\ref setGapIndexEnabled). Call this
+  after changing main values of data points to or from NaN through the non-const iterators.
+*/
+template <class DataType>
+void QCPDataContainer<DataType>::rebuildGapIndex()
+{
+  mGapKeys.clear();
+  addGapKeys(constBegin(), constEnd(), true);
+}
+
 /*! \internal
   
   Increases the preallocation pool to have a size of at least \a minimumPreallocSize. Depending on
@@ -791,3 +1046,30 @@ void QCPDataContainer<DataType>::performAutoSqueeze()
   if (shrinkPreAllocation || shrinkPostAllocation)
     squeeze(shrinkPreAllocation, shrinkPostAllocation);
 }
+
+/*! \internal
+  
+  Adds the sort keys of all data points with NaN main value in the range [\a begin, \a end) to the
+  gap index, if it is enabled. If \a alreadySorted is false, the range isn't required to be sorted
+  by sort key.
+*/
+template <class DataType>
+void QCPDataContainer<DataType>::addGapKeys(const_iterator begin, const_iterator end, bool alreadySorted)
+{
+  if (!mGapIndexEnabled)
+    return;
+  QVector<double> newKeys;
+  for (const_iterator it=begin; it!=end; ++it)
+  {
+    if (qIsNaN(it->mainValue()))
+      newKeys.append(it->sortKey());
+  }
+  if (newKeys.isEmpty())
+    return;
+  if (!alreadySorted)
+    std::sort(newKeys.begin(), newKeys.end());
+  const int oldSize = mGapKeys.size();
+  mGapKeys << newKeys;
+  if (oldSize > 0 && newKeys.first() < mGapKeys.at(oldSize-1)) // new gaps aren't all behind existing ones, merge the two partitions
+    std::inplace_merge(mGapKeys.begin(), mGapKeys.begin()+oldSize, mGapKeys.end());
+}
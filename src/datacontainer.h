@@ -46,14 +46,20 @@ public:
   typedef typename QVector<DataType>::iterator iterator;
   
   QCPDataContainer();
+  QCPDataContainer &operator=(const QCPDataContainer<DataType> &other);
   
   // getters:
   int size() const { return mData.size()-mPreallocSize; }
   bool isEmpty() const { return size() == 0; }
   bool autoSqueeze() const { return mAutoSqueeze; }
+  bool gapIndexEnabled() const { return mGapIndexEnabled; }
+  quint64 revision() const { return mRevision; }
+  quint64 editRevision() const { return mEditRevision; }
+  quint64 frontRemovalCount() const { return mFrontRemovalCount; }
   
   // setters:
   void setAutoSqueeze(bool enabled);
+  void setGapIndexEnabled(bool enabled);
   
   // non-virtual methods:
   void set(const QCPDataContainer<DataType> &data);
@@ -68,6 +74,7 @@ public:
   void clear();
   void sort();
   void squeeze(bool preAllocation=true, bool postAllocation=true);
+  void markModified() { ++mRevision; mEditRevision = mRevision; }
   
   const_iterator constBegin() const { return mData.constBegin()+mPreallocSize; }
   const_iterator constEnd() const { return mData.constEnd(); }
@@ -80,19 +87,28 @@ public:
   QCPRange valueRange(bool &foundRange, QCP::SignDomain signDomain=QCP::sdBoth, const QCPRange &inKeyRange=QCPRange());
   QCPDataRange dataRange() const { return QCPDataRange(0, size()); }
   void limitIteratorsToDataRange(const_iterator &begin, const_iterator &end, const QCPDataRange &dataRange) const;
+  int gapCount() const;
+  const_iterator findGap(const_iterator begin, const_iterator end) const;
+  const_iterator findGapEnd(const_iterator gap, const_iterator end) const;
+  void rebuildGapIndex();
   
 protected:
   // property members:
   bool mAutoSqueeze;
+  bool mGapIndexEnabled;
   
   // non-property memebers:
   QVector<DataType> mData;
   int mPreallocSize;
   int mPreallocIteration;
+  QVector<double> mGapKeys;
+  quint64 mRevision, mEditRevision;
+  quint64 mFrontRemovalCount;
   
   // non-virtual methods:
   void preallocateGrow(int minimumPreallocSize);
   void performAutoSqueeze();
+  void addGapKeys(const_iterator begin, const_iterator end, bool alreadySorted);
 };
 
 // include implementation in header since it is a class template:
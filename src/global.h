@@ -66,6 +66,15 @@
 #include <QtCore/QStack>
 #include <QtCore/QCache>
 #include <QtCore/QMargins>
+#include <QtCore/QFile>
+#include <QtCore/QDataStream>
+#include <QtCore/QTemporaryFile>
+#include <QtCore/QMetaProperty>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+#include <QtCore/QRunnable>
+#include <QtCore/QMutex>
+#include <QtCore/QSet>
 #include <qmath.h>
 #include <limits>
 #include <algorithm>
@@ -216,6 +225,14 @@ enum PlottingHint { phNone              = 0x000 ///< <tt>0x000</tt> No hints are
                     ,phImmediateRefresh = 0x002 ///< <tt>0x002</tt> causes an immediate repaint() instead of a soft update() when QCustomPlot::replot() is called with parameter \ref QCustomPlot::rpRefreshHint.
                                                 ///<                This is set by default to prevent the plot from freezing on fast consecutive replots (e.g. user drags ranges with mouse).
                     ,phCacheLabels      = 0x004 ///< <tt>0x004</tt> axis (tick) labels will be cached as pixmaps, increasing replot performance.
+                    ,phFastAntialiasedLines = 0x008 ///< <tt>0x008</tt> Layers are painted into QImage paint buffers (\ref QCPPaintBufferImage), so antialiased solid lines of plottables
+                                                ///<                with widths up to three pixels can be drawn directly into the buffer by \ref QCPLineRasterizer, at close to aliased cost. Has no effect if \ref QCustomPlot::setOpenGl is enabled.
+                    ,phDeferHiddenReplots = 0x010 ///< <tt>0x010</tt> Replots of a QCustomPlot that isn't visible on screen (e.g. in an inactive tab, in a minimized window or scrolled out of a scroll area) are skipped
+                                                ///<                and performed once when the widget is shown or scrolled into view again. See \ref QCustomPlot::replot.
+                    ,phBatchSelectionChanges = 0x020 ///< <tt>0x020</tt> Selection changes by the user and by \ref QCustomPlot::deselectAll are performed as one selection change transaction (see \ref QCustomPlot::beginSelectionChange),
+                                                ///<                so the individual selectionChanged signals of plottables and items are replaced by one \ref QCustomPlot::selectionChangeFinished signal.
+                    ,phConcurrentRectSelection = 0x040 ///< <tt>0x040</tt> When a selection rect is accepted and the candidate plottables hold many data points in total, their \ref QCPPlottableInterface1D::selectTestRect is called
+                                                ///<                concurrently in worker threads. Only set this if the plottables' data isn't modified by other threads. See \ref QCustomPlot::processRectSelection.
                   };
 Q_DECLARE_FLAGS(PlottingHints, PlottingHint)
 
@@ -954,7 +954,8 @@ void QCPItemPosition::setPixelPosition(const QPointF &pixelPosition)
 
 /*! \fn void QCPAbstractItem::selectionChanged(bool selected)
   This signal is emitted when the selection state of this item has changed, either by user interaction
-  or by a direct call to \ref setSelected.
+  or by a direct call to \ref setSelected. It is not emitted while a selection change transaction
+  is in progress (see \ref QCustomPlot::beginSelectionChange).
 */
 
 /* end documentation of signals */
@@ -1053,7 +1054,7 @@ void QCPAbstractItem::setSelected(bool selected)
   if (mSelected != selected)
   {
     mSelected = selected;
-    emit selectionChanged(mSelected);
+    notifySelectionChanged();
   }
 }
 
@@ -1264,6 +1265,19 @@ QCPItemAnchor *QCPAbstractItem::createAnchor(const QString &name, int anchorId)
   return newAnchor;
 }
 
+/*! \internal
+
+  Emits the \ref selectionChanged signal, or registers the change with the parent plot if a
+  selection change transaction is in progress (see \ref QCustomPlot::beginSelectionChange).
+*/
+void QCPAbstractItem::notifySelectionChanged()
+{
+  if (mParentPlot && mParentPlot->isChangingSelection())
+    mParentPlot->registerSelectionChange(this);
+  else
+    emit selectionChanged(mSelected);
+}
+
 /* inherits documentation from base class */
 void QCPAbstractItem::selectEvent(QMouseEvent *event, bool additive, const QVariant &details, bool *selectionStateChanged)
 {
@@ -208,6 +208,7 @@ protected:
   double rectDistance(const QRectF &rect, const QPointF &pos, bool filledRect) const;
   QCPItemPosition *createPosition(const QString &name);
   QCPItemAnchor *createAnchor(const QString &name, int anchorId);
+  void notifySelectionChanged();
   
 private:
   Q_DISABLE_COPY(QCPAbstractItem)
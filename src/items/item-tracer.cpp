@@ -330,43 +330,47 @@ void QCPItemTracer::updatePosition()
   {
     if (mParentPlot->hasPlottable(mGraph))
     {
-      if (mGraph->data()->size() > 1)
+      // read the data via the index based interface, so graphs with own data storage (e.g. QCPCompactGraph) needn't provide a container:
+      const int count = mGraph->dataCount();
+      if (count > 1)
       {
-        QCPGraphDataContainer::const_iterator first = mGraph->data()->constBegin();
-        QCPGraphDataContainer::const_iterator last = mGraph->data()->constEnd()-1;
-        if (mGraphKey <= first->key)
-          position->setCoords(first->key, first->value);
-        else if (mGraphKey >= last->key)
-          position->setCoords(last->key, last->value);
+        const double firstKey = mGraph->dataMainKey(0);
+        const double lastKey = mGraph->dataMainKey(count-1);
+        if (mGraphKey <= firstKey)
+          position->setCoords(firstKey, mGraph->dataMainValue(0));
+        else if (mGraphKey >= lastKey)
+          position->setCoords(lastKey, mGraph->dataMainValue(count-1));
         else
         {
-          QCPGraphDataContainer::const_iterator it = mGraph->data()->findBegin(mGraphKey);
-          if (it != mGraph->data()->constEnd()) // mGraphKey is not exactly on last iterator, but somewhere between iterators
+          int index = mGraph->findBegin(mGraphKey);
+          if (index < count-1) // mGraphKey is not exactly on last data point, but somewhere between data points
           {
-            QCPGraphDataContainer::const_iterator prevIt = it;
-            ++it; // won't advance to constEnd because we handled that case (mGraphKey >= last->key) before
+            const int prevIndex = index;
+            ++index; // won't advance beyond the last data point because we handled that case (mGraphKey >= lastKey) before
+            const double prevKey = mGraph->dataMainKey(prevIndex);
+            const double key = mGraph->dataMainKey(index);
             if (mInterpolating)
             {
-              // interpolate between iterators around mGraphKey:
+              // interpolate between data points around mGraphKey:
+              const double prevValue = mGraph->dataMainValue(prevIndex);
               double slope = 0;
-              if (!qFuzzyCompare((double)it->key, (double)prevIt->key))
-                slope = (it->value-prevIt->value)/(it->key-prevIt->key);
-              position->setCoords(mGraphKey, (mGraphKey-prevIt->key)*slope+prevIt->value);
+              if (!qFuzzyCompare(key, prevKey))
+                slope = (mGraph->dataMainValue(index)-prevValue)/(key-prevKey);
+              position->setCoords(mGraphKey, (mGraphKey-prevKey)*slope+prevValue);
             } else
             {
-              // find iterator with key closest to mGraphKey:
-              if (mGraphKey < (prevIt->key+it->key)*0.5)
-                position->setCoords(prevIt->key, prevIt->value);
+              // find data point with key closest to mGraphKey:
+              if (mGraphKey < (prevKey+key)*0.5)
+                position->setCoords(prevKey, mGraph->dataMainValue(prevIndex));
               else
-                position->setCoords(it->key, it->value);
+                position->setCoords(key, mGraph->dataMainValue(index));
             }
-          } else // mGraphKey is exactly on last iterator (should actually be caught when comparing first/last keys, but this is a failsafe for fp uncertainty)
-            position->setCoords(it->key, it->value);
+          } else // mGraphKey is exactly on last data point (should actually be caught when comparing first/last keys, but this is a failsafe for fp uncertainty)
+            position->setCoords(mGraph->dataMainKey(index), mGraph->dataMainValue(index));
         }
-      } else if (mGraph->data()->size() == 1)
+      } else if (count == 1)
       {
-        QCPGraphDataContainer::const_iterator it = mGraph->data()->constBegin();
-        position->setCoords(it->key, it->value);
+        position->setCoords(mGraph->dataMainKey(0), mGraph->dataMainValue(0));
       } else
         qDebug() << Q_FUNC_INFO << "graph has no data";
     } else
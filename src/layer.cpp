@@ -188,9 +188,12 @@ void QCPLayer::setMode(QCPLayer::LayerMode mode)
 
   Draws the contents of this layer with the provided \a painter.
 
+  If \a clipRegion is not empty, the drawing of all children is additionally clipped to it. This is
+  used to redraw only a part of the paint buffer, see \ref QCustomPlot::replotBlitted.
+
   \see replot, drawToPaintBuffer
 */
-void QCPLayer::draw(QCPPainter *painter)
+void QCPLayer::draw(QCPPainter *painter, const QRegion &clipRegion)
 {
   foreach (QCPLayerable *child, mChildren)
   {
@@ -198,6 +201,8 @@ void QCPLayer::draw(QCPPainter *painter)
     {
       painter->save();
       painter->setClipRect(child->clipRect().translated(0, -1));
+      if (!clipRegion.isEmpty())
+        painter->setClipRegion(clipRegion, Qt::IntersectClip);
       child->applyDefaultAntialiasingHint(painter);
       child->draw(painter);
       painter->restore();
@@ -211,16 +216,18 @@ void QCPLayer::draw(QCPPainter *painter)
   association is established by the parent QCustomPlot, which manages all paint buffers (see \ref
   QCustomPlot::setupPaintBuffers).
 
+  The optional \a clipRegion is passed on to \ref draw.
+
   \see draw
 */
-void QCPLayer::drawToPaintBuffer()
+void QCPLayer::drawToPaintBuffer(const QRegion &clipRegion)
 {
   if (!mPaintBuffer.isNull())
   {
     if (QCPPainter *painter = mPaintBuffer.data()->startPainting())
     {
       if (painter->isActive())
-        draw(painter);
+        draw(painter, clipRegion);
       else
         qDebug() << Q_FUNC_INFO << "paint buffer returned inactive painter";
       delete painter;
@@ -240,13 +247,16 @@ void QCPLayer::drawToPaintBuffer()
   the parent QCustomPlot instance.
 
   QCustomPlot also makes sure to replot all layers instead of only this one, if the layer ordering
-  has changed since the last full replot and the other paint buffers were thus invalidated.
+  has changed since the last full replot and the other paint buffers were thus invalidated. The
+  same applies while a range drag shift of the paint buffers is pending (see \ref
+  QCPAxisRect::setRangeDragBlitting), because the other paint buffers still show the previous
+  frame.
 
   \see draw
 */
 void QCPLayer::replot()
 {
-  if (mMode == lmBuffered && !mParentPlot->hasInvalidatedPaintBuffers())
+  if (mMode == lmBuffered && !mParentPlot->hasInvalidatedPaintBuffers() && mParentPlot->mBlitAxisRect.isNull())
   {
     if (!mPaintBuffer.isNull())
     {
@@ -256,7 +266,7 @@ void QCPLayer::replot()
       mParentPlot->update();
     } else
       qDebug() << Q_FUNC_INFO << "no valid paint buffer associated with this layer";
-  } else if (mMode == lmLogical)
+  } else
     mParentPlot->replot();
 }
 
@@ -91,8 +91,8 @@ protected:
   QWeakPointer<QCPAbstractPaintBuffer> mPaintBuffer;
   
   // non-virtual methods:
-  void draw(QCPPainter *painter);
-  void drawToPaintBuffer();
+  void draw(QCPPainter *painter, const QRegion &clipRegion=QRegion());
+  void drawToPaintBuffer(const QRegion &clipRegion=QRegion());
   void addChild(QCPLayerable *layerable, bool prepend);
   void removeChild(QCPLayerable *layerable);
   
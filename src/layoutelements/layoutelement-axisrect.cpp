@@ -157,7 +157,23 @@
   returned value is with respect to the inner \ref rect.
 */
 
+/*! \fn bool QCPAxisRect::isAnimatingRanges() const
+  
+  Returns whether a range animation started with \ref animateRange is currently running on any
+  axis of this axis rect.
+*/
+
 /* end documentation of inline functions */
+/* start documentation of signals */
+
+/*! \fn void QCPAxisRect::rangeAnimationFinished()
+  
+  This signal is emitted when all range animations of this axis rect have reached their target
+  ranges (see \ref animateRange). It isn't emitted if the animations are stopped by \ref
+  stopRangeAnimations or a user interaction.
+*/
+
+/* end documentation of signals */
 
 /*!
   Creates a QCPAxisRect instance and sets default values. An axis is added for each of the four
@@ -173,8 +189,19 @@ QCPAxisRect::QCPAxisRect(QCustomPlot *parentPlot, bool setupDefaultAxes) :
   mRangeZoom(Qt::Horizontal|Qt::Vertical),
   mRangeZoomFactorHorz(0.85),
   mRangeZoomFactorVert(0.85),
+  mRangeDragBlitting(false),
+  mRangeZoomPreviewDelay(0),
+  mRangeAnimationDuration(250),
+  mRangeAnimationDegraded(true),
+  mZoomPreviewTimer(new QTimer(this)),
+  mRangeAnimationTimer(new QTimer(this)),
+  mAnimationAntialiasingLowered(false),
   mDragging(false)
 {
+  mZoomPreviewTimer->setSingleShot(true);
+  connect(mZoomPreviewTimer, SIGNAL(timeout()), mParentPlot, SLOT(replot()));
+  mRangeAnimationTimer->setInterval(16); // about 60 frames per second
+  connect(mRangeAnimationTimer, SIGNAL(timeout()), this, SLOT(rangeAnimationStep()));
   mInsetLayout->initializeParentPlot(mParentPlot);
   mInsetLayout->setParentLayerable(this);
   mInsetLayout->setParent(this);
@@ -591,6 +618,90 @@ QList<QCPAbstractItem *> QCPAxisRect::items() const
   return result;
 }
 
+/*!
+  Changes the range of \a axis to \a range in a smooth animation lasting \a duration milliseconds.
+  If \a duration is -1, the default set with \ref setRangeAnimationDuration is used. \a axis must
+  be an axis of this axis rect. If \a axis is already being animated, its animation continues from
+  the current intermediate range towards the new target.
+  
+  The animations of all axes of this axis rect are driven by a single timer at about 60 frames per
+  second. Each frame sets the interpolated ranges and queues a replot (\ref
+  QCustomPlot::rpQueuedReplot), so the ranges of multiple animated axes are changed in the same
+  frame and replotted together. The interpolation depends on the elapsed time rather than the
+  number of frames, so if replots take longer than a frame, frames are skipped and the animation
+  still finishes in time. The ranges are interpolated in the scale domain of each axis (e.g.
+  geometrically for \ref QCPAxis::stLogarithmic), with a decelerating motion.
+  
+  By default, the intermediate frames are drawn with reduced fidelity, see \ref
+  setRangeAnimationDegraded. The final frame is replotted in full quality.
+  
+  Starting a range drag or mouse wheel zoom stops all animations of this axis rect at their
+  current intermediate ranges.
+  
+  \code
+  customPlot->xAxis->animateRange(QCPRange(eventTime-10, eventTime+10)); // jump to an event
+  \endcode
+  
+  \see stopRangeAnimations, isAnimatingRanges, rangeAnimationFinished
+*/
+void QCPAxisRect::animateRange(QCPAxis *axis, const QCPRange &range, int duration)
+{
+  if (!axis || !mAxes.value(axis->axisType()).contains(axis))
+  {
+    qDebug() << Q_FUNC_INFO << "axis isn't in this axis rect:" << reinterpret_cast<quintptr>(axis);
+    return;
+  }
+  
+  RangeAnimation animation;
+  animation.axis = axis;
+  animation.startRange = axis->range();
+  animation.targetRange = range;
+  animation.clock.start();
+  animation.duration = duration < 0 ? mRangeAnimationDuration : duration;
+  for (int i=mRangeAnimations.size()-1; i>=0; --i)
+  {
+    if (mRangeAnimations.at(i).axis == axis)
+      mRangeAnimations.removeAt(i);
+  }
+  
+  if (!mRangeAnimationTimer->isActive())
+  {
+    // lower the fidelity of intermediate frames (unless a range drag already did):
+    if (mRangeAnimationDegraded && !mDragging)
+    {
+      mAAAnimationBackup = mParentPlot->antialiasedElements();
+      mNotAAAnimationBackup = mParentPlot->notAntialiasedElements();
+      mAnimationAntialiasingLowered = true;
+      mParentPlot->setNotAntialiasedElements(QCP::aeAll);
+    }
+    mRangeAnimationTimer->start();
+  }
+  mRangeAnimations.append(animation);
+}
+
+/*!
+  Stops all range animations of this axis rect. If \a jumpToTarget is true, the animated axes are
+  set to their target ranges, otherwise they keep their current intermediate ranges. In both cases
+  a replot is queued and \ref rangeAnimationFinished is not emitted.
+  
+  \see animateRange
+*/
+void QCPAxisRect::stopRangeAnimations(bool jumpToTarget)
+{
+  if (mRangeAnimations.isEmpty())
+    return;
+  if (jumpToTarget)
+  {
+    for (int i=0; i<mRangeAnimations.size(); ++i)
+    {
+      if (!mRangeAnimations.at(i).axis.isNull())
+        mRangeAnimations.at(i).axis.data()->setRange(mRangeAnimations.at(i).targetRange);
+    }
+  }
+  mRangeAnimations.clear();
+  finishRangeAnimations();
+}
+
 /*!
   This method is called automatically upon replot and doesn't need to be called by users of
   QCPAxisRect.
@@ -1029,6 +1140,98 @@ void QCPAxisRect::setRangeZoomFactor(double factor)
   mRangeZoomFactorVert = factor;
 }
 
+/*!
+  Sets whether range dragging by the user reuses the previously rendered frame.
+  
+  Dragging the axis ranges only translates the contents of the axis rect. If \a enabled is true,
+  the replots during a range drag therefore shift the existing paint buffer contents by the dragged
+  pixel distance, and only draw the strip of the axis rect which was uncovered by the shift. The
+  axes with their tick labels are still redrawn regularly. When the drag ends, a full replot is
+  performed.
+  
+  A paint buffer can only be shifted if all visible layerables on its layers are plottables and
+  grids of this axis rect, whose axes are moved by the drag (see \ref setRangeDragAxes). All other
+  paint buffers are redrawn entirely. With the default layer configuration, the plottables share a
+  paint buffer with the axes, so to benefit from this setting, move the plottables to a layer in
+  \ref QCPLayer::lmBuffered mode, e.g. by setting the mode of the "main" layer:
+  \code
+  customPlot->layer("main")->setMode(QCPLayer::lmBuffered);
+  customPlot->axisRect()->setRangeDragBlitting(true);
+  \endcode
+  
+  Since the previous frame is reused, changes to the plottables during the drag which aren't caused
+  by the drag itself, e.g. newly added data, only appear in the uncovered strip until the drag
+  ends. OpenGL paint buffers (\ref QCustomPlot::setOpenGl) don't support shifting and are always
+  redrawn entirely.
+  
+  \see setRangeDrag, QCustomPlot::setNoAntialiasingOnDrag
+*/
+void QCPAxisRect::setRangeDragBlitting(bool enabled)
+{
+  mRangeDragBlitting = enabled;
+}
+
+/*!
+  Sets the time in \a milliseconds after the last mouse wheel zoom step, until a full quality
+  replot is performed. A value of 0 (the default) disables zoom previews.
+  
+  If enabled, each mouse wheel zoom step (see \ref setRangeZoom) doesn't redraw the plottables, but
+  scales the previously rendered frame inside the axis rect according to the zoom. The axes with
+  their tick labels are redrawn regularly. This makes zooming responsive even with large data sets,
+  at the cost of a blurred preview. Once no further zoom step happened for \a milliseconds, the
+  plot is replotted in full quality.
+  
+  The same restrictions as for \ref setRangeDragBlitting apply: Only paint buffers whose visible
+  layerables are plottables and grids of this axis rect, with axes that are zoomed, can be scaled.
+  So to benefit from zoom previews, move the plottables to a layer in \ref QCPLayer::lmBuffered
+  mode:
+  \code
+  customPlot->layer("main")->setMode(QCPLayer::lmBuffered);
+  customPlot->axisRect()->setRangeZoomPreviewDelay(150);
+  \endcode
+  
+  \see setRangeZoom, setRangeZoomFactor
+*/
+void QCPAxisRect::setRangeZoomPreviewDelay(int milliseconds)
+{
+  mRangeZoomPreviewDelay = qMax(0, milliseconds);
+  if (mRangeZoomPreviewDelay == 0 && mZoomPreviewTimer->isActive()) // make sure a pending preview doesn't stay
+  {
+    mZoomPreviewTimer->stop();
+    mParentPlot->replot(QCustomPlot::rpQueuedReplot);
+  }
+}
+
+/*!
+  Sets the default duration in \a milliseconds of range animations started with \ref animateRange
+  or \ref QCPAxis::animateRange, if no explicit duration is passed there. The default is 250 ms.
+*/
+void QCPAxisRect::setRangeAnimationDuration(int milliseconds)
+{
+  mRangeAnimationDuration = qMax(0, milliseconds);
+}
+
+/*!
+  Sets whether the intermediate frames of range animations (\ref animateRange) are drawn with
+  reduced fidelity, which is enabled by default. The final frame of an animation is always
+  replotted in full quality.
+  
+  If \a enabled is true, the intermediate frames are drawn without antialiasing. Further, they reuse
+  the previous frame like range dragging with \ref setRangeDragBlitting and zoom previews with \ref
+  setRangeZoomPreviewDelay do: If the animation only moves the ranges by whole pixels, the previous
+  contents of the axis rect are shifted and only the uncovered strip is drawn (animated pans are
+  rounded to whole pixels for this), otherwise the previous contents are scaled. The same
+  restrictions as for those settings apply, so only plottables on a layer in \ref
+  QCPLayer::lmBuffered mode benefit from the reuse, see \ref setRangeDragBlitting.
+  
+  Disable this if intermediate frames must show the data in full quality, e.g. if the data changes
+  during animations.
+*/
+void QCPAxisRect::setRangeAnimationDegraded(bool enabled)
+{
+  mRangeAnimationDegraded = enabled;
+}
+
 /*! \internal
   
   Draws the background of this axis rect. It may consist of a background fill (a QBrush) and a
@@ -1158,7 +1361,9 @@ void QCPAxisRect::mousePressEvent(QMouseEvent *event, const QVariant &details)
   Q_UNUSED(details)
   if (event->buttons() & Qt::LeftButton)
   {
+    stopRangeAnimations(); // the user takes over from the current intermediate ranges
     mDragging = true;
+    mDragScrollOffset = QPoint();
     // initialize antialiasing backup in case we start dragging:
     if (mParentPlot->noAntialiasingOnDrag())
     {
@@ -1191,6 +1396,11 @@ void QCPAxisRect::mouseMoveEvent(QMouseEvent *event, const QPointF &startPos)
   // Mouse range dragging interaction:
   if (mDragging && mParentPlot->interactions().testFlag(QCP::iRangeDrag))
   {
+    // pixel distance by which the axis rect contents are moved, used for blitting:
+    const QPoint dragOffset(mRangeDrag.testFlag(Qt::Horizontal) ? event->pos().x()-qRound(startPos.x()) : 0,
+                            mRangeDrag.testFlag(Qt::Vertical) ? event->pos().y()-qRound(startPos.y()) : 0);
+    bool blittable = mRangeDragBlitting;
+    QList<QCPAxis*> draggedAxes;
     
     if (mRangeDrag.testFlag(Qt::Horizontal))
     {
@@ -1209,7 +1419,14 @@ void QCPAxisRect::mouseMoveEvent(QMouseEvent *event, const QPointF &startPos)
         {
           double diff = ax->pixelToCoord(startPos.x()) / ax->pixelToCoord(event->pos().x());
           ax->setRange(mDragStartHorzRange.at(i).lower*diff, mDragStartHorzRange.at(i).upper*diff);
+        } else if (ax->mScaleType == QCPAxis::stCustom)
+        {
+          double diff = ax->mScaleTransform->transform(ax->pixelToCoord(startPos.x())) - ax->mScaleTransform->transform(ax->pixelToCoord(event->pos().x()));
+          ax->setRange(ax->mScaleTransform->movedRange(mDragStartHorzRange.at(i), diff));
         }
+        if (blittable && !rangeMappedBy(ax, mDragStartHorzRange.at(i), 1, dragOffset.x()))
+          blittable = false;
+        draggedAxes << ax;
       }
     }
     
@@ -1230,7 +1447,14 @@ void QCPAxisRect::mouseMoveEvent(QMouseEvent *event, const QPointF &startPos)
         {
           double diff = ax->pixelToCoord(startPos.y()) / ax->pixelToCoord(event->pos().y());
           ax->setRange(mDragStartVertRange.at(i).lower*diff, mDragStartVertRange.at(i).upper*diff);
+        } else if (ax->mScaleType == QCPAxis::stCustom)
+        {
+          double diff = ax->mScaleTransform->transform(ax->pixelToCoord(startPos.y())) - ax->mScaleTransform->transform(ax->pixelToCoord(event->pos().y()));
+          ax->setRange(ax->mScaleTransform->movedRange(mDragStartVertRange.at(i), diff));
         }
+        if (blittable && !rangeMappedBy(ax, mDragStartVertRange.at(i), 1, dragOffset.y()))
+          blittable = false;
+        draggedAxes << ax;
       }
     }
     
@@ -1238,6 +1462,14 @@ void QCPAxisRect::mouseMoveEvent(QMouseEvent *event, const QPointF &startPos)
     {
       if (mParentPlot->noAntialiasingOnDrag())
         mParentPlot->setNotAntialiasedElements(QCP::aeAll);
+      if (mRangeDragBlitting)
+      {
+        if (blittable)
+          mParentPlot->addPendingBlit(this, QTransform::fromTranslate(dragOffset.x()-mDragScrollOffset.x(), dragOffset.y()-mDragScrollOffset.y()), draggedAxes);
+        else // e.g. a range was limited, so the contents didn't simply move with the cursor
+          mParentPlot->invalidatePendingBlit();
+        mDragScrollOffset = dragOffset;
+      }
       mParentPlot->replot(QCustomPlot::rpQueuedReplot);
     }
     
@@ -1255,6 +1487,183 @@ void QCPAxisRect::mouseReleaseEvent(QMouseEvent *event, const QPointF &startPos)
     mParentPlot->setAntialiasedElements(mAADragBackup);
     mParentPlot->setNotAntialiasedElements(mNotAADragBackup);
   }
+  if (!mDragScrollOffset.isNull()) // frames during the drag were blitted, finish with a full replot
+  {
+    mDragScrollOffset = QPoint();
+    mParentPlot->invalidatePendingBlit();
+    mParentPlot->replot(QCustomPlot::rpQueuedReplot);
+  }
+}
+
+/*! \internal
+  
+  Returns whether changing the range of \a axis from \a oldRange to its current range maps the
+  old pixel positions p to p*\a scale+\a offset. This is not the case if the new range was limited,
+  e.g. by the restrictions of \ref QCPRange::validRange, so the previous frame can't be reused to
+  obtain the new one.
+  
+  \see setRangeDragBlitting, setRangeZoomPreviewDelay
+*/
+bool QCPAxisRect::rangeMappedBy(const QCPAxis *axis, const QCPRange &oldRange, double scale, double offset) const
+{
+  // the old range bounds were at the pixels where the current range bounds are now:
+  const QCPRange range = axis->range();
+  return qAbs(axis->coordToPixel(oldRange.lower)-(axis->coordToPixel(range.lower)*scale+offset)) < 0.01 &&
+         qAbs(axis->coordToPixel(oldRange.upper)-(axis->coordToPixel(range.upper)*scale+offset)) < 0.01;
+}
+
+/*! \internal
+  
+  Called by \ref QCustomPlot::replotBlitted when a replot showed a scaled preview of the previous
+  frame in this axis rect, instead of redrawing the plottables. Starts the timer for the full
+  quality replot, which follows when no further zoom step happens within \ref
+  setRangeZoomPreviewDelay. Wheel steps whose replot was drawn in full quality anyway (e.g.
+  because no paint buffer could be scaled) therefore don't cause an additional replot.
+*/
+void QCPAxisRect::zoomPreviewDrawn()
+{
+  if (isAnimatingRanges()) // a scaled intermediate animation frame, the animation finishes with a full quality replot
+    return;
+  if (mRangeZoomPreviewDelay > 0)
+    mZoomPreviewTimer->start(mRangeZoomPreviewDelay);
+  else // previews were disabled since the zoom step
+    mParentPlot->replot(QCustomPlot::rpQueuedReplot);
+}
+
+/*! \internal
+  
+  Returns the range at fraction \a t (between 0 and 1) of the way from \a from to \a to. The
+  bounds are interpolated in the scale domain of \a axis, so an animation appears as a uniform
+  motion on screen: linearly for \ref QCPAxis::stLinear, geometrically for \ref
+  QCPAxis::stLogarithmic and in the transformed domain of the scale transform for \ref
+  QCPAxis::stCustom.
+*/
+QCPRange QCPAxisRect::interpolatedRange(const QCPAxis *axis, const QCPRange &from, const QCPRange &to, double t) const
+{
+  if (axis->mScaleType == QCPAxis::stLogarithmic && from.lower*to.lower > 0 && from.upper*to.upper > 0)
+  {
+    return QCPRange(from.lower*qPow(to.lower/from.lower, t), from.upper*qPow(to.upper/from.upper, t));
+  } else if (axis->mScaleType == QCPAxis::stCustom)
+  {
+    const QCPScaleTransform *transform = axis->mScaleTransform.data();
+    const double lower = transform->transform(from.lower), upper = transform->transform(from.upper);
+    return QCPRange(transform->inverseTransform(lower+(transform->transform(to.lower)-lower)*t),
+                    transform->inverseTransform(upper+(transform->transform(to.upper)-upper)*t));
+  }
+  return QCPRange(from.lower+(to.lower-from.lower)*t, from.upper+(to.upper-from.upper)*t);
+}
+
+/*! \internal
+  
+  Stops the animation timer, restores the antialiasing settings changed for the intermediate frames
+  and queues the final replot in full quality, discarding a pending reuse of the previous frame.
+  
+  The settings are backed up separately from those of range dragging (\ref mousePressEvent), so
+  an animation that is started or stopped around a drag never restores the backup of the other.
+*/
+void QCPAxisRect::finishRangeAnimations()
+{
+  mRangeAnimationTimer->stop();
+  if (mAnimationAntialiasingLowered)
+  {
+    mAnimationAntialiasingLowered = false;
+    mParentPlot->setAntialiasedElements(mAAAnimationBackup);
+    mParentPlot->setNotAntialiasedElements(mNotAAAnimationBackup);
+  }
+  mParentPlot->invalidatePendingBlit();
+  mParentPlot->replot(QCustomPlot::rpQueuedReplot);
+}
+
+/*! \internal
+  
+  Called by the animation timer for each frame. Sets the interpolated ranges of all animated axes
+  and queues a replot. Animations that reached their duration are set to their target range and
+  removed.
+  
+  For intermediate frames with \ref setRangeAnimationDegraded enabled, the pixel transform from the
+  previous ranges to the new ones is registered with \ref QCustomPlot::addPendingBlit, so the
+  replot can reuse the previous frame. This requires that all animated axes of one orientation
+  move the contents the same way. Ranges that are merely shifted are rounded to whole pixel
+  shifts, so the previous frame can be scrolled instead of scaled.
+*/
+void QCPAxisRect::rangeAnimationStep()
+{
+  // determine all new ranges first, since setting them may start or stop animations via signals:
+  QList<QPair<QPointer<QCPAxis>, QCPRange> > newRanges;
+  for (int i=mRangeAnimations.size()-1; i>=0; --i)
+  {
+    const RangeAnimation &animation = mRangeAnimations.at(i);
+    if (animation.axis.isNull())
+    {
+      mRangeAnimations.removeAt(i);
+      continue;
+    }
+    const double t = animation.duration > 0 ? animation.clock.elapsed()/double(animation.duration) : 1.0;
+    if (t >= 1.0 || t < 0) // t < 0 if the clock wrapped around at midnight
+    {
+      newRanges.append(qMakePair(animation.axis, animation.targetRange));
+      mRangeAnimations.removeAt(i);
+    } else
+    {
+      const double eased = 1.0-(1.0-t)*(1.0-t)*(1.0-t); // decelerate towards the target
+      newRanges.append(qMakePair(animation.axis, interpolatedRange(animation.axis.data(), animation.startRange, animation.targetRange, eased)));
+    }
+  }
+  const bool degraded = mRangeAnimationDegraded && !mDragging && !mRangeAnimations.isEmpty(); // a range drag registers its own frame reuse
+  bool blittable = degraded;
+  double scale[2] = {1, 1}, offset[2] = {0, 0}; // pixel transform per orientation (horizontal, vertical)
+  bool transformed[2] = {false, false};
+  QList<QCPAxis*> animatedAxes;
+  for (int i=0; i<newRanges.size(); ++i)
+  {
+    QCPAxis *axis = newRanges.at(i).first.data();
+    if (!axis)
+      continue;
+    QCPRange range = newRanges.at(i).second;
+    const QCPRange oldRange = axis->range();
+    const double oldLowerPixel = axis->coordToPixel(oldRange.lower);
+    const double oldUpperPixel = axis->coordToPixel(oldRange.upper);
+    if (degraded)
+    {
+      const double lowerShift = oldLowerPixel-axis->coordToPixel(range.lower);
+      const double upperShift = oldUpperPixel-axis->coordToPixel(range.upper);
+      if (qAbs(lowerShift-upperShift) < 1e-6) // a pan, round it to whole pixels
+      {
+        const double shift = qRound(lowerShift);
+        range = QCPRange(axis->pixelToCoord(oldLowerPixel-shift), axis->pixelToCoord(oldUpperPixel-shift));
+      }
+    }
+    axis->setRange(range);
+    if (!degraded)
+      continue;
+    
+    // the pixel transform mapping the positions of the previous frame to the new ones:
+    const double pixelScale = (axis->coordToPixel(oldRange.lower)-axis->coordToPixel(oldRange.upper))/(oldLowerPixel-oldUpperPixel);
+    const double pixelOffset = axis->coordToPixel(oldRange.lower)-oldLowerPixel*pixelScale;
+    const int index = axis->orientation() == Qt::Horizontal ? 0 : 1;
+    if (!qIsFinite(pixelScale) || !qIsFinite(pixelOffset) || !rangeMappedBy(axis, oldRange, pixelScale, pixelOffset))
+      blittable = false;
+    else if (transformed[index] && (qAbs(scale[index]-pixelScale) > 1e-9 || qAbs(offset[index]-pixelOffset) > 1e-6))
+      blittable = false;
+    scale[index] = pixelScale;
+    offset[index] = pixelOffset;
+    transformed[index] = true;
+    animatedAxes << axis;
+  }
+  if (degraded)
+  {
+    if (blittable)
+      mParentPlot->addPendingBlit(this, QTransform(scale[0], 0, 0, scale[1], offset[0], offset[1]), animatedAxes);
+    else // e.g. a range was limited, so the contents didn't simply move
+      mParentPlot->invalidatePendingBlit();
+  }
+  
+  if (mRangeAnimations.isEmpty())
+  {
+    finishRangeAnimations();
+    emit rangeAnimationFinished();
+  } else
+    mParentPlot->replot(QCustomPlot::rpQueuedReplot);
 }
 
 /*! \internal
@@ -1278,24 +1687,53 @@ void QCPAxisRect::wheelEvent(QWheelEvent *event)
   {
     if (mRangeZoom != 0)
     {
+      stopRangeAnimations(); // zoom relative to the current intermediate ranges
       double factor;
       double wheelSteps = event->delta()/120.0; // a single step delta is +/-120 usually
+      // pixel scale of the axis rect contents, used for zoom previews:
+      double horzScale = 1, vertScale = 1;
+      bool previewable = mRangeZoomPreviewDelay > 0;
+      QList<QCPAxis*> zoomedAxes;
       if (mRangeZoom.testFlag(Qt::Horizontal))
       {
         factor = qPow(mRangeZoomFactorHorz, wheelSteps);
+        horzScale = 1.0/factor;
         for (int i=0; i<mRangeZoomHorzAxis.size(); ++i)
         {
           if (!mRangeZoomHorzAxis.at(i).isNull())
+          {
+            const QCPRange oldRange = mRangeZoomHorzAxis.at(i)->range();
             mRangeZoomHorzAxis.at(i)->scaleRange(factor, mRangeZoomHorzAxis.at(i)->pixelToCoord(event->pos().x()));
+            if (previewable && !rangeMappedBy(mRangeZoomHorzAxis.at(i), oldRange, horzScale, event->pos().x()*(1-horzScale)))
+              previewable = false;
+            zoomedAxes << mRangeZoomHorzAxis.at(i);
+          }
         }
       }
       if (mRangeZoom.testFlag(Qt::Vertical))
       {
         factor = qPow(mRangeZoomFactorVert, wheelSteps);
+        vertScale = 1.0/factor;
         for (int i=0; i<mRangeZoomVertAxis.size(); ++i)
         {
           if (!mRangeZoomVertAxis.at(i).isNull())
+          {
+            const QCPRange oldRange = mRangeZoomVertAxis.at(i)->range();
             mRangeZoomVertAxis.at(i)->scaleRange(factor, mRangeZoomVertAxis.at(i)->pixelToCoord(event->pos().y()));
+            if (previewable && !rangeMappedBy(mRangeZoomVertAxis.at(i), oldRange, vertScale, event->pos().y()*(1-vertScale)))
+              previewable = false;
+            zoomedAxes << mRangeZoomVertAxis.at(i);
+          }
+        }
+      }
+      if (mRangeZoomPreviewDelay > 0)
+      {
+        if (previewable)
+          mParentPlot->addPendingBlit(this, QTransform(horzScale, 0, 0, vertScale, event->pos().x()*(1-horzScale), event->pos().y()*(1-vertScale)), zoomedAxes);
+        else // e.g. a range was limited, so the contents weren't simply scaled around the cursor
+        {
+          mParentPlot->invalidatePendingBlit();
+          mZoomPreviewTimer->stop(); // the following replot is in full quality anyway
         }
       }
       mParentPlot->replot();
@@ -46,6 +46,10 @@ class QCP_LIB_DECL QCPAxisRect : public QCPLayoutElement
   Q_PROPERTY(Qt::AspectRatioMode backgroundScaledMode READ backgroundScaledMode WRITE setBackgroundScaledMode)
   Q_PROPERTY(Qt::Orientations rangeDrag READ rangeDrag WRITE setRangeDrag)
   Q_PROPERTY(Qt::Orientations rangeZoom READ rangeZoom WRITE setRangeZoom)
+  Q_PROPERTY(bool rangeDragBlitting READ rangeDragBlitting WRITE setRangeDragBlitting)
+  Q_PROPERTY(int rangeZoomPreviewDelay READ rangeZoomPreviewDelay WRITE setRangeZoomPreviewDelay)
+  Q_PROPERTY(int rangeAnimationDuration READ rangeAnimationDuration WRITE setRangeAnimationDuration)
+  Q_PROPERTY(bool rangeAnimationDegraded READ rangeAnimationDegraded WRITE setRangeAnimationDegraded)
   /// \endcond
 public:
   explicit QCPAxisRect(QCustomPlot *parentPlot, bool setupDefaultAxes=true);
@@ -58,6 +62,10 @@ public:
   Qt::AspectRatioMode backgroundScaledMode() const { return mBackgroundScaledMode; }
   Qt::Orientations rangeDrag() const { return mRangeDrag; }
   Qt::Orientations rangeZoom() const { return mRangeZoom; }
+  bool rangeDragBlitting() const { return mRangeDragBlitting; }
+  int rangeZoomPreviewDelay() const { return mRangeZoomPreviewDelay; }
+  int rangeAnimationDuration() const { return mRangeAnimationDuration; }
+  bool rangeAnimationDegraded() const { return mRangeAnimationDegraded; }
   QCPAxis *rangeDragAxis(Qt::Orientation orientation);
   QCPAxis *rangeZoomAxis(Qt::Orientation orientation);
   QList<QCPAxis*> rangeDragAxes(Qt::Orientation orientation);
@@ -80,6 +88,10 @@ public:
   void setRangeZoomAxes(QList<QCPAxis*> horizontal, QList<QCPAxis*> vertical);
   void setRangeZoomFactor(double horizontalFactor, double verticalFactor);
   void setRangeZoomFactor(double factor);
+  void setRangeDragBlitting(bool enabled);
+  void setRangeZoomPreviewDelay(int milliseconds);
+  void setRangeAnimationDuration(int milliseconds);
+  void setRangeAnimationDegraded(bool enabled);
   
   // non-property methods:
   int axisCount(QCPAxis::AxisType type) const;
@@ -97,6 +109,9 @@ public:
   QList<QCPAbstractPlottable*> plottables() const;
   QList<QCPGraph*> graphs() const;
   QList<QCPAbstractItem*> items() const;
+  void animateRange(QCPAxis *axis, const QCPRange &range, int duration=-1);
+  bool isAnimatingRanges() const { return !mRangeAnimations.isEmpty(); }
+  Q_SLOT void stopRangeAnimations(bool jumpToTarget=false);
   
   // read-only interface imitating a QRect:
   int left() const { return mRect.left(); }
@@ -115,8 +130,23 @@ public:
   // reimplemented virtual methods:
   virtual void update(UpdatePhase phase) Q_DECL_OVERRIDE;
   virtual QList<QCPLayoutElement*> elements(bool recursive) const Q_DECL_OVERRIDE;
+  
+signals:
+  void rangeAnimationFinished();
 
 protected:
+  /*! \internal
+    An ongoing range animation of a single axis, see \ref animateRange.
+  */
+  struct RangeAnimation
+  {
+    QPointer<QCPAxis> axis;
+    QCPRange startRange, targetRange;
+    QTime clock;
+    int duration;
+  };
+  
+
   // property members:
   QBrush mBackgroundBrush;
   QPixmap mBackgroundPixmap;
@@ -128,9 +158,19 @@ protected:
   QList<QPointer<QCPAxis> > mRangeDragHorzAxis, mRangeDragVertAxis;
   QList<QPointer<QCPAxis> > mRangeZoomHorzAxis, mRangeZoomVertAxis;
   double mRangeZoomFactorHorz, mRangeZoomFactorVert;
+  bool mRangeDragBlitting;
+  int mRangeZoomPreviewDelay;
+  int mRangeAnimationDuration;
+  bool mRangeAnimationDegraded;
   
   // non-property members:
   QList<QCPRange> mDragStartHorzRange, mDragStartVertRange;
+  QPoint mDragScrollOffset;
+  QTimer *mZoomPreviewTimer;
+  QList<RangeAnimation> mRangeAnimations;
+  QTimer *mRangeAnimationTimer;
+  QCP::AntialiasedElements mAAAnimationBackup, mNotAAAnimationBackup;
+  bool mAnimationAntialiasingLowered;
   QCP::AntialiasedElements mAADragBackup, mNotAADragBackup;
   bool mDragging;
   QHash<QCPAxis::AxisType, QList<QCPAxis*> > mAxes;
@@ -149,6 +189,11 @@ protected:
   // non-property methods:
   void drawBackground(QCPPainter *painter);
   void updateAxesOffset(QCPAxis::AxisType type);
+  bool rangeMappedBy(const QCPAxis *axis, const QCPRange &oldRange, double scale, double offset) const;
+  void zoomPreviewDrawn();
+  QCPRange interpolatedRange(const QCPAxis *axis, const QCPRange &from, const QCPRange &to, double t) const;
+  void finishRangeAnimations();
+  Q_SLOT void rangeAnimationStep();
   
 private:
   Q_DISABLE_COPY(QCPAxisRect)
@@ -0,0 +1,953 @@
+/***************************************************************************
+**                                                                        **
+**  QCustomPlot, an easy to use, modern plotting widget for Qt            **
+**  Copyright (C) 2011-2017 Emanuel Eichhammer                            **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+****************************************************************************
+**           Author: Emanuel Eichhammer                                   **
+**  Website/Contact: http://www.qcustomplot.com/                          **
+**             Date: 04.09.17                                             **
+**          Version: 2.0.0                                                **
+****************************************************************************/
+
+#include "layoutelement-overview.h"
+
+#include "../painter.h"
+#include "../core.h"
+#include "../plottable.h"
+#include "../plottable1d.h"
+#include "../axis/axis.h"
+#include "../plottables/plottable-graph.h"
+#include "../plottables/plottable-lodgraph.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////// QCPOverview
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*! \class QCPOverview
+  \brief A layout element showing a compact overview of plottables and the visible range of an axis
+
+  An overview (also known as minimap or range navigator) displays the entire key range of the
+  plottables added with \ref addPlottable, and marks the current range of the \ref setLinkedAxis
+  "linked axis" with a viewport rectangle. The user may drag the viewport rectangle, or click
+  beside it to center the viewport at the clicked key. The linked axis range is changed
+  accordingly.
+
+  The overview doesn't hold a copy of the plotted data. Instead it reads the data of the
+  plottables through their \ref QCPPlottableInterface1D and reduces it to a fixed number of
+  columns (see \ref setResolution), each storing the minimum and maximum value of the data points
+  falling into it. The columns don't depend on the size of the overview, so resizing only redraws
+  the (cheap) column representation, which is additionally cached in a pixmap between replots.
+  Plottables of type \ref QCPLodGraph are read from the coarsest level of their min/max pyramid
+  which still provides several buckets per column, so even files with hundreds of millions of data
+  points are scanned quickly.
+
+  When data is appended to a plottable, e.g. with \ref QCPGraph::addData in a real-time plot, only
+  the new data points are scanned. If appended data exceeds the current column range, the
+  range is doubled by merging neighbouring columns, also without rescanning previous data. For
+  plottables of type \ref QCPGraph, changes are tracked with \ref QCPDataContainer::revision, so
+  data removed from the front (e.g. with \ref QCPDataContainer::removeBefore in a rolling buffer)
+  is dropped by rebuilding only the columns which held removed data, and the column range moves
+  along with the data. Any other modification of the data (removing, inserting or changing data
+  points) is detected when possible and causes a full rescan. If data is modified in place in a
+  way that can't be detected (e.g. by changing values through \ref QCPDataContainer::begin without
+  calling \ref QCPDataContainer::markModified), call \ref invalidate.
+
+  The key axis of the overview is always linear, the plottables and the linked axis are expected
+  to use a linear scale type as well.
+
+  A typical setup places the overview below the main axis rect and aligns the two with a \ref
+  QCPMarginGroup:
+  \code
+  QCPOverview *overview = new QCPOverview(customPlot);
+  customPlot->plotLayout()->addElement(1, 0, overview);
+  customPlot->plotLayout()->setRowStretchFactor(1, 0.15);
+  overview->addPlottable(customPlot->graph(0));
+  overview->setLinkedAxis(customPlot->xAxis);
+  QCPMarginGroup *group = new QCPMarginGroup(customPlot);
+  customPlot->axisRect()->setMarginGroup(QCP::msLeft|QCP::msRight, group);
+  overview->setMarginGroup(QCP::msLeft|QCP::msRight, group);
+  \endcode
+*/
+
+/*!
+  Creates a new QCPOverview instance with no plottables and no linked axis.
+*/
+QCPOverview::QCPOverview(QCustomPlot *parentPlot) :
+  QCPLayoutElement(parentPlot),
+  mResolution(1000),
+  mViewportPen(QPen(QColor(50, 50, 140), 1)),
+  mViewportBrush(Qt::NoBrush),
+  mOutsideBrush(QColor(0, 0, 0, 40)),
+  mBackgroundBrush(Qt::NoBrush),
+  mBinRangeValid(false),
+  mCachedImageDirty(true),
+  mDragging(false),
+  mDragStartKey(0)
+{
+  setMinimumSize(50, 40);
+}
+
+QCPOverview::~QCPOverview()
+{
+}
+
+/*!
+  Sets the axis whose range is shown as viewport rectangle in the overview. Dragging the viewport
+  rectangle changes the range of this axis.
+
+  The axis may belong to a different QCustomPlot instance than the overview. In that case the
+  overview's parent plot is replotted whenever the range of \a axis changes.
+
+  Set \a axis to 0 to not show a viewport rectangle.
+*/
+void QCPOverview::setLinkedAxis(QCPAxis *axis)
+{
+  if (mLinkedAxis.data() == axis)
+    return;
+  if (mLinkedAxis)
+    disconnect(mLinkedAxis.data(), SIGNAL(rangeChanged(QCPRange)), this, SLOT(linkedAxisRangeChanged()));
+  mLinkedAxis = axis;
+  mDragging = false;
+  if (mLinkedAxis)
+    connect(mLinkedAxis.data(), SIGNAL(rangeChanged(QCPRange)), this, SLOT(linkedAxisRangeChanged()));
+}
+
+/*!
+  Sets the number of columns the key range of the plottables is divided into. Each column stores
+  the value span of the data points falling into it, so \a columns determines the horizontal
+  detail of the overview and the memory it requires, independent of the amount of data.
+
+  The default of 1000 columns is sufficient for overviews up to the same width in (device)
+  pixels. Changing the resolution causes a full rescan of the data on the next replot.
+*/
+void QCPOverview::setResolution(int columns)
+{
+  if (columns < 2)
+  {
+    qDebug() << Q_FUNC_INFO << "resolution must be at least 2 columns:" << columns;
+    return;
+  }
+  if (mResolution != columns)
+  {
+    mResolution = columns;
+    invalidate();
+  }
+}
+
+/*!
+  Sets the pen of the viewport rectangle, which marks the range of the \ref setLinkedAxis "linked
+  axis".
+
+  \see setViewportBrush, setOutsideBrush
+*/
+void QCPOverview::setViewportPen(const QPen &pen)
+{
+  mViewportPen = pen;
+}
+
+/*!
+  Sets the brush filling the viewport rectangle, which marks the range of the \ref setLinkedAxis
+  "linked axis".
+
+  \see setViewportPen, setOutsideBrush
+*/
+void QCPOverview::setViewportBrush(const QBrush &brush)
+{
+  mViewportBrush = brush;
+}
+
+/*!
+  Sets the brush which shades the parts of the overview outside the viewport rectangle.
+
+  \see setViewportPen, setViewportBrush
+*/
+void QCPOverview::setOutsideBrush(const QBrush &brush)
+{
+  mOutsideBrush = brush;
+}
+
+/*!
+  Sets the brush the overview background is filled with. By default, no background is drawn.
+*/
+void QCPOverview::setBackgroundBrush(const QBrush &brush)
+{
+  mBackgroundBrush = brush;
+}
+
+/*!
+  Returns the plottables shown in this overview.
+
+  \see addPlottable, removePlottable
+*/
+QList<QCPAbstractPlottable*> QCPOverview::plottables() const
+{
+  QList<QCPAbstractPlottable*> result;
+  for (int i=0; i<mChannels.size(); ++i)
+  {
+    if (mChannels.at(i).plottable)
+      result.append(mChannels.at(i).plottable.data());
+  }
+  return result;
+}
+
+/*!
+  Returns whether \a plottable is shown in this overview.
+*/
+bool QCPOverview::hasPlottable(QCPAbstractPlottable *plottable) const
+{
+  for (int i=0; i<mChannels.size(); ++i)
+  {
+    if (mChannels.at(i).plottable.data() == plottable)
+      return true;
+  }
+  return false;
+}
+
+/*!
+  Adds \a plottable to the overview. The plottable may belong to any QCustomPlot instance, and must
+  be a one-dimensional plottable (see \ref QCPAbstractPlottable::interface1D), such as \ref
+  QCPGraph, \ref QCPCurve or \ref QCPBars. The plottable's pen is used to draw its overview.
+
+  Returns true on success, i.e. if \a plottable is a one-dimensional plottable and wasn't already
+  added.
+
+  \see removePlottable, clearPlottables
+*/
+bool QCPOverview::addPlottable(QCPAbstractPlottable *plottable)
+{
+  if (!plottable || !plottable->interface1D())
+  {
+    qDebug() << Q_FUNC_INFO << "plottable is null or not one-dimensional:" << reinterpret_cast<quintptr>(plottable);
+    return false;
+  }
+  if (hasPlottable(plottable))
+  {
+    qDebug() << Q_FUNC_INFO << "plottable already in overview:" << reinterpret_cast<quintptr>(plottable);
+    return false;
+  }
+  Channel channel;
+  channel.plottable = plottable;
+  channel.revision = channel.frontRemovals = 0;
+  channel.scannedCount = 0;
+  channel.firstKey = channel.lastKey = qQNaN();
+  channel.keyMin = channel.keyMax = qQNaN();
+  mChannels.append(channel);
+  invalidate(); // the key range of the new plottable may not fit into the current columns
+  return true;
+}
+
+/*!
+  Removes \a plottable from the overview. The plottable itself is not deleted.
+
+  Returns true on success.
+
+  \see addPlottable, clearPlottables
+*/
+bool QCPOverview::removePlottable(QCPAbstractPlottable *plottable)
+{
+  for (int i=0; i<mChannels.size(); ++i)
+  {
+    if (mChannels.at(i).plottable.data() == plottable)
+    {
+      mChannels.removeAt(i);
+      mCachedImageDirty = true;
+      return true;
+    }
+  }
+  qDebug() << Q_FUNC_INFO << "plottable not in overview:" << reinterpret_cast<quintptr>(plottable);
+  return false;
+}
+
+/*!
+  Removes all plottables from the overview.
+
+  \see addPlottable, removePlottable
+*/
+void QCPOverview::clearPlottables()
+{
+  mChannels.clear();
+  invalidate();
+}
+
+/*!
+  Returns the key range spanned by the data of all plottables in the overview, as of the last
+  replot. This is the key range the overview displays.
+*/
+QCPRange QCPOverview::keyRange() const
+{
+  QCPRange result;
+  bool found = false;
+  for (int i=0; i<mChannels.size(); ++i)
+  {
+    const Channel &channel = mChannels.at(i);
+    if (!channel.plottable || qIsNaN(channel.keyMin))
+      continue;
+    if (found)
+    {
+      result.expand(channel.keyMin);
+      result.expand(channel.keyMax);
+    } else
+    {
+      result = QCPRange(channel.keyMin, channel.keyMax);
+      found = true;
+    }
+  }
+  return result;
+}
+
+/*!
+  Returns the value range spanned by the data of all plottables in the overview, as of the last
+  replot. This is the value range the overview displays.
+*/
+QCPRange QCPOverview::valueRange() const
+{
+  QCPRange result;
+  bool found = false;
+  for (int i=0; i<mChannels.size(); ++i)
+  {
+    const Channel &channel = mChannels.at(i);
+    if (!channel.plottable)
+      continue;
+    for (int c=0; c<channel.columnMin.size(); ++c)
+    {
+      if (qIsNaN(channel.columnMin.at(c)))
+        continue;
+      if (found)
+      {
+        result.expand(channel.columnMin.at(c));
+        result.expand(channel.columnMax.at(c));
+      } else
+      {
+        result = QCPRange(channel.columnMin.at(c), channel.columnMax.at(c));
+        found = true;
+      }
+    }
+  }
+  return result;
+}
+
+/*!
+  Discards the accumulated columns, so the data of all plottables is scanned again on the next
+  replot.
+
+  Call this method after modifying the data of a plottable in place, e.g. by changing values
+  through a non-const iterator of its data container. Appending data as well as replacing or
+  removing data is detected automatically.
+*/
+void QCPOverview::invalidate()
+{
+  mBinRangeValid = false;
+  mCachedImageDirty = true;
+}
+
+/* inherits documentation from base class */
+void QCPOverview::applyDefaultAntialiasingHint(QCPPainter *painter) const
+{
+  applyAntialiasingHint(painter, true, QCP::aePlottables);
+}
+
+/* inherits documentation from base class */
+void QCPOverview::draw(QCPPainter *painter)
+{
+  if (updateChannels())
+    mCachedImageDirty = true;
+  
+  if (mBackgroundBrush.style() != Qt::NoBrush)
+    painter->fillRect(mRect, mBackgroundBrush);
+  
+  // draw plottable overviews, from cached pixmap if possible:
+  if (painter->modes().testFlag(QCPPainter::pmNoCaching) || painter->modes().testFlag(QCPPainter::pmVectorized))
+  {
+    drawChannels(painter, mRect);
+  } else if (!mRect.isEmpty())
+  {
+    const double devicePixelRatio = mParentPlot->bufferDevicePixelRatio();
+    const QSize imageSize = mRect.size()*devicePixelRatio;
+    if (mCachedImageDirty || mCachedImage.size() != imageSize)
+    {
+      mCachedImage = QPixmap(imageSize);
+      if (!qFuzzyCompare(1.0, devicePixelRatio))
+      {
+#ifdef QCP_DEVICEPIXELRATIO_SUPPORTED
+#  ifdef QCP_DEVICEPIXELRATIO_FLOAT
+        mCachedImage.setDevicePixelRatio(mParentPlot->devicePixelRatioF());
+#  else
+        mCachedImage.setDevicePixelRatio(mParentPlot->devicePixelRatio());
+#  endif
+#endif
+      }
+      mCachedImage.fill(Qt::transparent);
+      QCPPainter imagePainter(&mCachedImage);
+      imagePainter.setAntialiasing(painter->antialiasing());
+      drawChannels(&imagePainter, QRect(QPoint(0, 0), mRect.size()));
+      mCachedImageDirty = false;
+    }
+    painter->drawPixmap(mRect.topLeft(), mCachedImage);
+  }
+  
+  // draw viewport of linked axis:
+  if (mLinkedAxis && mBinRangeValid)
+  {
+    const QCPRange viewRange = mLinkedAxis.data()->range();
+    const double left = qBound(double(mRect.left()), keyToPixel(viewRange.lower), double(mRect.right()+1));
+    const double right = qBound(double(mRect.left()), keyToPixel(viewRange.upper), double(mRect.right()+1));
+    const QRectF viewport(left, mRect.top(), right-left, mRect.height());
+    if (mOutsideBrush.style() != Qt::NoBrush)
+    {
+      painter->fillRect(QRectF(mRect.left(), mRect.top(), left-mRect.left(), mRect.height()), mOutsideBrush);
+      painter->fillRect(QRectF(right, mRect.top(), mRect.right()+1-right, mRect.height()), mOutsideBrush);
+    }
+    painter->setAntialiasing(false);
+    painter->setPen(mViewportPen);
+    painter->setBrush(mViewportBrush);
+    painter->drawRect(viewport.adjusted(0, 0, -1, -1));
+  }
+}
+
+/*!
+  Starts dragging the viewport rectangle. If the press happens outside the viewport rectangle, the
+  range of the \ref setLinkedAxis "linked axis" is first centered at the pressed key.
+
+  \seebaseclassmethod
+*/
+void QCPOverview::mousePressEvent(QMouseEvent *event, const QVariant &details)
+{
+  Q_UNUSED(details)
+  if (!(event->buttons() & Qt::LeftButton) || !mLinkedAxis || !mBinRangeValid || keyRange().size() <= 0)
+  {
+    event->ignore();
+    return;
+  }
+  const double key = pixelToKey(event->pos().x());
+  const QCPRange viewRange = mLinkedAxis.data()->range();
+  if (!viewRange.contains(key))
+  {
+    mLinkedAxis.data()->setRange(key, viewRange.size(), Qt::AlignCenter);
+    mLinkedAxis.data()->parentPlot()->replot(QCustomPlot::rpQueuedReplot);
+  }
+  mDragging = true;
+  mDragStartKey = key;
+  mDragStartRange = mLinkedAxis.data()->range();
+}
+
+/*!
+  Moves the range of the \ref setLinkedAxis "linked axis" while the viewport rectangle is dragged.
+
+  \seebaseclassmethod
+*/
+void QCPOverview::mouseMoveEvent(QMouseEvent *event, const QPointF &startPos)
+{
+  Q_UNUSED(startPos)
+  if (!mDragging || !mLinkedAxis)
+    return;
+  const double diff = pixelToKey(event->pos().x())-mDragStartKey;
+  mLinkedAxis.data()->setRange(mDragStartRange.lower+diff, mDragStartRange.upper+diff);
+  mLinkedAxis.data()->parentPlot()->replot(QCustomPlot::rpQueuedReplot);
+}
+
+/*!
+  Ends dragging of the viewport rectangle.
+
+  \seebaseclassmethod
+*/
+void QCPOverview::mouseReleaseEvent(QMouseEvent *event, const QPointF &startPos)
+{
+  Q_UNUSED(event)
+  Q_UNUSED(startPos)
+  mDragging = false;
+}
+
+/*! \internal
+
+  Brings the columns of all channels up to date with the data of their plottables. Removes
+  channels whose plottable was deleted, drops data points removed from the front, scans only the
+  new data points of plottables that had data appended, and rescans everything if data was
+  modified otherwise.
+
+  Plain \ref QCPGraph "QCPGraphs" (see \ref plainGraph) are checked with the revision counters of
+  their data container. For other plottables, appended data is detected by comparing the data
+  count and the keys of the first and last scanned data point.
+
+  Returns true if anything changed, i.e. if the cached image must be redrawn.
+*/
+bool QCPOverview::updateChannels()
+{
+  bool changed = false;
+  for (int i=mChannels.size()-1; i>=0; --i)
+  {
+    if (!mChannels.at(i).plottable)
+    {
+      mChannels.removeAt(i);
+      changed = true;
+    }
+  }
+  
+  bool needRescan = !mBinRangeValid;
+  // drop data removed from the front first, so the column range can move along before appended data is scanned:
+  bool frontRemoved = false;
+  for (int i=0; i<mChannels.size() && !needRescan; ++i)
+  {
+    Channel &channel = mChannels[i];
+    if (channel.pen != channel.plottable.data()->pen())
+    {
+      channel.pen = channel.plottable.data()->pen();
+      changed = true;
+    }
+    if (QCPGraph *graph = plainGraph(channel))
+    {
+      const QSharedPointer<QCPGraphDataContainer> container = graph->mDataContainer;
+      if (channel.container.toStrongRef() != container || container->editRevision() > channel.revision)
+      {
+        needRescan = true;
+      } else if (container->frontRemovalCount() != channel.frontRemovals)
+      {
+        removeChannelFront(channel, container->frontRemovalCount());
+        frontRemoved = true;
+        changed = true;
+      }
+    }
+  }
+  if (frontRemoved && !needRescan)
+    shiftBinRange();
+  
+  for (int i=0; i<mChannels.size() && !needRescan; ++i)
+  {
+    Channel &channel = mChannels[i];
+    QCPPlottableInterface1D *data = channel.plottable.data()->interface1D();
+    const int count = data->dataCount();
+    if (QCPGraph *graph = plainGraph(channel))
+    {
+      // front removals are handled above, so the only remaining change without a new edit revision is appended data:
+      const quint64 revision = graph->mDataContainer->revision();
+      if (revision == channel.revision)
+        continue;
+      if (count < channel.scannedCount || !scanChannel(channel, channel.scannedCount, count))
+        needRescan = true;
+      channel.revision = revision;
+      changed = true;
+    } else if (count < channel.scannedCount || (channel.scannedCount > 0 && (data->dataMainKey(0) != channel.firstKey || data->dataMainKey(channel.scannedCount-1) != channel.lastKey)))
+    {
+      // data was removed or replaced, e.g. in a rolling buffer of constant size:
+      needRescan = true;
+    } else if (count > channel.scannedCount)
+    {
+      // the previously scanned first and last data points are unchanged, so data was appended:
+      if (!scanChannel(channel, channel.scannedCount, count))
+        needRescan = true;
+      changed = true;
+    }
+  }
+  
+  if (needRescan)
+  {
+    rescanChannels();
+    changed = true;
+  }
+  return changed;
+}
+
+/*! \internal
+
+  Sets \ref mBinRange to the key range of all plottables and scans the complete data of every
+  channel.
+*/
+void QCPOverview::rescanChannels()
+{
+  bool found = false;
+  mBinRange = QCPRange();
+  for (int i=0; i<mChannels.size(); ++i)
+  {
+    bool foundRange;
+    const QCPRange range = mChannels.at(i).plottable.data()->getKeyRange(foundRange);
+    if (foundRange)
+    {
+      if (found)
+        mBinRange.expand(range);
+      else
+        mBinRange = range;
+      found = true;
+    }
+  }
+  if (mBinRange.size() <= 0)
+    mBinRange.upper = mBinRange.lower+1;
+  mBinRangeValid = true;
+  
+  for (int i=0; i<mChannels.size(); ++i)
+  {
+    Channel &channel = mChannels[i];
+    if (QCPGraph *graph = plainGraph(channel))
+    {
+      channel.container = graph->mDataContainer;
+      channel.revision = graph->mDataContainer->revision();
+      channel.frontRemovals = graph->mDataContainer->frontRemovalCount();
+    } else
+      channel.container.clear();
+    channel.pen = channel.plottable.data()->pen();
+    channel.scannedCount = 0;
+    channel.firstKey = channel.lastKey = qQNaN();
+    channel.keyMin = channel.keyMax = qQNaN();
+    channel.columnMin.fill(qQNaN(), mResolution);
+    channel.columnMax.fill(qQNaN(), mResolution);
+    channel.columnBegin.fill(0, mResolution);
+    channel.columnEnd.fill(0, mResolution);
+    scanChannel(channel, 0, channel.plottable.data()->interface1D()->dataCount());
+  }
+}
+
+/*! \internal
+
+  Accumulates the data points with indices \a begin to \a end-1 of the plottable of \a channel
+  into its columns. Keys beyond the upper end of \ref mBinRange grow the range via \ref
+  growBinRange.
+
+  Returns false if a key lies below \ref mBinRange, i.e. if the columns must be rebuilt with \ref
+  rescanChannels.
+*/
+bool QCPOverview::scanChannel(Channel &channel, int begin, int end)
+{
+  QCPPlottableInterface1D *data = channel.plottable.data()->interface1D();
+  // plain graphs are read directly from their data container, avoiding two virtual calls per point:
+  QCPGraph *graph = plainGraph(channel);
+  const QCPGraphData *points = 0;
+  if (graph && end > begin)
+    points = &*graph->mDataContainer->constBegin();
+  // LOD graphs are read from the coarsest pyramid level that still has enough buckets per column:
+  const double *buckets = 0;
+  int sampleBegin = begin, sampleEnd = end;
+  QCPLodGraph *lodGraph = qobject_cast<QCPLodGraph*>(channel.plottable.data());
+  if (lodGraph && begin == 0 && end == lodGraph->mCount)
+  {
+    for (int i=0; i<lodGraph->mLevels.size(); ++i)
+    {
+      if (lodGraph->mLevels.at(i).bucketCount >= 4*mResolution)
+      {
+        buckets = lodGraph->mLevels.at(i).buckets;
+        sampleEnd = lodGraph->mLevels.at(i).bucketCount;
+      }
+    }
+  }
+  
+  double binScale = mResolution/mBinRange.size();
+  for (int i=sampleBegin; i<sampleEnd; ++i)
+  {
+    double key, valueLower, valueUpper;
+    if (buckets)
+    {
+      key = buckets[3*i];
+      valueLower = buckets[3*i+1];
+      valueUpper = buckets[3*i+2];
+    } else if (points)
+    {
+      key = points[i].key;
+      valueLower = valueUpper = points[i].value;
+    } else
+    {
+      key = data->dataMainKey(i);
+      const QCPRange valueRange = data->dataValueRange(i);
+      valueLower = valueRange.lower;
+      valueUpper = valueRange.upper;
+    }
+    if (qIsNaN(key) || qIsNaN(valueLower) || qIsNaN(valueUpper))
+      continue;
+    if (key < mBinRange.lower)
+      return false;
+    if (key > mBinRange.upper)
+    {
+      growBinRange(key);
+      binScale = mResolution/mBinRange.size();
+    }
+    if (qIsNaN(channel.keyMin))
+    {
+      channel.keyMin = channel.keyMax = key;
+    } else
+    {
+      if (key < channel.keyMin) channel.keyMin = key;
+      if (key > channel.keyMax) channel.keyMax = key;
+    }
+    const int column = qMin(int((key-mBinRange.lower)*binScale), mResolution-1);
+    double &columnMin = channel.columnMin[column];
+    double &columnMax = channel.columnMax[column];
+    if (points) // data points of plain graphs may be removed from the front later, see removeChannelFront
+    {
+      if (qIsNaN(columnMin))
+        channel.columnBegin[column] = channel.frontRemovals+i;
+      channel.columnEnd[column] = channel.frontRemovals+i+1;
+    }
+    if (qIsNaN(columnMin))
+    {
+      columnMin = valueLower;
+      columnMax = valueUpper;
+    } else
+    {
+      if (valueLower < columnMin) columnMin = valueLower;
+      if (valueUpper > columnMax) columnMax = valueUpper;
+    }
+  }
+  if (end > 0)
+  {
+    channel.firstKey = data->dataMainKey(0);
+    channel.lastKey = data->dataMainKey(end-1);
+  }
+  channel.scannedCount = end;
+  return true;
+}
+
+/*! \internal
+
+  Drops the data points of \a channel which were removed from the front of the data container of
+  its plain graph (see \ref plainGraph), given the new \ref QCPDataContainer::frontRemovalCount
+  \a frontRemovals.
+
+  Columns whose data points were all removed are cleared. Columns which hold removed as well as
+  remaining data points (usually only the first remaining column) are rebuilt from their remaining
+  data points. The data points of each column are found with \ref Channel::columnBegin and \ref
+  Channel::columnEnd, so they needn't be assigned to columns again, and all other columns stay
+  untouched.
+*/
+void QCPOverview::removeChannelFront(Channel &channel, quint64 frontRemovals)
+{
+  channel.scannedCount -= int(qMin(frontRemovals-channel.frontRemovals, quint64(channel.scannedCount)));
+  channel.frontRemovals = frontRemovals;
+  const QCPGraphData *points = channel.scannedCount > 0 ? &*plainGraph(channel)->mDataContainer->constBegin() : 0;
+  for (int c=0; c<channel.columnMin.size(); ++c)
+  {
+    if (qIsNaN(channel.columnMin.at(c)) || channel.columnBegin.at(c) >= frontRemovals)
+      continue;
+    double &columnMin = channel.columnMin[c];
+    double &columnMax = channel.columnMax[c];
+    columnMin = columnMax = qQNaN();
+    const int end = channel.columnEnd.at(c) > frontRemovals ? int(qMin(channel.columnEnd.at(c)-frontRemovals, quint64(channel.scannedCount))) : 0;
+    for (int i=0; i<end; ++i)
+    {
+      if (qIsNaN(points[i].key) || qIsNaN(points[i].value))
+        continue;
+      if (qIsNaN(columnMin))
+      {
+        columnMin = columnMax = points[i].value;
+      } else
+      {
+        if (points[i].value < columnMin) columnMin = points[i].value;
+        if (points[i].value > columnMax) columnMax = points[i].value;
+      }
+    }
+    channel.columnBegin[c] = frontRemovals;
+  }
+  
+  // the lowest key is now the one of the first remaining valid data point, the highest key is unchanged:
+  int first = 0;
+  while (first < channel.scannedCount && (qIsNaN(points[first].key) || qIsNaN(points[first].value)))
+    ++first;
+  if (first < channel.scannedCount)
+    channel.keyMin = points[first].key;
+  else
+    channel.keyMin = channel.keyMax = qQNaN();
+  channel.firstKey = channel.scannedCount > 0 ? points[0].key : qQNaN();
+  if (channel.scannedCount == 0)
+    channel.lastKey = qQNaN();
+}
+
+/*! \internal
+
+  Doubles the size of \ref mBinRange (keeping its lower bound) until \a key is contained. Each
+  doubling merges pairs of neighbouring columns of all channels, so previously scanned data needn't
+  be scanned again.
+*/
+void QCPOverview::growBinRange(double key)
+{
+  while (key > mBinRange.upper)
+  {
+    for (int i=0; i<mChannels.size(); ++i)
+    {
+      QVector<double> &columnMin = mChannels[i].columnMin;
+      QVector<double> &columnMax = mChannels[i].columnMax;
+      QVector<quint64> &columnBegin = mChannels[i].columnBegin;
+      QVector<quint64> &columnEnd = mChannels[i].columnEnd;
+      if (columnMin.size() != mResolution)
+        continue;
+      for (int c=0; c<mResolution; ++c)
+      {
+        const int target = c/2;
+        if (c%2 == 0) // first column of pair initializes the merged column
+        {
+          columnMin[target] = columnMin.at(c);
+          columnMax[target] = columnMax.at(c);
+          columnBegin[target] = columnBegin.at(c);
+          columnEnd[target] = columnEnd.at(c);
+        } else if (!qIsNaN(columnMin.at(c)))
+        {
+          const bool targetEmpty = qIsNaN(columnMin.at(target));
+          if (targetEmpty || columnMin.at(c) < columnMin.at(target)) columnMin[target] = columnMin.at(c);
+          if (targetEmpty || columnMax.at(c) > columnMax.at(target)) columnMax[target] = columnMax.at(c);
+          if (targetEmpty || columnBegin.at(c) < columnBegin.at(target)) columnBegin[target] = columnBegin.at(c);
+          if (targetEmpty || columnEnd.at(c) > columnEnd.at(target)) columnEnd[target] = columnEnd.at(c);
+        }
+      }
+      for (int c=(mResolution+1)/2; c<mResolution; ++c)
+        columnMin[c] = columnMax[c] = qQNaN();
+    }
+    mBinRange.upper = mBinRange.lower+2*mBinRange.size();
+  }
+}
+
+/*! \internal
+
+  Moves \ref mBinRange up by the number of leading columns which are empty in all channels, and
+  shifts the columns accordingly. This is called after data was removed from the front, so a
+  rolling buffer keeps using the full resolution instead of repeatedly doubling the range with
+  \ref growBinRange as its data moves on.
+*/
+void QCPOverview::shiftBinRange()
+{
+  int shift = mResolution;
+  for (int i=0; i<mChannels.size(); ++i)
+  {
+    const QVector<double> &columnMin = mChannels.at(i).columnMin;
+    if (columnMin.size() != mResolution)
+      continue;
+    int firstColumn = 0;
+    while (firstColumn < shift && qIsNaN(columnMin.at(firstColumn)))
+      ++firstColumn;
+    shift = firstColumn;
+  }
+  if (shift <= 0 || shift >= mResolution) // nothing to shift or no data left at all
+    return;
+  
+  for (int i=0; i<mChannels.size(); ++i)
+  {
+    QVector<double> &columnMin = mChannels[i].columnMin;
+    QVector<double> &columnMax = mChannels[i].columnMax;
+    if (columnMin.size() != mResolution)
+      continue;
+    columnMin.remove(0, shift);
+    columnMin.insert(columnMin.size(), shift, qQNaN());
+    columnMax.remove(0, shift);
+    columnMax.insert(columnMax.size(), shift, qQNaN());
+    mChannels[i].columnBegin.remove(0, shift);
+    mChannels[i].columnBegin.insert(mChannels[i].columnBegin.size(), shift, 0);
+    mChannels[i].columnEnd.remove(0, shift);
+    mChannels[i].columnEnd.insert(mChannels[i].columnEnd.size(), shift, 0);
+  }
+  mBinRange += shift*mBinRange.size()/mResolution;
+}
+
+/*! \internal
+
+  Returns the plottable of \a channel if it is a QCPGraph, but not a subclass of it. Only the data
+  container of such graphs is read directly and tracked with its revision counters. Subclasses may
+  store their data differently, e.g. \ref QCPCompactGraph creates a copy of its data in \ref
+  QCPGraph::data.
+
+  Returns 0 for all other plottables.
+*/
+QCPGraph *QCPOverview::plainGraph(const Channel &channel) const
+{
+  QCPAbstractPlottable *plottable = channel.plottable.data();
+  if (plottable && plottable->metaObject() == &QCPGraph::staticMetaObject)
+    return static_cast<QCPGraph*>(plottable);
+  return 0;
+}
+
+/*! \internal
+
+  Draws the columns of all channels into \a rect. Each channel is drawn with the pen of its
+  plottable as a polyline which covers the value span of every column, similar to the adaptive
+  sampling of \ref QCPGraph.
+*/
+void QCPOverview::drawChannels(QCPPainter *painter, const QRect &rect) const
+{
+  const QCPRange keys = keyRange();
+  QCPRange values = valueRange();
+  if (keys.size() <= 0 || rect.isEmpty())
+    return;
+  if (values.size() <= 0)
+    values = QCPRange(values.lower-1, values.upper+1);
+  values = QCPRange(values.lower-values.size()*0.05, values.upper+values.size()*0.05);
+  
+  const double columnWidth = mBinRange.size()/mResolution;
+  const double keyScale = rect.width()/keys.size();
+  const double valueScale = rect.height()/values.size();
+  for (int i=0; i<mChannels.size(); ++i)
+  {
+    const Channel &channel = mChannels.at(i);
+    if (!channel.plottable || channel.columnMin.size() != mResolution)
+      continue;
+    QVector<QPointF> lineData;
+    lineData.reserve(2*mResolution);
+    for (int c=0; c<mResolution; ++c)
+    {
+      if (qIsNaN(channel.columnMin.at(c)))
+        continue;
+      const double key = qBound(keys.lower, mBinRange.lower+(c+0.5)*columnWidth, keys.upper);
+      const double x = rect.left()+(key-keys.lower)*keyScale;
+      const double yMin = rect.bottom()+1-(channel.columnMin.at(c)-values.lower)*valueScale;
+      const double yMax = rect.bottom()+1-(channel.columnMax.at(c)-values.lower)*valueScale;
+      // continue from the extremum closer to the previous point, to avoid crossing lines:
+      if (!lineData.isEmpty() && qAbs(lineData.last().y()-yMax) < qAbs(lineData.last().y()-yMin))
+      {
+        lineData.append(QPointF(x, yMax));
+        if (yMin != yMax)
+          lineData.append(QPointF(x, yMin));
+      } else
+      {
+        lineData.append(QPointF(x, yMin));
+        if (yMin != yMax)
+          lineData.append(QPointF(x, yMax));
+      }
+    }
+    painter->setPen(channel.pen);
+    painter->setBrush(Qt::NoBrush);
+    if (lineData.size() == 1)
+      painter->drawPoint(lineData.first());
+    else
+      painter->drawPolyline(lineData.constData(), lineData.size());
+  }
+}
+
+/*! \internal
+
+  Transforms \a key to a horizontal pixel coordinate of the overview.
+*/
+double QCPOverview::keyToPixel(double key) const
+{
+  const QCPRange keys = keyRange();
+  if (keys.size() <= 0)
+    return mRect.center().x();
+  return mRect.left()+(key-keys.lower)/keys.size()*mRect.width();
+}
+
+/*! \internal
+
+  Transforms the horizontal pixel coordinate \a pixel of the overview to a key.
+*/
+double QCPOverview::pixelToKey(double pixel) const
+{
+  const QCPRange keys = keyRange();
+  if (mRect.width() <= 0)
+    return keys.center();
+  return keys.lower+(pixel-mRect.left())/mRect.width()*keys.size();
+}
+
+/*! \internal
+
+  Called when the range of the linked axis changes. Queues a replot of the parent plot if the
+  linked axis belongs to a different plot, so the viewport rectangle follows the axis range.
+*/
+void QCPOverview::linkedAxisRangeChanged()
+{
+  if (mParentPlot && mLinkedAxis && mLinkedAxis.data()->parentPlot() != mParentPlot)
+    mParentPlot->replot(QCustomPlot::rpQueuedReplot);
+}
@@ -0,0 +1,142 @@
+/***************************************************************************
+**                                                                        **
+**  QCustomPlot, an easy to use, modern plotting widget for Qt            **
+**  Copyright (C) 2011-2017 Emanuel Eichhammer                            **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+****************************************************************************
+**           Author: Emanuel Eichhammer                                   **
+**  Website/Contact: http://www.qcustomplot.com/                          **
+**             Date: 04.09.17                                             **
+**          Version: 2.0.0                                                **
+****************************************************************************/
+
+#ifndef QCP_LAYOUTELEMENT_OVERVIEW_H
+#define QCP_LAYOUTELEMENT_OVERVIEW_H
+
+#include "../global.h"
+#include "../layer.h"
+#include "../layout.h"
+#include "../axis/range.h"
+
+class QCPPainter;
+class QCustomPlot;
+class QCPAxis;
+class QCPAbstractPlottable;
+class QCPGraph;
+class QCPGraphData;
+template <class DataType> class QCPDataContainer;
+
+class QCP_LIB_DECL QCPOverview : public QCPLayoutElement
+{
+  Q_OBJECT
+  /// \cond INCLUDE_QPROPERTIES
+  Q_PROPERTY(QCPAxis* linkedAxis READ linkedAxis WRITE setLinkedAxis)
+  Q_PROPERTY(int resolution READ resolution WRITE setResolution)
+  Q_PROPERTY(QPen viewportPen READ viewportPen WRITE setViewportPen)
+  Q_PROPERTY(QBrush viewportBrush READ viewportBrush WRITE setViewportBrush)
+  Q_PROPERTY(QBrush outsideBrush READ outsideBrush WRITE setOutsideBrush)
+  Q_PROPERTY(QBrush backgroundBrush READ backgroundBrush WRITE setBackgroundBrush)
+  /// \endcond
+public:
+  explicit QCPOverview(QCustomPlot *parentPlot);
+  virtual ~QCPOverview();
+  
+  // getters:
+  QCPAxis *linkedAxis() const { return mLinkedAxis.data(); }
+  int resolution() const { return mResolution; }
+  QPen viewportPen() const { return mViewportPen; }
+  QBrush viewportBrush() const { return mViewportBrush; }
+  QBrush outsideBrush() const { return mOutsideBrush; }
+  QBrush backgroundBrush() const { return mBackgroundBrush; }
+  
+  // setters:
+  void setLinkedAxis(QCPAxis *axis);
+  void setResolution(int columns);
+  void setViewportPen(const QPen &pen);
+  void setViewportBrush(const QBrush &brush);
+  void setOutsideBrush(const QBrush &brush);
+  void setBackgroundBrush(const QBrush &brush);
+  
+  // non-property methods:
+  QList<QCPAbstractPlottable*> plottables() const;
+  bool hasPlottable(QCPAbstractPlottable *plottable) const;
+  bool addPlottable(QCPAbstractPlottable *plottable);
+  bool removePlottable(QCPAbstractPlottable *plottable);
+  void clearPlottables();
+  QCPRange keyRange() const;
+  QCPRange valueRange() const;
+  Q_SLOT void invalidate();
+  
+protected:
+  /*! \internal
+    The accumulated data of one plottable: the value span of the data points falling into each
+    column of \ref mBinRange, and what was scanned so far to detect appended data.
+  */
+  struct Channel
+  {
+    QPointer<QCPAbstractPlottable> plottable;
+    QWeakPointer<QCPDataContainer<QCPGraphData> > container; ///< the data container of a plain QCPGraph, to detect \ref QCPGraph::setData with a new container
+    quint64 revision, frontRemovals; ///< state of \a container when it was last scanned, see \ref QCPDataContainer::revision
+    QPen pen;
+    int scannedCount;
+    double firstKey, lastKey; ///< keys of the first and last scanned data point, to detect appended data of other plottables
+    double keyMin, keyMax;
+    QVector<double> columnMin, columnMax;
+    QVector<quint64> columnBegin, columnEnd; ///< index span of the data points in each column of a plain graph, counting removed data points, to drop data removed from the front
+  };
+  
+  // property members:
+  QPointer<QCPAxis> mLinkedAxis;
+  int mResolution;
+  QPen mViewportPen;
+  QBrush mViewportBrush, mOutsideBrush, mBackgroundBrush;
+  
+  // non-property members:
+  QList<Channel> mChannels;
+  QCPRange mBinRange;
+  bool mBinRangeValid;
+  QPixmap mCachedImage;
+  bool mCachedImageDirty;
+  bool mDragging;
+  double mDragStartKey;
+  QCPRange mDragStartRange;
+  
+  // reimplemented virtual methods:
+  virtual void applyDefaultAntialiasingHint(QCPPainter *painter) const Q_DECL_OVERRIDE;
+  virtual void draw(QCPPainter *painter) Q_DECL_OVERRIDE;
+  // events:
+  virtual void mousePressEvent(QMouseEvent *event, const QVariant &details) Q_DECL_OVERRIDE;
+  virtual void mouseMoveEvent(QMouseEvent *event, const QPointF &startPos) Q_DECL_OVERRIDE;
+  virtual void mouseReleaseEvent(QMouseEvent *event, const QPointF &startPos) Q_DECL_OVERRIDE;
+  
+  // non-virtual methods:
+  bool updateChannels();
+  void rescanChannels();
+  bool scanChannel(Channel &channel, int begin, int end);
+  void removeChannelFront(Channel &channel, quint64 frontRemovals);
+  void growBinRange(double key);
+  void shiftBinRange();
+  QCPGraph *plainGraph(const Channel &channel) const;
+  void drawChannels(QCPPainter *painter, const QRect &rect) const;
+  double keyToPixel(double key) const;
+  double pixelToKey(double pixel) const;
+  Q_SLOT void linkedAxisRangeChanged();
+  
+private:
+  Q_DISABLE_COPY(QCPOverview)
+};
+
+#endif // QCP_LAYOUTELEMENT_OVERVIEW_H
@@ -0,0 +1,276 @@
+/***************************************************************************
+**                                                                        **
+**  QCustomPlot, an easy to use, modern plotting widget for Qt            **
+**  Copyright (C) 2011-2017 Emanuel Eichhammer                            **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+****************************************************************************
+**           Author: Emanuel Eichhammer                                   **
+**  Website/Contact: http://www.qcustomplot.com/                          **
+**             Date: 04.09.17                                             **
+**          Version: 2.0.0                                                **
+****************************************************************************/
+
+#include "linerasterizer.h"
+
+#include "painter.h"
+
+/*! \internal
+  
+  Multiplies all four 8 bit channels of \a x with \a a/255 at once.
+*/
+static inline quint32 qcpByteMul(quint32 x, quint32 a)
+{
+  quint32 t = (x & 0xff00ff)*a;
+  t = (t + ((t >> 8) & 0xff00ff) + 0x800080) >> 8;
+  t &= 0xff00ff;
+  x = ((x >> 8) & 0xff00ff)*a;
+  x = (x + ((x >> 8) & 0xff00ff) + 0x800080);
+  x &= 0xff00ff00;
+  return x | t;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////// QCPLineRasterizer
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*! \class QCPLineRasterizer
+  \brief Draws antialiased solid lines directly into the pixels of a QImage
+  
+  QPainter's antialiased stroker is several times slower than aliased line drawing, which makes
+  antialiased plottables (\ref QCP::aePlottables) with many data points expensive. For the common
+  case of thin solid lines, this class computes the pixel coverage of each line segment directly
+  and blends the pen color into the scanlines of the image the painter is drawing on, at a cost
+  close to aliased drawing.
+  
+  The rasterizer is only valid (\ref isValid) if the painter
+  \li draws on a \c QImage with format \c QImage::Format_ARGB32_Premultiplied and device pixel
+  ratio 1, e.g. the paint buffers created with \ref QCP::phFastAntialiasedLines,
+  \li isn't vectorized (\ref QCPPainter::pmVectorized) and uses \c QPainter::CompositionMode_SourceOver,
+  \li has a transform without rotation or shear, and
+  \li has a solid pen with solid color brush and a width of up to three pixels.
+  
+  Otherwise, the regular QPainter methods must be used. The static \ref drawPolyline does this
+  check, and returns whether it could draw the line.
+  
+  Created with \ref csBrush, the rasterizer instead fills spans of pixel columns with the brush
+  color (\ref fillSpan), which \ref QCPGraph uses for antialiased fills of dense lines.
+  
+  Line segments are drawn with flat caps and without joins. Lines are clipped to the bounding
+  rect of the painter's clip region.
+*/
+
+/*!
+  Creates a line rasterizer which draws with the current pen (or the brush, if \a source is \ref
+  csBrush), transform and clipping of \a painter. Check \ref isValid before drawing.
+  
+  In the \ref csBrush mode, the rasterizer requires a solid brush instead of the pen requirements
+  given in the class description, and a transform that is at most a translation by whole pixels.
+  
+  The rasterizer doesn't follow later state changes of \a painter.
+*/
+QCPLineRasterizer::QCPLineRasterizer(QCPPainter *painter, ColorSource source) :
+  mImage(0),
+  mBits(0),
+  mBytesPerLine(0),
+  mWidth(1),
+  mColor(0)
+{
+  if (!painter || !painter->isActive() || !painter->device() || painter->device()->devType() != QInternal::Image)
+    return;
+  QImage *image = static_cast<QImage*>(painter->device());
+  if (image->format() != QImage::Format_ARGB32_Premultiplied || image->isNull())
+    return;
+#ifdef QCP_DEVICEPIXELRATIO_SUPPORTED
+  if (!qFuzzyCompare(image->devicePixelRatio(), 1.0))
+    return;
+#endif
+  if (painter->modes().testFlag(QCPPainter::pmVectorized) || painter->compositionMode() != QPainter::CompositionMode_SourceOver)
+    return;
+  mTransform = painter->combinedTransform();
+  QColor color;
+  if (source == csBrush)
+  {
+    const QBrush brush = painter->brush();
+    if (brush.style() != Qt::SolidPattern)
+      return;
+    if (mTransform.type() > QTransform::TxTranslate || mTransform.dx() != qRound(mTransform.dx()) || mTransform.dy() != qRound(mTransform.dy()))
+      return;
+    color = brush.color();
+  } else
+  {
+    const QPen pen = painter->pen();
+    if (pen.style() != Qt::SolidLine || pen.brush().style() != Qt::SolidPattern)
+      return;
+    if (mTransform.type() > QTransform::TxScale || !qFuzzyCompare(qAbs(mTransform.m11()), qAbs(mTransform.m22())))
+      return;
+    mWidth = qMax(1.0, pen.widthF());
+    if (!pen.isCosmetic() && pen.widthF() > 0)
+      mWidth = pen.widthF()*qAbs(mTransform.m11());
+    if (mWidth > 3.0)
+      return;
+    color = pen.color();
+  }
+  
+  const int alpha = qRound(color.alphaF()*painter->opacity()*255);
+  if (alpha <= 0)
+    return;
+  mColor = qcpByteMul(0xff000000 | (color.red() << 16) | (color.green() << 8) | color.blue(), alpha);
+  mClip = image->rect();
+  if (painter->hasClipping())
+    mClip &= mTransform.mapRect(painter->clipBoundingRect()).toAlignedRect();
+  mImage = image;
+  mBits = image->bits();
+  mBytesPerLine = image->bytesPerLine();
+}
+
+/*!
+  Draws the line from \a p1 to \a p2 (in the logical coordinates of the painter). Lines with NaN
+  or infinite coordinates are not drawn.
+*/
+void QCPLineRasterizer::drawLine(const QPointF &p1, const QPointF &p2)
+{
+  if (!mImage || mClip.isEmpty())
+    return;
+  QPointF a = mTransform.map(p1);
+  QPointF b = mTransform.map(p2);
+  if (!qIsFinite(a.x()) || !qIsFinite(a.y()) || !qIsFinite(b.x()) || !qIsFinite(b.y()))
+    return;
+  
+  // work in (major, minor) coordinates, so the line is never steeper than 45 degrees:
+  const bool transposed = qAbs(b.y()-a.y()) > qAbs(b.x()-a.x());
+  if (transposed)
+  {
+    a = QPointF(a.y(), a.x());
+    b = QPointF(b.y(), b.x());
+  }
+  if (a.x() > b.x())
+    qSwap(a, b);
+  const double length = b.x()-a.x();
+  if (length < 1e-9)
+    return;
+  
+  const int majorLower = transposed ? mClip.top() : mClip.left();
+  const int majorUpper = transposed ? mClip.bottom() : mClip.right();
+  const int minorLower = transposed ? mClip.left() : mClip.top();
+  const int minorUpper = transposed ? mClip.right() : mClip.bottom();
+  const double slope = (b.y()-a.y())/length;
+  const double halfThickness = 0.5*mWidth*qSqrt(1.0+slope*slope); // thickness of the line along the minor axis
+  
+  // clip in floating point first, so far off-screen coordinates don't overflow the integer conversions:
+  double majorBegin = qMax(a.x(), (double)majorLower);
+  double majorEnd = qMin(b.x(), majorUpper+1.0);
+  if (slope != 0) // restrict to where the line is within the minor clip bounds
+  {
+    const double minorBeginMajor = a.x()+(minorLower-halfThickness-a.y())/slope;
+    const double minorEndMajor = a.x()+(minorUpper+1.0+halfThickness-a.y())/slope;
+    majorBegin = qMax(majorBegin, qMin(minorBeginMajor, minorEndMajor)-1.0);
+    majorEnd = qMin(majorEnd, qMax(minorBeginMajor, minorEndMajor)+1.0);
+  } else if (a.y()+halfThickness < minorLower || a.y()-halfThickness > minorUpper+1.0)
+    return;
+  if (!(majorBegin < majorEnd)) // also catches NaN from overflowing intermediate results
+    return;
+  const int first = qFloor(majorBegin);
+  const int last = qMin(qFloor(majorEnd), majorUpper);
+  for (int major=first; major<=last; ++major)
+  {
+    // the part of this pixel column covered by the segment, so consecutive segments share boundary columns:
+    const double columnBegin = qMax((double)major, a.x());
+    const double columnEnd = qMin(major+1.0, b.x());
+    const double majorCoverage = columnEnd-columnBegin;
+    if (majorCoverage <= 0)
+      continue;
+    const double center = a.y()+slope*((columnBegin+columnEnd)*0.5-a.x());
+    if (!qIsFinite(center))
+      continue;
+    const double top = center-halfThickness;
+    const double bottom = center+halfThickness;
+    const int minorBegin = qFloor(qMax(top, (double)minorLower));
+    const int minorEnd = qFloor(qMin(bottom, (double)minorUpper));
+    if (minorBegin <= minorEnd)
+      blendSpan(major, minorBegin, minorEnd, top, bottom, majorCoverage, transposed);
+  }
+}
+
+/*!
+  Draws a polyline through the \a pointCount points starting at \a points. Segments with NaN or
+  infinite end points are left out, so they create gaps in the line.
+*/
+void QCPLineRasterizer::drawPolyline(const QPointF *points, int pointCount)
+{
+  for (int i=1; i<pointCount; ++i)
+    drawLine(points[i-1], points[i]);
+}
+
+/*!
+  Draws a polyline through the \a pointCount points starting at \a points with \a painter, if the
+  requirements of the rasterizer are met (see the class description). Returns false, without
+  drawing anything, if they aren't met.
+*/
+bool QCPLineRasterizer::drawPolyline(QCPPainter *painter, const QPointF *points, int pointCount)
+{
+  QCPLineRasterizer rasterizer(painter);
+  if (!rasterizer.isValid())
+    return false;
+  rasterizer.drawPolyline(points, pointCount);
+  return true;
+}
+
+/*!
+  Fills the pixel column \a column (or row, if \a transposed), given in the logical coordinates of
+  the painter, from \a lower to \a upper with the brush color. The pixels at the ends of the span
+  are blended with the fraction of them that is covered, and the whole span with \a
+  columnCoverage, the fraction of the column width that is covered. This antialiases fills which
+  were reduced to one span per pixel column.
+  
+  Requires the rasterizer to be created with \ref csBrush.
+*/
+void QCPLineRasterizer::fillSpan(int column, double lower, double upper, double columnCoverage, bool transposed)
+{
+  if (!mImage || mClip.isEmpty() || !(lower < upper) || columnCoverage <= 0)
+    return;
+  const int major = column+qRound(transposed ? mTransform.dy() : mTransform.dx());
+  if (major < (transposed ? mClip.top() : mClip.left()) || major > (transposed ? mClip.bottom() : mClip.right()))
+    return;
+  const int minorLower = transposed ? mClip.left() : mClip.top();
+  const int minorUpper = transposed ? mClip.right() : mClip.bottom();
+  const double minorOffset = transposed ? mTransform.dx() : mTransform.dy();
+  const double top = lower+minorOffset;
+  const double bottom = upper+minorOffset;
+  const int minorBegin = qFloor(qMax(top, (double)minorLower));
+  const int minorEnd = qFloor(qMin(bottom, (double)minorUpper));
+  if (minorBegin <= minorEnd)
+    blendSpan(major, minorBegin, minorEnd, top, bottom, qMin(1.0, columnCoverage), transposed);
+}
+
+/*! \internal
+  
+  Blends the pen (or brush) color into the pixels \a minorBegin to \a minorEnd (inclusive) of the pixel
+  column (or row, if \a transposed) \a major. The line covers the minor interval from \a minorTop
+  to \a minorBottom and the fraction \a majorCoverage of the column.
+*/
+void QCPLineRasterizer::blendSpan(int major, int minorBegin, int minorEnd, double minorTop, double minorBottom, double majorCoverage, bool transposed)
+{
+  for (int minor=minorBegin; minor<=minorEnd; ++minor)
+  {
+    const double coverage = (qMin(minor+1.0, minorBottom)-qMax((double)minor, minorTop))*majorCoverage;
+    const quint32 alpha = (quint32)qBound(0, qRound(coverage*255), 255);
+    if (alpha == 0)
+      continue;
+    quint32 *pixel = transposed ? reinterpret_cast<quint32*>(mBits+major*mBytesPerLine)+minor : reinterpret_cast<quint32*>(mBits+minor*mBytesPerLine)+major;
+    const quint32 source = qcpByteMul(mColor, alpha);
+    *pixel = source + qcpByteMul(*pixel, 255-(source >> 24));
+  }
+}
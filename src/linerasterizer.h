@@ -0,0 +1,68 @@
+/***************************************************************************
+**                                                                        **
+**  QCustomPlot, an easy to use, modern plotting widget for Qt            **
+**  Copyright (C) 2011-2017 Emanuel Eichhammer                            **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+****************************************************************************
+**           Author: Emanuel Eichhammer                                   **
+**  Website/Contact: http://www.qcustomplot.com/                          **
+**             Date: 04.09.17                                             **
+**          Version: 2.0.0                                                **
+****************************************************************************/
+/*! \file */
+#ifndef QCP_LINERASTERIZER_H
+#define QCP_LINERASTERIZER_H
+
+#include "global.h"
+
+class QCPPainter;
+
+class QCP_LIB_DECL QCPLineRasterizer
+{
+public:
+  /*!
+    Defines which color of the painter the rasterizer draws with.
+  */
+  enum ColorSource { csPen   ///< lines are drawn with the pen of the painter (\ref drawLine, \ref drawPolyline)
+                     ,csBrush ///< spans are filled with the brush of the painter (\ref fillSpan)
+                   };
+  
+  QCPLineRasterizer(QCPPainter *painter, ColorSource source=csPen);
+  
+  // getters:
+  bool isValid() const { return mImage != 0; }
+  
+  // non-property methods:
+  void drawLine(const QPointF &p1, const QPointF &p2);
+  void drawPolyline(const QPointF *points, int pointCount);
+  static bool drawPolyline(QCPPainter *painter, const QPointF *points, int pointCount);
+  void fillSpan(int column, double lower, double upper, double columnCoverage, bool transposed);
+  
+protected:
+  // non-property members:
+  QImage *mImage;
+  uchar *mBits;
+  int mBytesPerLine;
+  QTransform mTransform;
+  QRect mClip;
+  double mWidth;
+  quint32 mColor;
+  
+  // non-virtual methods:
+  void blendSpan(int major, int minorBegin, int minorEnd, double minorTop, double minorBottom, double majorCoverage, bool transposed);
+};
+
+#endif // QCP_LINERASTERIZER_H
@@ -162,6 +162,50 @@ void QCPAbstractPaintBuffer::setInvalidated(bool invalidated)
   mInvalidated = invalidated;
 }
 
+/*!
+  Shifts the contents of this buffer inside \a rect by \a delta pixels, and fills the part of \a
+  rect that was uncovered by the shift with \c Qt::transparent. Contents outside of \a rect are
+  not changed.
+  
+  This is used by QCustomPlot to reuse the previous frame while the user drags the axis ranges, see
+  \ref QCPAxisRect::setRangeDragBlitting. Only the uncovered strip then needs to be drawn again.
+  
+  Returns true if the contents were shifted. The default implementation does nothing and returns
+  false, which means the buffer doesn't support shifting and must be redrawn entirely.
+  
+  This method must not be called if there is currently a painter (acquired with \ref
+  startPainting) active.
+*/
+bool QCPAbstractPaintBuffer::scroll(const QRect &rect, const QPoint &delta)
+{
+  Q_UNUSED(rect)
+  Q_UNUSED(delta)
+  return false;
+}
+
+/*!
+  Replaces the contents of this buffer inside \a rect with the previous contents, mapped by \a
+  transform (in pixel coordinates) and clipped to \a rect. Parts of \a rect that aren't covered by
+  the mapped contents are filled with \c Qt::transparent. Contents outside of \a rect are not
+  changed.
+  
+  Unlike \ref scroll, this generally requires resampling, so the result is only an approximation
+  of what a redraw would produce. QCustomPlot uses it to show a quick preview while the user zooms
+  the axis ranges, see \ref QCPAxisRect::setRangeZoomPreviewDelay.
+  
+  Returns true if the contents were mapped. The default implementation does nothing and returns
+  false, which means the buffer doesn't support this and must be redrawn entirely.
+  
+  This method must not be called if there is currently a painter (acquired with \ref
+  startPainting) active.
+*/
+bool QCPAbstractPaintBuffer::warp(const QRect &rect, const QTransform &transform)
+{
+  Q_UNUSED(rect)
+  Q_UNUSED(transform)
+  return false;
+}
+
 /*!
   Sets the the device pixel ratio to \a ratio. This is useful to render on high-DPI output devices.
   The ratio is automatically set to the device pixel ratio used by the parent QCustomPlot instance.
@@ -233,6 +277,40 @@ void QCPPaintBufferPixmap::clear(const QColor &color)
   mBuffer.fill(color);
 }
 
+/* inherits documentation from base class */
+bool QCPPaintBufferPixmap::scroll(const QRect &rect, const QPoint &delta)
+{
+  if (delta.isNull())
+    return true;
+  const QPointF deviceDelta = QPointF(delta)*mDevicePixelRatio;
+  if (deviceDelta != QPointF(deviceDelta.toPoint())) // fractional device pixel shifts can't be done without resampling
+    return false;
+  const QRect deviceRect(rect.topLeft()*mDevicePixelRatio, rect.size()*mDevicePixelRatio);
+  mBuffer.scroll(deviceDelta.toPoint().x(), deviceDelta.toPoint().y(), deviceRect);
+  
+  QPainter painter(&mBuffer);
+  painter.setCompositionMode(QPainter::CompositionMode_Source);
+  painter.setClipRegion(QRegion(rect).subtracted(QRegion(rect.translated(delta))));
+  painter.fillRect(rect, Qt::transparent);
+  return true;
+}
+
+/* inherits documentation from base class */
+bool QCPPaintBufferPixmap::warp(const QRect &rect, const QTransform &transform)
+{
+  const QRect deviceRect(rect.topLeft()*mDevicePixelRatio, rect.size()*mDevicePixelRatio);
+  const QPixmap source = mBuffer.copy(deviceRect);
+  
+  QPainter painter(&mBuffer);
+  painter.setCompositionMode(QPainter::CompositionMode_Source);
+  painter.setClipRect(rect);
+  painter.fillRect(rect, Qt::transparent);
+  painter.setRenderHint(QPainter::SmoothPixmapTransform);
+  painter.setTransform(transform);
+  painter.drawPixmap(QRectF(rect), source, QRectF(source.rect()));
+  return true;
+}
+
 /* inherits documentation from base class */
 void QCPPaintBufferPixmap::reallocateBuffer()
 {
@@ -254,6 +332,112 @@ void QCPPaintBufferPixmap::reallocateBuffer()
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////// QCPPaintBufferImage
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*! \class QCPPaintBufferImage
+  \brief A paint buffer based on QImage, using software raster rendering
+
+  This paint buffer uses a QImage with format \c QImage::Format_ARGB32_Premultiplied as internal
+  buffer. Unlike a QPixmap, its pixels can be accessed directly while painting, which allows \ref
+  QCPLineRasterizer to draw antialiased lines without going through QPainter. It is used instead of
+  \ref QCPPaintBufferPixmap if the plotting hint \ref QCP::phFastAntialiasedLines is set.
+*/
+
+/*!
+  Creates an image paint buffer instance with the specified \a size and \a devicePixelRatio, if
+  applicable.
+*/
+QCPPaintBufferImage::QCPPaintBufferImage(const QSize &size, double devicePixelRatio) :
+  QCPAbstractPaintBuffer(size, devicePixelRatio)
+{
+  QCPPaintBufferImage::reallocateBuffer();
+}
+
+QCPPaintBufferImage::~QCPPaintBufferImage()
+{
+}
+
+/* inherits documentation from base class */
+QCPPainter *QCPPaintBufferImage::startPainting()
+{
+  QCPPainter *result = new QCPPainter(&mBuffer);
+  result->setRenderHint(QPainter::HighQualityAntialiasing);
+  return result;
+}
+
+/* inherits documentation from base class */
+void QCPPaintBufferImage::draw(QCPPainter *painter) const
+{
+  if (painter && painter->isActive())
+    painter->drawImage(0, 0, mBuffer);
+  else
+    qDebug() << Q_FUNC_INFO << "invalid or inactive painter passed";
+}
+
+/* inherits documentation from base class */
+void QCPPaintBufferImage::clear(const QColor &color)
+{
+  mBuffer.fill(color);
+}
+
+/* inherits documentation from base class */
+bool QCPPaintBufferImage::scroll(const QRect &rect, const QPoint &delta)
+{
+  if (delta.isNull())
+    return true;
+  const QPointF deviceDelta = QPointF(delta)*mDevicePixelRatio;
+  if (deviceDelta != QPointF(deviceDelta.toPoint())) // fractional device pixel shifts can't be done without resampling
+    return false;
+  const QRect deviceRect(rect.topLeft()*mDevicePixelRatio, rect.size()*mDevicePixelRatio);
+  const QImage source = mBuffer.copy(deviceRect);
+  
+  QPainter painter(&mBuffer);
+  painter.setCompositionMode(QPainter::CompositionMode_Source);
+  painter.setClipRect(rect);
+  painter.fillRect(rect, Qt::transparent);
+  painter.drawImage(QRectF(rect.translated(delta)), source);
+  return true;
+}
+
+/* inherits documentation from base class */
+bool QCPPaintBufferImage::warp(const QRect &rect, const QTransform &transform)
+{
+  const QRect deviceRect(rect.topLeft()*mDevicePixelRatio, rect.size()*mDevicePixelRatio);
+  const QImage source = mBuffer.copy(deviceRect);
+  
+  QPainter painter(&mBuffer);
+  painter.setCompositionMode(QPainter::CompositionMode_Source);
+  painter.setClipRect(rect);
+  painter.fillRect(rect, Qt::transparent);
+  painter.setRenderHint(QPainter::SmoothPixmapTransform);
+  painter.setTransform(transform);
+  painter.drawImage(QRectF(rect), source, QRectF(source.rect()));
+  return true;
+}
+
+/* inherits documentation from base class */
+void QCPPaintBufferImage::reallocateBuffer()
+{
+  setInvalidated();
+  if (!qFuzzyCompare(1.0, mDevicePixelRatio))
+  {
+#ifdef QCP_DEVICEPIXELRATIO_SUPPORTED
+    mBuffer = QImage(mSize*mDevicePixelRatio, QImage::Format_ARGB32_Premultiplied);
+    mBuffer.setDevicePixelRatio(mDevicePixelRatio);
+#else
+    qDebug() << Q_FUNC_INFO << "Device pixel ratios not supported for Qt versions before 5.4";
+    mDevicePixelRatio = 1.0;
+    mBuffer = QImage(mSize, QImage::Format_ARGB32_Premultiplied);
+#endif
+  } else
+  {
+    mBuffer = QImage(mSize, QImage::Format_ARGB32_Premultiplied);
+  }
+}
+
+
 #ifdef QCP_OPENGL_PBUFFER
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////// QCPPaintBufferGlPbuffer
@@ -51,6 +51,8 @@ public:
   virtual void donePainting() {}
   virtual void draw(QCPPainter *painter) const = 0;
   virtual void clear(const QColor &color) = 0;
+  virtual bool scroll(const QRect &rect, const QPoint &delta);
+  virtual bool warp(const QRect &rect, const QTransform &transform);
   
 protected:
   // property members:
@@ -75,6 +77,8 @@ public:
   virtual QCPPainter *startPainting() Q_DECL_OVERRIDE;
   virtual void draw(QCPPainter *painter) const Q_DECL_OVERRIDE;
   void clear(const QColor &color) Q_DECL_OVERRIDE;
+  virtual bool scroll(const QRect &rect, const QPoint &delta) Q_DECL_OVERRIDE;
+  virtual bool warp(const QRect &rect, const QTransform &transform) Q_DECL_OVERRIDE;
   
 protected:
   // non-property members:
@@ -85,6 +89,28 @@ protected:
 };
 
 
+class QCP_LIB_DECL QCPPaintBufferImage : public QCPAbstractPaintBuffer
+{
+public:
+  explicit QCPPaintBufferImage(const QSize &size, double devicePixelRatio);
+  virtual ~QCPPaintBufferImage();
+  
+  // reimplemented virtual methods:
+  virtual QCPPainter *startPainting() Q_DECL_OVERRIDE;
+  virtual void draw(QCPPainter *painter) const Q_DECL_OVERRIDE;
+  void clear(const QColor &color) Q_DECL_OVERRIDE;
+  virtual bool scroll(const QRect &rect, const QPoint &delta) Q_DECL_OVERRIDE;
+  virtual bool warp(const QRect &rect, const QTransform &transform) Q_DECL_OVERRIDE;
+  
+protected:
+  // non-property members:
+  QImage mBuffer;
+  
+  // reimplemented virtual methods:
+  virtual void reallocateBuffer() Q_DECL_OVERRIDE;
+};
+
+
 #ifdef QCP_OPENGL_PBUFFER
 class QCP_LIB_DECL QCPPaintBufferGlPbuffer : public QCPAbstractPaintBuffer
 {
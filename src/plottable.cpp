@@ -391,6 +391,10 @@ bool QCPSelectionDecorator::registerWithPlottable(QCPAbstractPlottable *plottabl
   interaction or by a direct call to \ref setSelection. The parameter \a selected indicates whether
   there are any points selected or not.
   
+  It is not emitted while a selection change transaction is in progress (see \ref
+  QCustomPlot::beginSelectionChange), instead the plottable is reported by \ref
+  QCustomPlot::selectionChangeFinished.
+  
   \see selectionChanged(const QCPDataSelection &selection)
 */
 
@@ -400,6 +404,9 @@ bool QCPSelectionDecorator::registerWithPlottable(QCPAbstractPlottable *plottabl
   interaction or by a direct call to \ref setSelection. The parameter \a selection holds the
   currently selected data ranges.
   
+  Like \ref selectionChanged(bool selected), it is not emitted during a selection change
+  transaction.
+  
   \see selectionChanged(bool selected)
 */
 
@@ -433,7 +440,8 @@ QCPAbstractPlottable::QCPAbstractPlottable(QCPAxis *keyAxis, QCPAxis *valueAxis)
   mKeyAxis(keyAxis),
   mValueAxis(valueAxis),
   mSelectable(QCP::stWhole),
-  mSelectionDecorator(0)
+  mSelectionDecorator(0),
+  mConcurrentPreparation(false)
 {
   if (keyAxis->parentPlot() != valueAxis->parentPlot())
     qDebug() << Q_FUNC_INFO << "Parent plot of keyAxis is not the same as that of valueAxis.";
@@ -568,8 +576,7 @@ void QCPAbstractPlottable::setSelection(QCPDataSelection selection)
   if (mSelection != selection)
   {
     mSelection = selection;
-    emit selectionChanged(selected());
-    emit selectionChanged(mSelection);
+    notifySelectionChanged();
   }
 }
 
@@ -599,6 +606,23 @@ void QCPAbstractPlottable::setSelectionDecorator(QCPSelectionDecorator *decorato
   }
 }
 
+/*!
+  Sets whether the pixel geometry of this plottable may be prepared in a worker thread, when the
+  parent plot is replotted by a \ref QCPReplotCoordinator (see \ref prepareDraw). The default is
+  false, so all work happens on the GUI thread during drawing, as with a regular replot.
+  
+  Only enable this if the data and settings of the plottable aren't modified by other threads and
+  the plottable implementation supports it. This is the case for \ref QCPGraph, as long as the
+  graphs it uses as channel fill target (\ref QCPGraph::setChannelFillGraph) belong to the same
+  plot. The drawn result is the same either way.
+  
+  \see QCPReplotCoordinator::setThreadCount
+*/
+void QCPAbstractPlottable::setConcurrentPreparation(bool enabled)
+{
+  mConcurrentPreparation = enabled;
+}
+
 /*!
   Sets whether and to which granularity this plottable can be selected.
 
@@ -618,10 +642,7 @@ void QCPAbstractPlottable::setSelectable(QCP::SelectionType selectable)
     mSelection.enforceType(mSelectable);
     emit selectableChanged(mSelectable);
     if (mSelection != oldSelection)
-    {
-      emit selectionChanged(selected());
-      emit selectionChanged(mSelection);
-    }
+      notifySelectionChanged();
   }
 }
 
@@ -745,7 +766,7 @@ void QCPAbstractPlottable::rescaleKeyAxis(bool onlyEnlarge) const
     if (!QCPRange::validRange(newRange)) // likely due to range being zero (plottable has only constant data in this axis dimension), shift current range to at least center the plottable
     {
       double center = (newRange.lower+newRange.upper)*0.5; // upper and lower should be equal anyway, but just to make sure, incase validRange returned false for other reason
-      if (keyAxis->scaleType() == QCPAxis::stLinear)
+      if (keyAxis->scaleType() != QCPAxis::stLogarithmic)
       {
         newRange.lower = center-keyAxis->range().size()/2.0;
         newRange.upper = center+keyAxis->range().size()/2.0;
@@ -788,7 +809,7 @@ void QCPAbstractPlottable::rescaleValueAxis(bool onlyEnlarge, bool inKeyRange) c
     if (!QCPRange::validRange(newRange)) // likely due to range being zero (plottable has only constant data in this axis dimension), shift current range to at least center the plottable
     {
       double center = (newRange.lower+newRange.upper)*0.5; // upper and lower should be equal anyway, but just to make sure, incase validRange returned false for other reason
-      if (valueAxis->scaleType() == QCPAxis::stLinear)
+      if (valueAxis->scaleType() != QCPAxis::stLogarithmic)
       {
         newRange.lower = center-valueAxis->range().size()/2.0;
         newRange.upper = center+valueAxis->range().size()/2.0;
@@ -924,6 +945,23 @@ void QCPAbstractPlottable::applyDefaultAntialiasingHint(QCPPainter *painter) con
   applyAntialiasingHint(painter, mAntialiased, QCP::aePlottables);
 }
 
+/*! \internal
+
+  Called by \ref QCPReplotCoordinator during a coordinated replot, after the layout of the parent
+  plot was updated and before any layer is drawn. Subclasses may reimplement this method to compute
+  and cache the pixel geometry which their \ref draw implementation needs, so that this work is
+  done concurrently for the plots of a dashboard.
+
+  This method is only called if \ref setConcurrentPreparation is enabled, and then from a worker
+  thread. The plottables of one QCustomPlot are always prepared sequentially in the same thread,
+  but the implementation must not touch anything outside its own parent plot and must not draw.
+
+  The default implementation does nothing.
+*/
+void QCPAbstractPlottable::prepareDraw()
+{
+}
+
 /*! \internal
 
   A convenience function to easily set the QPainter::Antialiased hint on the provided \a painter
@@ -956,6 +994,23 @@ void QCPAbstractPlottable::applyScattersAntialiasingHint(QCPPainter *painter) co
   applyAntialiasingHint(painter, mAntialiasedScatters, QCP::aeScatters);
 }
 
+/*! \internal
+
+  Emits the \ref selectionChanged signals, or registers the change with the parent plot if a
+  selection change transaction is in progress (see \ref QCustomPlot::beginSelectionChange).
+*/
+void QCPAbstractPlottable::notifySelectionChanged()
+{
+  if (mParentPlot && mParentPlot->isChangingSelection())
+  {
+    mParentPlot->registerSelectionChange(this);
+  } else
+  {
+    emit selectionChanged(selected());
+    emit selectionChanged(mSelection);
+  }
+}
+
 /* inherits documentation from base class */
 void QCPAbstractPlottable::selectEvent(QMouseEvent *event, bool additive, const QVariant &details, bool *selectionStateChanged)
 {
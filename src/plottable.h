@@ -100,6 +100,7 @@ class QCP_LIB_DECL QCPAbstractPlottable : public QCPLayerable
   Q_PROPERTY(QCP::SelectionType selectable READ selectable WRITE setSelectable NOTIFY selectableChanged)
   Q_PROPERTY(QCPDataSelection selection READ selection WRITE setSelection NOTIFY selectionChanged)
   Q_PROPERTY(QCPSelectionDecorator* selectionDecorator READ selectionDecorator WRITE setSelectionDecorator)
+  Q_PROPERTY(bool concurrentPreparation READ concurrentPreparation WRITE setConcurrentPreparation)
   /// \endcond
 public:
   QCPAbstractPlottable(QCPAxis *keyAxis, QCPAxis *valueAxis);
@@ -117,6 +118,7 @@ public:
   bool selected() const { return !mSelection.isEmpty(); }
   QCPDataSelection selection() const { return mSelection; }
   QCPSelectionDecorator *selectionDecorator() const { return mSelectionDecorator; }
+  bool concurrentPreparation() const { return mConcurrentPreparation; }
   
   // setters:
   void setName(const QString &name);
@@ -129,6 +131,7 @@ public:
   Q_SLOT void setSelectable(QCP::SelectionType selectable);
   Q_SLOT void setSelection(QCPDataSelection selection);
   void setSelectionDecorator(QCPSelectionDecorator *decorator);
+  void setConcurrentPreparation(bool enabled);
 
   // introduced virtual methods:
   virtual double selectTest(const QPointF &pos, bool onlySelectable, QVariant *details=0) const = 0;
@@ -164,6 +167,7 @@ protected:
   QCP::SelectionType mSelectable;
   QCPDataSelection mSelection;
   QCPSelectionDecorator *mSelectionDecorator;
+  bool mConcurrentPreparation;
   
   // reimplemented virtual methods:
   virtual QRect clipRect() const Q_DECL_OVERRIDE;
@@ -176,10 +180,12 @@ protected:
   
   // introduced virtual methods:
   virtual void drawLegendIcon(QCPPainter *painter, const QRectF &rect) const = 0;
+  virtual void prepareDraw();
   
   // non-virtual methods:
   void applyFillAntialiasingHint(QCPPainter *painter) const;
   void applyScattersAntialiasingHint(QCPPainter *painter) const;
+  void notifySelectionChanged();
 
 private:
   Q_DISABLE_COPY(QCPAbstractPlottable)
@@ -187,6 +193,7 @@ private:
   friend class QCustomPlot;
   friend class QCPAxis;
   friend class QCPPlottableLegendItem;
+  friend class QCPReplotCoordinatorJob;
 };
 
 
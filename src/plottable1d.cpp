@@ -27,6 +27,7 @@
 
 #include "painter.h"
 #include "core.h"
+#include "linerasterizer.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////// QCPPlottableInterface1D
@@ -492,20 +493,35 @@ void QCPAbstractPlottable1D<DataType>::getDataSegments(QList<QCPDataRange> &sele
 
   Further it uses a faster line drawing technique based on \ref QCPPainter::drawLine rather than \c
   QPainter::drawPolyline if the configured \ref QCustomPlot::setPlottingHints() and \a painter
-  style allows.
+  style allows. In that case, if the data container's gap index (\ref
+  QCPDataContainer::setGapIndexEnabled) shows that the data has no gaps, the NaN checks for each
+  point are skipped.
+  
+  If antialiasing is enabled and the painter draws on an image paint buffer (see \ref
+  QCP::phFastAntialiasedLines), thin solid lines are drawn with \ref QCPLineRasterizer instead.
 */
 template <class DataType>
 void QCPAbstractPlottable1D<DataType>::drawPolyline(QCPPainter *painter, const QVector<QPointF> &lineData) const
 {
+  // antialiased thin solid lines on image paint buffers are rasterized directly into the buffer:
+  if (painter->antialiasing() && QCPLineRasterizer::drawPolyline(painter, lineData.constData(), lineData.size()))
+    return;
+  
   // if drawing solid line and not in PDF, use much faster line drawing instead of polyline:
   if (mParentPlot->plottingHints().testFlag(QCP::phFastPolylines) &&
       painter->pen().style() == Qt::SolidLine &&
       !painter->modes().testFlag(QCPPainter::pmVectorized) &&
       !painter->modes().testFlag(QCPPainter::pmNoCaching))
   {
+    const int lineDataSize = lineData.size();
+    if (DataType::sortKeyIsMainKey() && mDataContainer->gapIndexEnabled() && mDataContainer->gapCount() == 0) // keys are sorted, so can't be NaN either
+    {
+      for (int i=1; i<lineDataSize; ++i)
+        painter->drawLine(lineData.at(i-1), lineData.at(i));
+      return;
+    }
     int i = 0;
     bool lastIsNan = false;
-    const int lineDataSize = lineData.size();
     while (i < lineDataSize && (qIsNaN(lineData.at(i).y()) || qIsNaN(lineData.at(i).x()))) // make sure first point is not NaN
       ++i;
     ++i; // because drawing works in 1 point retrospect
@@ -0,0 +1,668 @@
+/***************************************************************************
+**                                                                        **
+**  QCustomPlot, an easy to use, modern plotting widget for Qt            **
+**  Copyright (C) 2011-2017 Emanuel Eichhammer                            **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+****************************************************************************
+**           Author: Emanuel Eichhammer                                   **
+**  Website/Contact: http://www.qcustomplot.com/                          **
+**             Date: 04.09.17                                             **
+**          Version: 2.0.0                                                **
+****************************************************************************/
+
+#include "plottable-asyncgraph.h"
+
+#include "../painter.h"
+#include "../core.h"
+#include "../axis/axis.h"
+#include "../layoutelements/layoutelement-axisrect.h"
+
+/*! \internal
+  
+  Runnable which executes one fetch job of a \ref QCPAbstractDataProvider on the provider's
+  background thread.
+*/
+class QCPDataProviderJob : public QRunnable
+{
+public:
+  QCPDataProviderJob(QCPAbstractDataProvider *provider, const QCPAbstractDataProvider::Job &job, quint64 generation) :
+    mProvider(provider),
+    mJob(job),
+    mGeneration(generation)
+  {}
+  virtual void run() Q_DECL_OVERRIDE { mProvider->runJob(mJob, mGeneration); }
+private:
+  QCPAbstractDataProvider *mProvider;
+  QCPAbstractDataProvider::Job mJob;
+  quint64 mGeneration;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////// QCPAbstractDataProvider
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*! \class QCPAbstractDataProvider
+  \brief The abstract base class for asynchronous data sources of \ref QCPAsyncGraph
+
+  A data provider supplies the data of a \ref QCPAsyncGraph on demand, for data that is too large
+  to be held in memory or that is slow to access, e.g. because it resides on disk or is served by
+  a remote service. The data is loaded on a background thread, so panning and zooming never block
+  the user interface.
+
+  Whenever the graph is drawn, it calls \ref requestRange with the visible key range. The provider
+  then loads the visible range, extended by the \ref setMargin on both sides and additionally by
+  the \ref setPrefetch in the direction the user is currently panning, unless the already resident
+  data covers it. Until the new data arrives, the graph draws what is resident: the previously
+  loaded range if it covers the visible range, or else a coarse overview of the whole data, which
+  is loaded first (see \ref setOverviewPointCount). When a job finishes, \ref dataArrived is
+  emitted and the graph queues a replot. At most one job is loaded at a time; requests made while
+  loading replace each other, so only the most recent one is loaded next.
+
+  To implement a data provider, subclass QCPAbstractDataProvider and reimplement \ref keyRange and
+  \ref fetch. \ref fetch is called on the background thread, so it must not access the GUI or
+  unprotected state shared with the GUI thread. The destructor of QCPAbstractDataProvider waits
+  for a running fetch to finish. Since the members of a subclass are already destroyed at that
+  point, subclasses whose \ref fetch accesses own members should call \c mThreadPool.waitForDone()
+  in their destructor as well, like \ref QCPBinaryFileDataProvider does.
+
+  \see QCPBinaryFileDataProvider
+*/
+
+/* start of documentation of pure virtual functions */
+
+/*! \fn QCPRange QCPAbstractDataProvider::keyRange(bool &foundRange) const = 0;
+
+  Returns the key range of all data available from this provider. \a foundRange is set to whether
+  there is any data. This is called on the GUI thread, e.g. by \ref QCPAbstractPlottable::rescaleAxes.
+*/
+
+/*! \fn QVector<QCPGraphData> QCPAbstractDataProvider::fetch(const QCPRange &keyRange, int maxPoints) const = 0;
+
+  Returns the data in \a keyRange, sorted by key, including one data point beyond each end of the
+  range if available. If there are more than \a maxPoints data points in the range, the data shall
+  be reduced to at most \a maxPoints points, preserving the visual envelope (e.g. by emitting the
+  minimum and maximum of consecutive groups of data points). Returning fewer than \a maxPoints
+  points indicates that the returned data is complete for \a keyRange, i.e. zooming in further
+  doesn't require another fetch.
+
+  This method is called on a background thread.
+*/
+
+/* end of documentation of pure virtual functions */
+/* start of documentation of signals */
+
+/*! \fn void QCPAbstractDataProvider::dataArrived()
+
+  This signal is emitted on the GUI thread when a background fetch has finished and its data is
+  available via \ref dataForRange.
+*/
+
+/* end of documentation of signals */
+
+/*!
+  Creates a data provider with a margin of 0.5, a prefetch of 1.0 and 4096 overview points.
+*/
+QCPAbstractDataProvider::QCPAbstractDataProvider(QObject *parent) :
+  QObject(parent),
+  mMargin(0.5),
+  mPrefetch(1.0),
+  mOverviewPointCount(4096),
+  mResidentComplete(false),
+  mLoading(false),
+  mHasPendingJob(false),
+  mOverviewRequested(false),
+  mGeneration(0),
+  mFinishedGeneration(0)
+{
+  mThreadPool.setMaxThreadCount(1);
+  mCurrentJob.maxPoints = 0;
+  mCurrentJob.overview = false;
+  mPendingJob = mCurrentJob;
+}
+
+QCPAbstractDataProvider::~QCPAbstractDataProvider()
+{
+  mThreadPool.waitForDone(); // a result arriving after destruction is dropped, because queued calls to destroyed objects are discarded
+}
+
+/*!
+  Sets the margin which is loaded on both sides of the visible key range, as a fraction of the
+  visible range size. A margin allows small pans and zooms without loading new data.
+*/
+void QCPAbstractDataProvider::setMargin(double margin)
+{
+  mMargin = qMax(0.0, margin);
+}
+
+/*!
+  Sets the additional range which is loaded in the direction the user is panning, as a fraction of
+  the visible range size. The direction is determined from consecutive calls of \ref requestRange
+  with equally sized ranges.
+*/
+void QCPAbstractDataProvider::setPrefetch(double prefetch)
+{
+  mPrefetch = qMax(0.0, prefetch);
+}
+
+/*!
+  Sets the number of data points of the coarse overview over the whole key range, which is loaded
+  first and drawn while the data for the visible range isn't resident yet.
+*/
+void QCPAbstractDataProvider::setOverviewPointCount(int count)
+{
+  mOverviewPointCount = qMax(2, count);
+}
+
+/*!
+  Requests the data for \a visibleRange, displayed on \a pixelWidth pixels. If the resident data
+  doesn't cover the visible range with its margins at sufficient resolution, a background fetch
+  is started (or queued, if a fetch is already running). This method returns immediately.
+
+  \see dataForRange
+*/
+void QCPAbstractDataProvider::requestRange(const QCPRange &visibleRange, int pixelWidth)
+{
+  if (pixelWidth <= 0 || visibleRange.size() <= 0)
+    return;
+  
+  // the coarse overview is loaded first, so something can be drawn as early as possible:
+  if (!mOverviewRequested && !mLoading)
+  {
+    bool foundRange = false;
+    const QCPRange fullRange = keyRange(foundRange);
+    if (foundRange)
+    {
+      mOverviewRequested = true;
+      Job overviewJob;
+      overviewJob.range = fullRange;
+      overviewJob.maxPoints = mOverviewPointCount;
+      overviewJob.overview = true;
+      startJob(overviewJob);
+    }
+  }
+  
+  // extend by margins and prefetch in pan direction:
+  const double size = visibleRange.size();
+  double lowerExtension = mMargin*size;
+  double upperExtension = mMargin*size;
+  if (mLastVisibleRange.size() > 0 && qAbs(mLastVisibleRange.size()-size) <= size*1e-9) // range was panned, not zoomed
+  {
+    if (visibleRange.center() > mLastVisibleRange.center())
+      upperExtension += mPrefetch*size;
+    else if (visibleRange.center() < mLastVisibleRange.center())
+      lowerExtension += mPrefetch*size;
+  }
+  mLastVisibleRange = visibleRange;
+  
+  // only fetch once the resident data doesn't cover at least half the margins anymore:
+  const QCPRange neededRange(visibleRange.lower-0.5*mMargin*size, visibleRange.upper+0.5*mMargin*size);
+  const int neededPoints = qMax(2, int(2.0*pixelWidth*neededRange.size()/size));
+  if (isSatisfied(neededRange, neededPoints))
+    return;
+  
+  Job job;
+  job.range = QCPRange(visibleRange.lower-lowerExtension, visibleRange.upper+upperExtension);
+  job.maxPoints = qMax(2, int(qMin(2.0*pixelWidth*job.range.size()/size, (double)std::numeric_limits<int>::max())));
+  job.overview = false;
+  if (mLoading)
+  {
+    if (!mCurrentJob.overview && mCurrentJob.range.contains(neededRange.lower) && mCurrentJob.range.contains(neededRange.upper) &&
+        mCurrentJob.maxPoints/mCurrentJob.range.size() >= 0.5*neededPoints/neededRange.size())
+    {
+      mHasPendingJob = false; // running job will satisfy request
+      return;
+    }
+    mPendingJob = job;
+    mHasPendingJob = true;
+  } else
+    startJob(job);
+}
+
+/*!
+  Returns the data to draw for \a visibleRange: the resident data if it covers the range,
+  otherwise the coarse overview, if already loaded. The returned container may be empty.
+
+  \see requestRange
+*/
+QSharedPointer<QCPGraphDataContainer> QCPAbstractDataProvider::dataForRange(const QCPRange &visibleRange) const
+{
+  if (mResidentData && mResidentRange.contains(visibleRange.lower) && mResidentRange.contains(visibleRange.upper))
+    return mResidentData;
+  if (mOverviewData)
+    return mOverviewData;
+  if (mResidentData)
+    return mResidentData;
+  return QSharedPointer<QCPGraphDataContainer>(new QCPGraphDataContainer);
+}
+
+/*!
+  Discards all resident data, e.g. because the underlying data source has changed. Results of a
+  currently running fetch are discarded as well. The next \ref requestRange loads the overview and
+  the visible range anew. Emits \ref dataArrived, so attached graphs are replotted.
+*/
+void QCPAbstractDataProvider::invalidate()
+{
+  ++mGeneration;
+  mResidentData.clear();
+  mOverviewData.clear();
+  mResidentRange = QCPRange();
+  mResidentComplete = false;
+  mOverviewRequested = false;
+  mHasPendingJob = false;
+  mLastVisibleRange = QCPRange();
+  emit dataArrived();
+}
+
+/*! \internal
+
+  Returns whether the resident data covers \a range with at least half the density of \a maxPoints
+  points over the range, or is complete for its range.
+*/
+bool QCPAbstractDataProvider::isSatisfied(const QCPRange &range, int maxPoints) const
+{
+  if (!mResidentData || !mResidentRange.contains(range.lower) || !mResidentRange.contains(range.upper))
+    return false;
+  if (mResidentComplete)
+    return true;
+  return mResidentData->size()/mResidentRange.size() >= 0.5*maxPoints/range.size();
+}
+
+/*! \internal
+
+  Starts \a job on the background thread.
+*/
+void QCPAbstractDataProvider::startJob(const Job &job)
+{
+  mCurrentJob = job;
+  mLoading = true;
+  mThreadPool.start(new QCPDataProviderJob(this, job, mGeneration));
+}
+
+/*! \internal
+
+  Executes \a job on the background thread and hands the result to the GUI thread via \ref
+  processResult.
+*/
+void QCPAbstractDataProvider::runJob(const Job &job, quint64 generation)
+{
+  QSharedPointer<QCPGraphDataContainer> container(new QCPGraphDataContainer);
+  container->set(fetch(job.range, job.maxPoints), true);
+  {
+    QMutexLocker locker(&mResultMutex);
+    mFinishedData = container;
+    mFinishedGeneration = generation;
+  }
+  QMetaObject::invokeMethod(this, "processResult", Qt::QueuedConnection);
+}
+
+/*! \internal
+
+  Called on the GUI thread when a job has finished. Installs the fetched data as resident or
+  overview data (unless \ref invalidate was called in the meantime), emits \ref dataArrived and
+  starts the pending job, if any.
+*/
+void QCPAbstractDataProvider::processResult()
+{
+  QSharedPointer<QCPGraphDataContainer> data;
+  quint64 generation;
+  {
+    QMutexLocker locker(&mResultMutex);
+    data = mFinishedData;
+    generation = mFinishedGeneration;
+    mFinishedData.clear();
+  }
+  mLoading = false;
+  if (data && generation == mGeneration)
+  {
+    if (mCurrentJob.overview)
+    {
+      mOverviewData = data;
+    } else
+    {
+      mResidentData = data;
+      mResidentRange = mCurrentJob.range;
+      mResidentComplete = data->size() < mCurrentJob.maxPoints;
+    }
+    emit dataArrived();
+  }
+  if (mHasPendingJob)
+  {
+    mHasPendingJob = false;
+    if (!isSatisfied(mPendingJob.range, mPendingJob.maxPoints))
+      startJob(mPendingJob);
+  }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////// QCPBinaryFileDataProvider
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*! \class QCPBinaryFileDataProvider
+  \brief Reference data provider which reads graph data from a binary file on disk
+
+  The file consists of consecutive (key, value) pairs of \c double values in native byte order,
+  sorted by key, as written by \ref writeFile. Each fetch opens the file, locates the requested key
+  range by binary search, and reads it in chunks. If the range contains more data points than
+  requested, each group of consecutive data points is reduced to its minimum and maximum.
+
+  This provider serves as a reference for implementing \ref QCPAbstractDataProvider. For fast
+  display of very large local files, also see \ref QCPLodGraph, which uses precomputed
+  level-of-detail data.
+*/
+
+/*!
+  Creates a data provider for the binary file \a fileName.
+*/
+QCPBinaryFileDataProvider::QCPBinaryFileDataProvider(const QString &fileName, QObject *parent) :
+  QCPAbstractDataProvider(parent),
+  mFileName(fileName)
+{
+}
+
+QCPBinaryFileDataProvider::~QCPBinaryFileDataProvider()
+{
+  mThreadPool.waitForDone(); // make sure fetch isn't running anymore while this object is destroyed
+}
+
+/* inherits documentation from base class */
+QCPRange QCPBinaryFileDataProvider::keyRange(bool &foundRange) const
+{
+  foundRange = false;
+  QFile file(mFileName);
+  if (!file.open(QIODevice::ReadOnly) || file.size() < (qint64)sizeof(QCPGraphData))
+    return QCPRange();
+  QCPGraphData first, last;
+  const qint64 count = file.size()/sizeof(QCPGraphData);
+  if (file.read(reinterpret_cast<char*>(&first), sizeof(first)) != sizeof(first) ||
+      !file.seek((count-1)*sizeof(QCPGraphData)) || file.read(reinterpret_cast<char*>(&last), sizeof(last)) != sizeof(last))
+    return QCPRange();
+  foundRange = true;
+  return QCPRange(first.key, last.key);
+}
+
+/*!
+  Writes the data points given by \a keys and \a values to the file \a fileName in the format
+  read by QCPBinaryFileDataProvider. The keys must be sorted ascending. Returns true on success.
+*/
+bool QCPBinaryFileDataProvider::writeFile(const QString &fileName, const QVector<double> &keys, const QVector<double> &values)
+{
+  QFile file(fileName);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+  {
+    qDebug() << Q_FUNC_INFO << "Couldn't open file for writing:" << fileName << file.errorString();
+    return false;
+  }
+  const int n = qMin(keys.size(), values.size());
+  const int chunkSize = 65536;
+  QVector<QCPGraphData> chunk;
+  for (int i=0; i<n; i+=chunkSize)
+  {
+    chunk.resize(qMin(chunkSize, n-i));
+    for (int k=0; k<chunk.size(); ++k)
+    {
+      chunk[k].key = keys.at(i+k);
+      chunk[k].value = values.at(i+k);
+    }
+    const qint64 byteCount = chunk.size()*(qint64)sizeof(QCPGraphData);
+    if (file.write(reinterpret_cast<const char*>(chunk.constData()), byteCount) != byteCount)
+    {
+      qDebug() << Q_FUNC_INFO << "Error while writing:" << fileName << file.errorString();
+      return false;
+    }
+  }
+  return true;
+}
+
+/* inherits documentation from base class */
+QVector<QCPGraphData> QCPBinaryFileDataProvider::fetch(const QCPRange &keyRange, int maxPoints) const
+{
+  QVector<QCPGraphData> result;
+  QFile file(mFileName);
+  if (!file.open(QIODevice::ReadOnly))
+    return result;
+  const qint64 count = file.size()/sizeof(QCPGraphData);
+  const qint64 begin = qMax(Q_INT64_C(0), findIndex(file, count, keyRange.lower)-1);
+  const qint64 end = qMin(count, findIndex(file, count, keyRange.upper)+1);
+  const qint64 n = end-begin;
+  if (n <= 0 || !file.seek(begin*sizeof(QCPGraphData)))
+    return result;
+  
+  if (n <= maxPoints) // few enough points, transfer all of them
+  {
+    result.resize((int)n);
+    const qint64 byteCount = n*sizeof(QCPGraphData);
+    if (file.read(reinterpret_cast<char*>(result.data()), byteCount) != byteCount)
+      result.clear();
+    return result;
+  }
+  
+  // reduce each group of consecutive points to its minimum and maximum, in the order they occur:
+  const qint64 groupSize = (n+maxPoints/2-1)/(maxPoints/2);
+  result.reserve(maxPoints);
+  QVector<QCPGraphData> chunk(65536);
+  qint64 groupFill = 0;
+  QCPGraphData minPoint(0, qQNaN()), maxPoint(0, qQNaN());
+  double groupKey = 0;
+  for (qint64 i=0; i<n; )
+  {
+    const int chunkCount = (int)qMin((qint64)chunk.size(), n-i);
+    const qint64 byteCount = chunkCount*(qint64)sizeof(QCPGraphData);
+    if (file.read(reinterpret_cast<char*>(chunk.data()), byteCount) != byteCount)
+      break;
+    for (int k=0; k<chunkCount; ++k, ++i)
+    {
+      const QCPGraphData &point = chunk.at(k);
+      if (groupFill == 0)
+      {
+        groupKey = point.key;
+        minPoint = QCPGraphData(point.key, qQNaN());
+        maxPoint = minPoint;
+      }
+      if (!qIsNaN(point.value))
+      {
+        if (qIsNaN(minPoint.value) || point.value < minPoint.value)
+          minPoint = point;
+        if (qIsNaN(maxPoint.value) || point.value > maxPoint.value)
+          maxPoint = point;
+      }
+      if (++groupFill == groupSize || i == n-1)
+      {
+        if (qIsNaN(minPoint.value))
+          result.append(QCPGraphData(groupKey, qQNaN())); // group consists of gaps only
+        else if (minPoint.key <= maxPoint.key)
+          result << minPoint << maxPoint;
+        else
+          result << maxPoint << minPoint;
+        groupFill = 0;
+      }
+    }
+  }
+  return result;
+}
+
+/*! \internal
+
+  Returns the index of the first data point in \a file (holding \a count data points) whose key is
+  not smaller than \a key, by binary search.
+*/
+qint64 QCPBinaryFileDataProvider::findIndex(QFile &file, qint64 count, double key) const
+{
+  qint64 low = 0;
+  qint64 high = count;
+  while (low < high)
+  {
+    const qint64 middle = low+(high-low)/2;
+    double middleKey;
+    if (!file.seek(middle*sizeof(QCPGraphData)) || file.read(reinterpret_cast<char*>(&middleKey), sizeof(double)) != sizeof(double))
+      return low;
+    if (middleKey < key)
+      low = middle+1;
+    else
+      high = middle;
+  }
+  return low;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////// QCPAsyncGraph
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*! \class QCPAsyncGraph
+  \brief A graph whose data is loaded in the background by a data provider
+
+  QCPAsyncGraph is a \ref QCPGraph which obtains its data from a \ref QCPAbstractDataProvider,
+  set with \ref setDataProvider. Each time the graph is drawn, it requests the visible key range
+  from the provider and draws the data that is currently resident, so replots never wait for disk
+  or network access. When the provider has fetched new data, the graph queues a replot of its
+  parent plot.
+
+  \code
+  QCPBinaryFileDataProvider *provider = new QCPBinaryFileDataProvider("recording.bin", customPlot);
+  QCPAsyncGraph *graph = new QCPAsyncGraph(customPlot->xAxis, customPlot->yAxis);
+  graph->setDataProvider(provider);
+  \endcode
+
+  The \ref QCPGraph::data container of the graph is replaced by the provider's resident data
+  whenever new data arrives, so it shouldn't be modified directly. When the container is replaced,
+  the selection is translated to the indices of the new data via the keys of the selected data
+  points, so the same key spans stay selected while panning and zooming.
+*/
+
+/*!
+  Constructs an asynchronous graph which uses \a keyAxis as its key axis ("x") and \a valueAxis as
+  its value axis ("y"). Set a data provider with \ref setDataProvider.
+
+  Like \ref QCPGraph, the created graph is automatically registered with the QCustomPlot instance
+  inferred from \a keyAxis, which takes ownership of it.
+*/
+QCPAsyncGraph::QCPAsyncGraph(QCPAxis *keyAxis, QCPAxis *valueAxis) :
+  QCPGraph(keyAxis, valueAxis)
+{
+}
+
+QCPAsyncGraph::~QCPAsyncGraph()
+{
+  if (mDataProvider)
+    disconnect(mDataProvider.data(), SIGNAL(dataArrived()), this, SLOT(providerDataArrived()));
+}
+
+/*!
+  Returns the data provider of this graph, or 0 if none is set.
+*/
+QCPAbstractDataProvider *QCPAsyncGraph::dataProvider() const
+{
+  return mDataProvider.data();
+}
+
+/*!
+  Sets the data provider which supplies the data of this graph. The graph doesn't take ownership
+  of \a provider, so one provider may serve multiple graphs, e.g. in linked plots.
+*/
+void QCPAsyncGraph::setDataProvider(QCPAbstractDataProvider *provider)
+{
+  if (mDataProvider)
+    disconnect(mDataProvider.data(), SIGNAL(dataArrived()), this, SLOT(providerDataArrived()));
+  mDataProvider = provider;
+  mDataContainer = QSharedPointer<QCPGraphDataContainer>(new QCPGraphDataContainer);
+  if (mDataProvider)
+    connect(mDataProvider.data(), SIGNAL(dataArrived()), this, SLOT(providerDataArrived()));
+}
+
+/*!
+  Returns the key range of all data available from the data provider, so \ref
+  QCPAbstractPlottable::rescaleAxes shows the entire data. If \a inSignDomain is restricted, the
+  key range of the resident data is returned.
+*/
+QCPRange QCPAsyncGraph::getKeyRange(bool &foundRange, QCP::SignDomain inSignDomain) const
+{
+  if (mDataProvider && inSignDomain == QCP::sdBoth)
+    return mDataProvider.data()->keyRange(foundRange);
+  return QCPGraph::getKeyRange(foundRange, inSignDomain);
+}
+
+/*! \internal
+
+  Requests the visible key range from the data provider and draws the currently resident data.
+*/
+void QCPAsyncGraph::draw(QCPPainter *painter)
+{
+  if (mDataProvider && mKeyAxis)
+  {
+    const QCPRange visibleRange = mKeyAxis.data()->range();
+    const QRect axisRect = mKeyAxis.data()->axisRect()->rect();
+    mDataProvider.data()->requestRange(visibleRange, mKeyAxis.data()->orientation() == Qt::Horizontal ? axisRect.width() : axisRect.height());
+    adoptContainer(mDataProvider.data()->dataForRange(visibleRange));
+  }
+  QCPGraph::draw(painter);
+}
+
+/*! \internal
+
+  Makes \a data the data container of this graph, if it isn't already. Since the data point
+  indices of the new container generally differ from the old one, the current selection is
+  translated via the keys of its first and last data points, so the same key spans stay selected.
+  The selection is changed without emitting \ref selectionChanged, because it still refers to the
+  same data, only with different indices.
+*/
+void QCPAsyncGraph::adoptContainer(const QSharedPointer<QCPGraphDataContainer> &data)
+{
+  if (data == mDataContainer)
+    return;
+  if (!mSelection.isEmpty())
+  {
+    QCPDataSelection translated;
+    const QList<QCPDataRange> ranges = mSelection.dataRanges();
+    for (int i=0; i<ranges.size(); ++i)
+    {
+      const QCPDataRange range = ranges.at(i).bounded(QCPDataRange(0, mDataContainer->size()));
+      if (range.isEmpty())
+        continue;
+      const double lowerKey = mDataContainer->at(range.begin())->key;
+      const double upperKey = mDataContainer->at(range.end()-1)->key;
+      const int begin = int(data->findBegin(lowerKey, false)-data->constBegin());
+      const int end = int(data->findEnd(upperKey, false)-data->constBegin());
+      if (begin < end)
+        translated.addDataRange(QCPDataRange(begin, end), false);
+    }
+    translated.simplify();
+    mSelection = translated;
+  }
+  mDataContainer = data;
+  mReplotLinesCount = 0; // data container was replaced, lines shared with channel fill graphs are stale
+  mLogKeysContainer.clear();
+}
+
+/*! \internal
+
+  Does nothing, because \ref draw replaces the data container with the currently resident provider
+  data first, which would discard any geometry prepared beforehand.
+*/
+void QCPAsyncGraph::prepareDraw()
+{
+}
+
+/*! \internal
+
+  Called when the data provider has fetched new data. Queues a replot of the parent plot, so
+  multiple arrivals in short succession cause only one replot.
+*/
+void QCPAsyncGraph::providerDataArrived()
+{
+  if (mParentPlot)
+    mParentPlot->replot(QCustomPlot::rpQueuedReplot);
+}
@@ -0,0 +1,164 @@
+/***************************************************************************
+**                                                                        **
+**  QCustomPlot, an easy to use, modern plotting widget for Qt            **
+**  Copyright (C) 2011-2017 Emanuel Eichhammer                            **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+****************************************************************************
+**           Author: Emanuel Eichhammer                                   **
+**  Website/Contact: http://www.qcustomplot.com/                          **
+**             Date: 04.09.17                                             **
+**          Version: 2.0.0                                                **
+****************************************************************************/
+/*! \file */
+#ifndef QCP_PLOTTABLE_ASYNCGRAPH_H
+#define QCP_PLOTTABLE_ASYNCGRAPH_H
+
+#include "../global.h"
+#include "plottable-graph.h"
+
+class QCPPainter;
+class QCPAxis;
+
+class QCP_LIB_DECL QCPAbstractDataProvider : public QObject
+{
+  Q_OBJECT
+  /// \cond INCLUDE_QPROPERTIES
+  Q_PROPERTY(double margin READ margin WRITE setMargin)
+  Q_PROPERTY(double prefetch READ prefetch WRITE setPrefetch)
+  Q_PROPERTY(int overviewPointCount READ overviewPointCount WRITE setOverviewPointCount)
+  /// \endcond
+public:
+  explicit QCPAbstractDataProvider(QObject *parent=0);
+  virtual ~QCPAbstractDataProvider();
+  
+  // getters:
+  double margin() const { return mMargin; }
+  double prefetch() const { return mPrefetch; }
+  int overviewPointCount() const { return mOverviewPointCount; }
+  QCPRange residentRange() const { return mResidentRange; }
+  bool isLoading() const { return mLoading; }
+  
+  // setters:
+  void setMargin(double margin);
+  void setPrefetch(double prefetch);
+  void setOverviewPointCount(int count);
+  
+  // introduced virtual methods:
+  virtual QCPRange keyRange(bool &foundRange) const = 0;
+  
+  // non-property methods:
+  void requestRange(const QCPRange &visibleRange, int pixelWidth);
+  QSharedPointer<QCPGraphDataContainer> dataForRange(const QCPRange &visibleRange) const;
+  void invalidate();
+  
+signals:
+  void dataArrived();
+  
+protected:
+  /*!
+    Describes one fetch job of the background loader.
+  */
+  struct Job
+  {
+    QCPRange range;
+    int maxPoints;
+    bool overview;
+  };
+  
+  // property members:
+  double mMargin, mPrefetch;
+  int mOverviewPointCount;
+  // non-property members:
+  QThreadPool mThreadPool;
+  QMutex mResultMutex;
+  QSharedPointer<QCPGraphDataContainer> mResidentData, mOverviewData, mFinishedData;
+  QCPRange mResidentRange, mLastVisibleRange;
+  bool mResidentComplete;
+  bool mLoading, mHasPendingJob, mOverviewRequested;
+  Job mCurrentJob, mPendingJob;
+  quint64 mGeneration, mFinishedGeneration;
+  
+  // introduced virtual methods:
+  virtual QVector<QCPGraphData> fetch(const QCPRange &keyRange, int maxPoints) const = 0;
+  
+  // non-virtual methods:
+  bool isSatisfied(const QCPRange &range, int maxPoints) const;
+  void startJob(const Job &job);
+  void runJob(const Job &job, quint64 generation);
+  Q_SLOT void processResult();
+  
+  friend class QCPDataProviderJob;
+};
+
+
+class QCP_LIB_DECL QCPBinaryFileDataProvider : public QCPAbstractDataProvider
+{
+  Q_OBJECT
+public:
+  explicit QCPBinaryFileDataProvider(const QString &fileName, QObject *parent=0);
+  virtual ~QCPBinaryFileDataProvider();
+  
+  // getters:
+  QString fileName() const { return mFileName; }
+  
+  // reimplemented virtual methods:
+  virtual QCPRange keyRange(bool &foundRange) const Q_DECL_OVERRIDE;
+  
+  // static methods:
+  static bool writeFile(const QString &fileName, const QVector<double> &keys, const QVector<double> &values);
+  
+protected:
+  // non-property members:
+  QString mFileName;
+  
+  // reimplemented virtual methods:
+  virtual QVector<QCPGraphData> fetch(const QCPRange &keyRange, int maxPoints) const Q_DECL_OVERRIDE;
+  
+  // non-virtual methods:
+  qint64 findIndex(QFile &file, qint64 count, double key) const;
+};
+
+
+class QCP_LIB_DECL QCPAsyncGraph : public QCPGraph
+{
+  Q_OBJECT
+public:
+  explicit QCPAsyncGraph(QCPAxis *keyAxis, QCPAxis *valueAxis);
+  virtual ~QCPAsyncGraph();
+  
+  // getters:
+  QCPAbstractDataProvider *dataProvider() const;
+  
+  // setters:
+  void setDataProvider(QCPAbstractDataProvider *provider);
+  
+  // reimplemented virtual methods:
+  virtual QCPRange getKeyRange(bool &foundRange, QCP::SignDomain inSignDomain=QCP::sdBoth) const Q_DECL_OVERRIDE;
+  
+protected:
+  // non-property members:
+  QPointer<QCPAbstractDataProvider> mDataProvider;
+  
+  // reimplemented virtual methods:
+  virtual void draw(QCPPainter *painter) Q_DECL_OVERRIDE;
+  virtual void prepareDraw() Q_DECL_OVERRIDE;
+  
+  // non-virtual methods:
+  void adoptContainer(const QSharedPointer<QCPGraphDataContainer> &data);
+  Q_SLOT void providerDataArrived();
+};
+
+#endif // QCP_PLOTTABLE_ASYNCGRAPH_H
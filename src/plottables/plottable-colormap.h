@@ -90,6 +90,7 @@ protected:
   bool createAlpha(bool initializeOpaque=true);
   
   friend class QCPColorMap;
+  friend class QCPSnapshot;
 };
 
 
@@ -0,0 +1,1003 @@
+/***************************************************************************
+**                                                                        **
+**  QCustomPlot, an easy to use, modern plotting widget for Qt            **
+**  Copyright (C) 2011-2017 Emanuel Eichhammer                            **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+****************************************************************************
+**           Author: Emanuel Eichhammer                                   **
+**  Website/Contact: http://www.qcustomplot.com/                          **
+**             Date: 04.09.17                                             **
+**          Version: 2.0.0                                                **
+****************************************************************************/
+
+#include "plottable-compactgraph.h"
+
+#include "../painter.h"
+#include "../core.h"
+#include "../axis/axis.h"
+#include "../layoutelements/layoutelement-axisrect.h"
+
+/*! \internal
+  
+  Comparison functor used by \ref QCPCompactGraph to sort an index permutation by the keys it refers
+  to.
+*/
+class QCPCompactGraphKeyLessThan
+{
+public:
+  explicit QCPCompactGraphKeyLessThan(const QVector<double> &keys) : mKeys(keys) {}
+  bool operator()(int a, int b) const { return mKeys.at(a) < mKeys.at(b); }
+private:
+  const QVector<double> &mKeys;
+};
+
+/*! \internal
+  
+  Reorders the elements of \a data from index \a offset on, such that element \a offset+i becomes
+  the previous element \a order[i]. \a order must be a permutation of the indices from \a offset to
+  the end of \a data. Elements before \a offset stay untouched.
+*/
+template <typename T>
+void qcpPermuteTail(QVector<T> &data, const QVector<int> &order, int offset)
+{
+  QVector<T> tail(order.size());
+  for (int i=0; i<order.size(); ++i)
+    tail[i] = data.at(order.at(i));
+  std::copy(tail.constBegin(), tail.constEnd(), data.begin()+offset);
+}
+
+/*! \internal
+  
+  Data accessor used by \ref QCPCompactGraph to pass its key column and the value column of type \a
+  T to the sampling templates of \ref QCPGraph (see \ref QCPGraph::sampleLineData). Values are
+  decoded only when they are read.
+*/
+template <typename T>
+class QCPCompactGraphAccessor
+{
+public:
+  QCPCompactGraphAccessor(const QCPCompactGraph *graph, const T *values) : mGraph(graph), mKeys(graph->mKeys.constData()), mValues(values) {}
+  double key(int index) const { return mKeys[index]; }
+  double value(int index) const { return mGraph->decodeValue(mValues[index]); }
+private:
+  const QCPCompactGraph *mGraph;
+  const double *mKeys;
+  const T *mValues;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////// QCPCompactGraph
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*! \class QCPCompactGraph
+  \brief A graph which stores its values in a compact single-precision or scaled integer format
+
+  QCPCompactGraph behaves like a regular \ref QCPGraph (line styles, scatter styles, fills, channel
+  fills and selection work the same way), but instead of a \ref QCPGraphDataContainer it holds its
+  data in two columns: the keys as \c double, and the values in the type selected with \ref
+  setValueStorage. This reduces the memory and cache footprint of the values by a factor of two
+  (\ref vsFloat, \ref vsInt32) or four (\ref vsInt16), which directly speeds up the sampling and
+  drawing of very large data sets, e.g. raw captures of analog-to-digital converters.
+  
+  The integer storage types are interpreted with a linear scaling, <tt>value = raw*scale +
+  offset</tt>, configured with \ref setValueScaling. Raw samples can be passed without conversion
+  via \ref setRawData. The smallest representable integer is reserved to mark NaN values, so gaps
+  in the graph work as usual.
+  
+  Since the columns are implicitly shared QVectors, passing already sorted data of the matching
+  storage type to \ref setData or \ref setRawData does not copy the data.
+  
+  The adaptive sampling and the selection tests operate directly on the compact columns; only the
+  sampled points that are actually drawn are converted to \c double.
+  
+  The adaptive sampling is the same as in \ref QCPGraph (see \ref QCPGraph::sampleLineData), it
+  reads the compact columns through an accessor that decodes the values on the fly.
+  
+  Since the data methods of \ref QCPGraph are virtual, data passed to a compact graph through a
+  QCPGraph pointer (e.g. one obtained from \ref QCustomPlot::graph) is stored in the compact
+  columns as well. Code written for any graph, like \ref QCPItemTracer and the data selection,
+  reads the data through the index based \ref QCPPlottableInterface1D methods.
+  
+  \note \ref data returns a decoded copy of the data as a \ref QCPGraphDataContainer, which costs
+  as much memory as the data of a regular \ref QCPGraph. The copy only exists as long as the
+  returned shared pointer (or a copy of it) is held, and is kept up to date with the graph in the
+  meantime. Changes made to it are written back to the compact columns. To avoid the memory
+  overhead, prefer \ref setData, \ref addData, \ref keys, \ref value and the \ref
+  QCPPlottableInterface1D methods.
+*/
+
+/* start of documentation of inline functions */
+
+/*! \fn QVector<double> QCPCompactGraph::keys() const
+  
+  Returns the (sorted) keys of the graph data. Since QVector is implicitly shared, this doesn't
+  copy the data.
+*/
+
+/* end of documentation of inline functions */
+
+/*!
+  Constructs a compact graph which uses \a keyAxis as its key axis ("x") and \a valueAxis as its
+  value axis ("y"), and stores its values in the type given by \a storage.
+  
+  Like \ref QCPGraph, the created graph is automatically registered with the QCustomPlot instance
+  inferred from \a keyAxis, which takes ownership of it.
+*/
+QCPCompactGraph::QCPCompactGraph(QCPAxis *keyAxis, QCPAxis *valueAxis, ValueStorage storage) :
+  QCPGraph(keyAxis, valueAxis),
+  mValueStorage(storage),
+  mValueScale(1.0),
+  mValueOffset(0.0),
+  mDataViewRevision(0)
+{
+}
+
+QCPCompactGraph::~QCPCompactGraph()
+{
+}
+
+/*!
+  Sets the type in which the values are stored. If the graph already holds data, it is converted to
+  the new storage type, using the current value scaling (\ref setValueScaling) for integer types.
+  Values that exceed the range of an integer storage type are clamped.
+*/
+void QCPCompactGraph::setValueStorage(ValueStorage storage)
+{
+  if (mValueStorage == storage)
+    return;
+  
+  syncDataView();
+  QVector<double> values(mKeys.size());
+  for (int i=0; i<values.size(); ++i)
+    values[i] = decodedValue(i);
+  mFloatValues.clear();
+  mInt16Values.clear();
+  mInt32Values.clear();
+  mValueStorage = storage;
+  appendValues(values, values.size());
+  updateDataView();
+}
+
+/*!
+  Sets the linear mapping from the stored values to the plot values, such that <tt>value = raw*scale
+  + offset</tt>. This is mainly useful for the integer storage types, e.g. to map raw ADC counts to
+  physical units.
+  
+  Changing the scaling changes the interpretation of the already stored values; it doesn't convert
+  them.
+  
+  \a scale must not be zero.
+*/
+void QCPCompactGraph::setValueScaling(double scale, double offset)
+{
+  if (scale == 0 || qIsNaN(scale) || qIsNaN(offset))
+  {
+    qDebug() << Q_FUNC_INFO << "invalid value scaling" << scale << offset;
+    return;
+  }
+  syncDataView();
+  mValueScale = scale;
+  mValueOffset = offset;
+  updateDataView();
+}
+
+/*! \overload
+  
+  Replaces the current data with the data points in the container \a data. The points are
+  converted to the configured value storage type (\ref setValueStorage).
+  
+  Unlike \ref QCPGraph::setData, the graph doesn't share \a data, since it holds its data in the
+  compact columns. Instead, \a data becomes the container returned by \ref data for as long as it
+  is held elsewhere, so later changes to it are written back to the compact columns like changes
+  to the container returned by \ref data.
+*/
+void QCPCompactGraph::setData(QSharedPointer<QCPGraphDataContainer> data)
+{
+  if (!data)
+  {
+    qDebug() << Q_FUNC_INFO << "passed null data container";
+    return;
+  }
+  setColumns(*data);
+  mDataView = data;
+  mDataViewRevision = data->revision();
+}
+
+/*! \overload
+  
+  Replaces the current data with the provided points in \a keys and \a values. The values are
+  converted to the configured value storage type (\ref setValueStorage). The provided vectors should
+  have equal length. Else, the number of added points will be the size of the smallest vector.
+  
+  If you can guarantee that the passed data points are sorted by \a keys in ascending order, you
+  can set \a alreadySorted to true, to improve performance by saving a sorting run.
+*/
+void QCPCompactGraph::setData(const QVector<double> &keys, const QVector<double> &values, bool alreadySorted)
+{
+  clearData();
+  addData(keys, values, alreadySorted);
+}
+
+/*! \overload
+  
+  Replaces the current data with the provided points in \a keys and \a values. Like the stored
+  values, \a values are interpreted with the value scaling (\ref setValueScaling), which is the
+  identity by default.
+  
+  If the value storage type is \ref vsFloat, the values are taken over without conversion. Since
+  QVector is implicitly shared, no copy is made in that case if both vectors have equal length and
+  \a alreadySorted is true.
+  
+  \see setRawData
+*/
+void QCPCompactGraph::setData(const QVector<double> &keys, const QVector<float> &values, bool alreadySorted)
+{
+  clearData();
+  const int n = qMin(keys.size(), values.size());
+  if (mValueStorage == vsFloat)
+  {
+    mKeys = keys;
+    mFloatValues = values;
+    mKeys.resize(n);
+    mFloatValues.resize(n);
+  } else
+  {
+    QVector<double> doubleValues(n);
+    for (int i=0; i<n; ++i)
+      doubleValues[i] = decodeValue(values.at(i));
+    mKeys = keys;
+    mKeys.resize(n);
+    appendValues(doubleValues, n);
+  }
+  if (!alreadySorted)
+    mergeAppended(0);
+  updateDataView();
+}
+
+/*! \overload
+  
+  Replaces the current data with the keys in \a keys and the raw 16 bit integer samples in \a
+  rawValues. The plot values are obtained via the value scaling (\ref setValueScaling). The value
+  <tt>std::numeric_limits<qint16>::min()</tt> marks a gap in the graph.
+  
+  If the value storage type is \ref vsInt16, the samples are taken over without conversion (and,
+  due to implicit sharing, without copy if \a alreadySorted is true). Otherwise they are converted
+  to the configured storage type.
+*/
+void QCPCompactGraph::setRawData(const QVector<double> &keys, const QVector<qint16> &rawValues, bool alreadySorted)
+{
+  clearData();
+  const int n = qMin(keys.size(), rawValues.size());
+  mKeys = keys;
+  mKeys.resize(n);
+  if (mValueStorage == vsInt16)
+  {
+    mInt16Values = rawValues;
+    mInt16Values.resize(n);
+  } else
+  {
+    QVector<double> doubleValues(n);
+    for (int i=0; i<n; ++i)
+      doubleValues[i] = decodeValue(rawValues.at(i));
+    appendValues(doubleValues, n);
+  }
+  if (!alreadySorted)
+    mergeAppended(0);
+  updateDataView();
+}
+
+/*! \overload
+  
+  Replaces the current data with the keys in \a keys and the raw 32 bit integer samples in \a
+  rawValues. The plot values are obtained via the value scaling (\ref setValueScaling). The value
+  <tt>std::numeric_limits<qint32>::min()</tt> marks a gap in the graph.
+  
+  If the value storage type is \ref vsInt32, the samples are taken over without conversion (and,
+  due to implicit sharing, without copy if \a alreadySorted is true). Otherwise they are converted
+  to the configured storage type.
+*/
+void QCPCompactGraph::setRawData(const QVector<double> &keys, const QVector<qint32> &rawValues, bool alreadySorted)
+{
+  clearData();
+  const int n = qMin(keys.size(), rawValues.size());
+  mKeys = keys;
+  mKeys.resize(n);
+  if (mValueStorage == vsInt32)
+  {
+    mInt32Values = rawValues;
+    mInt32Values.resize(n);
+  } else
+  {
+    QVector<double> doubleValues(n);
+    for (int i=0; i<n; ++i)
+      doubleValues[i] = decodeValue(rawValues.at(i));
+    appendValues(doubleValues, n);
+  }
+  if (!alreadySorted)
+    mergeAppended(0);
+  updateDataView();
+}
+
+/*! \overload
+  
+  Adds the provided points in \a keys and \a values to the current data. The values are converted
+  to the configured value storage type. The provided vectors should have equal length. Else, the
+  number of added points will be the size of the smallest vector.
+  
+  If you can guarantee that the passed data points are sorted by \a keys in ascending order, you
+  can set \a alreadySorted to true, to improve performance by saving a sorting run. Appending
+  points whose keys are all larger than the existing keys never requires a sort. Otherwise only the
+  added points and the existing points with larger keys are reordered.
+*/
+void QCPCompactGraph::addData(const QVector<double> &keys, const QVector<double> &values, bool alreadySorted)
+{
+  if (keys.size() != values.size())
+    qDebug() << Q_FUNC_INFO << "keys and values have different sizes:" << keys.size() << values.size();
+  const int n = qMin(keys.size(), values.size());
+  if (n == 0)
+    return;
+  syncDataView();
+  const int oldSize = mKeys.size();
+  const bool appendsInOrder = mKeys.isEmpty() || keys.first() >= mKeys.last();
+  mKeys.reserve(oldSize+n);
+  for (int i=0; i<n; ++i)
+    mKeys.append(keys.at(i));
+  appendValues(values, n);
+  if (!alreadySorted || !appendsInOrder)
+    mergeAppended(oldSize);
+  updateDataView();
+}
+
+/*! \overload
+  
+  Adds the provided data point as \a key and \a value to the current data.
+*/
+void QCPCompactGraph::addData(double key, double value)
+{
+  syncDataView();
+  const int oldSize = mKeys.size();
+  const bool appendsInOrder = mKeys.isEmpty() || key >= mKeys.last();
+  mKeys.append(key);
+  appendValue(value);
+  if (!appendsInOrder)
+    mergeAppended(oldSize);
+  updateDataView();
+}
+
+/*!
+  Removes all data points.
+*/
+void QCPCompactGraph::clearData()
+{
+  mKeys.clear();
+  mFloatValues.clear();
+  mInt16Values.clear();
+  mInt32Values.clear();
+  updateDataView();
+}
+
+/*!
+  Returns the plot value of the data point at \a index, i.e. the stored value converted to \c
+  double and mapped with the value scaling. NaN is returned for gaps and for out of bounds indices.
+*/
+double QCPCompactGraph::value(int index) const
+{
+  syncDataView();
+  return decodedValue(index);
+}
+
+/*!
+  Returns a copy of the data of the graph as a \ref QCPGraphDataContainer, so code written for the
+  data container of \ref QCPGraph works with compact graphs, too.
+  
+  The container is a decoded copy of the compact columns, so it takes as much memory as the data
+  of a regular QCPGraph. It is kept only as long as the returned shared pointer (or a copy of it)
+  is held. In the meantime, the graph keeps it up to date when its data changes, and changes made
+  to the container are written back to the compact columns. Changes made through the non-const
+  iterators of the container are only detected if \ref QCPDataContainer::markModified is called
+  afterwards.
+*/
+QSharedPointer<QCPGraphDataContainer> QCPCompactGraph::data() const
+{
+  syncDataView();
+  QSharedPointer<QCPGraphDataContainer> view = mDataView.toStrongRef();
+  if (!view)
+  {
+    view = QSharedPointer<QCPGraphDataContainer>(new QCPGraphDataContainer);
+    view->set(decodedData(), true);
+    mDataView = view;
+    mDataViewRevision = view->revision();
+  }
+  return view;
+}
+
+/*! \internal
+  
+  Returns the plot value of the data point at \a index like \ref value, without applying changes
+  made through the container returned by \ref data first.
+*/
+double QCPCompactGraph::decodedValue(int index) const
+{
+  if (index < 0 || index >= mKeys.size())
+    return qQNaN();
+  switch (mValueStorage)
+  {
+    case vsFloat: return decodeValue(mFloatValues.at(index));
+    case vsInt16: return decodeValue(mInt16Values.at(index));
+    case vsInt32: return decodeValue(mInt32Values.at(index));
+  }
+  return qQNaN();
+}
+
+/* inherits documentation from base class */
+int QCPCompactGraph::dataCount() const
+{
+  syncDataView();
+  return mKeys.size();
+}
+
+/* inherits documentation from base class */
+double QCPCompactGraph::dataMainKey(int index) const
+{
+  syncDataView();
+  if (index >= 0 && index < mKeys.size())
+  {
+    return mKeys.at(index);
+  } else
+  {
+    qDebug() << Q_FUNC_INFO << "Index out of bounds" << index;
+    return 0;
+  }
+}
+
+/* inherits documentation from base class */
+double QCPCompactGraph::dataSortKey(int index) const
+{
+  return dataMainKey(index);
+}
+
+/* inherits documentation from base class */
+double QCPCompactGraph::dataMainValue(int index) const
+{
+  syncDataView();
+  if (index >= 0 && index < mKeys.size())
+  {
+    return decodedValue(index);
+  } else
+  {
+    qDebug() << Q_FUNC_INFO << "Index out of bounds" << index;
+    return 0;
+  }
+}
+
+/* inherits documentation from base class */
+QCPRange QCPCompactGraph::dataValueRange(int index) const
+{
+  syncDataView();
+  if (index >= 0 && index < mKeys.size())
+  {
+    const double v = decodedValue(index);
+    return QCPRange(v, v);
+  } else
+  {
+    qDebug() << Q_FUNC_INFO << "Index out of bounds" << index;
+    return QCPRange(0, 0);
+  }
+}
+
+/* inherits documentation from base class */
+QPointF QCPCompactGraph::dataPixelPosition(int index) const
+{
+  syncDataView();
+  if (index >= 0 && index < mKeys.size())
+  {
+    return coordsToPixels(mKeys.at(index), decodedValue(index));
+  } else
+  {
+    qDebug() << Q_FUNC_INFO << "Index out of bounds" << index;
+    return QPointF();
+  }
+}
+
+/* inherits documentation from base class */
+QCPDataSelection QCPCompactGraph::selectTestRect(const QRectF &rect, bool onlySelectable) const
+{
+  syncDataView();
+  QCPDataSelection result;
+  if ((onlySelectable && mSelectable == QCP::stNone) || mKeys.isEmpty())
+    return result;
+  if (!mKeyAxis || !mValueAxis)
+    return result;
+  
+  // convert rect given in pixels to ranges given in plot coordinates:
+  double key1, value1, key2, value2;
+  pixelsToCoords(rect.topLeft(), key1, value1);
+  pixelsToCoords(rect.bottomRight(), key2, value2);
+  QCPRange keyRange(key1, key2); // QCPRange normalizes internally so we don't have to care about whether key1 < key2
+  QCPRange valueRange(value1, value2);
+  const int begin = findBegin(keyRange.lower, false);
+  const int end = findEnd(keyRange.upper, false);
+  
+  int currentSegmentBegin = -1; // -1 means we're currently not in a segment that's contained in rect
+  for (int i=begin; i<end; ++i)
+  {
+    if (currentSegmentBegin == -1)
+    {
+      if (valueRange.contains(decodedValue(i)) && keyRange.contains(mKeys.at(i))) // start segment
+        currentSegmentBegin = i;
+    } else if (!valueRange.contains(decodedValue(i)) || !keyRange.contains(mKeys.at(i))) // segment just ended
+    {
+      result.addDataRange(QCPDataRange(currentSegmentBegin, i), false);
+      currentSegmentBegin = -1;
+    }
+  }
+  // process potential last segment:
+  if (currentSegmentBegin != -1)
+    result.addDataRange(QCPDataRange(currentSegmentBegin, end), false);
+  
+  result.simplify();
+  return result;
+}
+
+/* inherits documentation from base class */
+int QCPCompactGraph::findBegin(double sortKey, bool expandedRange) const
+{
+  syncDataView();
+  if (mKeys.isEmpty())
+    return 0;
+  int result = std::lower_bound(mKeys.constBegin(), mKeys.constEnd(), sortKey)-mKeys.constBegin();
+  if (expandedRange && result > 0) // also covers result == size case, and we know size-1 is valid because mKeys isn't empty
+    --result;
+  return result;
+}
+
+/* inherits documentation from base class */
+int QCPCompactGraph::findEnd(double sortKey, bool expandedRange) const
+{
+  syncDataView();
+  if (mKeys.isEmpty())
+    return 0;
+  int result = std::upper_bound(mKeys.constBegin(), mKeys.constEnd(), sortKey)-mKeys.constBegin();
+  if (expandedRange && result < mKeys.size())
+    ++result;
+  return result;
+}
+
+/* inherits documentation from base class */
+double QCPCompactGraph::selectTest(const QPointF &pos, bool onlySelectable, QVariant *details) const
+{
+  syncDataView();
+  if ((onlySelectable && mSelectable == QCP::stNone) || mKeys.isEmpty())
+    return -1;
+  if (!mKeyAxis || !mValueAxis)
+    return -1;
+  if (mLineStyle == lsNone && mScatterStyle.isNone())
+    return -1;
+  if (!mKeyAxis.data()->axisRect()->rect().contains(pos.toPoint()))
+    return -1;
+  
+  // calculate minimum distances to graph data points and find closest data point:
+  double minDistSqr = std::numeric_limits<double>::max();
+  int closestIndex = mKeys.size();
+  double posKeyMin, posKeyMax, dummy;
+  pixelsToCoords(pos-QPointF(mParentPlot->selectionTolerance(), mParentPlot->selectionTolerance()), posKeyMin, dummy);
+  pixelsToCoords(pos+QPointF(mParentPlot->selectionTolerance(), mParentPlot->selectionTolerance()), posKeyMax, dummy);
+  if (posKeyMin > posKeyMax)
+    qSwap(posKeyMin, posKeyMax);
+  const int begin = findBegin(posKeyMin, true);
+  const int end = findEnd(posKeyMax, true);
+  for (int i=begin; i<end; ++i)
+  {
+    const double currentDistSqr = QCPVector2D(coordsToPixels(mKeys.at(i), decodedValue(i))-pos).lengthSquared();
+    if (currentDistSqr < minDistSqr)
+    {
+      minDistSqr = currentDistSqr;
+      closestIndex = i;
+    }
+  }
+  
+  // calculate distance to graph line if there is one (if so, will probably be smaller than distance to closest data point):
+  if (mLineStyle != lsNone)
+  {
+    QVector<QPointF> lineData;
+    getLines(&lineData, QCPDataRange(0, dataCount()));
+    QCPVector2D p(pos);
+    const int step = mLineStyle==lsImpulse ? 2 : 1; // impulse plot differs from other line styles in that the lineData points are only pairwise connected
+    for (int i=0; i<lineData.size()-1; i+=step)
+    {
+      const double currentDistSqr = p.distanceSquaredToLine(lineData.at(i), lineData.at(i+1));
+      if (currentDistSqr < minDistSqr)
+        minDistSqr = currentDistSqr;
+    }
+  }
+  
+  if (details)
+  {
+    QCPDataSelection selectionResult;
+    if (closestIndex != mKeys.size())
+      selectionResult.addDataRange(QCPDataRange(closestIndex, closestIndex+1), false);
+    details->setValue(selectionResult);
+  }
+  return qSqrt(minDistSqr);
+}
+
+/* inherits documentation from base class */
+QCPRange QCPCompactGraph::getKeyRange(bool &foundRange, QCP::SignDomain inSignDomain) const
+{
+  syncDataView();
+  QCPRange range;
+  bool haveLower = false;
+  bool haveUpper = false;
+  const int n = mKeys.size();
+  if (inSignDomain == QCP::sdBoth) // keys are sorted, so find just first and last key with non-NaN value
+  {
+    for (int i=0; i<n; ++i)
+    {
+      if (!qIsNaN(decodedValue(i)))
+      {
+        range.lower = mKeys.at(i);
+        haveLower = true;
+        break;
+      }
+    }
+    for (int i=n-1; i>=0; --i)
+    {
+      if (!qIsNaN(decodedValue(i)))
+      {
+        range.upper = mKeys.at(i);
+        haveUpper = true;
+        break;
+      }
+    }
+  } else
+  {
+    for (int i=0; i<n; ++i)
+    {
+      const double current = mKeys.at(i);
+      if ((inSignDomain == QCP::sdNegative && current >= 0) || (inSignDomain == QCP::sdPositive && current <= 0) || qIsNaN(decodedValue(i)))
+        continue;
+      if (current < range.lower || !haveLower)
+      {
+        range.lower = current;
+        haveLower = true;
+      }
+      if (current > range.upper || !haveUpper)
+      {
+        range.upper = current;
+        haveUpper = true;
+      }
+    }
+  }
+  foundRange = haveLower && haveUpper;
+  return range;
+}
+
+/* inherits documentation from base class */
+QCPRange QCPCompactGraph::getValueRange(bool &foundRange, QCP::SignDomain inSignDomain, const QCPRange &inKeyRange) const
+{
+  syncDataView();
+  QCPRange range;
+  bool haveLower = false;
+  bool haveUpper = false;
+  const bool restrictKeyRange = inKeyRange != QCPRange();
+  int begin = 0;
+  int end = mKeys.size();
+  if (restrictKeyRange)
+  {
+    begin = findBegin(inKeyRange.lower);
+    end = findEnd(inKeyRange.upper);
+  }
+  for (int i=begin; i<end; ++i)
+  {
+    if (restrictKeyRange && (mKeys.at(i) < inKeyRange.lower || mKeys.at(i) > inKeyRange.upper))
+      continue;
+    const double current = decodedValue(i);
+    if (qIsNaN(current) || (inSignDomain == QCP::sdNegative && current >= 0) || (inSignDomain == QCP::sdPositive && current <= 0))
+      continue;
+    if (current < range.lower || !haveLower)
+    {
+      range.lower = current;
+      haveLower = true;
+    }
+    if (current > range.upper || !haveUpper)
+    {
+      range.upper = current;
+      haveUpper = true;
+    }
+  }
+  foundRange = haveLower && haveUpper;
+  return range;
+}
+
+/*! \internal
+
+  Reimplements the line generation of \ref QCPGraph such that the adaptive sampling (\ref
+  QCPGraph::sampleLineData) operates directly on the compact value column. Only the sampled points
+  are converted to \c double before being passed on to the line style specific conversion (\ref
+  QCPGraph::dataToLineStyleLines).
+*/
+void QCPCompactGraph::getLines(QVector<QPointF> *lines, const QCPDataRange &dataRange) const
+{
+  syncDataView();
+  if (!lines) return;
+  int begin, end;
+  getVisibleIndexBounds(begin, end, dataRange);
+  if (begin == end)
+  {
+    lines->clear();
+    return;
+  }
+  
+  QVector<QCPGraphData> lineData;
+  if (mLineStyle != lsNone)
+  {
+    switch (mValueStorage)
+    {
+      case vsFloat: sampleLineData(&lineData, QCPCompactGraphAccessor<float>(this, mFloatValues.constData()), begin, end); break;
+      case vsInt16: sampleLineData(&lineData, QCPCompactGraphAccessor<qint16>(this, mInt16Values.constData()), begin, end); break;
+      case vsInt32: sampleLineData(&lineData, QCPCompactGraphAccessor<qint32>(this, mInt32Values.constData()), begin, end); break;
+    }
+  }
+  
+  if (mKeyAxis->rangeReversed() != (mKeyAxis->orientation() == Qt::Vertical)) // make sure key pixels are sorted ascending in lineData (significantly simplifies following processing)
+    std::reverse(lineData.begin(), lineData.end());
+  
+  *lines = dataToLineStyleLines(lineData);
+}
+
+/*! \internal
+
+  Reimplements the scatter generation of \ref QCPGraph such that the adaptive sampling (\ref
+  QCPGraph::sampleScatterData) operates directly on the compact value column.
+*/
+void QCPCompactGraph::getScatters(QVector<QPointF> *scatters, const QCPDataRange &dataRange) const
+{
+  syncDataView();
+  if (!scatters) return;
+  if (!mKeyAxis || !mValueAxis) { qDebug() << Q_FUNC_INFO << "invalid key or value axis"; scatters->clear(); return; }
+  
+  int begin, end;
+  getVisibleIndexBounds(begin, end, dataRange);
+  if (begin == end)
+  {
+    scatters->clear();
+    return;
+  }
+  
+  QVector<QCPGraphData> data;
+  switch (mValueStorage)
+  {
+    case vsFloat: sampleScatterData(&data, QCPCompactGraphAccessor<float>(this, mFloatValues.constData()), begin, end); break;
+    case vsInt16: sampleScatterData(&data, QCPCompactGraphAccessor<qint16>(this, mInt16Values.constData()), begin, end); break;
+    case vsInt32: sampleScatterData(&data, QCPCompactGraphAccessor<qint32>(this, mInt32Values.constData()), begin, end); break;
+  }
+  
+  if (mKeyAxis->rangeReversed() != (mKeyAxis->orientation() == Qt::Vertical)) // make sure key pixels are sorted ascending in data (significantly simplifies following processing)
+    std::reverse(data.begin(), data.end());
+  
+  *scatters = dataToScatters(data);
+}
+
+/*! \internal
+
+  Index based counterpart of \ref QCPGraph::getVisibleDataBounds. Outputs the currently visible
+  data index range via \a begin and \a end, including the points just outside the visible key
+  range, and never exceeding \a rangeRestriction.
+*/
+void QCPCompactGraph::getVisibleIndexBounds(int &begin, int &end, const QCPDataRange &rangeRestriction) const
+{
+  if (rangeRestriction.isEmpty() || !mKeyAxis)
+  {
+    begin = mKeys.size();
+    end = begin;
+  } else
+  {
+    QCPDataRange visibleRange(findBegin(mKeyAxis->range().lower), findEnd(mKeyAxis->range().upper));
+    visibleRange = visibleRange.bounded(rangeRestriction.bounded(QCPDataRange(0, mKeys.size())));
+    begin = visibleRange.begin();
+    end = visibleRange.end();
+  }
+}
+
+/*! \internal
+
+  Converts \a value to the configured value storage type and appends it to the respective value
+  column. The key column must be extended accordingly by the caller.
+*/
+void QCPCompactGraph::appendValue(double value)
+{
+  switch (mValueStorage)
+  {
+    case vsFloat: mFloatValues.append((value-mValueOffset)/mValueScale); break;
+    case vsInt16: mInt16Values.append(encodeIntValue<qint16>(value)); break;
+    case vsInt32: mInt32Values.append(encodeIntValue<qint32>(value)); break;
+  }
+}
+
+/*! \internal
+
+  Converts the first \a count entries of \a values to the configured value storage type and appends
+  them to the respective value column. The key column must be extended accordingly by the caller.
+*/
+void QCPCompactGraph::appendValues(const QVector<double> &values, int count)
+{
+  switch (mValueStorage)
+  {
+    case vsFloat:
+    {
+      mFloatValues.reserve(mFloatValues.size()+count);
+      for (int i=0; i<count; ++i)
+        mFloatValues.append((values.at(i)-mValueOffset)/mValueScale);
+      break;
+    }
+    case vsInt16:
+    {
+      mInt16Values.reserve(mInt16Values.size()+count);
+      for (int i=0; i<count; ++i)
+        mInt16Values.append(encodeIntValue<qint16>(values.at(i)));
+      break;
+    }
+    case vsInt32:
+    {
+      mInt32Values.reserve(mInt32Values.size()+count);
+      for (int i=0; i<count; ++i)
+        mInt32Values.append(encodeIntValue<qint32>(values.at(i)));
+      break;
+    }
+  }
+}
+
+/*! \internal
+
+  Converts the plot value \a value to the raw integer type \a T, using the inverse of the value
+  scaling. NaN values are mapped to the reserved minimum integer, and values outside the
+  representable range are clamped.
+*/
+template <typename T>
+T QCPCompactGraph::encodeIntValue(double value) const
+{
+  if (qIsNaN(value))
+    return std::numeric_limits<T>::min();
+  const double scaled = (value-mValueOffset)/mValueScale;
+  if (scaled <= (double)std::numeric_limits<T>::min()+1)
+    return std::numeric_limits<T>::min()+1; // minimum is reserved for NaN
+  if (scaled >= (double)std::numeric_limits<T>::max())
+    return std::numeric_limits<T>::max();
+  return (T)qRound64(scaled);
+}
+
+/*! \internal
+
+  Sorts the data points from index \a oldSize on, which were just added, and merges them with the
+  already sorted data points before them. Like \ref QCPDataContainer::add, only the added points
+  and the existing points with larger keys are reordered, the existing points with smaller keys
+  stay untouched. Points with equal keys keep their relative order, existing points come first.
+  Does nothing if the added points are sorted and not smaller than the existing ones.
+*/
+void QCPCompactGraph::mergeAppended(int oldSize)
+{
+  const int n = mKeys.size();
+  bool isSorted = true;
+  for (int i=qMax(1, oldSize); i<n; ++i)
+  {
+    if (mKeys.at(i) < mKeys.at(i-1))
+    {
+      isSorted = false;
+      break;
+    }
+  }
+  if (isSorted)
+    return;
+  
+  QVector<int> added(n-oldSize);
+  for (int i=0; i<added.size(); ++i)
+    added[i] = oldSize+i;
+  std::stable_sort(added.begin(), added.end(), QCPCompactGraphKeyLessThan(mKeys));
+  // existing points up to the smallest added key keep their place, merge the rest with the added points:
+  const int first = std::upper_bound(mKeys.constBegin(), mKeys.constBegin()+oldSize, mKeys.at(added.first()))-mKeys.constBegin();
+  QVector<int> order;
+  order.reserve(n-first);
+  int existing = first;
+  int addedIndex = 0;
+  while (existing < oldSize && addedIndex < added.size())
+  {
+    if (mKeys.at(added.at(addedIndex)) < mKeys.at(existing))
+      order.append(added.at(addedIndex++));
+    else
+      order.append(existing++);
+  }
+  while (existing < oldSize)
+    order.append(existing++);
+  while (addedIndex < added.size())
+    order.append(added.at(addedIndex++));
+  
+  qcpPermuteTail(mKeys, order, first);
+  switch (mValueStorage)
+  {
+    case vsFloat: qcpPermuteTail(mFloatValues, order, first); break;
+    case vsInt16: qcpPermuteTail(mInt16Values, order, first); break;
+    case vsInt32: qcpPermuteTail(mInt32Values, order, first); break;
+  }
+}
+
+/*! \internal
+
+  Replaces the compact columns with the (sorted) data points of \a data, converted to the
+  configured value storage type.
+*/
+void QCPCompactGraph::setColumns(const QCPGraphDataContainer &data)
+{
+  mKeys.clear();
+  mFloatValues.clear();
+  mInt16Values.clear();
+  mInt32Values.clear();
+  mKeys.reserve(data.size());
+  switch (mValueStorage)
+  {
+    case vsFloat: mFloatValues.reserve(data.size()); break;
+    case vsInt16: mInt16Values.reserve(data.size()); break;
+    case vsInt32: mInt32Values.reserve(data.size()); break;
+  }
+  for (QCPGraphDataContainer::const_iterator it=data.constBegin(); it!=data.constEnd(); ++it)
+  {
+    mKeys.append(it->key);
+    appendValue(it->value);
+  }
+}
+
+/*! \internal
+
+  Writes changes made to the container returned by \ref data back to the compact columns. Called
+  via \ref syncDataView by all methods which access the compact columns, as long as the container
+  is held somewhere.
+*/
+void QCPCompactGraph::applyDataView()
+{
+  const QSharedPointer<QCPGraphDataContainer> view = mDataView.toStrongRef();
+  if (!view || view->revision() == mDataViewRevision)
+    return;
+  setColumns(*view);
+  mDataViewRevision = view->revision();
+}
+
+/*! \internal
+
+  Brings the container returned by \ref data up to date after the compact columns were changed, if
+  the container is still held somewhere.
+*/
+void QCPCompactGraph::updateDataView()
+{
+  const QSharedPointer<QCPGraphDataContainer> view = mDataView.toStrongRef();
+  if (!view)
+    return;
+  view->set(decodedData(), true);
+  mDataViewRevision = view->revision();
+}
+
+/*! \internal
+
+  Returns the data points of the graph, decoded to \c double.
+*/
+QVector<QCPGraphData> QCPCompactGraph::decodedData() const
+{
+  QVector<QCPGraphData> result(mKeys.size());
+  for (int i=0; i<result.size(); ++i)
+  {
+    result[i].key = mKeys.at(i);
+    result[i].value = decodedValue(i);
+  }
+  return result;
+}
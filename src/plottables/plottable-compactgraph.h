@@ -0,0 +1,139 @@
+/***************************************************************************
+**                                                                        **
+**  QCustomPlot, an easy to use, modern plotting widget for Qt            **
+**  Copyright (C) 2011-2017 Emanuel Eichhammer                            **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+****************************************************************************
+**           Author: Emanuel Eichhammer                                   **
+**  Website/Contact: http://www.qcustomplot.com/                          **
+**             Date: 04.09.17                                             **
+**          Version: 2.0.0                                                **
+****************************************************************************/
+/*! \file */
+#ifndef QCP_PLOTTABLE_COMPACTGRAPH_H
+#define QCP_PLOTTABLE_COMPACTGRAPH_H
+
+#include "../global.h"
+#include "plottable-graph.h"
+
+class QCPPainter;
+class QCPAxis;
+template <typename T> class QCPCompactGraphAccessor;
+
+class QCP_LIB_DECL QCPCompactGraph : public QCPGraph
+{
+  Q_OBJECT
+  /// \cond INCLUDE_QPROPERTIES
+  Q_PROPERTY(ValueStorage valueStorage READ valueStorage WRITE setValueStorage)
+  Q_PROPERTY(double valueScale READ valueScale)
+  Q_PROPERTY(double valueOffset READ valueOffset)
+  /// \endcond
+public:
+  /*!
+    Defines the type in which the values of the graph are stored. Keys are always stored as
+    double.
+
+    For the integer types, the value of a data point is <tt>raw*valueScale + valueOffset</tt> (see
+    \ref setValueScaling), and the smallest representable integer is reserved to represent NaN
+    values, i.e. gaps in the graph.
+
+    \see setValueStorage
+  */
+  enum ValueStorage { vsFloat  ///< values are stored as single-precision floating point numbers (4 bytes per value)
+                      ,vsInt16 ///< values are stored as scaled 16 bit integers (2 bytes per value), e.g. for raw ADC samples
+                      ,vsInt32 ///< values are stored as scaled 32 bit integers (4 bytes per value)
+                    };
+  Q_ENUMS(ValueStorage)
+  
+  explicit QCPCompactGraph(QCPAxis *keyAxis, QCPAxis *valueAxis, ValueStorage storage=vsFloat);
+  virtual ~QCPCompactGraph();
+  
+  // getters:
+  ValueStorage valueStorage() const { return mValueStorage; }
+  double valueScale() const { return mValueScale; }
+  double valueOffset() const { return mValueOffset; }
+  QVector<double> keys() const { syncDataView(); return mKeys; }
+  
+  // setters:
+  void setValueStorage(ValueStorage storage);
+  void setValueScaling(double scale, double offset);
+  virtual void setData(QSharedPointer<QCPGraphDataContainer> data) Q_DECL_OVERRIDE;
+  virtual void setData(const QVector<double> &keys, const QVector<double> &values, bool alreadySorted=false) Q_DECL_OVERRIDE;
+  void setData(const QVector<double> &keys, const QVector<float> &values, bool alreadySorted=false);
+  void setRawData(const QVector<double> &keys, const QVector<qint16> &rawValues, bool alreadySorted=false);
+  void setRawData(const QVector<double> &keys, const QVector<qint32> &rawValues, bool alreadySorted=false);
+  
+  // non-property methods:
+  virtual void addData(const QVector<double> &keys, const QVector<double> &values, bool alreadySorted=false) Q_DECL_OVERRIDE;
+  virtual void addData(double key, double value) Q_DECL_OVERRIDE;
+  void clearData();
+  double value(int index) const;
+  
+  // reimplemented virtual methods:
+  virtual QSharedPointer<QCPGraphDataContainer> data() const Q_DECL_OVERRIDE;
+  virtual int dataCount() const Q_DECL_OVERRIDE;
+  virtual double dataMainKey(int index) const Q_DECL_OVERRIDE;
+  virtual double dataSortKey(int index) const Q_DECL_OVERRIDE;
+  virtual double dataMainValue(int index) const Q_DECL_OVERRIDE;
+  virtual QCPRange dataValueRange(int index) const Q_DECL_OVERRIDE;
+  virtual QPointF dataPixelPosition(int index) const Q_DECL_OVERRIDE;
+  virtual QCPDataSelection selectTestRect(const QRectF &rect, bool onlySelectable) const Q_DECL_OVERRIDE;
+  virtual int findBegin(double sortKey, bool expandedRange=true) const Q_DECL_OVERRIDE;
+  virtual int findEnd(double sortKey, bool expandedRange=true) const Q_DECL_OVERRIDE;
+  virtual double selectTest(const QPointF &pos, bool onlySelectable, QVariant *details=0) const Q_DECL_OVERRIDE;
+  virtual QCPRange getKeyRange(bool &foundRange, QCP::SignDomain inSignDomain=QCP::sdBoth) const Q_DECL_OVERRIDE;
+  virtual QCPRange getValueRange(bool &foundRange, QCP::SignDomain inSignDomain=QCP::sdBoth, const QCPRange &inKeyRange=QCPRange()) const Q_DECL_OVERRIDE;
+  
+protected:
+  // property members:
+  ValueStorage mValueStorage;
+  double mValueScale, mValueOffset;
+  
+  // non-property members:
+  QVector<double> mKeys;
+  QVector<float> mFloatValues;
+  QVector<qint16> mInt16Values;
+  QVector<qint32> mInt32Values;
+  mutable QWeakPointer<QCPGraphDataContainer> mDataView;
+  mutable quint64 mDataViewRevision;
+  
+  // reimplemented virtual methods:
+  virtual void getLines(QVector<QPointF> *lines, const QCPDataRange &dataRange) const Q_DECL_OVERRIDE;
+  virtual void getScatters(QVector<QPointF> *scatters, const QCPDataRange &dataRange) const Q_DECL_OVERRIDE;
+  
+  // non-virtual methods:
+  void getVisibleIndexBounds(int &begin, int &end, const QCPDataRange &rangeRestriction) const;
+  void appendValue(double value);
+  void appendValues(const QVector<double> &values, int count);
+  void mergeAppended(int oldSize);
+  void setColumns(const QCPGraphDataContainer &data);
+  void applyDataView();
+  void updateDataView();
+  QVector<QCPGraphData> decodedData() const;
+  double decodedValue(int index) const;
+  
+  inline void syncDataView() const { if (!mDataView.isNull()) const_cast<QCPCompactGraph*>(this)->applyDataView(); }
+  inline double decodeValue(float raw) const { return raw*mValueScale+mValueOffset; }
+  inline double decodeValue(qint16 raw) const { return raw == std::numeric_limits<qint16>::min() ? qQNaN() : raw*mValueScale+mValueOffset; }
+  inline double decodeValue(qint32 raw) const { return raw == std::numeric_limits<qint32>::min() ? qQNaN() : raw*mValueScale+mValueOffset; }
+  template <typename T> T encodeIntValue(double value) const;
+  
+  template <typename T> friend class QCPCompactGraphAccessor;
+  friend class QCPSnapshot;
+};
+Q_DECLARE_METATYPE(QCPCompactGraph::ValueStorage)
+
+#endif // QCP_PLOTTABLE_COMPACTGRAPH_H
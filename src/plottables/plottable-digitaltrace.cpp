@@ -0,0 +1,915 @@
+/***************************************************************************
+**                                                                        **
+**  QCustomPlot, an easy to use, modern plotting widget for Qt            **
+**  Copyright (C) 2011-2017 Emanuel Eichhammer                            **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+****************************************************************************
+**           Author: Emanuel Eichhammer                                   **
+**  Website/Contact: http://www.qcustomplot.com/                          **
+**             Date: 04.09.17                                             **
+**          Version: 2.0.0                                                **
+****************************************************************************/
+
+#include "plottable-digitaltrace.h"
+
+#include "../painter.h"
+#include "../core.h"
+#include "../axis/axis.h"
+#include "../layoutelements/layoutelement-axisrect.h"
+
+/*! \internal
+  
+  Orders transition indices by their timestamp, used by \ref QCPDigitalTrace::setData to sort
+  unsorted timestamps together with their states.
+*/
+class QCPDigitalTraceKeyLess
+{
+public:
+  explicit QCPDigitalTraceKeyLess(const double *keys) : mKeys(keys) {}
+  bool operator()(int a, int b) const { return mKeys[a] < mKeys[b]; }
+  
+private:
+  const double *mKeys;
+};
+
+/*! \internal
+  
+  The number of transitions summarized by one entry of \ref QCPDigitalTrace::mChangeBlocks.
+*/
+static const int QCPDigitalTraceBlockSize = 64;
+
+/*! \internal
+  
+  Accumulates the channel change mask \a changed of a transition into the masks of channels that
+  changed at least once (\a once) and at least twice (\a twice).
+*/
+static inline void qcpAccumulateChange(quint64 changed, quint64 &once, quint64 &twice)
+{
+  twice |= once & changed;
+  once |= changed;
+}
+
+/*! \internal
+  
+  Holds the pixel geometry of one row of a \ref QCPDigitalTrace, as generated by \ref
+  QCPDigitalTrace::getRowTraces: The segments of constant row value, and the activity ranges in
+  which the row changes faster than can be resolved on screen. All positions are key pixel
+  coordinates.
+*/
+struct QCPDigitalTrace::RowTrace
+{
+  struct Segment
+  {
+    double begin, end;
+    quint64 value;
+  };
+  
+  quint64 value;
+  double lastPixel;
+  double activityBegin;
+  bool inActivity;
+  QVector<Segment> segments;
+  QVector<QCPRange> activity;
+  
+  /*
+    Registers a change of the row value to \a newValue, which happens between \a entry and \a exit.
+    A \a dense change (more than one transition within the pixel range), or a change less than a
+    pixel away from the previous one, opens or extends an activity range instead of adding a
+    segment.
+  */
+  void add(double entry, double exit, quint64 newValue, bool dense)
+  {
+    const bool adjacent = qAbs(entry-lastPixel) < 1;
+    if (dense || adjacent)
+    {
+      if (!inActivity)
+      {
+        if (!adjacent)
+          appendSegment(lastPixel, entry);
+        activityBegin = adjacent ? lastPixel : entry;
+        inActivity = true;
+      } else if (!adjacent) // the previous activity range has ended, a stable segment lies in between
+      {
+        activity.append(QCPRange(activityBegin, lastPixel));
+        appendSegment(lastPixel, entry);
+        activityBegin = entry;
+      }
+    } else
+    {
+      closeActivity();
+      appendSegment(lastPixel, entry);
+    }
+    value = newValue;
+    lastPixel = exit;
+  }
+  
+  /*
+    Closes the trace at \a endPixel, extending the current row value up to there.
+  */
+  void finish(double endPixel)
+  {
+    closeActivity();
+    if (endPixel != lastPixel)
+      appendSegment(lastPixel, endPixel);
+  }
+  
+  void closeActivity()
+  {
+    if (inActivity)
+    {
+      activity.append(QCPRange(activityBegin, lastPixel));
+      inActivity = false;
+    }
+  }
+  
+  void appendSegment(double begin, double end)
+  {
+    Segment segment;
+    segment.begin = begin;
+    segment.end = end;
+    segment.value = value;
+    segments.append(segment);
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////// QCPDigitalTrace
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*! \class QCPDigitalTrace
+  \brief A plottable representing the channels of a logic analyzer capture
+  
+  QCPDigitalTrace displays up to 64 digital channels that share one time base. Instead of storing
+  a value per sample and channel, it stores a list of transitions: a timestamp (the key) and the
+  packed state of all channels after the transition, one bit per channel. So a transition costs 16
+  bytes regardless of the number of channels, and transitions that don't change the state are
+  dropped when data is added. This makes it suitable for captures with a very large number of
+  transitions, where emulating each channel with a \ref QCPGraph in a step line style would store
+  and draw every step of every channel separately.
+  
+  Each channel is displayed in its own row. Consecutive channels can be grouped to a bus with \ref
+  addBus, which is displayed as a single row showing the bus value in hexadecimal notation. Row
+  \c i occupies the value coordinates \c i to \c i+rowHeight (see \ref setRowHeight), so the rows
+  are stacked upwards from zero. The bits of channels that are part of a bus are in ascending
+  significance, i.e. the first channel of a bus is its least significant bit.
+  
+  When drawing, all rows are processed in a single pass over the visible transitions. Where a row
+  changes more than once within a pixel column of the key axis, the individual steps can't be
+  resolved anyway, so the affected range is drawn as an activity bar (filled with the brush, see
+  \ref setBrush) instead of individual steps. Within such dense stretches, transitions are
+  processed per pixel column using binary search and bit operations on precomputed summaries of
+  64 transitions each, so the drawing effort grows with the number of pixel columns and only a
+  small fraction of the number of visible transitions.
+  
+  The state before the first transition is undefined and not drawn. The state of the last
+  transition is held up to the end of the visible key range.
+  
+  The key axis can be shared with regular graphs, e.g. to show analog signals below the digital
+  channels. Use \ref findBegin, \ref findEnd and \ref stateAt to look up transitions, e.g. for
+  cursors or measurements.
+  
+  The plottable can only be selected as a whole (see \ref setSelectable). \ref rowAt returns the
+  row at a given pixel position, e.g. to show the channel or bus name in a tool tip.
+*/
+
+/*!
+  Constructs a digital trace which uses \a keyAxis as its key axis ("x") and \a valueAxis as its
+  value axis ("y"). \a keyAxis and \a valueAxis must reside in the same QCustomPlot instance and
+  not have the same orientation. If either of these restrictions is violated, a corresponding
+  message is printed to the debug output (qDebug), the construction is not aborted, though.
+  
+  The created QCPDigitalTrace is automatically registered with the QCustomPlot instance inferred
+  from \a keyAxis. This QCustomPlot instance takes ownership of the QCPDigitalTrace, so do not
+  delete it manually but use QCustomPlot::removePlottable() instead.
+  
+  Initially, the trace has a single channel and no buses.
+*/
+QCPDigitalTrace::QCPDigitalTrace(QCPAxis *keyAxis, QCPAxis *valueAxis) :
+  QCPAbstractPlottable(keyAxis, valueAxis),
+  mChannelCount(1),
+  mRowHeight(0.7)
+{
+  setPen(QPen(QColor(20, 130, 60)));
+  setBrush(QBrush(QColor(20, 130, 60, 110)));
+  setSelectable(QCP::stWhole);
+  updateRows();
+}
+
+QCPDigitalTrace::~QCPDigitalTrace()
+{
+}
+
+/*!
+  Returns the name of the bus with \a index.
+  
+  \see addBus
+*/
+QString QCPDigitalTrace::busName(int index) const
+{
+  if (index < 0 || index >= mBuses.size())
+  {
+    qDebug() << Q_FUNC_INFO << "index out of bounds" << index;
+    return QString();
+  }
+  return mBuses.at(index).name;
+}
+
+/*!
+  Returns the first (least significant) channel of the bus with \a index.
+  
+  \see addBus
+*/
+int QCPDigitalTrace::busFirstChannel(int index) const
+{
+  if (index < 0 || index >= mBuses.size())
+  {
+    qDebug() << Q_FUNC_INFO << "index out of bounds" << index;
+    return -1;
+  }
+  return mBuses.at(index).firstChannel;
+}
+
+/*!
+  Returns the number of channels that form the bus with \a index.
+  
+  \see addBus
+*/
+int QCPDigitalTrace::busChannelCount(int index) const
+{
+  if (index < 0 || index >= mBuses.size())
+  {
+    qDebug() << Q_FUNC_INFO << "index out of bounds" << index;
+    return 0;
+  }
+  return mBuses.at(index).channelCount;
+}
+
+/*!
+  Replaces all transitions. \a timestamps are the keys of the transitions, and \a states the
+  packed channel states after each transition, bit \c n holding the level of channel \c n. If the
+  vectors differ in size, the surplus entries of the longer one are ignored.
+  
+  Transitions that don't change the state with respect to the preceding transition are dropped.
+  
+  If you can guarantee that \a timestamps are sorted ascending, set \a alreadySorted to true, to
+  avoid the sorting step.
+*/
+void QCPDigitalTrace::setData(const QVector<double> &timestamps, const QVector<quint64> &states, bool alreadySorted)
+{
+  const int n = qMin(timestamps.size(), states.size());
+  QVector<int> order;
+  if (!alreadySorted)
+  {
+    for (int i=1; i<n; ++i)
+    {
+      if (timestamps.at(i) < timestamps.at(i-1))
+      {
+        order.resize(n);
+        for (int k=0; k<n; ++k)
+          order[k] = k;
+        std::stable_sort(order.begin(), order.end(), QCPDigitalTraceKeyLess(timestamps.constData()));
+        break;
+      }
+    }
+  }
+  
+  mTimestamps.resize(0);
+  mStates.resize(0);
+  mTimestamps.reserve(n);
+  mStates.reserve(n);
+  for (int k=0; k<n; ++k)
+  {
+    const int source = order.isEmpty() ? k : order.at(k);
+    const quint64 state = states.at(source);
+    if (mStates.isEmpty() || state != mStates.last())
+    {
+      mTimestamps.append(timestamps.at(source));
+      mStates.append(state);
+    }
+  }
+  mTimestamps.squeeze();
+  mStates.squeeze();
+  mChangeBlocks.clear();
+}
+
+/*!
+  Sets the number of channels, i.e. the number of bits of the transition states that are
+  displayed. \a count is limited to the range 1 to 64. Buses that reach beyond the new channel
+  count are removed.
+*/
+void QCPDigitalTrace::setChannelCount(int count)
+{
+  mChannelCount = qBound(1, count, 64);
+  for (int i=mBuses.size()-1; i>=0; --i)
+  {
+    if (mBuses.at(i).firstChannel+mBuses.at(i).channelCount > mChannelCount)
+      mBuses.removeAt(i);
+  }
+  updateRows();
+}
+
+/*!
+  Sets the height of each row in value coordinates. Row \c i spans the value coordinates \c i to
+  \c i+height, so a \a height below 1 leaves a gap between neighbouring rows. \a height is limited
+  to the range 0.05 to 1.
+*/
+void QCPDigitalTrace::setRowHeight(double height)
+{
+  mRowHeight = qBound(0.05, height, 1.0);
+}
+
+/*!
+  Adds a transition to \a state at \a timestamp. Appending at the end, i.e. with a \a timestamp
+  that isn't smaller than the last one, is the fast path used when streaming a capture.
+  
+  The transition is dropped if it doesn't change the state. If it is inserted before an existing
+  transition which thereby becomes redundant, that transition is removed.
+*/
+void QCPDigitalTrace::addTransition(double timestamp, quint64 state)
+{
+  if (mTimestamps.isEmpty() || timestamp >= mTimestamps.last())
+  {
+    if (mStates.isEmpty() || state != mStates.last())
+    {
+      mTimestamps.append(timestamp);
+      mStates.append(state);
+    }
+    return;
+  }
+  
+  const int index = int(std::upper_bound(mTimestamps.constBegin(), mTimestamps.constEnd(), timestamp)-mTimestamps.constBegin());
+  if (index > 0 && mStates.at(index-1) == state)
+    return;
+  if (mStates.at(index) == state) // the following transition becomes redundant, move it instead
+  {
+    mTimestamps[index] = timestamp; // the states and thus the change blocks are unaffected
+    return;
+  }
+  mTimestamps.insert(index, timestamp);
+  mStates.insert(index, state);
+  mChangeBlocks.resize(qMin(mChangeBlocks.size(), 2*(index/QCPDigitalTraceBlockSize))); // blocks from the insertion on are shifted
+}
+
+/*!
+  Adds the transitions with \a timestamps and corresponding \a states. If the vectors differ in
+  size, the surplus entries of the longer one are ignored.
+  
+  If the transitions are sorted (set \a alreadySorted to true if you can guarantee that) and all
+  of them lie after the existing ones, they are appended directly. Otherwise the new transitions
+  are merged with the existing ones.
+  
+  \see setData
+*/
+void QCPDigitalTrace::addTransitions(const QVector<double> &timestamps, const QVector<quint64> &states, bool alreadySorted)
+{
+  const int n = qMin(timestamps.size(), states.size());
+  if (n == 0)
+    return;
+  if (!alreadySorted)
+  {
+    for (int i=1; i<n; ++i)
+    {
+      if (timestamps.at(i) < timestamps.at(i-1))
+      {
+        setData(mTimestamps+timestamps.mid(0, n), mStates+states.mid(0, n), false);
+        return;
+      }
+    }
+  }
+  if (!mTimestamps.isEmpty() && timestamps.first() < mTimestamps.last())
+  {
+    setData(mTimestamps+timestamps.mid(0, n), mStates+states.mid(0, n), false);
+    return;
+  }
+  mTimestamps.reserve(mTimestamps.size()+n);
+  mStates.reserve(mStates.size()+n);
+  for (int i=0; i<n; ++i)
+  {
+    if (mStates.isEmpty() || states.at(i) != mStates.last())
+    {
+      mTimestamps.append(timestamps.at(i));
+      mStates.append(states.at(i));
+    }
+  }
+}
+
+/*!
+  Removes all transitions. The channel count and buses are kept.
+*/
+void QCPDigitalTrace::clearData()
+{
+  mTimestamps.clear();
+  mStates.clear();
+  mChangeBlocks.clear();
+}
+
+/*!
+  Groups the \a channelCount consecutive channels starting at \a firstChannel to a bus, which is
+  displayed as a single row showing the bus value. \a firstChannel is the least significant bit of
+  the bus value. Returns the index of the new bus, or -1 if the channels are out of range or
+  overlap an existing bus.
+*/
+int QCPDigitalTrace::addBus(int firstChannel, int channelCount, const QString &name)
+{
+  if (firstChannel < 0 || channelCount < 1 || firstChannel+channelCount > mChannelCount)
+  {
+    qDebug() << Q_FUNC_INFO << "channels out of range" << firstChannel << channelCount;
+    return -1;
+  }
+  for (int i=0; i<mBuses.size(); ++i)
+  {
+    const Bus &bus = mBuses.at(i);
+    if (firstChannel < bus.firstChannel+bus.channelCount && bus.firstChannel < firstChannel+channelCount)
+    {
+      qDebug() << Q_FUNC_INFO << "channels overlap existing bus" << i;
+      return -1;
+    }
+  }
+  Bus bus;
+  bus.firstChannel = firstChannel;
+  bus.channelCount = channelCount;
+  bus.name = name;
+  mBuses.append(bus);
+  updateRows();
+  return mBuses.size()-1;
+}
+
+/*!
+  Removes the bus with \a index, so its channels are displayed in individual rows again. Returns
+  false if \a index is out of bounds.
+*/
+bool QCPDigitalTrace::removeBus(int index)
+{
+  if (index < 0 || index >= mBuses.size())
+  {
+    qDebug() << Q_FUNC_INFO << "index out of bounds" << index;
+    return false;
+  }
+  mBuses.removeAt(index);
+  updateRows();
+  return true;
+}
+
+/*!
+  Removes all buses, so every channel is displayed in its own row.
+*/
+void QCPDigitalTrace::clearBuses()
+{
+  mBuses.clear();
+  updateRows();
+}
+
+/*!
+  Returns the index of the first transition with a timestamp equal to or greater than \a key. If
+  \a expandedRange is true, the transition just below \a key is returned instead (if there is
+  one), which is the transition defining the state at \a key.
+  
+  The semantics are the same as \ref QCPDataContainer::findBegin, except that an index is returned
+  instead of an iterator. If there is no such transition, \ref transitionCount is returned.
+  
+  \see findEnd, stateAt
+*/
+int QCPDigitalTrace::findBegin(double key, bool expandedRange) const
+{
+  int index = int(std::lower_bound(mTimestamps.constBegin(), mTimestamps.constEnd(), key)-mTimestamps.constBegin());
+  if (expandedRange && index > 0)
+    --index;
+  return index;
+}
+
+/*!
+  Returns the index after the last transition with a timestamp equal to or smaller than \a key. If
+  \a expandedRange is true, the index is increased by one more transition (if there is one).
+  
+  The semantics are the same as \ref QCPDataContainer::findEnd, except that an index is returned
+  instead of an iterator.
+  
+  \see findBegin
+*/
+int QCPDigitalTrace::findEnd(double key, bool expandedRange) const
+{
+  int index = int(std::upper_bound(mTimestamps.constBegin(), mTimestamps.constEnd(), key)-mTimestamps.constBegin());
+  if (expandedRange && index < mTimestamps.size())
+    ++index;
+  return index;
+}
+
+/*!
+  Returns the packed state of all channels at \a key, i.e. the state of the last transition at or
+  before \a key. If \a key lies before the first transition, zero is returned.
+*/
+quint64 QCPDigitalTrace::stateAt(double key) const
+{
+  const int index = findEnd(key, false)-1;
+  return index >= 0 ? mStates.at(index) : 0;
+}
+
+/*!
+  Returns the number of displayed rows, i.e. the number of buses plus the number of channels that
+  aren't part of a bus.
+*/
+int QCPDigitalTrace::rowCount() const
+{
+  return mRows.size();
+}
+
+/*!
+  Returns the bit mask of the channels displayed in \a row. For a single channel, this is a single
+  bit, for a bus the bits of all its channels.
+*/
+quint64 QCPDigitalTrace::rowMask(int row) const
+{
+  if (row < 0 || row >= mRows.size())
+  {
+    qDebug() << Q_FUNC_INFO << "row out of bounds" << row;
+    return 0;
+  }
+  return mRows.at(row).mask;
+}
+
+/*!
+  Returns the row at the pixel position \a pos, or -1 if \a pos doesn't lie on a row or lies before
+  the first transition.
+  
+  \see rowMask
+*/
+int QCPDigitalTrace::rowAt(const QPointF &pos) const
+{
+  if (!mKeyAxis || !mValueAxis || mTimestamps.isEmpty())
+    return -1;
+  double posKey, posValue;
+  pixelsToCoords(pos, posKey, posValue);
+  if (posKey < mTimestamps.first())
+    return -1;
+  const double row = qFloor(posValue);
+  if (row < 0 || row >= mRows.size() || posValue-row > mRowHeight)
+    return -1;
+  return int(row);
+}
+
+/* inherits documentation from base class */
+double QCPDigitalTrace::selectTest(const QPointF &pos, bool onlySelectable, QVariant *details) const
+{
+  if ((onlySelectable && mSelectable == QCP::stNone) || mTimestamps.isEmpty())
+    return -1;
+  if (!mKeyAxis || !mValueAxis)
+    return -1;
+  
+  if (mKeyAxis.data()->axisRect()->rect().contains(pos.toPoint()) && rowAt(pos) != -1)
+  {
+    if (details)
+      details->setValue(QCPDataSelection(QCPDataRange(0, 1))); // whole-plottable selection, like QCPColorMap
+    return mParentPlot->selectionTolerance()*0.99;
+  }
+  return -1;
+}
+
+/* inherits documentation from base class */
+QCPRange QCPDigitalTrace::getKeyRange(bool &foundRange, QCP::SignDomain inSignDomain) const
+{
+  foundRange = false;
+  if (mTimestamps.isEmpty())
+    return QCPRange();
+  
+  int begin = 0, end = mTimestamps.size();
+  if (inSignDomain == QCP::sdPositive)
+    begin = findEnd(0, false);
+  else if (inSignDomain == QCP::sdNegative)
+    end = findBegin(0, false);
+  if (begin >= end)
+    return QCPRange();
+  foundRange = true;
+  return QCPRange(mTimestamps.at(begin), mTimestamps.at(end-1));
+}
+
+/* inherits documentation from base class */
+QCPRange QCPDigitalTrace::getValueRange(bool &foundRange, QCP::SignDomain inSignDomain, const QCPRange &inKeyRange) const
+{
+  Q_UNUSED(inKeyRange)
+  foundRange = !mTimestamps.isEmpty() && inSignDomain != QCP::sdNegative;
+  return foundRange ? QCPRange(0, mRows.size()-1+mRowHeight) : QCPRange();
+}
+
+/* inherits documentation from base class */
+void QCPDigitalTrace::draw(QCPPainter *painter)
+{
+  if (!mKeyAxis || !mValueAxis) { qDebug() << Q_FUNC_INFO << "invalid key or value axis"; return; }
+  if (mTimestamps.isEmpty()) return;
+  
+  // the transition defining the state at the left border, up to the last transition within the key range:
+  const QCPRange keyRange = mKeyAxis.data()->range();
+  const int begin = qMax(0, findEnd(keyRange.lower, false)-1);
+  const int end = findEnd(keyRange.upper, false);
+  if (begin >= end) return;
+  
+  QVector<RowTrace> traces;
+  getRowTraces(&traces, begin, end);
+  
+  QCPAxis *valueAxis = mValueAxis.data();
+  const bool drawSelected = selected() && mSelectionDecorator;
+  QVector<QRectF> activityRects;
+  QVector<QPointF> levelLine;
+  for (int r=0; r<traces.size(); ++r)
+  {
+    const RowTrace &trace = traces.at(r);
+    const Row &row = mRows.at(r);
+    const double lowPixel = valueAxis->coordToPixel(r);
+    const double highPixel = valueAxis->coordToPixel(r+mRowHeight);
+    
+    // draw activity bars, at least one pixel wide:
+    if (!trace.activity.isEmpty())
+    {
+      activityRects.resize(0);
+      for (int i=0; i<trace.activity.size(); ++i)
+      {
+        QCPRange range = trace.activity.at(i);
+        range.normalize();
+        if (range.size() < 1)
+          range.upper = range.lower+1;
+        activityRects.append(QRectF(pixelPoint(range.lower, lowPixel), pixelPoint(range.upper, highPixel)).normalized());
+      }
+      applyFillAntialiasingHint(painter);
+      painter->setPen(Qt::NoPen);
+      if (drawSelected)
+        mSelectionDecorator->applyBrush(painter);
+      else
+        painter->setBrush(mBrush);
+      painter->drawRects(activityRects);
+    }
+    
+    // draw the stable segments:
+    applyDefaultAntialiasingHint(painter);
+    painter->setBrush(Qt::NoBrush);
+    if (drawSelected)
+      mSelectionDecorator->applyPen(painter);
+    else
+      painter->setPen(mPen);
+    if (painter->pen().style() == Qt::NoPen || painter->pen().color().alpha() == 0)
+      continue;
+    if (row.bus >= 0)
+    {
+      drawBusRow(painter, trace, row, lowPixel, highPixel);
+    } else
+    {
+      // contiguous segments form one step line, activity bars interrupt it:
+      levelLine.resize(0);
+      for (int i=0; i<trace.segments.size(); ++i)
+      {
+        const RowTrace::Segment &segment = trace.segments.at(i);
+        if (!levelLine.isEmpty() && segment.begin != trace.segments.at(i-1).end)
+        {
+          painter->drawPolyline(levelLine.constData(), levelLine.size());
+          levelLine.resize(0);
+        }
+        const double levelPixel = segment.value ? highPixel : lowPixel;
+        levelLine.append(pixelPoint(segment.begin, levelPixel));
+        levelLine.append(pixelPoint(segment.end, levelPixel));
+      }
+      if (!levelLine.isEmpty())
+        painter->drawPolyline(levelLine.constData(), levelLine.size());
+    }
+  }
+  
+  // draw other selection decoration that isn't just line/scatter pens and brushes:
+  if (mSelectionDecorator)
+    mSelectionDecorator->drawDecoration(painter, selection());
+}
+
+/* inherits documentation from base class */
+void QCPDigitalTrace::drawLegendIcon(QCPPainter *painter, const QRectF &rect) const
+{
+  applyDefaultAntialiasingHint(painter);
+  painter->setPen(mPen);
+  painter->setBrush(Qt::NoBrush);
+  const double top = rect.top()+rect.height()*0.2;
+  const double bottom = rect.bottom()-rect.height()*0.2;
+  const double step = rect.width()/4.0;
+  QPolygonF wave;
+  wave << QPointF(rect.left(), bottom) << QPointF(rect.left()+step, bottom)
+       << QPointF(rect.left()+step, top) << QPointF(rect.left()+2*step, top)
+       << QPointF(rect.left()+2*step, bottom) << QPointF(rect.left()+3*step, bottom)
+       << QPointF(rect.left()+3*step, top) << QPointF(rect.right(), top);
+  painter->drawPolyline(wave);
+}
+
+/*! \internal
+  
+  Rebuilds the row layout from the channel count and the buses. Channels are assigned to rows in
+  ascending order, a bus taking the row of its first channel.
+*/
+void QCPDigitalTrace::updateRows()
+{
+  mRows.clear();
+  for (int channel=0; channel<mChannelCount; )
+  {
+    Row row;
+    row.bus = -1;
+    row.shift = channel;
+    row.mask = Q_UINT64_C(1) << channel;
+    int width = 1;
+    for (int i=0; i<mBuses.size(); ++i)
+    {
+      if (mBuses.at(i).firstChannel == channel)
+      {
+        row.bus = i;
+        width = mBuses.at(i).channelCount;
+        row.mask = width == 64 ? ~Q_UINT64_C(0) : ((Q_UINT64_C(1) << width)-1) << channel;
+        break;
+      }
+    }
+    mRows.append(row);
+    channel += width;
+  }
+}
+
+/*! \internal
+  
+  Brings \ref mChangeBlocks up to date with the transitions. Each complete block of \ref
+  QCPDigitalTraceBlockSize transitions is summarized by two masks: the channels changing at least
+  once and at least twice within the block, where the change of transition \c k is its state
+  XOR the state of transition \c k-1.
+  
+  Appending transitions leaves the existing blocks valid, so only the new complete blocks are
+  computed here. Modifications that shift transitions truncate \ref mChangeBlocks accordingly.
+*/
+void QCPDigitalTrace::updateChangeBlocks() const
+{
+  const int blockCount = mStates.size()/QCPDigitalTraceBlockSize;
+  const quint64 *states = mStates.constData();
+  mChangeBlocks.reserve(2*blockCount);
+  for (int b=mChangeBlocks.size()/2; b<blockCount; ++b)
+  {
+    quint64 once = 0, twice = 0;
+    for (int k=qMax(1, b*QCPDigitalTraceBlockSize); k<(b+1)*QCPDigitalTraceBlockSize; ++k)
+      qcpAccumulateChange(states[k]^states[k-1], once, twice);
+    mChangeBlocks.append(once);
+    mChangeBlocks.append(twice);
+  }
+}
+
+/*! \internal
+  
+  Accumulates the changes of the transitions [\a begin, \a end) into \a changedOnce and \a
+  changedTwice, see \ref qcpAccumulateChange. \a begin must be at least 1.
+  
+  Complete blocks within the range are taken from \ref mChangeBlocks, so only the transitions at
+  the range borders are visited individually. \ref updateChangeBlocks must have been called.
+*/
+void QCPDigitalTrace::accumulateChanges(int begin, int end, quint64 *changedOnce, quint64 *changedTwice) const
+{
+  const quint64 *states = mStates.constData();
+  const int cachedEnd = mChangeBlocks.size()/2*QCPDigitalTraceBlockSize;
+  int k = begin;
+  while (k < end && k%QCPDigitalTraceBlockSize != 0)
+  {
+    qcpAccumulateChange(states[k]^states[k-1], *changedOnce, *changedTwice);
+    ++k;
+  }
+  while (k+QCPDigitalTraceBlockSize <= qMin(end, cachedEnd))
+  {
+    const int b = k/QCPDigitalTraceBlockSize;
+    *changedTwice |= mChangeBlocks.at(2*b+1) | (*changedOnce & mChangeBlocks.at(2*b));
+    *changedOnce |= mChangeBlocks.at(2*b);
+    k += QCPDigitalTraceBlockSize;
+  }
+  while (k < end)
+  {
+    qcpAccumulateChange(states[k]^states[k-1], *changedOnce, *changedTwice);
+    ++k;
+  }
+}
+
+/*! \internal
+  
+  Fills \a traces with the pixel geometry of every row, for the transitions [\a begin, \a end).
+  Transition \a begin defines the state at the left border of the key axis range.
+  
+  The transitions are processed in groups that fall into the same pixel column of the key axis:
+  The end of a group is found by binary search, and the changed channels of the group are
+  accumulated as bit masks (channels that changed at least once and at least twice) with \ref
+  accumulateChanges. Since complete blocks of transitions are taken from the precomputed \ref
+  mChangeBlocks, a group costs about a hundred bit operations plus one per 64 transitions, and a
+  little work per affected row. A row that changes more than once within a group gets an activity
+  range covering the pixel column.
+*/
+void QCPDigitalTrace::getRowTraces(QVector<RowTrace> *traces, int begin, int end) const
+{
+  QCPAxis *keyAxis = mKeyAxis.data();
+  const QCPRange keyRange = keyAxis->range();
+  const double *timestamps = mTimestamps.constData();
+  const quint64 *states = mStates.constData();
+  const bool ascending = keyAxis->coordToPixel(keyRange.upper) >= keyAxis->coordToPixel(keyRange.lower);
+  const double startPixel = keyAxis->coordToPixel(qMax(timestamps[begin], keyRange.lower));
+  const double endPixel = keyAxis->coordToPixel(keyRange.upper);
+  
+  updateChangeBlocks();
+  const int rowCount = mRows.size();
+  traces->resize(rowCount);
+  for (int r=0; r<rowCount; ++r)
+  {
+    RowTrace &trace = (*traces)[r];
+    trace.value = states[begin] & mRows.at(r).mask;
+    trace.lastPixel = startPixel;
+    trace.activityBegin = startPixel;
+    trace.inActivity = false;
+    trace.segments.resize(0);
+    trace.activity.resize(0);
+  }
+  
+  int i = begin+1;
+  while (i < end)
+  {
+    // find the transitions that fall into the pixel column of transition i:
+    const double pixel = keyAxis->coordToPixel(timestamps[i]);
+    const double column = qFloor(pixel);
+    const double boundaryKey = keyAxis->pixelToCoord(ascending ? column+1 : column);
+    const int groupEnd = int(std::lower_bound(timestamps+i+1, timestamps+end, boundaryKey)-timestamps);
+    
+    quint64 changedOnce = 0, changedTwice = 0;
+    accumulateChanges(i, groupEnd, &changedOnce, &changedTwice);
+    
+    const quint64 newState = states[groupEnd-1];
+    const bool single = groupEnd == i+1;
+    for (int r=0; r<rowCount; ++r)
+    {
+      const quint64 mask = mRows.at(r).mask;
+      const quint64 rowChanged = changedOnce & mask;
+      if (!rowChanged)
+        continue;
+      RowTrace &trace = (*traces)[r];
+      if (single)
+        trace.add(pixel, pixel, newState & mask, false);
+      else if ((changedTwice & mask) || (rowChanged & (rowChanged-1))) // several changes of the row (for buses possibly simultaneous, which is indistinguishable at this scale)
+        trace.add(ascending ? column : column+1, ascending ? column+1 : column, newState & mask, true);
+      else
+        trace.add(column+0.5, column+0.5, newState & mask, false);
+    }
+    i = groupEnd;
+  }
+  
+  for (int r=0; r<rowCount; ++r)
+    (*traces)[r].finish(endPixel);
+}
+
+/*! \internal
+  
+  Draws the segments of a bus \a row given in \a trace, as the usual bus shape with crossings at
+  value changes, between the value pixel coordinates \a lowPixel and \a highPixel. If the key axis
+  is horizontal, the bus value is written into segments that are wide enough.
+*/
+void QCPDigitalTrace::drawBusRow(QCPPainter *painter, const RowTrace &trace, const Row &row, double lowPixel, double highPixel) const
+{
+  const double centerPixel = (lowPixel+highPixel)*0.5;
+  const bool drawLabels = mKeyAxis.data()->orientation() == Qt::Horizontal;
+  QVector<QLineF> lines;
+  lines.reserve(trace.segments.size()*6);
+  if (drawLabels)
+    painter->setFont(mParentPlot->font());
+  for (int i=0; i<trace.segments.size(); ++i)
+  {
+    const RowTrace::Segment &segment = trace.segments.at(i);
+    const double width = segment.end-segment.begin;
+    const double slant = (width < 0 ? -1 : 1)*qMin(2.0, qAbs(width)*0.5);
+    const QPointF beginCenter = pixelPoint(segment.begin, centerPixel);
+    const QPointF endCenter = pixelPoint(segment.end, centerPixel);
+    const QPointF topLeft = pixelPoint(segment.begin+slant, highPixel), topRight = pixelPoint(segment.end-slant, highPixel);
+    const QPointF bottomLeft = pixelPoint(segment.begin+slant, lowPixel), bottomRight = pixelPoint(segment.end-slant, lowPixel);
+    lines << QLineF(beginCenter, topLeft) << QLineF(topLeft, topRight) << QLineF(topRight, endCenter)
+          << QLineF(beginCenter, bottomLeft) << QLineF(bottomLeft, bottomRight) << QLineF(bottomRight, endCenter);
+    
+    if (drawLabels && qAbs(width) > 12)
+    {
+      const QString text = QLatin1String("0x") + QString::number(segment.value >> row.shift, 16).toUpper();
+      const QRectF textRect = QRectF(topLeft, bottomRight).normalized();
+      if (painter->fontMetrics().boundingRect(0, 0, 0, 0, Qt::TextDontClip, text).width() < textRect.width())
+        painter->drawText(textRect, Qt::AlignCenter, text);
+    }
+  }
+  painter->drawLines(lines);
+}
+
+/*! \internal
+  
+  Returns the pixel position of the point with key pixel coordinate \a keyPixel and value pixel
+  coordinate \a valuePixel, taking into account the orientation of the key axis.
+*/
+QPointF QCPDigitalTrace::pixelPoint(double keyPixel, double valuePixel) const
+{
+  if (mKeyAxis.data()->orientation() == Qt::Horizontal)
+    return QPointF(keyPixel, valuePixel);
+  else
+    return QPointF(valuePixel, keyPixel);
+}
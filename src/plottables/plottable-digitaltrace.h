@@ -0,0 +1,123 @@
+/***************************************************************************
+**                                                                        **
+**  QCustomPlot, an easy to use, modern plotting widget for Qt            **
+**  Copyright (C) 2011-2017 Emanuel Eichhammer                            **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+****************************************************************************
+**           Author: Emanuel Eichhammer                                   **
+**  Website/Contact: http://www.qcustomplot.com/                          **
+**             Date: 04.09.17                                             **
+**          Version: 2.0.0                                                **
+****************************************************************************/
+/*! \file */
+#ifndef QCP_PLOTTABLE_DIGITALTRACE_H
+#define QCP_PLOTTABLE_DIGITALTRACE_H
+
+#include "../global.h"
+#include "../axis/range.h"
+#include "../plottable.h"
+
+class QCPPainter;
+class QCPAxis;
+
+class QCP_LIB_DECL QCPDigitalTrace : public QCPAbstractPlottable
+{
+  Q_OBJECT
+  /// \cond INCLUDE_QPROPERTIES
+  Q_PROPERTY(int channelCount READ channelCount WRITE setChannelCount)
+  Q_PROPERTY(double rowHeight READ rowHeight WRITE setRowHeight)
+  /// \endcond
+public:
+  explicit QCPDigitalTrace(QCPAxis *keyAxis, QCPAxis *valueAxis);
+  virtual ~QCPDigitalTrace();
+  
+  // getters:
+  QVector<double> timestamps() const { return mTimestamps; }
+  QVector<quint64> states() const { return mStates; }
+  int transitionCount() const { return mTimestamps.size(); }
+  int channelCount() const { return mChannelCount; }
+  double rowHeight() const { return mRowHeight; }
+  int busCount() const { return mBuses.size(); }
+  QString busName(int index) const;
+  int busFirstChannel(int index) const;
+  int busChannelCount(int index) const;
+  
+  // setters:
+  void setData(const QVector<double> &timestamps, const QVector<quint64> &states, bool alreadySorted=false);
+  void setChannelCount(int count);
+  void setRowHeight(double height);
+  
+  // non-property methods:
+  void addTransition(double timestamp, quint64 state);
+  void addTransitions(const QVector<double> &timestamps, const QVector<quint64> &states, bool alreadySorted=false);
+  void clearData();
+  int addBus(int firstChannel, int channelCount, const QString &name=QString());
+  bool removeBus(int index);
+  void clearBuses();
+  int findBegin(double key, bool expandedRange=true) const;
+  int findEnd(double key, bool expandedRange=true) const;
+  quint64 stateAt(double key) const;
+  int rowCount() const;
+  quint64 rowMask(int row) const;
+  int rowAt(const QPointF &pos) const;
+  
+  // reimplemented virtual methods:
+  virtual double selectTest(const QPointF &pos, bool onlySelectable, QVariant *details=0) const Q_DECL_OVERRIDE;
+  virtual QCPRange getKeyRange(bool &foundRange, QCP::SignDomain inSignDomain=QCP::sdBoth) const Q_DECL_OVERRIDE;
+  virtual QCPRange getValueRange(bool &foundRange, QCP::SignDomain inSignDomain=QCP::sdBoth, const QCPRange &inKeyRange=QCPRange()) const Q_DECL_OVERRIDE;
+  
+protected:
+  struct Bus
+  {
+    int firstChannel;
+    int channelCount;
+    QString name;
+  };
+  struct Row
+  {
+    quint64 mask;
+    int bus; // index in mBuses, or -1 for a single channel
+    int shift;
+  };
+  struct RowTrace;
+  
+  // property members:
+  QVector<double> mTimestamps;
+  QVector<quint64> mStates;
+  int mChannelCount;
+  double mRowHeight;
+  QList<Bus> mBuses;
+  // non-property members:
+  QVector<Row> mRows;
+  mutable QVector<quint64> mChangeBlocks;
+  
+  // reimplemented virtual methods:
+  virtual void draw(QCPPainter *painter) Q_DECL_OVERRIDE;
+  virtual void drawLegendIcon(QCPPainter *painter, const QRectF &rect) const Q_DECL_OVERRIDE;
+  
+  // non-virtual methods:
+  void updateRows();
+  void updateChangeBlocks() const;
+  void accumulateChanges(int begin, int end, quint64 *changedOnce, quint64 *changedTwice) const;
+  void getRowTraces(QVector<RowTrace> *traces, int begin, int end) const;
+  void drawBusRow(QCPPainter *painter, const RowTrace &trace, const Row &row, double lowPixel, double highPixel) const;
+  QPointF pixelPoint(double keyPixel, double valuePixel) const;
+  
+  friend class QCustomPlot;
+  friend class QCPLegend;
+};
+
+#endif // QCP_PLOTTABLE_DIGITALTRACE_H
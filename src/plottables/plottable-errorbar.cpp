@@ -547,6 +547,11 @@ void QCPErrorBars::draw(QCPPainter *painter)
       if (!checkPointVisibility || errorBarVisible(it-mDataContainer->constBegin()))
         getErrorBarLines(it, backbones, whiskers);
     }
+    if (!painter->modes().testFlag(QCPPainter::pmVectorized)) // dense error bars overlap on screen, draw each covered pixel span once
+    {
+      mergeLineSpans(backbones);
+      mergeLineSpans(whiskers);
+    }
     painter->drawLines(backbones);
     painter->drawLines(whiskers);
   }
@@ -735,6 +740,49 @@ QCPRange QCPErrorBars::getValueRange(bool &foundRange, QCP::SignDomain inSignDom
   return range;
 }
 
+/*! \internal
+
+  Merges overlapping axis-parallel \a lines in place, as generated by \ref getErrorBarLines: A line
+  is merged into one of the two previously kept lines, if both have the same orientation, lie in
+  the same pixel column (or row, for horizontal lines) and their extents overlap or touch. Lines
+  with a gap in between are kept separate, so gaps stay visible. Comparing with the two previous lines catches the alternating plus and minus error
+  lines of consecutive data points.
+  
+  For densely packed error bars of sorted data, this reduces the backbones and whiskers to roughly
+  one span per pixel column, without changing the rendered result beyond sub-pixel positions.
+*/
+void QCPErrorBars::mergeLineSpans(QVector<QLineF> &lines) const
+{
+  int kept = 0;
+  for (int i=0; i<lines.size(); ++i)
+  {
+    const QLineF line = lines.at(i);
+    const bool vertical = line.x1() == line.x2();
+    const double position = vertical ? line.x1() : line.y1();
+    const double lower = vertical ? qMin(line.y1(), line.y2()) : qMin(line.x1(), line.x2());
+    const double upper = vertical ? qMax(line.y1(), line.y2()) : qMax(line.x1(), line.x2());
+    bool merged = false;
+    for (int k=kept-1; k>=qMax(0, kept-2) && !merged; --k)
+    {
+      QLineF &other = lines[k];
+      const bool otherVertical = other.x1() == other.x2();
+      if (otherVertical != vertical || std::floor(vertical ? other.x1() : other.y1()) != std::floor(position))
+        continue;
+      const double otherLower = vertical ? qMin(other.y1(), other.y2()) : qMin(other.x1(), other.x2());
+      const double otherUpper = vertical ? qMax(other.y1(), other.y2()) : qMax(other.x1(), other.x2());
+      if (lower > otherUpper || upper < otherLower)
+        continue;
+      const double otherPosition = vertical ? other.x1() : other.y1();
+      const double newLower = qMin(lower, otherLower), newUpper = qMax(upper, otherUpper);
+      other = vertical ? QLineF(otherPosition, newLower, otherPosition, newUpper) : QLineF(newLower, otherPosition, newUpper, otherPosition);
+      merged = true;
+    }
+    if (!merged)
+      lines[kept++] = line;
+  }
+  lines.resize(kept);
+}
+
 /*! \internal
 
   Calculates the lines that make up the error bar belonging to the data point \a it.
@@ -26,6 +26,7 @@
 #include "plottable-graph.h"
 
 #include "../painter.h"
+#include "../linerasterizer.h"
 #include "../core.h"
 #include "../axis/axis.h"
 #include "../layoutelements/layoutelement-axisrect.h"
@@ -169,6 +170,9 @@ QCPGraphData::QCPGraphData(double key, double value) :
   Returns a shared pointer to the internal data storage of type \ref QCPGraphDataContainer. You may
   use it to directly manipulate the data, which may be more convenient and faster than using the
   regular \ref setData or \ref addData methods.
+  
+  This method as well as \ref setData and \ref addData are virtual, so subclasses which store their
+  data differently (e.g. \ref QCPCompactGraph) receive data passed to any graph of the plot.
 */
 
 /* end of documentation of inline functions */
@@ -186,7 +190,11 @@ QCPGraphData::QCPGraphData(double key, double value) :
   To directly create a graph inside a plot, you can also use the simpler QCustomPlot::addGraph function.
 */
 QCPGraph::QCPGraph(QCPAxis *keyAxis, QCPAxis *valueAxis) :
-  QCPAbstractPlottable1D<QCPGraphData>(keyAxis, valueAxis)
+  QCPAbstractPlottable1D<QCPGraphData>(keyAxis, valueAxis),
+  mReplotLinesCount(0),
+  mLogKeysOffset(0),
+  mLogKeysRevision(0),
+  mLogKeysFrontRemovals(0)
 {
   // special handling for QCPGraphs to maintain the simple graph interface:
   mParentPlot->registerGraph(this);
@@ -425,7 +433,7 @@ QCPRange QCPGraph::getValueRange(bool &foundRange, QCP::SignDomain inSignDomain,
 void QCPGraph::draw(QCPPainter *painter)
 {
   if (!mKeyAxis || !mValueAxis) { qDebug() << Q_FUNC_INFO << "invalid key or value axis"; return; }
-  if (mKeyAxis.data()->range().size() <= 0 || mDataContainer->isEmpty()) return;
+  if (mKeyAxis.data()->range().size() <= 0 || dataCount() == 0) return;
   if (mLineStyle == lsNone && mScatterStyle.isNone()) return;
   
   QVector<QPointF> lines, scatters; // line and (if necessary) scatter pixel coordinates will be stored here while iterating over segments
@@ -439,7 +447,10 @@ void QCPGraph::draw(QCPPainter *painter)
     bool isSelectedSegment = i >= unselectedSegments.size();
     // get line pixel points appropriate to line style:
     QCPDataRange lineDataRange = isSelectedSegment ? allSegments.at(i) : allSegments.at(i).adjusted(-1, 1); // unselected segments extend lines to bordering selected data point (safe to exceed total data bounds in first/last segment, getLines takes care)
-    getLines(&lines, lineDataRange);
+    if (allSegments.size() == 1) // single segment spans all data, so use the lines that are shared with graphs which have this graph as channel fill target
+      lines = getReplotLines();
+    else
+      getLines(&lines, lineDataRange);
     
     // check data validity if flag set:
 #ifdef QCUSTOMPLOT_CHECK_DATA
@@ -524,6 +535,20 @@ void QCPGraph::drawLegendIcon(QCPPainter *painter, const QRectF &rect) const
   }
 }
 
+/* inherits documentation from base class */
+void QCPGraph::prepareDraw()
+{
+  if (!mKeyAxis || !mValueAxis) return;
+  if (mKeyAxis.data()->range().size() <= 0 || dataCount() == 0) return;
+  if (mLineStyle == lsNone && mScatterStyle.isNone()) return;
+  
+  // only the unsegmented case uses the cached replot lines in draw, see there:
+  QList<QCPDataRange> selectedSegments, unselectedSegments;
+  getDataSegments(selectedSegments, unselectedSegments);
+  if (selectedSegments.size()+unselectedSegments.size() == 1)
+    getReplotLines();
+}
+
 /*! \internal
 
   This method retrieves an optimized set of data points via \ref getOptimizedLineData, an branches
@@ -562,15 +587,57 @@ void QCPGraph::getLines(QVector<QPointF> *lines, const QCPDataRange &dataRange)
   if (mKeyAxis->rangeReversed() != (mKeyAxis->orientation() == Qt::Vertical)) // make sure key pixels are sorted ascending in lineData (significantly simplifies following processing)
     std::reverse(lineData.begin(), lineData.end());
 
+  *lines = dataToLineStyleLines(lineData);
+}
+
+/*! \internal
+
+  Returns the pixel lines of the entire data range, as \ref getLines would produce them for the
+  range (0, \ref dataCount()).
+
+  While the parent plot is replotting, the lines are calculated only once per replot and then
+  shared (implicitly) between this graph's own \ref draw and all graphs that use this graph as
+  channel fill target (see \ref setChannelFillGraph). Outside of a replot, e.g. when exporting
+  via \ref QCustomPlot::toPainter, the lines are calculated anew on each call.
+*/
+QVector<QPointF> QCPGraph::getReplotLines() const
+{
+  if (mParentPlot && mParentPlot->mReplotting)
+  {
+    if (mReplotLinesCount != mParentPlot->mReplotCount)
+    {
+      getLines(&mReplotLines, QCPDataRange(0, dataCount()));
+      mReplotLinesCount = mParentPlot->mReplotCount;
+    }
+    return mReplotLines;
+  }
+  QVector<QPointF> result;
+  getLines(&result, QCPDataRange(0, dataCount()));
+  return result;
+}
+
+/*! \internal
+
+  Converts the (already optimized) data points in \a data to pixel coordinates by branching out to
+  the line style specific functions such as \ref dataToLines, \ref dataToStepLeftLines, etc.,
+  according to the line style of the graph. If the line style is \ref lsNone, returns an empty
+  vector.
+
+  \a data is expected to be sorted such that the key pixels are ascending, as is ensured by \ref
+  getLines.
+*/
+QVector<QPointF> QCPGraph::dataToLineStyleLines(const QVector<QCPGraphData> &data) const
+{
   switch (mLineStyle)
   {
-    case lsNone: lines->clear(); break;
-    case lsLine: *lines = dataToLines(lineData); break;
-    case lsStepLeft: *lines = dataToStepLeftLines(lineData); break;
-    case lsStepRight: *lines = dataToStepRightLines(lineData); break;
-    case lsStepCenter: *lines = dataToStepCenterLines(lineData); break;
-    case lsImpulse: *lines = dataToImpulseLines(lineData); break;
+    case lsNone: break;
+    case lsLine: return dataToLines(data);
+    case lsStepLeft: return mergeStepLines(dataToStepLeftLines(data));
+    case lsStepRight: return mergeStepLines(dataToStepRightLines(data));
+    case lsStepCenter: return mergeStepLines(dataToStepCenterLines(data));
+    case lsImpulse: return dataToImpulseLines(data);
   }
+  return QVector<QPointF>();
 }
 
 /*! \internal
@@ -606,15 +673,45 @@ void QCPGraph::getScatters(QVector<QPointF> *scatters, const QCPDataRange &dataR
   if (mKeyAxis->rangeReversed() != (mKeyAxis->orientation() == Qt::Vertical)) // make sure key pixels are sorted ascending in data (significantly simplifies following processing)
     std::reverse(data.begin(), data.end());
   
-  scatters->resize(data.size());
+  *scatters = dataToScatters(data);
+}
+
+/*! \internal
+
+  Takes raw data points in plot coordinates as \a data, and returns a vector containing the
+  corresponding pixel coordinates, suitable for \ref drawScatterPlot. Points with a NaN value are
+  left default-constructed in the result.
+
+  The source of \a data is usually \ref getOptimizedScatterData, and this method is called in \ref
+  getScatters.
+*/
+QVector<QPointF> QCPGraph::dataToScatters(const QVector<QCPGraphData> &data) const
+{
+  QVector<QPointF> result;
+  QCPAxis *keyAxis = mKeyAxis.data();
+  QCPAxis *valueAxis = mValueAxis.data();
+  if (!keyAxis || !valueAxis) { qDebug() << Q_FUNC_INFO << "invalid key or value axis"; return result; }
+  
+  if (keyAxis->scaleType() == QCPAxis::stCustom || valueAxis->scaleType() == QCPAxis::stCustom)
+  {
+    result = dataToPixelsBatched(data);
+    for (int i=0; i<data.size(); ++i)
+    {
+      if (qIsNaN(data.at(i).value))
+        result[i] = QPointF();
+    }
+    return result;
+  }
+  
+  result.resize(data.size());
   if (keyAxis->orientation() == Qt::Vertical)
   {
     for (int i=0; i<data.size(); ++i)
     {
       if (!qIsNaN(data.at(i).value))
       {
-        (*scatters)[i].setX(valueAxis->coordToPixel(data.at(i).value));
-        (*scatters)[i].setY(keyAxis->coordToPixel(data.at(i).key));
+        result[i].setX(valueAxis->coordToPixel(data.at(i).value));
+        result[i].setY(keyAxis->coordToPixel(data.at(i).key));
       }
     }
   } else
@@ -623,11 +720,47 @@ void QCPGraph::getScatters(QVector<QPointF> *scatters, const QCPDataRange &dataR
     {
       if (!qIsNaN(data.at(i).value))
       {
-        (*scatters)[i].setX(keyAxis->coordToPixel(data.at(i).key));
-        (*scatters)[i].setY(valueAxis->coordToPixel(data.at(i).value));
+        result[i].setX(keyAxis->coordToPixel(data.at(i).key));
+        result[i].setY(valueAxis->coordToPixel(data.at(i).value));
       }
     }
   }
+  return result;
+}
+
+/*! \internal
+  
+  Returns the pixel positions of the data points \a data. The keys and values are transformed in
+  two batches with \ref QCPAxis::coordsToPixels, so axes with a custom scale (\ref
+  QCPAxis::stCustom) apply their scale transform once per batch instead of once per coordinate.
+  
+  This is used by \ref dataToLines and \ref dataToScatters if one of the axes has a custom scale.
+*/
+QVector<QPointF> QCPGraph::dataToPixelsBatched(const QVector<QCPGraphData> &data) const
+{
+  QCPAxis *keyAxis = mKeyAxis.data();
+  QCPAxis *valueAxis = mValueAxis.data();
+  const int n = data.size();
+  QVector<double> keyPixels(n), valuePixels(n);
+  for (int i=0; i<n; ++i)
+  {
+    keyPixels[i] = data.at(i).key;
+    valuePixels[i] = data.at(i).value;
+  }
+  keyAxis->coordsToPixels(keyPixels.constData(), keyPixels.data(), n);
+  valueAxis->coordsToPixels(valuePixels.constData(), valuePixels.data(), n);
+  
+  QVector<QPointF> result(n);
+  if (keyAxis->orientation() == Qt::Vertical)
+  {
+    for (int i=0; i<n; ++i)
+      result[i] = QPointF(valuePixels.at(i), keyPixels.at(i));
+  } else
+  {
+    for (int i=0; i<n; ++i)
+      result[i] = QPointF(keyPixels.at(i), valuePixels.at(i));
+  }
+  return result;
 }
 
 /*! \internal
@@ -646,6 +779,9 @@ QVector<QPointF> QCPGraph::dataToLines(const QVector<QCPGraphData> &data) const
   QCPAxis *keyAxis = mKeyAxis.data();
   QCPAxis *valueAxis = mValueAxis.data();
   if (!keyAxis || !valueAxis) { qDebug() << Q_FUNC_INFO << "invalid key or value axis"; return result; }
+  
+  if (keyAxis->scaleType() == QCPAxis::stCustom || valueAxis->scaleType() == QCPAxis::stCustom)
+    return dataToPixelsBatched(data);
 
   result.resize(data.size());
   
@@ -824,6 +960,107 @@ QVector<QPointF> QCPGraph::dataToStepCenterLines(const QVector<QCPGraphData> &da
   return result;
 }
 
+/*! \internal
+  
+  Appends \a point to the step line \a lines, unless it duplicates the last point. If the last two
+  points and \a point lie on one horizontal or vertical line and \a point continues in the same
+  direction, the last point is moved to \a point instead of appending it. \a keyIsX specifies
+  which coordinate is the key.
+*/
+static inline void qcpAppendStepPoint(QVector<QPointF> &lines, const QPointF &point, bool keyIsX)
+{
+  const int n = lines.size();
+  if (n > 0)
+  {
+    const QPointF &b = lines.at(n-1);
+    if (b == point)
+      return;
+    if (n > 1)
+    {
+      const QPointF &a = lines.at(n-2);
+      const double ak = keyIsX ? a.x() : a.y(), av = keyIsX ? a.y() : a.x();
+      const double bk = keyIsX ? b.x() : b.y(), bv = keyIsX ? b.y() : b.x();
+      const double pk = keyIsX ? point.x() : point.y(), pv = keyIsX ? point.y() : point.x();
+      if ((av == bv && bv == pv && (pk-bk)*(bk-ak) >= 0) || // continues horizontal run
+          (ak == bk && bk == pk && (pv-bv)*(bv-av) >= 0)) // continues vertical run
+      {
+        lines[n-1] = point;
+        return;
+      }
+    }
+  }
+  lines.append(point);
+}
+
+/*! \internal
+  
+  Takes the pixel coordinate points \a lines of a step line style (see \ref dataToStepLeftLines,
+  \ref dataToStepRightLines and \ref dataToStepCenterLines) and returns an equivalent line with
+  fewer points.
+  
+  Consecutive points that fall into the same pixel column (in key direction) are collapsed to a
+  vertical span consisting of the first point, the minimum and maximum value, and the last point
+  of the column. Then duplicate points are removed and collinear horizontal and vertical runs are
+  merged into single segments. The drawn result is the same, but a step line with far more steps
+  than pixels costs at most about four points per pixel column, and long constant stretches cost
+  only two points.
+  
+  NaN points are passed through, so gaps are preserved.
+*/
+QVector<QPointF> QCPGraph::mergeStepLines(const QVector<QPointF> &lines) const
+{
+  QVector<QPointF> result;
+  if (!mKeyAxis) return result;
+  const bool keyIsX = mKeyAxis.data()->orientation() == Qt::Horizontal;
+  const int n = lines.size();
+  result.reserve(n);
+  
+  int i = 0;
+  while (i < n)
+  {
+    const QPointF &first = lines.at(i);
+    const double firstValue = keyIsX ? first.y() : first.x();
+    if (qIsNaN(firstValue))
+    {
+      result.append(first);
+      ++i;
+      continue;
+    }
+    // find points in the same pixel column:
+    const double column = std::floor(keyIsX ? first.x() : first.y());
+    double minValue = firstValue, maxValue = firstValue;
+    int j = i+1;
+    while (j < n)
+    {
+      const QPointF &p = lines.at(j);
+      const double value = keyIsX ? p.y() : p.x();
+      if (qIsNaN(value) || std::floor(keyIsX ? p.x() : p.y()) != column)
+        break;
+      if (value < minValue)
+        minValue = value;
+      else if (value > maxValue)
+        maxValue = value;
+      ++j;
+    }
+    
+    const QPointF &last = lines.at(j-1);
+    qcpAppendStepPoint(result, first, keyIsX);
+    if (j-i > 2) // collapse the column to a vertical span, keeping the entry and exit point
+    {
+      const double lastValue = keyIsX ? last.y() : last.x();
+      const double spanKey = keyIsX ? first.x() : first.y();
+      if (minValue < qMin(firstValue, lastValue))
+        qcpAppendStepPoint(result, keyIsX ? QPointF(spanKey, minValue) : QPointF(minValue, spanKey), keyIsX);
+      if (maxValue > qMax(firstValue, lastValue))
+        qcpAppendStepPoint(result, keyIsX ? QPointF(spanKey, maxValue) : QPointF(maxValue, spanKey), keyIsX);
+    }
+    if (j-i > 1)
+      qcpAppendStepPoint(result, last, keyIsX);
+    i = j;
+  }
+  return result;
+}
+
 /*! \internal
 
   Takes raw data points in plot coordinates as \a data, and returns a vector containing pixel
@@ -831,6 +1068,12 @@ QVector<QPointF> QCPGraph::dataToStepCenterLines(const QVector<QCPGraphData> &da
   
   The source of \a data is usually \ref getOptimizedLineData, and this method is called in \a
   getLines if the line style is set accordingly.
+  
+  If adaptive sampling is enabled (\ref setAdaptiveSampling), consecutive impulses whose keys fall
+  into the same pixel column are reduced to a single impulse, spanning from the lowest to the
+  highest of their values and the zero line. Since all impulses start at the zero line, this is
+  their union, so dense stem plots (e.g. spectra) look the same but only one line per pixel column
+  is drawn.
 
   \see dataToLines, dataToStepLeftLines, dataToStepRightLines, dataToStepCenterLines, getLines, drawImpulsePlot
 */
@@ -841,32 +1084,242 @@ QVector<QPointF> QCPGraph::dataToImpulseLines(const QVector<QCPGraphData> &data)
   QCPAxis *valueAxis = mValueAxis.data();
   if (!keyAxis || !valueAxis) { qDebug() << Q_FUNC_INFO << "invalid key or value axis"; return result; }
   
-  result.resize(data.size()*2);
+  const bool keyIsVertical = keyAxis->orientation() == Qt::Vertical;
+  const double basePixel = valueAxis->coordToPixel(0);
+  result.reserve(data.size()*2);
   
-  // transform data points to pixels:
-  if (keyAxis->orientation() == Qt::Vertical)
+  // transform data points to pixels, merging impulses of the same pixel column if adaptive sampling is enabled:
+  int i = 0;
+  double keyPixel = data.isEmpty() ? 0 : keyAxis->coordToPixel(data.first().key);
+  while (i < data.size())
   {
-    for (int i=0; i<data.size(); ++i)
+    double lowPixel = valueAxis->coordToPixel(data.at(i).value);
+    double highPixel = lowPixel;
+    double nextKeyPixel = 0;
+    int j = i+1;
+    if (j < data.size())
+      nextKeyPixel = keyAxis->coordToPixel(data.at(j).key);
+    if (mAdaptiveSampling && !qIsNaN(lowPixel))
     {
-      const double key = keyAxis->coordToPixel(data.at(i).key);
-      result[i*2+0].setX(valueAxis->coordToPixel(0));
-      result[i*2+0].setY(key);
-      result[i*2+1].setX(valueAxis->coordToPixel(data.at(i).value));
-      result[i*2+1].setY(key);
+      const double column = std::floor(keyPixel);
+      while (j < data.size() && std::floor(nextKeyPixel) == column)
+      {
+        const double valuePixel = valueAxis->coordToPixel(data.at(j).value);
+        if (qIsNaN(valuePixel))
+          break;
+        if (valuePixel < lowPixel)
+          lowPixel = valuePixel;
+        else if (valuePixel > highPixel)
+          highPixel = valuePixel;
+        ++j;
+        if (j < data.size())
+          nextKeyPixel = keyAxis->coordToPixel(data.at(j).key);
+      }
+      if (j > i+1) // several impulses merged, the span must include the zero line
+      {
+        lowPixel = qMin(lowPixel, basePixel);
+        highPixel = qMax(highPixel, basePixel);
+      }
     }
-  } else // key axis is horizontal
+    
+    const double startPixel = j > i+1 ? lowPixel : basePixel;
+    const double endPixel = j > i+1 ? highPixel : lowPixel;
+    if (keyIsVertical)
+      result << QPointF(startPixel, keyPixel) << QPointF(endPixel, keyPixel);
+    else
+      result << QPointF(keyPixel, startPixel) << QPointF(keyPixel, endPixel);
+    i = j;
+    keyPixel = nextKeyPixel;
+  }
+  return result;
+}
+
+/*! \internal
+  
+  Rasterizes the area enclosed by monotone (in key pixel direction) boundary lines into spans of
+  one pixel column each, as used by \ref QCPGraph::drawFill for dense fills.
+  
+  Every boundary added with \ref addBoundary extends the value range of each pixel column it
+  passes through, and marks the column with the boundary's \a mask bit. \ref rects then returns one
+  rect per run of columns with equal span, restricted to columns that are covered by all required
+  boundaries. For antialiased fills, \ref blend instead writes the spans with fractional coverage
+  at their ends directly into the painter's image. The columns are limited to \a clipRect, so boundaries that extend far outside the
+  visible area don't cost anything beyond iterating their points.
+*/
+class QCPGraphFillSpans
+{
+public:
+  QCPGraphFillSpans(bool keyIsX, const QRect &clipRect) :
+    mKeyIsX(keyIsX),
+    mFirstColumn(keyIsX ? clipRect.left()-1 : clipRect.top()-1),
+    mColumnCount((keyIsX ? clipRect.width() : clipRect.height())+2),
+    mValueLower(keyIsX ? clipRect.top()-1 : clipRect.left()-1),
+    mValueUpper(keyIsX ? clipRect.bottom()+2 : clipRect.right()+2),
+    mMin(qMax(0, mColumnCount), std::numeric_limits<double>::max()),
+    mMax(qMax(0, mColumnCount), -std::numeric_limits<double>::max()),
+    mKeyMin(qMax(0, mColumnCount), std::numeric_limits<double>::max()),
+    mKeyMax(qMax(0, mColumnCount), -std::numeric_limits<double>::max()),
+    mMask(qMax(0, mColumnCount), 0)
+  {}
+  
+  /*! Adds the line through the points of \a lineData within \a segment, which must be sorted
+    ascending by key pixel and not contain NaN points. */
+  void addBoundary(const QVector<QPointF> *lineData, const QCPDataRange &segment, int mask)
   {
-    for (int i=0; i<data.size(); ++i)
+    const QPointF *points = lineData->constData();
+    if (segment.size() == 1)
     {
-      const double key = keyAxis->coordToPixel(data.at(i).key);
-      result[i*2+0].setX(key);
-      result[i*2+0].setY(valueAxis->coordToPixel(0));
-      result[i*2+1].setX(key);
-      result[i*2+1].setY(valueAxis->coordToPixel(data.at(i).value));
+      const double k = key(points[segment.begin()]);
+      const double v = value(points[segment.begin()]);
+      include(qFloor(k), k, k, v, v, mask);
+      return;
+    }
+    const int lastColumn = mFirstColumn+mColumnCount-1;
+    for (int i=segment.begin(); i<segment.end()-1; ++i)
+    {
+      const double ka = key(points[i]), kb = key(points[i+1]);
+      const double va = value(points[i]), vb = value(points[i+1]);
+      if (kb < mFirstColumn || ka >= lastColumn+1)
+        continue;
+      const int c0 = qMax(qFloor(ka), mFirstColumn);
+      const int c1 = qMin(qFloor(kb), lastColumn);
+      if (c0 == c1 || kb <= ka) // segment lies within one column (e.g. vertical step)
+      {
+        include(c0, ka, kb, va, vb, mask);
+        continue;
+      }
+      const double slope = (vb-va)/(kb-ka);
+      for (int c=c0; c<=c1; ++c)
+      {
+        // value range of the segment within the column [c, c+1):
+        const double lower = qMax(ka, (double)c);
+        const double upper = qMin(kb, c+1.0);
+        include(c, lower, upper, va+slope*(lower-ka), va+slope*(upper-ka), mask);
+      }
     }
   }
-  return result;
-}
+  
+  /*! Returns the spans of all columns covered by every boundary bit in \a requiredMask. If \a
+    baseValue isn't NaN, each span is extended to include it. */
+  QVector<QRect> rects(int requiredMask, double baseValue) const
+  {
+    QVector<QRect> result;
+    int runBegin = 0, runLower = 0, runUpper = 0;
+    bool inRun = false;
+    for (int c=0; c<=mColumnCount; ++c)
+    {
+      bool covered = c < mColumnCount && (mMask.at(c) & requiredMask) == requiredMask;
+      int lower = 0, upper = 0;
+      if (covered)
+      {
+        double minValue = mMin.at(c), maxValue = mMax.at(c);
+        if (!qIsNaN(baseValue))
+        {
+          minValue = qMin(minValue, baseValue);
+          maxValue = qMax(maxValue, baseValue);
+        }
+        lower = qFloor(qBound(mValueLower, minValue, mValueUpper));
+        upper = qCeil(qBound(mValueLower, maxValue, mValueUpper));
+        covered = upper > lower;
+      }
+      if (inRun && (!covered || lower != runLower || upper != runUpper)) // close current run
+      {
+        if (mKeyIsX)
+          result.append(QRect(mFirstColumn+runBegin, runLower, c-runBegin, runUpper-runLower));
+        else
+          result.append(QRect(runLower, mFirstColumn+runBegin, runUpper-runLower, c-runBegin));
+        inRun = false;
+      }
+      if (covered && !inRun)
+      {
+        runBegin = c;
+        runLower = lower;
+        runUpper = upper;
+        inRun = true;
+      }
+    }
+    return result;
+  }
+  
+  /*! Draws the spans of all columns covered by every boundary bit in \a requiredMask with the brush
+    of \a painter, antialiased: The pixels at the span ends and the columns at the key ends of the
+    boundaries are blended with the fraction of them that is covered. If \a baseValue isn't NaN,
+    each span is extended to include it.
+    
+    The spans are written directly into the painter's image with \ref QCPLineRasterizer, if the
+    painter draws on a \ref QCPPaintBufferImage (or another suitable image). Otherwise they are
+    rasterized into a temporary image of the clip rect size, which is then drawn with \a painter.
+    Must not be used with vectorized painters. */
+  void blend(QCPPainter *painter, int requiredMask, double baseValue) const
+  {
+    QCPLineRasterizer rasterizer(painter, QCPLineRasterizer::csBrush);
+    if (rasterizer.isValid())
+    {
+      blend(&rasterizer, requiredMask, baseValue);
+      return;
+    }
+    const QRect area = mKeyIsX ? QRect(mFirstColumn, (int)mValueLower, mColumnCount, (int)(mValueUpper-mValueLower)) :
+                                 QRect((int)mValueLower, mFirstColumn, (int)(mValueUpper-mValueLower), mColumnCount);
+    if (area.isEmpty())
+      return;
+    QImage image(area.size(), QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    QCPPainter imagePainter(&image);
+    imagePainter.translate(-area.topLeft());
+    imagePainter.setBrush(QBrush(painter->brush().color()));
+    QCPLineRasterizer imageRasterizer(&imagePainter, QCPLineRasterizer::csBrush);
+    blend(&imageRasterizer, requiredMask, baseValue);
+    imagePainter.end();
+    painter->drawImage(area.topLeft(), image);
+  }
+  
+private:
+  bool mKeyIsX;
+  int mFirstColumn, mColumnCount;
+  double mValueLower, mValueUpper;
+  QVector<double> mMin, mMax;
+  QVector<double> mKeyMin, mKeyMax;
+  QVector<int> mMask;
+  
+  double key(const QPointF &p) const { return mKeyIsX ? p.x() : p.y(); }
+  double value(const QPointF &p) const { return mKeyIsX ? p.y() : p.x(); }
+  
+  void include(int column, double k1, double k2, double v1, double v2, int mask)
+  {
+    const int index = column-mFirstColumn;
+    if (index < 0 || index >= mColumnCount)
+      return;
+    if (v1 > v2)
+      qSwap(v1, v2);
+    if (v1 < mMin.at(index))
+      mMin[index] = v1;
+    if (v2 > mMax.at(index))
+      mMax[index] = v2;
+    if (k1 < mKeyMin.at(index))
+      mKeyMin[index] = k1;
+    if (k2 > mKeyMax.at(index))
+      mKeyMax[index] = k2;
+    mMask[index] |= mask;
+  }
+  
+  void blend(QCPLineRasterizer *rasterizer, int requiredMask, double baseValue) const
+  {
+    for (int c=0; c<mColumnCount; ++c)
+    {
+      if ((mMask.at(c) & requiredMask) != requiredMask)
+        continue;
+      double minValue = mMin.at(c), maxValue = mMax.at(c);
+      if (!qIsNaN(baseValue))
+      {
+        minValue = qMin(minValue, baseValue);
+        maxValue = qMax(maxValue, baseValue);
+      }
+      const double column = mFirstColumn+c;
+      const double columnCoverage = qMin(mKeyMax.at(c), column+1.0)-qMax(mKeyMin.at(c), column);
+      rasterizer->fillSpan(mFirstColumn+c, qBound(mValueLower, minValue, mValueUpper), qBound(mValueLower, maxValue, mValueUpper), columnCoverage, !mKeyIsX);
+    }
+  }
+};
 
 /*! \internal
   
@@ -881,6 +1334,17 @@ QVector<QPointF> QCPGraph::dataToImpulseLines(const QVector<QCPGraphData> &data)
   segments of the two involved graphs, before passing the overlapping pairs to \ref
   getChannelFillPolygon.
   
+  If the lines are dense, i.e. have more than two points per pixel along the key axis, and the
+  painter isn't vectorized (\ref QCPPainter::pmVectorized), polygons with that many vertices are
+  expensive to rasterize. In that case, the fill is instead reduced to one value span per pixel
+  column (exploiting that the lines are monotone in key direction), at a cost proportional to the
+  number of points plus the axis rect size. Non-antialiased fills draw the spans as a set of rects,
+  which yields the same pixel aligned shape as the polygon. Antialiased fills (see \ref
+  setAntialiasedFill and \ref QCP::aeFills) blend the spans with fractional coverage at their ends
+  directly into the pixels of the paint buffer (see \ref QCPLineRasterizer), so their edges stay
+  smooth. Since this only supports solid colors, antialiased fills with other brush styles use the
+  polygon.
+  
   Pass the points of this graph's line as \a lines, in pixel coordinates.
 
   \see drawLinePlot, drawImpulsePlot, drawScatterPlot
@@ -890,24 +1354,58 @@ void QCPGraph::drawFill(QCPPainter *painter, QVector<QPointF> *lines) const
   if (mLineStyle == lsImpulse) return; // fill doesn't make sense for impulse plot
   if (painter->brush().style() == Qt::NoBrush || painter->brush().color().alpha() == 0) return;
   
+  const bool keyIsX = keyAxis()->orientation() == Qt::Horizontal;
+  const QRect clip = clipRect();
   applyFillAntialiasingHint(painter);
+  const bool blendSpans = painter->antialiasing();
+  const bool useSpans = !painter->modes().testFlag(QCPPainter::pmVectorized) && lines->size() > 2*(keyIsX ? clip.width() : clip.height()) &&
+                        (!blendSpans || painter->brush().style() == Qt::SolidPattern);
   QVector<QCPDataRange> segments = getNonNanSegments(lines, keyAxis()->orientation());
   if (!mChannelFillGraph)
   {
     // draw base fill under graph, fill goes all the way to the zero-value-line:
-    for (int i=0; i<segments.size(); ++i)
-      painter->drawPolygon(getFillPolygon(lines, segments.at(i)));
+    if (useSpans)
+    {
+      if (segments.isEmpty()) return;
+      QCPGraphFillSpans spans(keyIsX, clip);
+      for (int i=0; i<segments.size(); ++i)
+        spans.addBoundary(lines, segments.at(i), 1);
+      const QPointF basePoint = getFillBasePoint(lines->at(segments.first().begin()));
+      if (blendSpans)
+        spans.blend(painter, 1, keyIsX ? basePoint.y() : basePoint.x());
+      else
+        painter->drawRects(spans.rects(1, keyIsX ? basePoint.y() : basePoint.x()));
+    } else
+    {
+      for (int i=0; i<segments.size(); ++i)
+        painter->drawPolygon(getFillPolygon(lines, segments.at(i)));
+    }
   } else
   {
     // draw fill between this graph and mChannelFillGraph:
-    QVector<QPointF> otherLines;
-    mChannelFillGraph->getLines(&otherLines, QCPDataRange(0, mChannelFillGraph->dataCount()));
+    const QVector<QPointF> otherLines = mChannelFillGraph->getReplotLines(); // computed only once per replot, also if the other graph draws itself
     if (!otherLines.isEmpty())
     {
-      QVector<QCPDataRange> otherSegments = getNonNanSegments(&otherLines, mChannelFillGraph->keyAxis()->orientation());
+      QVector<QCPDataRange> otherSegments = mChannelFillGraph->getNonNanSegments(&otherLines, mChannelFillGraph->keyAxis()->orientation());
       QVector<QPair<QCPDataRange, QCPDataRange> > segmentPairs = getOverlappingSegments(segments, lines, otherSegments, &otherLines);
-      for (int i=0; i<segmentPairs.size(); ++i)
-        painter->drawPolygon(getChannelFillPolygon(lines, segmentPairs.at(i).first, &otherLines, segmentPairs.at(i).second));
+      if (useSpans && mChannelFillGraph->keyAxis()->orientation() == keyAxis()->orientation())
+      {
+        // columns are filled where both graphs have a non-NaN segment, between the envelope of both:
+        QCPGraphFillSpans spans(keyIsX, clip);
+        for (int i=0; i<segmentPairs.size(); ++i)
+        {
+          spans.addBoundary(lines, segmentPairs.at(i).first, 1);
+          spans.addBoundary(&otherLines, segmentPairs.at(i).second, 2);
+        }
+        if (blendSpans)
+          spans.blend(painter, 1|2, qQNaN());
+        else
+          painter->drawRects(spans.rects(1|2, qQNaN()));
+      } else
+      {
+        for (int i=0; i<segmentPairs.size(); ++i)
+          painter->drawPolygon(getChannelFillPolygon(lines, segmentPairs.at(i).first, &otherLines, segmentPairs.at(i).second));
+      }
     }
   }
 }
@@ -964,6 +1462,37 @@ void QCPGraph::drawImpulsePlot(QCPPainter *painter, const QVector<QPointF> &line
   }
 }
 
+/*! \internal
+  
+  Data accessor used by \ref QCPGraph to pass its data container to the sampling templates \ref
+  QCPGraph::sampleLineData and \ref QCPGraph::sampleScatterData. Indices are relative to \a data,
+  which is the beginning of the data container.
+*/
+class QCPGraphDataAccessor
+{
+public:
+  explicit QCPGraphDataAccessor(QCPGraphDataContainer::const_iterator data) : mData(data) {}
+  double key(int index) const { return (mData+index)->key; }
+  double value(int index) const { return (mData+index)->value; }
+private:
+  QCPGraphDataContainer::const_iterator mData;
+};
+
+/*! \internal
+  
+  Appends the data of one pixel column into which \ref QCPGraph::getOptimizedLineData folded
+  several gaps: the minimum \a minValue and maximum \a maxValue of the folded data points, at the
+  keys \a firstKey and \a lastKey of the first and last of them, followed by the NaN data point
+  \a gap of the last folded gap.
+*/
+static inline void qcpAppendFoldedGaps(QVector<QCPGraphData> *lineData, double firstKey, double lastKey, double minValue, double maxValue, const QCPGraphData &gap)
+{
+  lineData->append(QCPGraphData(firstKey, minValue));
+  if (lastKey != firstKey || maxValue != minValue)
+    lineData->append(QCPGraphData(lastKey, maxValue));
+  lineData->append(gap);
+}
+
 /*! \internal
 
   Returns via \a lineData the data points that need to be visualized for this graph when plotting
@@ -972,7 +1501,18 @@ void QCPGraph::drawImpulsePlot(QCPPainter *painter, const QVector<QPointF> &line
   further by \a begin and \a end, e.g. to only plot a certain segment of the data (see \ref
   getDataSegments).
 
-  This method is used by \ref getLines to retrieve the basic working set of data.
+  This method is used by \ref getLines to retrieve the basic working set of data. The data points
+  are appended to \a lineData.
+  
+  If the data container maintains a gap index (\ref QCPDataContainer::setGapIndexEnabled), the
+  connected segments between gaps are sampled separately, jumping from gap to gap via the index.
+  Each gap is represented by one NaN data point in \a lineData, so it stays visible even where
+  many data points fall into one pixel. Further gaps and segments inside the pixel column of a gap
+  are folded into one minimum/maximum pair followed by one NaN point, so the output stays
+  proportional to the number of pixel columns even if there are many more gaps than pixels.
+  
+  On logarithmic key axes, the sampling is performed in the logarithmic domain with cached key
+  logarithms, see \ref getOptimizedLogLineData.
 
   \see getOptimizedScatterData
 */
@@ -993,251 +1533,268 @@ void QCPGraph::getOptimizedLineData(QVector<QCPGraphData> *lineData, const QCPGr
       maxCount = 2*keyPixelSpan+2;
   }
   
-  if (mAdaptiveSampling && dataCount >= maxCount) // use adaptive sampling only if there are at least two points per pixel on average
-  {
-    QCPGraphDataContainer::const_iterator it = begin;
-    double minValue = it->value;
-    double maxValue = it->value;
-    QCPGraphDataContainer::const_iterator currentIntervalFirstPoint = it;
-    int reversedFactor = keyAxis->pixelOrientation(); // is used to calculate keyEpsilon pixel into the correct direction
-    int reversedRound = reversedFactor==-1 ? 1 : 0; // is used to switch between floor (normal) and ceil (reversed) rounding of currentIntervalStartKey
-    double currentIntervalStartKey = keyAxis->pixelToCoord((int)(keyAxis->coordToPixel(begin->key)+reversedRound));
-    double lastIntervalEndKey = currentIntervalStartKey;
-    double keyEpsilon = qAbs(currentIntervalStartKey-keyAxis->pixelToCoord(keyAxis->coordToPixel(currentIntervalStartKey)+1.0*reversedFactor)); // interval of one pixel on screen when mapped to plot key coordinates
-    bool keyEpsilonVariable = keyAxis->scaleType() == QCPAxis::stLogarithmic; // indicates whether keyEpsilon needs to be updated after every interval (for log axes)
-    int intervalDataCount = 1;
-    ++it; // advance iterator to second data point because adaptive sampling works in 1 point retrospect
-    while (it != end)
+  if (mAdaptiveSampling && dataCount >= maxCount && mDataContainer->gapIndexEnabled())
+  {
+    QCPGraphDataContainer::const_iterator gap = mDataContainer->findGap(begin, end);
+    if (gap != end) // sample the connected segments between gaps separately, so gaps don't get lost inside pixel clusters
     {
-      if (it->key < currentIntervalStartKey+keyEpsilon) // data point is still within same pixel, so skip it and expand value span of this cluster if necessary
+      QCPGraphDataContainer::const_iterator segmentBegin = begin;
+      // segments and gaps that lie in the pixel column of the last emitted gap are folded into that column:
+      QCPGraphDataContainer::const_iterator foldFirst = end, foldLast = end, foldGap = end;
+      double foldColumn = 0, foldMin = 0, foldMax = 0;
+      bool folding = false;
+      while (gap != end)
       {
-        if (it->value < minValue)
-          minValue = it->value;
-        else if (it->value > maxValue)
-          maxValue = it->value;
-        ++intervalDataCount;
-      } else // new pixel interval started
-      {
-        if (intervalDataCount >= 2) // last pixel had multiple data points, consolidate them to a cluster
+        const double gapColumn = std::floor(keyAxis->coordToPixel(gap->key));
+        if (folding && gapColumn == foldColumn && (segmentBegin == gap || std::floor(keyAxis->coordToPixel(segmentBegin->key)) == foldColumn))
         {
-          if (lastIntervalEndKey < currentIntervalStartKey-keyEpsilon) // last point is further away, so first point of this cluster must be at a real data point
-            lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.2, currentIntervalFirstPoint->value));
-          lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.25, minValue));
-          lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.75, maxValue));
-          if (it->key > currentIntervalStartKey+keyEpsilon*2) // new pixel started further away from previous cluster, so make sure the last point of the cluster is at a real data point
-            lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.8, (it-1)->value));
+          for (QCPGraphDataContainer::const_iterator it=segmentBegin; it!=gap; ++it)
+          {
+            if (foldFirst == end)
+            {
+              foldFirst = it;
+              foldMin = it->value;
+              foldMax = it->value;
+            } else if (it->value < foldMin)
+              foldMin = it->value;
+            else if (it->value > foldMax)
+              foldMax = it->value;
+            foldLast = it;
+          }
+          foldGap = gap;
         } else
-          lineData->append(QCPGraphData(currentIntervalFirstPoint->key, currentIntervalFirstPoint->value));
-        lastIntervalEndKey = (it-1)->key;
-        minValue = it->value;
-        maxValue = it->value;
-        currentIntervalFirstPoint = it;
-        currentIntervalStartKey = keyAxis->pixelToCoord((int)(keyAxis->coordToPixel(it->key)+reversedRound));
-        if (keyEpsilonVariable)
-          keyEpsilon = qAbs(currentIntervalStartKey-keyAxis->pixelToCoord(keyAxis->coordToPixel(currentIntervalStartKey)+1.0*reversedFactor));
-        intervalDataCount = 1;
+        {
+          if (foldFirst != end)
+            qcpAppendFoldedGaps(lineData, foldFirst->key, foldLast->key, foldMin, foldMax, *foldGap);
+          if (gap != segmentBegin)
+            QCPGraph::getOptimizedLineData(lineData, segmentBegin, gap);
+          lineData->append(*gap); // one NaN point represents the entire gap
+          folding = true;
+          foldColumn = gapColumn;
+          foldFirst = end;
+        }
+        segmentBegin = mDataContainer->findGapEnd(gap, end);
+        gap = mDataContainer->findGap(segmentBegin, end);
       }
-      ++it;
+      if (foldFirst != end)
+        qcpAppendFoldedGaps(lineData, foldFirst->key, foldLast->key, foldMin, foldMax, *foldGap);
+      if (segmentBegin != end)
+        QCPGraph::getOptimizedLineData(lineData, segmentBegin, end);
+      return;
     }
-    // handle last interval:
-    if (intervalDataCount >= 2) // last pixel had multiple data points, consolidate them to a cluster
-    {
-      if (lastIntervalEndKey < currentIntervalStartKey-keyEpsilon) // last point wasn't a cluster, so first point of this cluster must be at a real data point
-        lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.2, currentIntervalFirstPoint->value));
-      lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.25, minValue));
-      lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.75, maxValue));
-    } else
-      lineData->append(QCPGraphData(currentIntervalFirstPoint->key, currentIntervalFirstPoint->value));
-    
-  } else // don't use adaptive sampling algorithm, transfer points one-to-one from the data container into the output
-  {
-    lineData->resize(dataCount);
-    std::copy(begin, end, lineData->begin());
   }
+  
+  if (mAdaptiveSampling && dataCount >= maxCount && keyAxis->scaleType() == QCPAxis::stLogarithmic && keyAxis->range().lower > 0 && begin->key > 0)
+    getOptimizedLogLineData(lineData, begin, end);
+  else if (mAdaptiveSampling && dataCount >= maxCount && keyAxis->scaleType() == QCPAxis::stCustom)
+    getOptimizedCustomLineData(lineData, begin, end);
+  else
+    sampleLineData(lineData, QCPGraphDataAccessor(mDataContainer->constBegin()), begin-mDataContainer->constBegin(), end-mDataContainer->constBegin());
 }
 
 /*! \internal
-
-  Returns via \a scatterData the data points that need to be visualized for this graph when
-  plotting scatter points, taking into consideration the currently visible axis ranges and, if \ref
-  setAdaptiveSampling is enabled, local point densities. The considered data can be restricted
-  further by \a begin and \a end, e.g. to only plot a certain segment of the data (see \ref
-  getDataSegments).
-
-  This method is used by \ref getScatters to retrieve the basic working set of data.
-
-  \see getOptimizedLineData
+  
+  Performs the adaptive sampling of \ref getOptimizedLineData for a logarithmic key axis with a
+  positive range, for the data points between \a begin and \a end. The sampled points are appended
+  to \a lineData.
+  
+  On a logarithmic axis, the key pixel is a linear function of the logarithm of the key. So instead
+  of transforming every key with \ref QCPAxis::coordToPixel and recalculating the key extent of
+  each pixel interval via \ref QCPAxis::pixelToCoord, the logarithms of all keys are taken from
+  the cache provided by \ref logKeys, and the key pixels are determined with one multiply-add per
+  data point. The pixel intervals are then formed by \ref sampleKeyPixelLineData, and only the keys
+  of the generated cluster points are transformed back.
 */
-void QCPGraph::getOptimizedScatterData(QVector<QCPGraphData> *scatterData, QCPGraphDataContainer::const_iterator begin, QCPGraphDataContainer::const_iterator end) const
+void QCPGraph::getOptimizedLogLineData(QVector<QCPGraphData> *lineData, const QCPGraphDataContainer::const_iterator &begin, const QCPGraphDataContainer::const_iterator &end) const
 {
-  if (!scatterData) return;
   QCPAxis *keyAxis = mKeyAxis.data();
-  QCPAxis *valueAxis = mValueAxis.data();
-  if (!keyAxis || !valueAxis) { qDebug() << Q_FUNC_INFO << "invalid key or value axis"; return; }
-  
-  const int scatterModulo = mScatterSkip+1;
-  const bool doScatterSkip = mScatterSkip > 0;
-  int beginIndex = begin-mDataContainer->constBegin();
-  int endIndex = end-mDataContainer->constBegin();
-  while (doScatterSkip && begin != end && beginIndex % scatterModulo != 0) // advance begin iterator to first non-skipped scatter
-  {
-    ++beginIndex;
-    ++begin;
-  }
-  if (begin == end) return;
-  int dataCount = end-begin;
-  int maxCount = std::numeric_limits<int>::max();
-  if (mAdaptiveSampling)
+  const QCPRange range = keyAxis->range();
+  const double lowerPixel = keyAxis->coordToPixel(range.lower);
+  const double scale = (keyAxis->coordToPixel(range.upper)-lowerPixel)/(qLn(range.upper)-qLn(range.lower)); // pixels per unit of ln(key)
+  const double offset = lowerPixel-scale*qLn(range.lower);
+  const double *logKey = logKeys()+(begin-mDataContainer->constBegin());
+  const int count = end-begin;
+  
+  QVector<double> keyPixels(count);
+  for (int i=0; i<count; ++i)
+    keyPixels[i] = offset+scale*logKey[i];
+  QVector<int> clusterPoints;
+  sampleKeyPixelLineData(lineData, begin, keyPixels.constData(), count, &clusterPoints);
+  for (int i=0; i<clusterPoints.size(); ++i)
   {
-    int keyPixelSpan = qAbs(keyAxis->coordToPixel(begin->key)-keyAxis->coordToPixel((end-1)->key));
-    maxCount = 2*keyPixelSpan+2;
+    QCPGraphData &point = (*lineData)[clusterPoints.at(i)];
+    point.key = qExp((point.key-offset)/scale);
   }
+}
+
+/*! \internal
   
-  if (mAdaptiveSampling && dataCount >= maxCount) // use adaptive sampling only if there are at least two points per pixel on average
-  {
-    double valueMaxRange = valueAxis->range().upper;
-    double valueMinRange = valueAxis->range().lower;
-    QCPGraphDataContainer::const_iterator it = begin;
-    int itIndex = beginIndex;
-    double minValue = it->value;
-    double maxValue = it->value;
-    QCPGraphDataContainer::const_iterator minValueIt = it;
-    QCPGraphDataContainer::const_iterator maxValueIt = it;
-    QCPGraphDataContainer::const_iterator currentIntervalStart = it;
-    int reversedFactor = keyAxis->pixelOrientation(); // is used to calculate keyEpsilon pixel into the correct direction
-    int reversedRound = reversedFactor==-1 ? 1 : 0; // is used to switch between floor (normal) and ceil (reversed) rounding of currentIntervalStartKey
-    double currentIntervalStartKey = keyAxis->pixelToCoord((int)(keyAxis->coordToPixel(begin->key)+reversedRound));
-    double keyEpsilon = qAbs(currentIntervalStartKey-keyAxis->pixelToCoord(keyAxis->coordToPixel(currentIntervalStartKey)+1.0*reversedFactor)); // interval of one pixel on screen when mapped to plot key coordinates
-    bool keyEpsilonVariable = keyAxis->scaleType() == QCPAxis::stLogarithmic; // indicates whether keyEpsilon needs to be updated after every interval (for log axes)
-    int intervalDataCount = 1;
-    // advance iterator to second (non-skipped) data point because adaptive sampling works in 1 point retrospect:
-    if (!doScatterSkip)
-      ++it;
-    else
+  Performs the adaptive sampling of \ref getOptimizedLineData for a key axis with a custom scale
+  (\ref QCPAxis::stCustom), for the data points between \a begin and \a end. The sampled points
+  are appended to \a lineData.
+  
+  Like \ref getOptimizedLogLineData, but the key pixels are calculated in one batch with \ref
+  QCPAxis::coordsToPixels, so the scale transform is applied via \ref
+  QCPScaleTransform::transformMany instead of twice per pixel interval. The keys of the generated
+  cluster points are transformed back in one batch with \ref QCPAxis::pixelsToCoords.
+*/
+void QCPGraph::getOptimizedCustomLineData(QVector<QCPGraphData> *lineData, const QCPGraphDataContainer::const_iterator &begin, const QCPGraphDataContainer::const_iterator &end) const
+{
+  QCPAxis *keyAxis = mKeyAxis.data();
+  const int count = end-begin;
+  QVector<double> keyPixels(count);
+  for (int i=0; i<count; ++i)
+    keyPixels[i] = (begin+i)->key;
+  keyAxis->coordsToPixels(keyPixels.constData(), keyPixels.data(), count);
+  
+  QVector<int> clusterPoints;
+  sampleKeyPixelLineData(lineData, begin, keyPixels.constData(), count, &clusterPoints);
+  QVector<double> clusterKeys(clusterPoints.size());
+  for (int i=0; i<clusterPoints.size(); ++i)
+    clusterKeys[i] = lineData->at(clusterPoints.at(i)).key;
+  keyAxis->pixelsToCoords(clusterKeys.constData(), clusterKeys.data(), clusterKeys.size());
+  for (int i=0; i<clusterPoints.size(); ++i)
+    (*lineData)[clusterPoints.at(i)].key = clusterKeys.at(i);
+}
+
+/*! \internal
+  
+  Forms the pixel intervals of the adaptive sampling for the \a count data points starting at \a
+  begin, whose key pixel coordinates are given in \a keyPixels, and appends the resulting points
+  to \a lineData.
+  
+  The generated points are the same as in the linear case: A pixel column containing multiple data
+  points is represented by its minimum and maximum, plus its first and last value where the
+  neighbouring columns are further away. Data points that are passed through keep their key. The
+  cluster points however are appended with their key pixel coordinate as key, and their indices
+  in \a lineData are appended to \a clusterPoints, so the caller can transform their keys back in
+  the way that suits the axis scale.
+*/
+void QCPGraph::sampleKeyPixelLineData(QVector<QCPGraphData> *lineData, const QCPGraphDataContainer::const_iterator &begin, const double *keyPixels, int count, QVector<int> *clusterPoints) const
+{
+  const double direction = mKeyAxis.data()->pixelOrientation(); // pixel direction of increasing keys
+  double pixel = keyPixels[0];
+  double column = std::floor(pixel);
+  double intervalStart = direction > 0 ? column : column+1; // pixel edge of the column that is reached first with increasing keys
+  double lastIntervalEndPixel = intervalStart;
+  double minValue = begin->value;
+  double maxValue = begin->value;
+  int intervalFirst = 0;
+  for (int i=1; i<=count; ++i)
+  {
+    if (i < count)
     {
-      itIndex += scatterModulo;
-      if (itIndex < endIndex) // make sure we didn't jump over end
-        it += scatterModulo;
-      else
+      pixel = keyPixels[i];
+      if (std::floor(pixel) == column) // data point is still within same pixel, so expand value span of this cluster if necessary
       {
-        it = end;
-        itIndex = endIndex;
+        const double value = (begin+i)->value;
+        if (value < minValue)
+          minValue = value;
+        else if (value > maxValue)
+          maxValue = value;
+        continue;
       }
     }
-    // main loop over data points:
-    while (it != end)
+    // pixel interval ended, at the next data point or the end of the data:
+    if (i-intervalFirst >= 2) // interval had multiple data points, consolidate them to a cluster
     {
-      if (it->key < currentIntervalStartKey+keyEpsilon) // data point is still within same pixel, so skip it and expand value span of this pixel if necessary
-      {
-        if (it->value < minValue && it->value > valueMinRange && it->value < valueMaxRange)
-        {
-          minValue = it->value;
-          minValueIt = it;
-        } else if (it->value > maxValue && it->value > valueMinRange && it->value < valueMaxRange)
-        {
-          maxValue = it->value;
-          maxValueIt = it;
-        }
-        ++intervalDataCount;
-      } else // new pixel started
+      if ((intervalStart-lastIntervalEndPixel)*direction > 1) // last point is further away, so first point of this cluster must be at a real data point
       {
-        if (intervalDataCount >= 2) // last pixel had multiple data points, consolidate them
-        {
-          // determine value pixel span and add as many points in interval to maintain certain vertical data density (this is specific to scatter plot):
-          double valuePixelSpan = qAbs(valueAxis->coordToPixel(minValue)-valueAxis->coordToPixel(maxValue));
-          int dataModulo = qMax(1, qRound(intervalDataCount/(valuePixelSpan/4.0))); // approximately every 4 value pixels one data point on average
-          QCPGraphDataContainer::const_iterator intervalIt = currentIntervalStart;
-          int c = 0;
-          while (intervalIt != it)
-          {
-            if ((c % dataModulo == 0 || intervalIt == minValueIt || intervalIt == maxValueIt) && intervalIt->value > valueMinRange && intervalIt->value < valueMaxRange)
-              scatterData->append(*intervalIt);
-            ++c;
-            if (!doScatterSkip)
-              ++intervalIt;
-            else
-              intervalIt += scatterModulo; // since we know indices of "currentIntervalStart", "intervalIt" and "it" are multiples of scatterModulo, we can't accidentally jump over "it" here
-          }
-        } else if (currentIntervalStart->value > valueMinRange && currentIntervalStart->value < valueMaxRange)
-          scatterData->append(*currentIntervalStart);
-        minValue = it->value;
-        maxValue = it->value;
-        currentIntervalStart = it;
-        currentIntervalStartKey = keyAxis->pixelToCoord((int)(keyAxis->coordToPixel(it->key)+reversedRound));
-        if (keyEpsilonVariable)
-          keyEpsilon = qAbs(currentIntervalStartKey-keyAxis->pixelToCoord(keyAxis->coordToPixel(currentIntervalStartKey)+1.0*reversedFactor));
-        intervalDataCount = 1;
+        clusterPoints->append(lineData->size());
+        lineData->append(QCPGraphData(intervalStart+0.2*direction, (begin+intervalFirst)->value));
       }
-      // advance to next data point:
-      if (!doScatterSkip)
-        ++it;
-      else
+      clusterPoints->append(lineData->size());
+      lineData->append(QCPGraphData(intervalStart+0.25*direction, minValue));
+      clusterPoints->append(lineData->size());
+      lineData->append(QCPGraphData(intervalStart+0.75*direction, maxValue));
+      if (i < count && (pixel-intervalStart)*direction > 2) // new pixel started further away from previous cluster, so make sure the last point of the cluster is at a real data point
       {
-        itIndex += scatterModulo;
-        if (itIndex < endIndex) // make sure we didn't jump over end
-          it += scatterModulo;
-        else
-        {
-          it = end;
-          itIndex = endIndex;
-        }
+        clusterPoints->append(lineData->size());
+        lineData->append(QCPGraphData(intervalStart+0.8*direction, (begin+i-1)->value));
       }
-    }
-    // handle last interval:
-    if (intervalDataCount >= 2) // last pixel had multiple data points, consolidate them
+    } else
+      lineData->append(*(begin+intervalFirst));
+    if (i == count)
+      break;
+    lastIntervalEndPixel = keyPixels[i-1];
+    minValue = (begin+i)->value;
+    maxValue = minValue;
+    intervalFirst = i;
+    column = std::floor(pixel);
+    intervalStart = direction > 0 ? column : column+1;
+  }
+}
+
+/*! \internal
+  
+  Returns the natural logarithms of the keys of all data points, in the order of the data
+  container. The logarithms are cached, so as long as the data isn't changed, replots on a
+  logarithmic key axis don't transform the keys again.
+  
+  The cache is bound to the data container itself (not its address, which may be reused by a new
+  container) and validated with \ref QCPDataContainer::revision. If data was only appended at the
+  end or removed at the front since the last call (see \ref QCPDataContainer::editRevision), only
+  the appended keys are transformed, so streaming data with a rolling buffer doesn't cause a full
+  pass over the data on every replot.
+  
+  Non-positive keys yield NaN or negative infinity, callers must only access positive keys.
+*/
+const double *QCPGraph::logKeys() const
+{
+  const QCPGraphDataContainer *container = mDataContainer.data();
+  if (mLogKeysContainer.toStrongRef() != mDataContainer || container->editRevision() > mLogKeysRevision)
+  {
+    mLogKeys.resize(0);
+    mLogKeysOffset = 0;
+  } else if (container->revision() != mLogKeysRevision)
+  {
+    // only appends and removals at the front since the cache was built:
+    mLogKeysOffset += int(qMin(container->frontRemovalCount()-mLogKeysFrontRemovals, quint64(mLogKeys.size()-mLogKeysOffset)));
+    if (mLogKeysOffset > mLogKeys.size()/2) // drop removed keys once they make up most of the cache
     {
-      // determine value pixel span and add as many points in interval to maintain certain vertical data density (this is specific to scatter plot):
-      double valuePixelSpan = qAbs(valueAxis->coordToPixel(minValue)-valueAxis->coordToPixel(maxValue));
-      int dataModulo = qMax(1, qRound(intervalDataCount/(valuePixelSpan/4.0))); // approximately every 4 value pixels one data point on average
-      QCPGraphDataContainer::const_iterator intervalIt = currentIntervalStart;
-      int intervalItIndex = intervalIt-mDataContainer->constBegin();
-      int c = 0;
-      while (intervalIt != it)
-      {
-        if ((c % dataModulo == 0 || intervalIt == minValueIt || intervalIt == maxValueIt) && intervalIt->value > valueMinRange && intervalIt->value < valueMaxRange)
-          scatterData->append(*intervalIt);
-        ++c;
-        if (!doScatterSkip)
-          ++intervalIt;
-        else // here we can't guarantee that adding scatterModulo doesn't exceed "it" (because "it" is equal to "end" here, and "end" isn't scatterModulo-aligned), so check via index comparison:
-        {
-          intervalItIndex += scatterModulo;
-          if (intervalItIndex < itIndex)
-            intervalIt += scatterModulo;
-          else
-          {
-            intervalIt = it;
-            intervalItIndex = itIndex;
-          }
-        }
-      }
-    } else if (currentIntervalStart->value > valueMinRange && currentIntervalStart->value < valueMaxRange)
-      scatterData->append(*currentIntervalStart);
-    
-  } else // don't use adaptive sampling algorithm, transfer points one-to-one from the data container into the output
+      mLogKeys.remove(0, mLogKeysOffset);
+      mLogKeysOffset = 0;
+    }
+  }
+  
+  const int cachedCount = mLogKeys.size()-mLogKeysOffset;
+  if (cachedCount != container->size())
   {
-    QCPGraphDataContainer::const_iterator it = begin;
-    int itIndex = beginIndex;
-    scatterData->reserve(dataCount);
-    while (it != end)
+    if (cachedCount > container->size()) // can't happen with consistent change tracking, rebuild to be safe
     {
-      scatterData->append(*it);
-      // advance to next data point:
-      if (!doScatterSkip)
-        ++it;
-      else
-      {
-        itIndex += scatterModulo;
-        if (itIndex < endIndex)
-          it += scatterModulo;
-        else
-        {
-          it = end;
-          itIndex = endIndex;
-        }
-      }
+      mLogKeys.resize(0);
+      mLogKeysOffset = 0;
     }
+    const int first = mLogKeys.size()-mLogKeysOffset;
+    mLogKeys.resize(mLogKeysOffset+container->size());
+    double *logKey = mLogKeys.data()+mLogKeysOffset+first;
+    for (QCPGraphDataContainer::const_iterator it=container->constBegin()+first; it!=container->constEnd(); ++it, ++logKey)
+      *logKey = qLn(it->key);
   }
+  mLogKeysContainer = mDataContainer;
+  mLogKeysRevision = container->revision();
+  mLogKeysFrontRemovals = container->frontRemovalCount();
+  return mLogKeys.constData()+mLogKeysOffset;
+}
+
+/*! \internal
+
+  Returns via \a scatterData the data points that need to be visualized for this graph when
+  plotting scatter points, taking into consideration the currently visible axis ranges and, if \ref
+  setAdaptiveSampling is enabled, local point densities. The considered data can be restricted
+  further by \a begin and \a end, e.g. to only plot a certain segment of the data (see \ref
+  getDataSegments).
+
+  This method is used by \ref getScatters to retrieve the basic working set of data.
+
+  \see getOptimizedLineData
+*/
+void QCPGraph::getOptimizedScatterData(QVector<QCPGraphData> *scatterData, QCPGraphDataContainer::const_iterator begin, QCPGraphDataContainer::const_iterator end) const
+{
+  if (!scatterData) return;
+  if (!mKeyAxis || !mValueAxis) { qDebug() << Q_FUNC_INFO << "invalid key or value axis"; return; }
+  
+  sampleScatterData(scatterData, QCPGraphDataAccessor(mDataContainer->constBegin()), begin-mDataContainer->constBegin(), end-mDataContainer->constBegin());
 }
 
 /*!
@@ -1277,6 +1834,10 @@ void QCPGraph::getVisibleDataBounds(QCPGraphDataContainer::const_iterator &begin
   for NaN. If \a keyOrientation is \c Qt::Horizontal, the \a y member is checked, if it is \c
   Qt::Vertical, the \a x member is checked.
   
+  \a lineData must have been created by this graph. If its data container maintains a gap index
+  (\ref QCPDataContainer::setGapIndexEnabled) and there is no gap in the visible data, the index
+  lookup replaces going through the points.
+  
   \see getOverlappingSegments, drawFill
 */
 QVector<QCPDataRange> QCPGraph::getNonNanSegments(const QVector<QPointF> *lineData, Qt::Orientation keyOrientation) const
@@ -1284,6 +1845,17 @@ QVector<QCPDataRange> QCPGraph::getNonNanSegments(const QVector<QPointF> *lineDa
   QVector<QCPDataRange> result;
   const int n = lineData->size();
   
+  if (n > 0 && mKeyAxis && mDataContainer->gapIndexEnabled() && !mDataContainer->isEmpty())
+  {
+    QCPGraphDataContainer::const_iterator begin, end;
+    getVisibleDataBounds(begin, end, mDataContainer->dataRange());
+    if (mDataContainer->findGap(begin, end) == end) // no NaN data, so lines can't contain NaN points
+    {
+      result.append(QCPDataRange(0, n));
+      return result;
+    }
+  }
+  
   QCPDataRange currentSegment(-1, -1);
   int i = 0;
   
@@ -1440,7 +2012,7 @@ QPointF QCPGraph::getFillBasePoint(QPointF matchingDataPoint) const
   if (!keyAxis || !valueAxis) { qDebug() << Q_FUNC_INFO << "invalid key or value axis"; return QPointF(); }
   
   QPointF result;
-  if (valueAxis->scaleType() == QCPAxis::stLinear)
+  if (valueAxis->scaleType() != QCPAxis::stLogarithmic)
   {
     if (keyAxis->orientation() == Qt::Horizontal)
     {
@@ -1505,6 +2077,95 @@ const QPolygonF QCPGraph::getFillPolygon(const QVector<QPointF> *lineData, QCPDa
   return result;
 }
 
+/*! \internal
+  
+  Read-only view on a segment of pixel line data, as used by \ref QCPGraph::getChannelFillPolygon.
+  The first and last point of the view may be replaced by interpolated points (\ref cropLower, \ref
+  cropUpper), without modifying or copying the underlying line data. This allows channel fills to
+  operate directly on the lines that are shared between the two graphs during a replot.
+*/
+class QCPGraphFillSegment
+{
+public:
+  QCPGraphFillSegment(const QVector<QPointF> *data, const QCPDataRange &segment, bool keyIsX) :
+    mData(data->constData()),
+    mBegin(segment.begin()),
+    mEnd(segment.end()),
+    mKeyIsX(keyIsX),
+    mFirst(data->at(segment.begin())),
+    mLast(data->at(segment.end()-1))
+  {}
+  
+  int size() const { return mEnd-mBegin; }
+  double firstKey() const { return key(mFirst); }
+  double lastKey() const { return key(mLast); }
+  
+  /*! Crops the view such that its first point lies exactly at key coordinate \a k, by linear
+    interpolation. Returns false if the segment doesn't reach \a k or too few points remain. */
+  bool cropLower(double k)
+  {
+    int i = mBegin;
+    while (i < mEnd && key(at(i)) <= k)
+      ++i;
+    if (i == mEnd) return false; // key ranges have no overlap
+    mBegin = i > mBegin ? i-1 : mBegin;
+    mFirst = mData[mBegin];
+    if (size() < 2) return false; // need at least two points for interpolation
+    const QPointF next = at(mBegin+1);
+    mFirst = interpolated(mFirst, next, k);
+    return true;
+  }
+  
+  /*! Crops the view such that its last point lies exactly at key coordinate \a k, by linear
+    interpolation. Returns false if the segment doesn't reach \a k or too few points remain. */
+  bool cropUpper(double k)
+  {
+    int i = mEnd-1;
+    while (i >= mBegin && key(at(i)) >= k)
+      --i;
+    if (i < mBegin) return false; // key ranges have no overlap
+    mEnd = (i < mEnd-1 ? i+1 : mEnd-1)+1;
+    if (size() < 2) return false; // need at least two points for interpolation
+    mLast = mData[mEnd-1];
+    mLast = interpolated(at(mEnd-2), mLast, k);
+    return true;
+  }
+  
+  /*! Appends the points of this view to \a polygon, in reversed order if \a reversed is true. */
+  void appendTo(QPolygonF &polygon, bool reversed) const
+  {
+    if (reversed)
+    {
+      for (int i=mEnd-1; i>=mBegin; --i)
+        polygon << at(i);
+    } else
+    {
+      for (int i=mBegin; i<mEnd; ++i)
+        polygon << at(i);
+    }
+  }
+  
+private:
+  const QPointF *mData;
+  int mBegin, mEnd;
+  bool mKeyIsX;
+  QPointF mFirst, mLast;
+  
+  QPointF at(int i) const { return i == mBegin ? mFirst : (i == mEnd-1 ? mLast : mData[i]); }
+  double key(const QPointF &p) const { return mKeyIsX ? p.x() : p.y(); }
+  double value(const QPointF &p) const { return mKeyIsX ? p.y() : p.x(); }
+  
+  /* returns the point on the line through \a base and \a other which has key coordinate \a k */
+  QPointF interpolated(const QPointF &base, const QPointF &other, double k) const
+  {
+    double slope = 0;
+    if (!qFuzzyCompare(key(other), key(base))) // avoid division by zero in step plots
+      slope = (value(other)-value(base))/(key(other)-key(base));
+    const double v = value(base)+slope*(k-key(base));
+    return mKeyIsX ? QPointF(k, v) : QPointF(v, k);
+  }
+};
+
 /*! \internal
   
   Returns the polygon needed for drawing (partial) channel fills between this graph and the graph
@@ -1519,6 +2180,10 @@ const QPolygonF QCPGraph::getFillPolygon(const QVector<QPointF> *lineData, QCPDa
   \ref getOverlappingSegments, to make sure only segments that actually have key coordinate overlap
   need to be processed here.
   
+  The segments are cropped to their common key range without copying \a thisData or \a otherData,
+  so both may be the line buffers shared during the replot (see \ref getReplotLines). Only the
+  resulting polygon is allocated.
+  
   For increased performance due to implicit sharing, keep the returned QPolygonF const.
   
   \see drawFill, getOverlappingSegments, getNonNanSegments
@@ -1536,90 +2201,32 @@ const QPolygonF QCPGraph::getChannelFillPolygon(const QVector<QPointF> *thisData
   if (mChannelFillGraph.data()->mKeyAxis.data()->orientation() != keyAxis->orientation())
     return QPolygonF(); // don't have same axis orientation, can't fill that (Note: if keyAxis fits, valueAxis will fit too, because it's always orthogonal to keyAxis)
   
-  if (thisData->isEmpty()) return QPolygonF();
-  QVector<QPointF> thisSegmentData(thisSegment.size());
-  QVector<QPointF> otherSegmentData(otherSegment.size());
-  std::copy(thisData->constBegin()+thisSegment.begin(), thisData->constBegin()+thisSegment.end(), thisSegmentData.begin());
-  std::copy(otherData->constBegin()+otherSegment.begin(), otherData->constBegin()+otherSegment.end(), otherSegmentData.begin());
+  if (thisData->isEmpty() || thisSegment.isEmpty() || otherSegment.isEmpty()) return QPolygonF();
+  const bool keyIsX = keyAxis->orientation() == Qt::Horizontal;
+  QCPGraphFillSegment thisSegmentView(thisData, thisSegment, keyIsX);
+  QCPGraphFillSegment otherSegmentView(otherData, otherSegment, keyIsX);
   // pointers to be able to swap them, depending which data range needs cropping:
-  QVector<QPointF> *staticData = &thisSegmentData;
-  QVector<QPointF> *croppedData = &otherSegmentData;
-  
-  // crop both vectors to ranges in which the keys overlap (which coord is key, depends on axisType):
-  if (keyAxis->orientation() == Qt::Horizontal)
-  {
-    // x is key
-    // crop lower bound:
-    if (staticData->first().x() < croppedData->first().x()) // other one must be cropped
-      qSwap(staticData, croppedData);
-    const int lowBound = findIndexBelowX(croppedData, staticData->first().x());
-    if (lowBound == -1) return QPolygonF(); // key ranges have no overlap
-    croppedData->remove(0, lowBound);
-    // set lowest point of cropped data to fit exactly key position of first static data point via linear interpolation:
-    if (croppedData->size() < 2) return QPolygonF(); // need at least two points for interpolation
-    double slope;
-    if (!qFuzzyCompare(croppedData->at(1).x(), croppedData->at(0).x()))
-      slope = (croppedData->at(1).y()-croppedData->at(0).y())/(croppedData->at(1).x()-croppedData->at(0).x());
-    else
-      slope = 0;
-    (*croppedData)[0].setY(croppedData->at(0).y()+slope*(staticData->first().x()-croppedData->at(0).x()));
-    (*croppedData)[0].setX(staticData->first().x());
-    
-    // crop upper bound:
-    if (staticData->last().x() > croppedData->last().x()) // other one must be cropped
-      qSwap(staticData, croppedData);
-    int highBound = findIndexAboveX(croppedData, staticData->last().x());
-    if (highBound == -1) return QPolygonF(); // key ranges have no overlap
-    croppedData->remove(highBound+1, croppedData->size()-(highBound+1));
-    // set highest point of cropped data to fit exactly key position of last static data point via linear interpolation:
-    if (croppedData->size() < 2) return QPolygonF(); // need at least two points for interpolation
-    const int li = croppedData->size()-1; // last index
-    if (!qFuzzyCompare(croppedData->at(li).x(), croppedData->at(li-1).x()))
-      slope = (croppedData->at(li).y()-croppedData->at(li-1).y())/(croppedData->at(li).x()-croppedData->at(li-1).x());
-    else
-      slope = 0;
-    (*croppedData)[li].setY(croppedData->at(li-1).y()+slope*(staticData->last().x()-croppedData->at(li-1).x()));
-    (*croppedData)[li].setX(staticData->last().x());
-  } else // mKeyAxis->orientation() == Qt::Vertical
-  {
-    // y is key
-    // crop lower bound:
-    if (staticData->first().y() < croppedData->first().y()) // other one must be cropped
-      qSwap(staticData, croppedData);
-    int lowBound = findIndexBelowY(croppedData, staticData->first().y());
-    if (lowBound == -1) return QPolygonF(); // key ranges have no overlap
-    croppedData->remove(0, lowBound);
-    // set lowest point of cropped data to fit exactly key position of first static data point via linear interpolation:
-    if (croppedData->size() < 2) return QPolygonF(); // need at least two points for interpolation
-    double slope;
-    if (!qFuzzyCompare(croppedData->at(1).y(), croppedData->at(0).y())) // avoid division by zero in step plots
-      slope = (croppedData->at(1).x()-croppedData->at(0).x())/(croppedData->at(1).y()-croppedData->at(0).y());
-    else
-      slope = 0;
-    (*croppedData)[0].setX(croppedData->at(0).x()+slope*(staticData->first().y()-croppedData->at(0).y()));
-    (*croppedData)[0].setY(staticData->first().y());
-    
-    // crop upper bound:
-    if (staticData->last().y() > croppedData->last().y()) // other one must be cropped
-      qSwap(staticData, croppedData);
-    int highBound = findIndexAboveY(croppedData, staticData->last().y());
-    if (highBound == -1) return QPolygonF(); // key ranges have no overlap
-    croppedData->remove(highBound+1, croppedData->size()-(highBound+1));
-    // set highest point of cropped data to fit exactly key position of last static data point via linear interpolation:
-    if (croppedData->size() < 2) return QPolygonF(); // need at least two points for interpolation
-    int li = croppedData->size()-1; // last index
-    if (!qFuzzyCompare(croppedData->at(li).y(), croppedData->at(li-1).y())) // avoid division by zero in step plots
-      slope = (croppedData->at(li).x()-croppedData->at(li-1).x())/(croppedData->at(li).y()-croppedData->at(li-1).y());
-    else
-      slope = 0;
-    (*croppedData)[li].setX(croppedData->at(li-1).x()+slope*(staticData->last().y()-croppedData->at(li-1).y()));
-    (*croppedData)[li].setY(staticData->last().y());
-  }
+  QCPGraphFillSegment *staticData = &thisSegmentView;
+  QCPGraphFillSegment *croppedData = &otherSegmentView;
+  
+  // crop both views to ranges in which the keys overlap (which coord is key, depends on axisType):
+  // crop lower bound:
+  if (staticData->firstKey() < croppedData->firstKey()) // other one must be cropped
+    qSwap(staticData, croppedData);
+  if (!croppedData->cropLower(staticData->firstKey()))
+    return QPolygonF();
+  // crop upper bound:
+  if (staticData->lastKey() > croppedData->lastKey()) // other one must be cropped
+    qSwap(staticData, croppedData);
+  if (!croppedData->cropUpper(staticData->lastKey()))
+    return QPolygonF();
   
   // return joined:
-  for (int i=otherSegmentData.size()-1; i>=0; --i) // insert reversed, otherwise the polygon will be twisted
-    thisSegmentData << otherSegmentData.at(i);
-  return QPolygonF(thisSegmentData);
+  QPolygonF result;
+  result.reserve(thisSegmentView.size()+otherSegmentView.size());
+  thisSegmentView.appendTo(result, false);
+  otherSegmentView.appendTo(result, true); // insert reversed, otherwise the polygon will be twisted
+  return result;
 }
 
 /*! \internal
@@ -1628,7 +2235,8 @@ const QPolygonF QCPGraph::getChannelFillPolygon(const QVector<QPointF> *thisData
   \a data points are ordered ascending, as is ensured by \ref getLines/\ref getScatters if the key
   axis is horizontal.
 
-  Used to calculate the channel fill polygon, see \ref getChannelFillPolygon.
+  \deprecated The channel fill polygon (\ref getChannelFillPolygon) doesn't use this method
+  anymore. It is only kept for subclasses that rely on it.
 */
 int QCPGraph::findIndexAboveX(const QVector<QPointF> *data, double x) const
 {
@@ -1651,7 +2259,8 @@ int QCPGraph::findIndexAboveX(const QVector<QPointF> *data, double x) const
   \a data points are ordered ascending, as is ensured by \ref getLines/\ref getScatters if the key
   axis is horizontal.
   
-  Used to calculate the channel fill polygon, see \ref getChannelFillPolygon.
+  \deprecated The channel fill polygon (\ref getChannelFillPolygon) doesn't use this method
+  anymore. It is only kept for subclasses that rely on it.
 */
 int QCPGraph::findIndexBelowX(const QVector<QPointF> *data, double x) const
 {
@@ -1674,7 +2283,8 @@ int QCPGraph::findIndexBelowX(const QVector<QPointF> *data, double x) const
   \a data points are ordered ascending, as is ensured by \ref getLines/\ref getScatters if the key
   axis is vertical.
   
-  Used to calculate the channel fill polygon, see \ref getChannelFillPolygon.
+  \deprecated The channel fill polygon (\ref getChannelFillPolygon) doesn't use this method
+  anymore. It is only kept for subclasses that rely on it.
 */
 int QCPGraph::findIndexAboveY(const QVector<QPointF> *data, double y) const
 {
@@ -1756,7 +2366,8 @@ double QCPGraph::pointDistance(const QPointF &pixelPoint, QCPGraphDataContainer:
   \a data points are ordered ascending, as is ensured by \ref getLines/\ref getScatters if the key
   axis is vertical.
 
-  Used to calculate the channel fill polygon, see \ref getChannelFillPolygon.
+  \deprecated The channel fill polygon (\ref getChannelFillPolygon) doesn't use this method
+  anymore. It is only kept for subclasses that rely on it.
 */
 int QCPGraph::findIndexBelowY(const QVector<QPointF> *data, double y) const
 {
@@ -96,7 +96,7 @@ public:
   virtual ~QCPGraph();
   
   // getters:
-  QSharedPointer<QCPGraphDataContainer> data() const { return mDataContainer; }
+  virtual QSharedPointer<QCPGraphDataContainer> data() const { return mDataContainer; }
   LineStyle lineStyle() const { return mLineStyle; }
   QCPScatterStyle scatterStyle() const { return mScatterStyle; }
   int scatterSkip() const { return mScatterSkip; }
@@ -104,8 +104,8 @@ public:
   bool adaptiveSampling() const { return mAdaptiveSampling; }
   
   // setters:
-  void setData(QSharedPointer<QCPGraphDataContainer> data);
-  void setData(const QVector<double> &keys, const QVector<double> &values, bool alreadySorted=false);
+  virtual void setData(QSharedPointer<QCPGraphDataContainer> data);
+  virtual void setData(const QVector<double> &keys, const QVector<double> &values, bool alreadySorted=false);
   void setLineStyle(LineStyle ls);
   void setScatterStyle(const QCPScatterStyle &style);
   void setScatterSkip(int skip);
@@ -113,8 +113,8 @@ public:
   void setAdaptiveSampling(bool enabled);
   
   // non-property methods:
-  void addData(const QVector<double> &keys, const QVector<double> &values, bool alreadySorted=false);
-  void addData(double key, double value);
+  virtual void addData(const QVector<double> &keys, const QVector<double> &values, bool alreadySorted=false);
+  virtual void addData(double key, double value);
   
   // reimplemented virtual methods:
   virtual double selectTest(const QPointF &pos, bool onlySelectable, QVariant *details=0) const Q_DECL_OVERRIDE;
@@ -128,10 +128,18 @@ protected:
   int mScatterSkip;
   QPointer<QCPGraph> mChannelFillGraph;
   bool mAdaptiveSampling;
+  // non-property members:
+  mutable QVector<QPointF> mReplotLines;
+  mutable quint64 mReplotLinesCount;
+  mutable QVector<double> mLogKeys;
+  mutable int mLogKeysOffset;
+  mutable QWeakPointer<QCPGraphDataContainer> mLogKeysContainer;
+  mutable quint64 mLogKeysRevision, mLogKeysFrontRemovals;
   
   // reimplemented virtual methods:
   virtual void draw(QCPPainter *painter) Q_DECL_OVERRIDE;
   virtual void drawLegendIcon(QCPPainter *painter, const QRectF &rect) const Q_DECL_OVERRIDE;
+  virtual void prepareDraw() Q_DECL_OVERRIDE;
   
   // introduced virtual methods:
   virtual void drawFill(QCPPainter *painter, QVector<QPointF> *lines) const;
@@ -141,15 +149,26 @@ protected:
   
   virtual void getOptimizedLineData(QVector<QCPGraphData> *lineData, const QCPGraphDataContainer::const_iterator &begin, const QCPGraphDataContainer::const_iterator &end) const;
   virtual void getOptimizedScatterData(QVector<QCPGraphData> *scatterData, QCPGraphDataContainer::const_iterator begin, QCPGraphDataContainer::const_iterator end) const;
+  virtual void getLines(QVector<QPointF> *lines, const QCPDataRange &dataRange) const;
+  virtual void getScatters(QVector<QPointF> *scatters, const QCPDataRange &dataRange) const;
   
   // non-virtual methods:
+  QVector<QPointF> getReplotLines() const;
   void getVisibleDataBounds(QCPGraphDataContainer::const_iterator &begin, QCPGraphDataContainer::const_iterator &end, const QCPDataRange &rangeRestriction) const;
-  void getLines(QVector<QPointF> *lines, const QCPDataRange &dataRange) const;
-  void getScatters(QVector<QPointF> *scatters, const QCPDataRange &dataRange) const;
+  void getOptimizedLogLineData(QVector<QCPGraphData> *lineData, const QCPGraphDataContainer::const_iterator &begin, const QCPGraphDataContainer::const_iterator &end) const;
+  void getOptimizedCustomLineData(QVector<QCPGraphData> *lineData, const QCPGraphDataContainer::const_iterator &begin, const QCPGraphDataContainer::const_iterator &end) const;
+  void sampleKeyPixelLineData(QVector<QCPGraphData> *lineData, const QCPGraphDataContainer::const_iterator &begin, const double *keyPixels, int count, QVector<int> *clusterPoints) const;
+  const double *logKeys() const;
+  template <class DataAccessor> void sampleLineData(QVector<QCPGraphData> *lineData, const DataAccessor &data, int begin, int end) const;
+  template <class DataAccessor> void sampleScatterData(QVector<QCPGraphData> *scatterData, const DataAccessor &data, int begin, int end) const;
+  QVector<QPointF> dataToLineStyleLines(const QVector<QCPGraphData> &data) const;
+  QVector<QPointF> dataToScatters(const QVector<QCPGraphData> &data) const;
+  QVector<QPointF> dataToPixelsBatched(const QVector<QCPGraphData> &data) const;
   QVector<QPointF> dataToLines(const QVector<QCPGraphData> &data) const;
   QVector<QPointF> dataToStepLeftLines(const QVector<QCPGraphData> &data) const;
   QVector<QPointF> dataToStepRightLines(const QVector<QCPGraphData> &data) const;
   QVector<QPointF> dataToStepCenterLines(const QVector<QCPGraphData> &data) const;
+  QVector<QPointF> mergeStepLines(const QVector<QPointF> &lines) const;
   QVector<QPointF> dataToImpulseLines(const QVector<QCPGraphData> &data) const;
   QVector<QCPDataRange> getNonNanSegments(const QVector<QPointF> *lineData, Qt::Orientation keyOrientation) const;
   QVector<QPair<QCPDataRange, QCPDataRange> > getOverlappingSegments(QVector<QCPDataRange> thisSegments, const QVector<QPointF> *thisData, QVector<QCPDataRange> otherSegments, const QVector<QPointF> *otherData) const;
@@ -165,7 +184,230 @@ protected:
   
   friend class QCustomPlot;
   friend class QCPLegend;
+  friend class QCPOverview;
 };
 Q_DECLARE_METATYPE(QCPGraph::LineStyle)
 
+// member templates are defined in the header, so graph subclasses with own data storage can instantiate them:
+
+/*! \internal
+
+  Performs the adaptive sampling of the line data (see \ref getOptimizedLineData) on the data
+  points with the indices \a begin to \a end-1, and appends the result to \a lineData. If adaptive
+  sampling is disabled or there are less than two data points per pixel on average, the data points
+  are appended one-to-one.
+
+  The data points are read through \a data, which must provide the methods <tt>double key(int
+  index) const</tt> and <tt>double value(int index) const</tt>. This allows subclasses which store
+  their data in a different format (e.g. \ref QCPCompactGraph) to use the same sampling as \ref
+  QCPGraph.
+*/
+template <class DataAccessor>
+void QCPGraph::sampleLineData(QVector<QCPGraphData> *lineData, const DataAccessor &data, int begin, int end) const
+{
+  QCPAxis *keyAxis = mKeyAxis.data();
+  if (!keyAxis || begin >= end) return;
+  
+  int dataCount = end-begin;
+  int maxCount = std::numeric_limits<int>::max();
+  if (mAdaptiveSampling)
+  {
+    double keyPixelSpan = qAbs(keyAxis->coordToPixel(data.key(begin))-keyAxis->coordToPixel(data.key(end-1)));
+    if (2*keyPixelSpan+2 < (double)std::numeric_limits<int>::max())
+      maxCount = 2*keyPixelSpan+2;
+  }
+  
+  if (mAdaptiveSampling && dataCount >= maxCount) // use adaptive sampling only if there are at least two points per pixel on average
+  {
+    int it = begin;
+    double minValue = data.value(it);
+    double maxValue = minValue;
+    int currentIntervalFirstPoint = it;
+    int reversedFactor = keyAxis->pixelOrientation(); // is used to calculate keyEpsilon pixel into the correct direction
+    int reversedRound = reversedFactor==-1 ? 1 : 0; // is used to switch between floor (normal) and ceil (reversed) rounding of currentIntervalStartKey
+    double currentIntervalStartKey = keyAxis->pixelToCoord((int)(keyAxis->coordToPixel(data.key(begin))+reversedRound));
+    double lastIntervalEndKey = currentIntervalStartKey;
+    double keyEpsilon = qAbs(currentIntervalStartKey-keyAxis->pixelToCoord(keyAxis->coordToPixel(currentIntervalStartKey)+1.0*reversedFactor)); // interval of one pixel on screen when mapped to plot key coordinates
+    bool keyEpsilonVariable = keyAxis->scaleType() != QCPAxis::stLinear; // indicates whether keyEpsilon needs to be updated after every interval (for log and custom axes)
+    int intervalDataCount = 1;
+    ++it; // advance to second data point because adaptive sampling works in 1 point retrospect
+    while (it != end)
+    {
+      const double key = data.key(it);
+      const double value = data.value(it);
+      if (key < currentIntervalStartKey+keyEpsilon) // data point is still within same pixel, so skip it and expand value span of this cluster if necessary
+      {
+        if (value < minValue)
+          minValue = value;
+        else if (value > maxValue)
+          maxValue = value;
+        ++intervalDataCount;
+      } else // new pixel interval started
+      {
+        if (intervalDataCount >= 2) // last pixel had multiple data points, consolidate them to a cluster
+        {
+          if (lastIntervalEndKey < currentIntervalStartKey-keyEpsilon) // last point is further away, so first point of this cluster must be at a real data point
+            lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.2, data.value(currentIntervalFirstPoint)));
+          lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.25, minValue));
+          lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.75, maxValue));
+          if (key > currentIntervalStartKey+keyEpsilon*2) // new pixel started further away from previous cluster, so make sure the last point of the cluster is at a real data point
+            lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.8, data.value(it-1)));
+        } else
+          lineData->append(QCPGraphData(data.key(currentIntervalFirstPoint), data.value(currentIntervalFirstPoint)));
+        lastIntervalEndKey = data.key(it-1);
+        minValue = value;
+        maxValue = value;
+        currentIntervalFirstPoint = it;
+        currentIntervalStartKey = keyAxis->pixelToCoord((int)(keyAxis->coordToPixel(key)+reversedRound));
+        if (keyEpsilonVariable)
+          keyEpsilon = qAbs(currentIntervalStartKey-keyAxis->pixelToCoord(keyAxis->coordToPixel(currentIntervalStartKey)+1.0*reversedFactor));
+        intervalDataCount = 1;
+      }
+      ++it;
+    }
+    // handle last interval:
+    if (intervalDataCount >= 2) // last pixel had multiple data points, consolidate them to a cluster
+    {
+      if (lastIntervalEndKey < currentIntervalStartKey-keyEpsilon) // last point wasn't a cluster, so first point of this cluster must be at a real data point
+        lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.2, data.value(currentIntervalFirstPoint)));
+      lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.25, minValue));
+      lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.75, maxValue));
+    } else
+      lineData->append(QCPGraphData(data.key(currentIntervalFirstPoint), data.value(currentIntervalFirstPoint)));
+    
+  } else // don't use adaptive sampling algorithm, transfer points one-to-one into the output
+  {
+    const int oldSize = lineData->size();
+    lineData->resize(oldSize+dataCount);
+    QCPGraphData *out = lineData->data()+oldSize;
+    for (int i=begin; i<end; ++i, ++out)
+    {
+      out->key = data.key(i);
+      out->value = data.value(i);
+    }
+  }
+}
+
+/*! \internal
+
+  Performs the adaptive sampling of the scatter data (see \ref getOptimizedScatterData) on the data
+  points with the indices \a begin to \a end-1, taking the scatter skip (\ref setScatterSkip) into
+  account, and appends the result to \a scatterData.
+
+  The data points are read through \a data, see \ref sampleLineData.
+*/
+template <class DataAccessor>
+void QCPGraph::sampleScatterData(QVector<QCPGraphData> *scatterData, const DataAccessor &data, int begin, int end) const
+{
+  QCPAxis *keyAxis = mKeyAxis.data();
+  QCPAxis *valueAxis = mValueAxis.data();
+  if (!keyAxis || !valueAxis) return;
+  
+  const int scatterModulo = mScatterSkip+1;
+  while (begin < end && begin % scatterModulo != 0) // advance begin to first non-skipped scatter
+    ++begin;
+  if (begin >= end) return;
+  int dataCount = end-begin;
+  int maxCount = std::numeric_limits<int>::max();
+  if (mAdaptiveSampling)
+  {
+    int keyPixelSpan = qAbs(keyAxis->coordToPixel(data.key(begin))-keyAxis->coordToPixel(data.key(end-1)));
+    maxCount = 2*keyPixelSpan+2;
+  }
+  
+  if (mAdaptiveSampling && dataCount >= maxCount) // use adaptive sampling only if there are at least two points per pixel on average
+  {
+    double valueMaxRange = valueAxis->range().upper;
+    double valueMinRange = valueAxis->range().lower;
+    int it = begin;
+    double minValue = data.value(it);
+    double maxValue = minValue;
+    int minValueIt = it;
+    int maxValueIt = it;
+    int currentIntervalStart = it;
+    int reversedFactor = keyAxis->pixelOrientation(); // is used to calculate keyEpsilon pixel into the correct direction
+    int reversedRound = reversedFactor==-1 ? 1 : 0; // is used to switch between floor (normal) and ceil (reversed) rounding of currentIntervalStartKey
+    double currentIntervalStartKey = keyAxis->pixelToCoord((int)(keyAxis->coordToPixel(data.key(begin))+reversedRound));
+    double keyEpsilon = qAbs(currentIntervalStartKey-keyAxis->pixelToCoord(keyAxis->coordToPixel(currentIntervalStartKey)+1.0*reversedFactor)); // interval of one pixel on screen when mapped to plot key coordinates
+    bool keyEpsilonVariable = keyAxis->scaleType() != QCPAxis::stLinear; // indicates whether keyEpsilon needs to be updated after every interval (for log and custom axes)
+    int intervalDataCount = 1;
+    it = qMin(it+scatterModulo, end); // advance to second (non-skipped) data point because adaptive sampling works in 1 point retrospect
+    // main loop over data points:
+    while (it < end)
+    {
+      const double key = data.key(it);
+      const double value = data.value(it);
+      if (key < currentIntervalStartKey+keyEpsilon) // data point is still within same pixel, so skip it and expand value span of this pixel if necessary
+      {
+        if (value < minValue && value > valueMinRange && value < valueMaxRange)
+        {
+          minValue = value;
+          minValueIt = it;
+        } else if (value > maxValue && value > valueMinRange && value < valueMaxRange)
+        {
+          maxValue = value;
+          maxValueIt = it;
+        }
+        ++intervalDataCount;
+      } else // new pixel started
+      {
+        if (intervalDataCount >= 2) // last pixel had multiple data points, consolidate them
+        {
+          // determine value pixel span and add as many points in interval to maintain certain vertical data density (this is specific to scatter plot):
+          double valuePixelSpan = qAbs(valueAxis->coordToPixel(minValue)-valueAxis->coordToPixel(maxValue));
+          int dataModulo = qMax(1, qRound(intervalDataCount/(valuePixelSpan/4.0))); // approximately every 4 value pixels one data point on average
+          int c = 0;
+          for (int intervalIt=currentIntervalStart; intervalIt<it; intervalIt+=scatterModulo)
+          {
+            const double intervalValue = data.value(intervalIt);
+            if ((c % dataModulo == 0 || intervalIt == minValueIt || intervalIt == maxValueIt) && intervalValue > valueMinRange && intervalValue < valueMaxRange)
+              scatterData->append(QCPGraphData(data.key(intervalIt), intervalValue));
+            ++c;
+          }
+        } else
+        {
+          const double startValue = data.value(currentIntervalStart);
+          if (startValue > valueMinRange && startValue < valueMaxRange)
+            scatterData->append(QCPGraphData(data.key(currentIntervalStart), startValue));
+        }
+        minValue = value;
+        maxValue = value;
+        currentIntervalStart = it;
+        currentIntervalStartKey = keyAxis->pixelToCoord((int)(keyAxis->coordToPixel(key)+reversedRound));
+        if (keyEpsilonVariable)
+          keyEpsilon = qAbs(currentIntervalStartKey-keyAxis->pixelToCoord(keyAxis->coordToPixel(currentIntervalStartKey)+1.0*reversedFactor));
+        intervalDataCount = 1;
+      }
+      it += scatterModulo;
+    }
+    it = qMin(it, end);
+    // handle last interval:
+    if (intervalDataCount >= 2) // last pixel had multiple data points, consolidate them
+    {
+      // determine value pixel span and add as many points in interval to maintain certain vertical data density (this is specific to scatter plot):
+      double valuePixelSpan = qAbs(valueAxis->coordToPixel(minValue)-valueAxis->coordToPixel(maxValue));
+      int dataModulo = qMax(1, qRound(intervalDataCount/(valuePixelSpan/4.0))); // approximately every 4 value pixels one data point on average
+      int c = 0;
+      for (int intervalIt=currentIntervalStart; intervalIt<it; intervalIt+=scatterModulo)
+      {
+        const double intervalValue = data.value(intervalIt);
+        if ((c % dataModulo == 0 || intervalIt == minValueIt || intervalIt == maxValueIt) && intervalValue > valueMinRange && intervalValue < valueMaxRange)
+          scatterData->append(QCPGraphData(data.key(intervalIt), intervalValue));
+        ++c;
+      }
+    } else
+    {
+      const double startValue = data.value(currentIntervalStart);
+      if (startValue > valueMinRange && startValue < valueMaxRange)
+        scatterData->append(QCPGraphData(data.key(currentIntervalStart), startValue));
+    }
+    
+  } else // don't use adaptive sampling algorithm, transfer points one-to-one into the output
+  {
+    scatterData->reserve(scatterData->size()+dataCount/scatterModulo+1);
+    for (int it=begin; it<end; it+=scatterModulo)
+      scatterData->append(QCPGraphData(data.key(it), data.value(it)));
+  }
+}
+
 #endif // QCP_PLOTTABLE_GRAPH_H
@@ -0,0 +1,987 @@
+/***************************************************************************
+**                                                                        **
+**  QCustomPlot, an easy to use, modern plotting widget for Qt            **
+**  Copyright (C) 2011-2017 Emanuel Eichhammer                            **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+****************************************************************************
+**           Author: Emanuel Eichhammer                                   **
+**  Website/Contact: http://www.qcustomplot.com/                          **
+**             Date: 04.09.17                                             **
+**          Version: 2.0.0                                                **
+****************************************************************************/
+
+#include "plottable-lodgraph.h"
+
+#include "../painter.h"
+#include "../core.h"
+#include "../axis/axis.h"
+#include "../layoutelements/layoutelement-axisrect.h"
+
+/*! \internal
+  
+  Fixed size header at the beginning of every LOD file written by \ref QCPLodFileWriter. All
+  offsets are in bytes from the beginning of the file and multiples of 8, so the columns and
+  pyramid levels can be accessed in place once the file is memory-mapped.
+*/
+struct QCPLodFileHeader
+{
+  quint32 magic;
+  quint32 version;
+  qint64 count;
+  qint32 bucketSize;
+  qint32 levelFactor;
+  qint32 levelCount;
+  qint32 reserved;
+  qint64 keysOffset;
+  qint64 valuesOffset;
+  qint64 levelTableOffset;
+  qint64 reserved2;
+};
+
+/*! \internal
+  
+  Entry of the level table of a LOD file, describing the location and size of one pyramid level.
+*/
+struct QCPLodFileLevel
+{
+  qint64 offset;
+  qint64 bucketCount;
+  qint64 bucketSize;
+};
+
+static const quint32 qcpLodFileMagic = 0x4C504351; // "QCPL" when written in little endian byte order
+static const quint32 qcpLodFileVersion = 1;
+
+/*! \internal
+  
+  Extends \a range (and sets \a found) to include the minimum \a min and maximum \a max of a group
+  of data points. NaN values, i.e. groups without valid data points, are ignored.
+*/
+inline void qcpLodExpandRange(QCPRange &range, bool &found, double min, double max)
+{
+  if (qIsNaN(min) || qIsNaN(max))
+    return;
+  if (!found)
+  {
+    range.lower = min;
+    range.upper = max;
+    found = true;
+  } else
+  {
+    if (min < range.lower)
+      range.lower = min;
+    if (max > range.upper)
+      range.upper = max;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////// QCPLodFileWriter
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*! \class QCPLodFileWriter
+  \brief Writes graph data to a columnar file with precomputed level-of-detail pyramid
+
+  QCPLodFileWriter creates the files displayed by \ref QCPLodGraph. Data is written in a streaming
+  fashion: open the file with \ref open, pass the (ascending) keys and values in arbitrarily sized
+  blocks to \ref append, and finalize the file with \ref close. Memory usage during writing is
+  independent of the data size, except for the pyramid (about 24/bucketSize bytes per data point).
+  For data that is available as a whole, \ref write does all three steps at once.
+
+  The file contains the key and value columns as raw \c double arrays, followed by a pyramid of
+  minimum/maximum levels: level 0 summarizes \a bucketSize consecutive data points per bucket,
+  each further level combines \a levelFactor buckets of the previous level, until a level consists
+  of a single bucket. All data is stored in the byte order of the writing machine.
+*/
+
+/*!
+  Creates a writer for LOD files whose finest pyramid level summarizes \a bucketSize data points
+  per bucket, and whose further levels each combine \a levelFactor buckets of the previous level.
+*/
+QCPLodFileWriter::QCPLodFileWriter(int bucketSize, int levelFactor) :
+  mBucketSize(qMax(2, bucketSize)),
+  mLevelFactor(qMax(2, levelFactor)),
+  mFile(0),
+  mValueFile(0),
+  mCount(0),
+  mLastKey(-std::numeric_limits<double>::infinity()),
+  mBucketFirstKey(0),
+  mBucketMin(qQNaN()),
+  mBucketMax(qQNaN())
+{
+}
+
+/*!
+  Destroys the writer. If a file is still open, it is finalized with \ref close.
+*/
+QCPLodFileWriter::~QCPLodFileWriter()
+{
+  if (mFile)
+    close();
+}
+
+/*!
+  Creates the LOD file \a fileName (an existing file is overwritten) and prepares it for \ref
+  append. Returns true on success.
+*/
+bool QCPLodFileWriter::open(const QString &fileName)
+{
+  if (mFile)
+  {
+    qDebug() << Q_FUNC_INFO << "writer already has an open file:" << mFile->fileName();
+    return false;
+  }
+  mFile = new QFile(fileName);
+  mValueFile = new QTemporaryFile;
+  if (!mFile->open(QIODevice::WriteOnly | QIODevice::Truncate) || !mValueFile->open())
+  {
+    qDebug() << Q_FUNC_INFO << "Couldn't open file for writing:" << fileName << mFile->errorString() << mValueFile->errorString();
+    abort();
+    return false;
+  }
+  // reserve space for the header, which is written when closing:
+  QCPLodFileHeader header;
+  memset(&header, 0, sizeof(header));
+  mFile->write(reinterpret_cast<const char*>(&header), sizeof(header));
+  mCount = 0;
+  mLastKey = -std::numeric_limits<double>::infinity();
+  mBuckets.clear();
+  return true;
+}
+
+/*!
+  Appends \a count data points with the given \a keys and \a values to the open file. The keys
+  must be ascending, also with respect to previously appended data. NaN values are allowed and
+  represent gaps in the graph.
+
+  Returns false if no file is open, the keys aren't sorted or writing fails.
+*/
+bool QCPLodFileWriter::append(const double *keys, const double *values, int count)
+{
+  if (!mFile)
+  {
+    qDebug() << Q_FUNC_INFO << "no open file";
+    return false;
+  }
+  if (count <= 0)
+    return true;
+  if (mCount+count > std::numeric_limits<int>::max())
+  {
+    qDebug() << Q_FUNC_INFO << "LOD files are limited to" << std::numeric_limits<int>::max() << "data points";
+    return false;
+  }
+  double lastKey = mLastKey;
+  for (int i=0; i<count; ++i)
+  {
+    if (!(keys[i] >= lastKey)) // also catches NaN keys
+    {
+      qDebug() << Q_FUNC_INFO << "keys must be ascending, got" << keys[i] << "after" << lastKey;
+      return false;
+    }
+    lastKey = keys[i];
+  }
+  
+  for (int i=0; i<count; ++i, ++mCount)
+  {
+    if (mCount % mBucketSize == 0)
+    {
+      if (mCount > 0)
+        finishBucket();
+      mBucketFirstKey = keys[i];
+      mBucketMin = qQNaN();
+      mBucketMax = qQNaN();
+    }
+    const double value = values[i];
+    if (!qIsNaN(value))
+    {
+      if (qIsNaN(mBucketMin) || value < mBucketMin)
+        mBucketMin = value;
+      if (qIsNaN(mBucketMax) || value > mBucketMax)
+        mBucketMax = value;
+    }
+  }
+  mLastKey = lastKey;
+  
+  const qint64 byteCount = (qint64)count*sizeof(double);
+  if (mFile->write(reinterpret_cast<const char*>(keys), byteCount) != byteCount ||
+      mValueFile->write(reinterpret_cast<const char*>(values), byteCount) != byteCount)
+  {
+    qDebug() << Q_FUNC_INFO << "Error while writing:" << mFile->errorString() << mValueFile->errorString();
+    abort();
+    return false;
+  }
+  return true;
+}
+
+/*! \overload
+  
+  Appends the data points given by \a keys and \a values, which must have the same size.
+*/
+bool QCPLodFileWriter::append(const QVector<double> &keys, const QVector<double> &values)
+{
+  if (keys.size() != values.size())
+    qDebug() << Q_FUNC_INFO << "keys and values have different sizes:" << keys.size() << values.size();
+  return append(keys.constData(), values.constData(), qMin(keys.size(), values.size()));
+}
+
+/*!
+  Finalizes the open file by appending the value column and the pyramid levels and writing the
+  header. Returns true on success.
+*/
+bool QCPLodFileWriter::close()
+{
+  if (!mFile)
+    return false;
+  if (mCount > 0)
+    finishBucket();
+  
+  // append value column:
+  mValueFile->seek(0);
+  QByteArray chunk;
+  while (!(chunk = mValueFile->read(1<<24)).isEmpty())
+  {
+    if (mFile->write(chunk) != chunk.size())
+    {
+      qDebug() << Q_FUNC_INFO << "Error while writing:" << mFile->errorString();
+      abort();
+      return false;
+    }
+  }
+  
+  // build pyramid levels, each combining mLevelFactor buckets of the previous one:
+  QList<QVector<double> > levels;
+  if (!mBuckets.isEmpty())
+    levels.append(mBuckets);
+  while (!levels.isEmpty() && levels.last().size() > 3)
+  {
+    const QVector<double> &previous = levels.last();
+    const int previousCount = previous.size()/3;
+    QVector<double> level;
+    level.reserve(((previousCount+mLevelFactor-1)/mLevelFactor)*3);
+    for (int i=0; i<previousCount; i+=mLevelFactor)
+    {
+      QCPRange range;
+      bool found = false;
+      for (int k=i; k<qMin(i+mLevelFactor, previousCount); ++k)
+        qcpLodExpandRange(range, found, previous.at(k*3+1), previous.at(k*3+2));
+      level << previous.at(i*3) << (found ? range.lower : qQNaN()) << (found ? range.upper : qQNaN());
+    }
+    levels.append(level);
+  }
+  
+  QCPLodFileHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic = qcpLodFileMagic;
+  header.version = qcpLodFileVersion;
+  header.count = mCount;
+  header.bucketSize = mBucketSize;
+  header.levelFactor = mLevelFactor;
+  header.levelCount = levels.size();
+  header.keysOffset = sizeof(QCPLodFileHeader);
+  header.valuesOffset = header.keysOffset+mCount*(qint64)sizeof(double);
+  header.levelTableOffset = header.valuesOffset+mCount*(qint64)sizeof(double);
+  qint64 levelOffset = header.levelTableOffset+levels.size()*(qint64)sizeof(QCPLodFileLevel);
+  qint64 bucketSize = mBucketSize;
+  for (int i=0; i<levels.size(); ++i)
+  {
+    QCPLodFileLevel entry;
+    entry.offset = levelOffset;
+    entry.bucketCount = levels.at(i).size()/3;
+    entry.bucketSize = bucketSize;
+    mFile->write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+    levelOffset += levels.at(i).size()*(qint64)sizeof(double);
+    bucketSize *= mLevelFactor;
+  }
+  for (int i=0; i<levels.size(); ++i)
+    mFile->write(reinterpret_cast<const char*>(levels.at(i).constData()), levels.at(i).size()*(qint64)sizeof(double));
+  mFile->seek(0);
+  mFile->write(reinterpret_cast<const char*>(&header), sizeof(header));
+  
+  const bool result = mFile->error() == QFile::NoError;
+  if (!result)
+    qDebug() << Q_FUNC_INFO << "Error while writing:" << mFile->errorString();
+  mFile->close();
+  delete mFile;
+  mFile = 0;
+  delete mValueFile;
+  mValueFile = 0;
+  mBuckets.clear();
+  return result;
+}
+
+/*!
+  Convenience method that writes the data points given by \a keys and \a values to the LOD file \a
+  fileName with the default bucket size and level factor. The keys must be ascending.
+
+  Returns true on success.
+*/
+bool QCPLodFileWriter::write(const QString &fileName, const QVector<double> &keys, const QVector<double> &values)
+{
+  QCPLodFileWriter writer;
+  return writer.open(fileName) && writer.append(keys, values) && writer.close();
+}
+
+/*! \internal
+
+  Appends the current (complete or final partial) bucket to the level 0 buckets.
+*/
+void QCPLodFileWriter::finishBucket()
+{
+  mBuckets << mBucketFirstKey << mBucketMin << mBucketMax;
+}
+
+/*! \internal
+
+  Closes and removes the partially written file after an error.
+*/
+void QCPLodFileWriter::abort()
+{
+  if (mFile)
+  {
+    mFile->close();
+    mFile->remove();
+    delete mFile;
+    mFile = 0;
+  }
+  delete mValueFile;
+  mValueFile = 0;
+  mBuckets.clear();
+  mCount = 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////// QCPLodGraph
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*! \class QCPLodGraph
+  \brief A graph which displays very large data sets directly from a memory-mapped LOD file
+
+  QCPLodGraph behaves like a regular \ref QCPGraph, but instead of holding its data in memory, it
+  displays the data of a file written by \ref QCPLodFileWriter, opened with \ref openFile. Opening
+  only maps the file and reads its header, so even files with hundreds of millions of data points
+  are displayed immediately.
+
+  When drawing, the graph determines the visible index range by binary search in the key column,
+  and selects the coarsest pyramid level whose buckets are still finer than one pixel of the axis
+  rect. Only the minimum/maximum pairs of that level within the visible range (plus the few data
+  points at the edges) are accessed, so the operating system only needs to page in those parts of
+  the file. The amount of data touched per replot is thus proportional to the axis rect width,
+  independent of the total data size and the zoom level. When zoomed in so far that even the finest
+  level has more than one bucket per pixel, the raw data points are used, reduced by the regular
+  adaptive sampling of \ref QCPGraph.
+
+  \ref getValueRange (and thus \ref QCPAbstractPlottable::rescaleAxes) uses the pyramid as well.
+
+  Since the pyramid only stores the minimum and maximum of each bucket, gaps (NaN values) in the
+  data are only shown where whole buckets consist of NaN values at the current level of detail.
+  The number of data points is limited to the maximum value of \c int.
+
+  \note The \ref QCPGraph::data container inherited from \ref QCPGraph is not used by this class
+  and stays empty. Access the data via \ref value and the \ref QCPPlottableInterface1D methods
+  instead.
+*/
+
+/*!
+  Constructs a LOD graph which uses \a keyAxis as its key axis ("x") and \a valueAxis as its value
+  axis ("y"). Use \ref openFile to display the data of a LOD file.
+
+  Like \ref QCPGraph, the created graph is automatically registered with the QCustomPlot instance
+  inferred from \a keyAxis, which takes ownership of it.
+*/
+QCPLodGraph::QCPLodGraph(QCPAxis *keyAxis, QCPAxis *valueAxis) :
+  QCPGraph(keyAxis, valueAxis),
+  mFile(0),
+  mMappedData(0),
+  mKeys(0),
+  mValues(0),
+  mCount(0)
+{
+}
+
+QCPLodGraph::~QCPLodGraph()
+{
+  closeFile();
+}
+
+/*!
+  Returns the name of the currently opened LOD file, or an empty string if no file is open.
+*/
+QString QCPLodGraph::fileName() const
+{
+  return mFile ? mFile->fileName() : QString();
+}
+
+/*!
+  Opens the LOD file \a fileName written by \ref QCPLodFileWriter and displays its data. A
+  previously opened file is closed. Returns true on success.
+*/
+bool QCPLodGraph::openFile(const QString &fileName)
+{
+  closeFile();
+  mFile = new QFile(fileName);
+  if (!mFile->open(QIODevice::ReadOnly))
+  {
+    qDebug() << Q_FUNC_INFO << "Couldn't open file for reading:" << fileName << mFile->errorString();
+    closeFile();
+    return false;
+  }
+  const qint64 fileSize = mFile->size();
+  if (fileSize < (qint64)sizeof(QCPLodFileHeader) || !(mMappedData = mFile->map(0, fileSize)))
+  {
+    qDebug() << Q_FUNC_INFO << "Couldn't map file:" << fileName << mFile->errorString();
+    closeFile();
+    return false;
+  }
+  
+  QCPLodFileHeader header;
+  memcpy(&header, mMappedData, sizeof(header));
+  QString error;
+  if (header.magic != qcpLodFileMagic)
+    error = QLatin1String("not a LOD file or different byte order");
+  else if (header.version > qcpLodFileVersion)
+    error = QString(QLatin1String("unsupported format version %1")).arg(header.version);
+  else if (header.count < 0 || header.count > std::numeric_limits<int>::max() || header.levelCount < 0 ||
+           header.keysOffset < 0 || header.keysOffset > fileSize || header.valuesOffset < 0 || header.valuesOffset > fileSize ||
+           header.levelTableOffset < 0 || header.levelTableOffset > fileSize ||
+           header.keysOffset%8 != 0 || header.valuesOffset%8 != 0 || header.levelTableOffset%8 != 0 ||
+           header.keysOffset+header.count*(qint64)sizeof(double) > fileSize ||
+           header.valuesOffset+header.count*(qint64)sizeof(double) > fileSize ||
+           header.levelTableOffset+header.levelCount*(qint64)sizeof(QCPLodFileLevel) > fileSize)
+    error = QLatin1String("file is truncated or corrupt");
+  for (int i=0; i<header.levelCount && error.isEmpty(); ++i)
+  {
+    QCPLodFileLevel entry;
+    memcpy(&entry, mMappedData+header.levelTableOffset+i*sizeof(QCPLodFileLevel), sizeof(entry));
+    if (entry.offset < 0 || entry.offset > fileSize || entry.offset%8 != 0 || entry.bucketCount < 0 || entry.bucketCount > std::numeric_limits<int>::max() || entry.bucketSize < 1 ||
+        entry.offset+entry.bucketCount*3*(qint64)sizeof(double) > fileSize || (header.count > 0 && entry.bucketCount < (header.count-1)/entry.bucketSize+1)) // division avoids overflow for huge bucket sizes
+    {
+      error = QLatin1String("file is truncated or corrupt");
+      break;
+    }
+    Level level;
+    level.buckets = reinterpret_cast<const double*>(mMappedData+entry.offset);
+    level.bucketCount = (int)entry.bucketCount;
+    level.bucketSize = entry.bucketSize;
+    mLevels.append(level);
+  }
+  if (!error.isEmpty())
+  {
+    qDebug() << Q_FUNC_INFO << "Couldn't open" << fileName << ":" << error;
+    closeFile();
+    return false;
+  }
+  mKeys = reinterpret_cast<const double*>(mMappedData+header.keysOffset);
+  mValues = reinterpret_cast<const double*>(mMappedData+header.valuesOffset);
+  mCount = header.count;
+  return true;
+}
+
+/*!
+  Closes the currently opened LOD file. The graph is empty afterwards.
+*/
+void QCPLodGraph::closeFile()
+{
+  if (mFile)
+  {
+    if (mMappedData)
+      mFile->unmap(mMappedData);
+    delete mFile;
+  }
+  mFile = 0;
+  mMappedData = 0;
+  mKeys = 0;
+  mValues = 0;
+  mCount = 0;
+  mLevels.clear();
+}
+
+/*!
+  Returns the value of the data point at \a index. \a index must be between 0 and \ref dataCount
+  - 1.
+*/
+double QCPLodGraph::value(int index) const
+{
+  return mValues[index];
+}
+
+/* inherits documentation from base class */
+int QCPLodGraph::dataCount() const
+{
+  return (int)mCount; // openFile only accepts files whose count fits into an int
+}
+
+/* inherits documentation from base class */
+double QCPLodGraph::dataMainKey(int index) const
+{
+  if (index >= 0 && index < mCount)
+  {
+    return mKeys[index];
+  } else
+  {
+    qDebug() << Q_FUNC_INFO << "Index out of bounds" << index;
+    return 0;
+  }
+}
+
+/* inherits documentation from base class */
+double QCPLodGraph::dataSortKey(int index) const
+{
+  return dataMainKey(index);
+}
+
+/* inherits documentation from base class */
+double QCPLodGraph::dataMainValue(int index) const
+{
+  if (index >= 0 && index < mCount)
+  {
+    return mValues[index];
+  } else
+  {
+    qDebug() << Q_FUNC_INFO << "Index out of bounds" << index;
+    return 0;
+  }
+}
+
+/* inherits documentation from base class */
+QCPRange QCPLodGraph::dataValueRange(int index) const
+{
+  if (index >= 0 && index < mCount)
+  {
+    return QCPRange(mValues[index], mValues[index]);
+  } else
+  {
+    qDebug() << Q_FUNC_INFO << "Index out of bounds" << index;
+    return QCPRange(0, 0);
+  }
+}
+
+/* inherits documentation from base class */
+QPointF QCPLodGraph::dataPixelPosition(int index) const
+{
+  if (index >= 0 && index < mCount)
+  {
+    return coordsToPixels(mKeys[index], mValues[index]);
+  } else
+  {
+    qDebug() << Q_FUNC_INFO << "Index out of bounds" << index;
+    return QPointF();
+  }
+}
+
+/*!
+  Returns the data points inside \a rect as a data selection. Buckets of the finest pyramid level
+  whose values lie completely outside the value range of \a rect are skipped without accessing the
+  individual data points.
+*/
+QCPDataSelection QCPLodGraph::selectTestRect(const QRectF &rect, bool onlySelectable) const
+{
+  QCPDataSelection result;
+  if ((onlySelectable && mSelectable == QCP::stNone) || mCount == 0)
+    return result;
+  if (!mKeyAxis || !mValueAxis)
+    return result;
+  
+  // convert rect given in pixels to ranges given in plot coordinates:
+  double key1, value1, key2, value2;
+  pixelsToCoords(rect.topLeft(), key1, value1);
+  pixelsToCoords(rect.bottomRight(), key2, value2);
+  QCPRange keyRange(key1, key2); // QCPRange normalizes internally so we don't have to care about whether key1 < key2
+  QCPRange valueRange(value1, value2);
+  const int begin = findBegin(keyRange.lower, false);
+  const int end = findEnd(keyRange.upper, false);
+  const Level *level = mLevels.isEmpty() ? 0 : &mLevels.first();
+  
+  int currentSegmentBegin = -1; // -1 means we're currently not in a segment that's contained in rect
+  int i = begin;
+  while (i < end)
+  {
+    // skip whole buckets if their min/max show that none of their data points is inside rect:
+    if (level && i % level->bucketSize == 0 && i+level->bucketSize <= end)
+    {
+      const double *bucket = level->buckets+(i/level->bucketSize)*3;
+      if (qIsNaN(bucket[1]) || bucket[2] < valueRange.lower || bucket[1] > valueRange.upper)
+      {
+        if (currentSegmentBegin != -1)
+        {
+          result.addDataRange(QCPDataRange(currentSegmentBegin, i), false);
+          currentSegmentBegin = -1;
+        }
+        i += (int)level->bucketSize;
+        continue;
+      }
+    }
+    const bool inside = valueRange.contains(mValues[i]) && keyRange.contains(mKeys[i]);
+    if (currentSegmentBegin == -1 && inside) // start segment
+      currentSegmentBegin = i;
+    else if (currentSegmentBegin != -1 && !inside) // segment just ended
+    {
+      result.addDataRange(QCPDataRange(currentSegmentBegin, i), false);
+      currentSegmentBegin = -1;
+    }
+    ++i;
+  }
+  // process potential last segment:
+  if (currentSegmentBegin != -1)
+    result.addDataRange(QCPDataRange(currentSegmentBegin, end), false);
+  
+  result.simplify();
+  return result;
+}
+
+/* inherits documentation from base class */
+int QCPLodGraph::findBegin(double sortKey, bool expandedRange) const
+{
+  if (mCount == 0)
+    return 0;
+  int result = int(std::lower_bound(mKeys, mKeys+mCount, sortKey)-mKeys);
+  if (expandedRange && result > 0) // also covers result == size case, and we know size-1 is valid because mCount isn't zero
+    --result;
+  return result;
+}
+
+/* inherits documentation from base class */
+int QCPLodGraph::findEnd(double sortKey, bool expandedRange) const
+{
+  if (mCount == 0)
+    return 0;
+  int result = int(std::upper_bound(mKeys, mKeys+mCount, sortKey)-mKeys);
+  if (expandedRange && result < mCount)
+    ++result;
+  return result;
+}
+
+/* inherits documentation from base class */
+double QCPLodGraph::selectTest(const QPointF &pos, bool onlySelectable, QVariant *details) const
+{
+  if ((onlySelectable && mSelectable == QCP::stNone) || mCount == 0)
+    return -1;
+  if (!mKeyAxis || !mValueAxis)
+    return -1;
+  if (mLineStyle == lsNone && mScatterStyle.isNone())
+    return -1;
+  if (!mKeyAxis.data()->axisRect()->rect().contains(pos.toPoint()))
+    return -1;
+  
+  // calculate minimum distances to graph data points and find closest data point:
+  double minDistSqr = std::numeric_limits<double>::max();
+  int closestIndex = dataCount();
+  double posKey, posKeyMin, posKeyMax, dummy;
+  pixelsToCoords(pos, posKey, dummy);
+  pixelsToCoords(pos-QPointF(mParentPlot->selectionTolerance(), mParentPlot->selectionTolerance()), posKeyMin, dummy);
+  pixelsToCoords(pos+QPointF(mParentPlot->selectionTolerance(), mParentPlot->selectionTolerance()), posKeyMax, dummy);
+  if (posKeyMin > posKeyMax)
+    qSwap(posKeyMin, posKeyMax);
+  const int begin = findBegin(posKeyMin, true);
+  const int end = findEnd(posKeyMax, true);
+  if (end-begin <= 10000)
+  {
+    for (int i=begin; i<end; ++i)
+    {
+      const double currentDistSqr = QCPVector2D(coordsToPixels(mKeys[i], mValues[i])-pos).lengthSquared();
+      if (currentDistSqr < minDistSqr)
+      {
+        minDistSqr = currentDistSqr;
+        closestIndex = i;
+      }
+    }
+  } else // too many points around cursor to test each, use the one at the cursor key (the line distance below determines the result anyway)
+  {
+    closestIndex = qBound(0, findBegin(posKey, false), dataCount()-1);
+    minDistSqr = QCPVector2D(coordsToPixels(mKeys[closestIndex], mValues[closestIndex])-pos).lengthSquared();
+  }
+  
+  // calculate distance to graph line if there is one (if so, will probably be smaller than distance to closest data point):
+  if (mLineStyle != lsNone)
+  {
+    QVector<QPointF> lineData;
+    getLines(&lineData, QCPDataRange(0, dataCount()));
+    QCPVector2D p(pos);
+    const int step = mLineStyle==lsImpulse ? 2 : 1; // impulse plot differs from other line styles in that the lineData points are only pairwise connected
+    for (int i=0; i<lineData.size()-1; i+=step)
+    {
+      const double currentDistSqr = p.distanceSquaredToLine(lineData.at(i), lineData.at(i+1));
+      if (currentDistSqr < minDistSqr)
+        minDistSqr = currentDistSqr;
+    }
+  }
+  
+  if (details)
+  {
+    QCPDataSelection selectionResult;
+    if (closestIndex != mCount)
+      selectionResult.addDataRange(QCPDataRange(closestIndex, closestIndex+1), false);
+    details->setValue(selectionResult);
+  }
+  return qSqrt(minDistSqr);
+}
+
+/*!
+  Returns the key range of the data. Since the keys are sorted, this only requires accessing the
+  first and last key (or a binary search, if \a inSignDomain is restricted).
+*/
+QCPRange QCPLodGraph::getKeyRange(bool &foundRange, QCP::SignDomain inSignDomain) const
+{
+  QCPRange range;
+  foundRange = false;
+  if (mCount == 0)
+    return range;
+  int first = 0;
+  int last = dataCount()-1;
+  if (inSignDomain == QCP::sdPositive)
+    first = int(std::upper_bound(mKeys, mKeys+mCount, 0.0)-mKeys);
+  else if (inSignDomain == QCP::sdNegative)
+    last = int(std::lower_bound(mKeys, mKeys+mCount, 0.0)-mKeys)-1;
+  if (first <= last)
+  {
+    range.lower = mKeys[first];
+    range.upper = mKeys[last];
+    foundRange = true;
+  }
+  return range;
+}
+
+/*!
+  Returns the value range of the data. If \a inSignDomain is \ref QCP::sdBoth, the range is
+  determined from the pyramid levels, accessing only a few buckets per level. Restricted sign
+  domains require a scan of the value column in the key range.
+*/
+QCPRange QCPLodGraph::getValueRange(bool &foundRange, QCP::SignDomain inSignDomain, const QCPRange &inKeyRange) const
+{
+  int begin = 0;
+  int end = dataCount();
+  if (inKeyRange != QCPRange())
+  {
+    begin = findBegin(inKeyRange.lower, false);
+    end = findEnd(inKeyRange.upper, false);
+  }
+  if (inSignDomain == QCP::sdBoth)
+    return indexValueRange(begin, end, mLevels.size()-1, foundRange);
+  
+  QCPRange range;
+  foundRange = false;
+  for (int i=begin; i<end; ++i)
+  {
+    const double current = mValues[i];
+    if ((inSignDomain == QCP::sdNegative && current >= 0) || (inSignDomain == QCP::sdPositive && current <= 0))
+      continue;
+    qcpLodExpandRange(range, foundRange, current, current);
+  }
+  return range;
+}
+
+/*! \internal
+
+  Reimplements the line generation of \ref QCPGraph such that the line is generated from the
+  pyramid level appropriate for the current zoom, see \ref getLodData.
+*/
+void QCPLodGraph::getLines(QVector<QPointF> *lines, const QCPDataRange &dataRange) const
+{
+  if (!lines) return;
+  int begin, end;
+  getVisibleIndexBounds(begin, end, dataRange);
+  if (begin == end)
+  {
+    lines->clear();
+    return;
+  }
+  
+  QVector<QCPGraphData> lineData;
+  if (mLineStyle != lsNone)
+    getLodData(&lineData, begin, end, false);
+  
+  if (mKeyAxis->rangeReversed() != (mKeyAxis->orientation() == Qt::Vertical)) // make sure key pixels are sorted ascending in lineData (significantly simplifies following processing)
+    std::reverse(lineData.begin(), lineData.end());
+  
+  *lines = dataToLineStyleLines(lineData);
+}
+
+/*! \internal
+
+  Reimplements the scatter generation of \ref QCPGraph such that the scatters are generated from
+  the pyramid level appropriate for the current zoom, see \ref getLodData.
+*/
+void QCPLodGraph::getScatters(QVector<QPointF> *scatters, const QCPDataRange &dataRange) const
+{
+  if (!scatters) return;
+  if (!mKeyAxis || !mValueAxis) { qDebug() << Q_FUNC_INFO << "invalid key or value axis"; scatters->clear(); return; }
+  
+  int begin, end;
+  getVisibleIndexBounds(begin, end, dataRange);
+  if (begin == end)
+  {
+    scatters->clear();
+    return;
+  }
+  
+  QVector<QCPGraphData> data;
+  getLodData(&data, begin, end, true);
+  
+  if (mKeyAxis->rangeReversed() != (mKeyAxis->orientation() == Qt::Vertical)) // make sure key pixels are sorted ascending in data (significantly simplifies following processing)
+    std::reverse(data.begin(), data.end());
+  
+  *scatters = dataToScatters(data);
+}
+
+/*! \internal
+
+  Index based counterpart of \ref QCPGraph::getVisibleDataBounds. Outputs the currently visible
+  data index range via \a begin and \a end, including the points just outside the visible key
+  range, and never exceeding \a rangeRestriction.
+*/
+void QCPLodGraph::getVisibleIndexBounds(int &begin, int &end, const QCPDataRange &rangeRestriction) const
+{
+  if (rangeRestriction.isEmpty() || !mKeyAxis)
+  {
+    begin = dataCount();
+    end = begin;
+  } else
+  {
+    QCPDataRange visibleRange(findBegin(mKeyAxis->range().lower), findEnd(mKeyAxis->range().upper));
+    visibleRange = visibleRange.bounded(rangeRestriction.bounded(QCPDataRange(0, dataCount())));
+    begin = visibleRange.begin();
+    end = visibleRange.end();
+  }
+}
+
+/*! \internal
+  
+  Provides the mapped key and value columns to the sampling templates of \ref QCPGraph.
+*/
+class QCPLodDataAccessor
+{
+public:
+  QCPLodDataAccessor(const double *keys, const double *values) : mKeys(keys), mValues(values) {}
+  double key(int index) const { return mKeys[index]; }
+  double value(int index) const { return mValues[index]; }
+private:
+  const double *mKeys, *mValues;
+};
+
+/*! \internal
+
+  Outputs the data to draw for the index range \a begin to \a end in \a data. If a pyramid level
+  is appropriate for the current zoom (see \ref selectLevel), each of its buckets in the range is
+  represented by two points at the bucket's first key, holding its minimum and maximum value. The
+  partial buckets at the edges of the range are summarized with finer levels. Otherwise, the raw
+  data points are passed through the adaptive sampling of \ref QCPGraph (\ref sampleLineData or,
+  if \a forScatters is true, \ref sampleScatterData), so densities below the bucket size of the
+  finest level are reduced as well.
+*/
+void QCPLodGraph::getLodData(QVector<QCPGraphData> *data, int begin, int end, bool forScatters) const
+{
+  const int levelIndex = selectLevel(begin, end);
+  if (levelIndex < 0) // zoomed in far enough to use raw data, the regular adaptive sampling reduces the remaining density
+  {
+    if (forScatters)
+      sampleScatterData(data, QCPLodDataAccessor(mKeys, mValues), begin, end);
+    else
+      sampleLineData(data, QCPLodDataAccessor(mKeys, mValues), begin, end);
+    return;
+  }
+  
+  const Level &level = mLevels.at(levelIndex);
+  const int firstBucket = int((begin+level.bucketSize-1)/level.bucketSize);
+  const int endBucket = (int)qMin(end/level.bucketSize, (qint64)level.bucketCount);
+  data->reserve(2*qMax(0, endBucket-firstBucket)+4);
+  bool found;
+  // leading partial bucket:
+  const int leadingEnd = (int)qMin((qint64)end, firstBucket*level.bucketSize);
+  if (begin < leadingEnd)
+  {
+    const QCPRange range = indexValueRange(begin, leadingEnd, levelIndex-1, found);
+    data->append(QCPGraphData(mKeys[begin], found ? range.lower : qQNaN()));
+    if (found)
+      data->append(QCPGraphData(mKeys[begin], range.upper));
+  }
+  // full buckets:
+  for (int b=firstBucket; b<endBucket; ++b)
+  {
+    const double *bucket = level.buckets+b*3;
+    data->append(QCPGraphData(bucket[0], bucket[1]));
+    if (!qIsNaN(bucket[1]))
+      data->append(QCPGraphData(bucket[0], bucket[2]));
+  }
+  // trailing partial bucket:
+  const int trailingBegin = qMax(leadingEnd, int(qMax(firstBucket, endBucket)*level.bucketSize));
+  if (trailingBegin < end)
+  {
+    const QCPRange range = indexValueRange(trailingBegin, end, levelIndex-1, found);
+    data->append(QCPGraphData(mKeys[trailingBegin], found ? range.lower : qQNaN()));
+    if (found)
+      data->append(QCPGraphData(mKeys[trailingBegin], range.upper));
+  }
+}
+
+/*! \internal
+
+  Returns the index of the coarsest pyramid level whose buckets contain no more data points than
+  are displayed per pixel in the index range \a begin to \a end. Returns -1 if the raw data should
+  be used, because there are fewer data points per pixel than the bucket size of the finest level,
+  or adaptive sampling is disabled.
+*/
+int QCPLodGraph::selectLevel(int begin, int end) const
+{
+  if (!mAdaptiveSampling || mLevels.isEmpty() || end-begin < 2)
+    return -1;
+  const double keyPixelSpan = qAbs(mKeyAxis->coordToPixel(mKeys[begin])-mKeyAxis->coordToPixel(mKeys[end-1]));
+  const double pointsPerPixel = (end-begin)/qMax(1.0, keyPixelSpan);
+  int result = -1;
+  for (int i=0; i<mLevels.size(); ++i)
+  {
+    if (mLevels.at(i).bucketSize <= pointsPerPixel)
+      result = i;
+  }
+  return result;
+}
+
+/*! \internal
+
+  Returns the value range of the data points in the index range \a begin to \a end, ignoring NaN
+  values. Buckets of pyramid level \a level that lie completely inside the range are taken from the
+  pyramid, the remaining data points at the edges are handled recursively with the next finer
+  level. Level -1 means the raw values are scanned. \a foundRange is set to whether the range
+  contains any non-NaN value.
+*/
+QCPRange QCPLodGraph::indexValueRange(int begin, int end, int level, bool &foundRange) const
+{
+  QCPRange range;
+  foundRange = false;
+  if (begin >= end)
+    return range;
+  if (level < 0)
+  {
+    for (int i=begin; i<end; ++i)
+      qcpLodExpandRange(range, foundRange, mValues[i], mValues[i]);
+    return range;
+  }
+  
+  const Level &lodLevel = mLevels.at(level);
+  const int firstBucket = int((begin+lodLevel.bucketSize-1)/lodLevel.bucketSize);
+  const int endBucket = (int)qMin(end/lodLevel.bucketSize, (qint64)lodLevel.bucketCount);
+  if (firstBucket >= endBucket)
+    return indexValueRange(begin, end, level-1, foundRange);
+  for (int b=firstBucket; b<endBucket; ++b)
+    qcpLodExpandRange(range, foundRange, lodLevel.buckets[b*3+1], lodLevel.buckets[b*3+2]);
+  bool found;
+  QCPRange edgeRange = indexValueRange(begin, int(firstBucket*lodLevel.bucketSize), level-1, found);
+  if (found)
+    qcpLodExpandRange(range, foundRange, edgeRange.lower, edgeRange.upper);
+  edgeRange = indexValueRange(int(endBucket*lodLevel.bucketSize), end, level-1, found);
+  if (found)
+    qcpLodExpandRange(range, foundRange, edgeRange.lower, edgeRange.upper);
+  return range;
+}
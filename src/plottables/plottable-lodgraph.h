@@ -0,0 +1,140 @@
+/***************************************************************************
+**                                                                        **
+**  QCustomPlot, an easy to use, modern plotting widget for Qt            **
+**  Copyright (C) 2011-2017 Emanuel Eichhammer                            **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+****************************************************************************
+**           Author: Emanuel Eichhammer                                   **
+**  Website/Contact: http://www.qcustomplot.com/                          **
+**             Date: 04.09.17                                             **
+**          Version: 2.0.0                                                **
+****************************************************************************/
+/*! \file */
+#ifndef QCP_PLOTTABLE_LODGRAPH_H
+#define QCP_PLOTTABLE_LODGRAPH_H
+
+#include "../global.h"
+#include "plottable-graph.h"
+
+class QCPPainter;
+class QCPAxis;
+
+class QCP_LIB_DECL QCPLodFileWriter
+{
+public:
+  explicit QCPLodFileWriter(int bucketSize=256, int levelFactor=8);
+  ~QCPLodFileWriter();
+  
+  // getters:
+  int bucketSize() const { return mBucketSize; }
+  int levelFactor() const { return mLevelFactor; }
+  qint64 count() const { return mCount; }
+  bool isOpen() const { return mFile != 0; }
+  
+  // non-property methods:
+  bool open(const QString &fileName);
+  bool append(const double *keys, const double *values, int count);
+  bool append(const QVector<double> &keys, const QVector<double> &values);
+  bool close();
+  static bool write(const QString &fileName, const QVector<double> &keys, const QVector<double> &values);
+  
+protected:
+  // property members:
+  int mBucketSize, mLevelFactor;
+  // non-property members:
+  QFile *mFile;
+  QTemporaryFile *mValueFile;
+  qint64 mCount;
+  double mLastKey;
+  QVector<double> mBuckets; // level 0 buckets as (first key, min, max) triples
+  double mBucketFirstKey, mBucketMin, mBucketMax;
+  
+  // non-virtual methods:
+  void finishBucket();
+  void abort();
+  
+private:
+  Q_DISABLE_COPY(QCPLodFileWriter)
+};
+
+
+class QCP_LIB_DECL QCPLodGraph : public QCPGraph
+{
+  Q_OBJECT
+  /// \cond INCLUDE_QPROPERTIES
+  Q_PROPERTY(QString fileName READ fileName)
+  /// \endcond
+public:
+  explicit QCPLodGraph(QCPAxis *keyAxis, QCPAxis *valueAxis);
+  virtual ~QCPLodGraph();
+  
+  // getters:
+  QString fileName() const;
+  bool isOpen() const { return mMappedData != 0; }
+  int levelCount() const { return mLevels.size(); }
+  
+  // non-property methods:
+  bool openFile(const QString &fileName);
+  void closeFile();
+  double value(int index) const;
+  
+  // reimplemented virtual methods:
+  virtual int dataCount() const Q_DECL_OVERRIDE;
+  virtual double dataMainKey(int index) const Q_DECL_OVERRIDE;
+  virtual double dataSortKey(int index) const Q_DECL_OVERRIDE;
+  virtual double dataMainValue(int index) const Q_DECL_OVERRIDE;
+  virtual QCPRange dataValueRange(int index) const Q_DECL_OVERRIDE;
+  virtual QPointF dataPixelPosition(int index) const Q_DECL_OVERRIDE;
+  virtual QCPDataSelection selectTestRect(const QRectF &rect, bool onlySelectable) const Q_DECL_OVERRIDE;
+  virtual int findBegin(double sortKey, bool expandedRange=true) const Q_DECL_OVERRIDE;
+  virtual int findEnd(double sortKey, bool expandedRange=true) const Q_DECL_OVERRIDE;
+  virtual double selectTest(const QPointF &pos, bool onlySelectable, QVariant *details=0) const Q_DECL_OVERRIDE;
+  virtual QCPRange getKeyRange(bool &foundRange, QCP::SignDomain inSignDomain=QCP::sdBoth) const Q_DECL_OVERRIDE;
+  virtual QCPRange getValueRange(bool &foundRange, QCP::SignDomain inSignDomain=QCP::sdBoth, const QCPRange &inKeyRange=QCPRange()) const Q_DECL_OVERRIDE;
+  
+protected:
+  /*!
+    Describes one level of the min/max pyramid stored in a LOD file. Each bucket holds the first key
+    and the minimum and maximum value of \a bucketSize consecutive data points.
+  */
+  struct Level
+  {
+    const double *buckets; ///< (first key, min, max) triples in the mapped file
+    int bucketCount;
+    qint64 bucketSize;
+  };
+  
+  // non-property members:
+  QFile *mFile;
+  uchar *mMappedData;
+  const double *mKeys, *mValues;
+  qint64 mCount;
+  QVector<Level> mLevels;
+  
+  // reimplemented virtual methods:
+  virtual void getLines(QVector<QPointF> *lines, const QCPDataRange &dataRange) const Q_DECL_OVERRIDE;
+  virtual void getScatters(QVector<QPointF> *scatters, const QCPDataRange &dataRange) const Q_DECL_OVERRIDE;
+  
+  // non-virtual methods:
+  void getVisibleIndexBounds(int &begin, int &end, const QCPDataRange &rangeRestriction) const;
+  void getLodData(QVector<QCPGraphData> *data, int begin, int end, bool forScatters) const;
+  int selectLevel(int begin, int end) const;
+  QCPRange indexValueRange(int begin, int end, int level, bool &foundRange) const;
+  
+  friend class QCPOverview;
+};
+
+#endif // QCP_PLOTTABLE_LODGRAPH_H
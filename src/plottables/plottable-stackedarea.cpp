@@ -0,0 +1,754 @@
+/***************************************************************************
+**                                                                        **
+**  QCustomPlot, an easy to use, modern plotting widget for Qt            **
+**  Copyright (C) 2011-2017 Emanuel Eichhammer                            **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+****************************************************************************
+**           Author: Emanuel Eichhammer                                   **
+**  Website/Contact: http://www.qcustomplot.com/                          **
+**             Date: 04.09.17                                             **
+**          Version: 2.0.0                                                **
+****************************************************************************/
+
+#include "plottable-stackedarea.h"
+
+#include "../painter.h"
+#include "../core.h"
+#include "../axis/axis.h"
+#include "../layoutelements/layoutelement-axisrect.h"
+
+/*! \internal
+  
+  Computes the cumulative sums of all layers of a \ref QCPStackedArea for one chunk of key
+  indices. Instances are run concurrently by \ref QCPStackedArea::updateCumulative, each one
+  writing to a disjoint index range of the cumulative buffer.
+*/
+class QCPStackedAreaSumJob : public QRunnable
+{
+public:
+  QCPStackedAreaSumJob(const QVector<const double*> &layers, double *cumulative, int keyCount, int begin, int end) :
+    mLayers(layers),
+    mCumulative(cumulative),
+    mKeyCount(keyCount),
+    mBegin(begin),
+    mEnd(end)
+  {
+    setAutoDelete(false);
+  }
+  
+  virtual void run() Q_DECL_OVERRIDE
+  {
+    for (int l=0; l<mLayers.size(); ++l)
+    {
+      const double *values = mLayers.at(l);
+      double *sum = mCumulative+l*(qint64)mKeyCount;
+      const double *below = l > 0 ? sum-mKeyCount : 0;
+      for (int k=mBegin; k<mEnd; ++k)
+      {
+        const double value = qIsNaN(values[k]) ? 0 : values[k];
+        sum[k] = below ? below[k]+value : value;
+      }
+    }
+  }
+  
+private:
+  QVector<const double*> mLayers;
+  double *mCumulative;
+  int mKeyCount, mBegin, mEnd;
+};
+
+/*! \internal
+  
+  Orders key indices by their key, used by \ref QCPStackedArea::setData to sort unsorted keys
+  together with the values of all layers.
+*/
+class QCPStackedAreaKeyLess
+{
+public:
+  explicit QCPStackedAreaKeyLess(const double *keys) : mKeys(keys) {}
+  bool operator()(int a, int b) const { return mKeys[a] < mKeys[b]; }
+  
+private:
+  const double *mKeys;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////// QCPStackedArea
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*! \class QCPStackedArea
+  \brief A plottable representing a stacked area chart of multiple series sharing one key vector
+  
+  QCPStackedArea holds any number of layers (series) that share the key vector passed to \ref
+  setData. Each layer is drawn as a filled area between the cumulative sum of all layers up to and
+  including it, and the cumulative sum of the layers below it. The first layer is filled down to
+  zero. NaN values are treated as zero.
+  
+  Compared to emulating stacked areas with several \ref QCPGraph "QCPGraphs" linked via \ref
+  QCPGraph::setChannelFillGraph, the data isn't copied per layer and all layers are processed
+  together:
+  
+  \li The cumulative sums are computed lazily, i.e. only once after the data was changed, and for
+  large data sets in parallel over chunks of keys.
+  \li The visible key range is determined once for all layers, and with \ref setAdaptiveSampling
+  enabled, data points falling into the same pixel column are reduced to at most four points per
+  layer (first, minimum, maximum and last) in a single pass over the column for all layers.
+  \li The boundary line of each layer is converted to pixel coordinates once, and used both as
+  upper edge of its own fill polygon and as lower edge of the fill polygon of the layer above.
+  
+  The appearance of each layer is controlled with \ref setLayerBrush and \ref setLayerPen. The
+  layer pen is used for the upper boundary line of the layer. New layers get a distinct default
+  color.
+  
+  The plottable can only be selected as a whole (see \ref setSelectable). \ref layerAt returns the
+  layer at a given pixel position, e.g. to show the layer name in a tool tip.
+*/
+
+/*!
+  Constructs a stacked area chart which uses \a keyAxis as its key axis ("x") and \a valueAxis as
+  its value axis ("y"). \a keyAxis and \a valueAxis must reside in the same QCustomPlot instance
+  and not have the same orientation. If either of these restrictions is violated, a corresponding
+  message is printed to the debug output (qDebug), the construction is not aborted, though.
+  
+  The created QCPStackedArea is automatically registered with the QCustomPlot instance inferred
+  from \a keyAxis. This QCustomPlot instance takes ownership of the QCPStackedArea, so do not
+  delete it manually but use QCustomPlot::removePlottable() instead.
+*/
+QCPStackedArea::QCPStackedArea(QCPAxis *keyAxis, QCPAxis *valueAxis) :
+  QCPAbstractPlottable(keyAxis, valueAxis),
+  mAdaptiveSampling(true),
+  mCumulativeDirty(false)
+{
+  setSelectable(QCP::stWhole);
+}
+
+QCPStackedArea::~QCPStackedArea()
+{
+}
+
+/*!
+  Returns the values of the layer with \a index, as passed to \ref setData, \ref addLayer or \ref
+  setLayerValues (resized to the number of keys).
+*/
+QVector<double> QCPStackedArea::layerValues(int index) const
+{
+  if (index < 0 || index >= mLayers.size())
+  {
+    qDebug() << Q_FUNC_INFO << "index out of bounds" << index;
+    return QVector<double>();
+  }
+  return mLayers.at(index).values;
+}
+
+/*!
+  Returns the name of the layer with \a index.
+  
+  \see setLayerName
+*/
+QString QCPStackedArea::layerName(int index) const
+{
+  if (index < 0 || index >= mLayers.size())
+  {
+    qDebug() << Q_FUNC_INFO << "index out of bounds" << index;
+    return QString();
+  }
+  return mLayers.at(index).name;
+}
+
+/*!
+  Returns the pen of the layer with \a index.
+  
+  \see setLayerPen
+*/
+QPen QCPStackedArea::layerPen(int index) const
+{
+  if (index < 0 || index >= mLayers.size())
+  {
+    qDebug() << Q_FUNC_INFO << "index out of bounds" << index;
+    return QPen();
+  }
+  return mLayers.at(index).pen;
+}
+
+/*!
+  Returns the brush of the layer with \a index.
+  
+  \see setLayerBrush
+*/
+QBrush QCPStackedArea::layerBrush(int index) const
+{
+  if (index < 0 || index >= mLayers.size())
+  {
+    qDebug() << Q_FUNC_INFO << "index out of bounds" << index;
+    return QBrush();
+  }
+  return mLayers.at(index).brush;
+}
+
+/*!
+  Replaces the keys and the values of all layers. \a layerValues contains one value vector per
+  layer, from bottom to top. Layers that already exist keep their name, pen and brush, additional
+  layers are created with default appearance, and surplus layers are removed.
+  
+  Value vectors that are shorter than \a keys are padded with zeros, longer ones are truncated.
+  
+  If you can guarantee that \a keys are sorted ascending, set \a alreadySorted to true, to avoid
+  the sorting step. Otherwise the keys are sorted, and the values of all layers are permuted
+  accordingly.
+*/
+void QCPStackedArea::setData(const QVector<double> &keys, const QVector<QVector<double> > &layerValues, bool alreadySorted)
+{
+  const int n = keys.size();
+  QVector<int> order;
+  if (!alreadySorted)
+  {
+    for (int i=1; i<n; ++i)
+    {
+      if (keys.at(i) < keys.at(i-1))
+      {
+        order.resize(n);
+        for (int k=0; k<n; ++k)
+          order[k] = k;
+        std::stable_sort(order.begin(), order.end(), QCPStackedAreaKeyLess(keys.constData()));
+        break;
+      }
+    }
+  }
+  
+  if (order.isEmpty())
+  {
+    mKeys = keys;
+  } else
+  {
+    mKeys.resize(n);
+    for (int k=0; k<n; ++k)
+      mKeys[k] = keys.at(order.at(k));
+  }
+  while (mLayers.size() > layerValues.size())
+    mLayers.removeLast();
+  for (int l=0; l<layerValues.size(); ++l)
+  {
+    if (l == mLayers.size())
+      addLayer(QVector<double>());
+    const QVector<double> &source = layerValues.at(l);
+    QVector<double> &values = mLayers[l].values;
+    if (order.isEmpty())
+    {
+      values = source;
+      values.resize(n);
+      for (int k=source.size(); k<n; ++k)
+        values[k] = 0;
+    } else
+    {
+      values.resize(n);
+      for (int k=0; k<n; ++k)
+        values[k] = order.at(k) < source.size() ? source.at(order.at(k)) : 0;
+    }
+  }
+  mCumulativeDirty = true;
+}
+
+/*!
+  Replaces the values of the layer with \a index. \a values must correspond to the keys passed to
+  \ref setData, and are padded with zeros or truncated to the number of keys.
+*/
+void QCPStackedArea::setLayerValues(int index, const QVector<double> &values)
+{
+  if (index < 0 || index >= mLayers.size())
+  {
+    qDebug() << Q_FUNC_INFO << "index out of bounds" << index;
+    return;
+  }
+  QVector<double> &layerValues = mLayers[index].values;
+  layerValues = values;
+  layerValues.resize(mKeys.size());
+  for (int k=values.size(); k<mKeys.size(); ++k)
+    layerValues[k] = 0;
+  mCumulativeDirty = true;
+}
+
+/*!
+  Sets the name of the layer with \a index.
+*/
+void QCPStackedArea::setLayerName(int index, const QString &name)
+{
+  if (index < 0 || index >= mLayers.size())
+  {
+    qDebug() << Q_FUNC_INFO << "index out of bounds" << index;
+    return;
+  }
+  mLayers[index].name = name;
+}
+
+/*!
+  Sets the pen of the layer with \a index, which is used to draw the upper boundary line of the
+  layer. Set \c Qt::NoPen to only draw the fill.
+*/
+void QCPStackedArea::setLayerPen(int index, const QPen &pen)
+{
+  if (index < 0 || index >= mLayers.size())
+  {
+    qDebug() << Q_FUNC_INFO << "index out of bounds" << index;
+    return;
+  }
+  mLayers[index].pen = pen;
+}
+
+/*!
+  Sets the brush of the layer with \a index, which is used to fill the area of the layer.
+*/
+void QCPStackedArea::setLayerBrush(int index, const QBrush &brush)
+{
+  if (index < 0 || index >= mLayers.size())
+  {
+    qDebug() << Q_FUNC_INFO << "index out of bounds" << index;
+    return;
+  }
+  mLayers[index].brush = brush;
+}
+
+/*!
+  Sets whether adaptive sampling shall be used when drawing. If enabled and more than one data
+  point falls into a pixel column of the key axis, the points of each layer in that column are
+  reduced to the first, minimum, maximum and last point. The visual appearance is the same as
+  without sampling, but drawing large data sets is considerably faster.
+  
+  Adaptive sampling is enabled by default.
+  
+  \see QCPGraph::setAdaptiveSampling
+*/
+void QCPStackedArea::setAdaptiveSampling(bool enabled)
+{
+  mAdaptiveSampling = enabled;
+}
+
+/*!
+  Adds a new layer on top of the existing layers and returns its index. \a values must correspond
+  to the keys passed to \ref setData, and are padded with zeros or truncated to the number of
+  keys.
+  
+  The layer gets a default brush and pen with a hue that differs from its neighbouring layers. Use
+  \ref setLayerBrush and \ref setLayerPen to change them.
+*/
+int QCPStackedArea::addLayer(const QVector<double> &values, const QString &name)
+{
+  const int index = mLayers.size();
+  const QColor color = QColor::fromHsv((index*67)%360, 140, 230);
+  Layer layer;
+  layer.name = name;
+  layer.pen = QPen(color.darker(130));
+  layer.brush = QBrush(color);
+  mLayers.append(layer);
+  setLayerValues(index, values);
+  return index;
+}
+
+/*!
+  Removes the layer with \a index. The layers above move down by one. Returns false if \a index
+  is out of bounds.
+*/
+bool QCPStackedArea::removeLayer(int index)
+{
+  if (index < 0 || index >= mLayers.size())
+  {
+    qDebug() << Q_FUNC_INFO << "index out of bounds" << index;
+    return false;
+  }
+  mLayers.removeAt(index);
+  mCumulativeDirty = true;
+  return true;
+}
+
+/*!
+  Removes all layers. The keys are kept.
+*/
+void QCPStackedArea::clearLayers()
+{
+  mLayers.clear();
+  mCumulativeDirty = true;
+}
+
+/*!
+  Returns the cumulative value of the layer with index \a layer at the key with index \a keyIndex,
+  i.e. the sum of the values of all layers up to and including \a layer. This is the value
+  coordinate of the upper boundary line of the layer.
+*/
+double QCPStackedArea::stackedValue(int layer, int keyIndex) const
+{
+  if (layer < 0 || layer >= mLayers.size() || keyIndex < 0 || keyIndex >= mKeys.size())
+  {
+    qDebug() << Q_FUNC_INFO << "index out of bounds" << layer << keyIndex;
+    return 0;
+  }
+  updateCumulative();
+  return mCumulative.at(layer*mKeys.size()+keyIndex);
+}
+
+/*!
+  Returns the index of the layer whose area contains the pixel position \a pos, or -1 if \a pos
+  is outside of all layers. Between two keys, the layer boundaries are linearly interpolated.
+*/
+int QCPStackedArea::layerAt(const QPointF &pos) const
+{
+  if (!mKeyAxis || !mValueAxis || mKeys.isEmpty() || mLayers.isEmpty())
+    return -1;
+  
+  double posKey, posValue;
+  pixelsToCoords(pos, posKey, posValue);
+  if (posKey < mKeys.first() || posKey > mKeys.last())
+    return -1;
+  updateCumulative();
+  
+  const int n = mKeys.size();
+  int upper = qBound(qMin(1, n-1), int(std::upper_bound(mKeys.constBegin(), mKeys.constEnd(), posKey)-mKeys.constBegin()), n-1);
+  int lower = qMax(0, upper-1);
+  const double keyDistance = mKeys.at(upper)-mKeys.at(lower);
+  const double t = keyDistance > 0 ? (posKey-mKeys.at(lower))/keyDistance : 0;
+  double below = 0;
+  for (int l=0; l<mLayers.size(); ++l)
+  {
+    const double *sum = mCumulative.constData()+l*(qint64)n;
+    const double above = sum[lower]+t*(sum[upper]-sum[lower]);
+    if ((posValue >= below && posValue <= above) || (posValue <= below && posValue >= above))
+      return l;
+    below = above;
+  }
+  return -1;
+}
+
+/* inherits documentation from base class */
+double QCPStackedArea::selectTest(const QPointF &pos, bool onlySelectable, QVariant *details) const
+{
+  if ((onlySelectable && mSelectable == QCP::stNone) || mKeys.isEmpty() || mLayers.isEmpty())
+    return -1;
+  if (!mKeyAxis || !mValueAxis)
+    return -1;
+  
+  if (mKeyAxis.data()->axisRect()->rect().contains(pos.toPoint()) && layerAt(pos) != -1)
+  {
+    if (details)
+      details->setValue(QCPDataSelection(QCPDataRange(0, 1))); // whole-plottable selection, like QCPColorMap
+    return mParentPlot->selectionTolerance()*0.99;
+  }
+  return -1;
+}
+
+/* inherits documentation from base class */
+QCPRange QCPStackedArea::getKeyRange(bool &foundRange, QCP::SignDomain inSignDomain) const
+{
+  foundRange = false;
+  if (mKeys.isEmpty())
+    return QCPRange();
+  
+  // keys are sorted, so the bounds in the requested sign domain can be found by binary search:
+  int begin = 0, end = mKeys.size();
+  if (inSignDomain == QCP::sdPositive)
+    begin = std::upper_bound(mKeys.constBegin(), mKeys.constEnd(), 0.0)-mKeys.constBegin();
+  else if (inSignDomain == QCP::sdNegative)
+    end = std::lower_bound(mKeys.constBegin(), mKeys.constEnd(), 0.0)-mKeys.constBegin();
+  if (begin >= end)
+    return QCPRange();
+  foundRange = true;
+  return QCPRange(mKeys.at(begin), mKeys.at(end-1));
+}
+
+/* inherits documentation from base class */
+QCPRange QCPStackedArea::getValueRange(bool &foundRange, QCP::SignDomain inSignDomain, const QCPRange &inKeyRange) const
+{
+  foundRange = false;
+  if (mKeys.isEmpty() || mLayers.isEmpty())
+    return QCPRange();
+  
+  int begin = 0, end = mKeys.size();
+  if (inKeyRange != QCPRange())
+  {
+    begin = std::lower_bound(mKeys.constBegin(), mKeys.constEnd(), inKeyRange.lower)-mKeys.constBegin();
+    end = std::upper_bound(mKeys.constBegin(), mKeys.constEnd(), inKeyRange.upper)-mKeys.constBegin();
+  }
+  if (begin >= end)
+    return QCPRange();
+  updateCumulative();
+  
+  double lower = std::numeric_limits<double>::max();
+  double upper = -std::numeric_limits<double>::max();
+  if (inSignDomain == QCP::sdBoth) // the first layer is filled down to zero
+    lower = upper = 0;
+  const int n = mKeys.size();
+  for (int l=0; l<mLayers.size(); ++l)
+  {
+    const double *sum = mCumulative.constData()+l*(qint64)n;
+    for (int k=begin; k<end; ++k)
+    {
+      const double value = sum[k];
+      if ((inSignDomain == QCP::sdPositive && value <= 0) || (inSignDomain == QCP::sdNegative && value >= 0))
+        continue;
+      if (value < lower)
+        lower = value;
+      if (value > upper)
+        upper = value;
+    }
+  }
+  foundRange = lower <= upper;
+  return foundRange ? QCPRange(lower, upper) : QCPRange();
+}
+
+/* inherits documentation from base class */
+void QCPStackedArea::draw(QCPPainter *painter)
+{
+  if (!mKeyAxis || !mValueAxis) { qDebug() << Q_FUNC_INFO << "invalid key or value axis"; return; }
+  if (mKeys.isEmpty() || mLayers.isEmpty()) return;
+  
+  updateCumulative();
+  int begin, end;
+  getVisibleIndexBounds(begin, end);
+  if (begin >= end) return;
+  
+  // one geometry pass for all layers; each boundary is the upper edge of its layer and the lower edge of the next:
+  QVector<QVector<QPointF> > boundaries;
+  getBoundaries(&boundaries, begin, end);
+  
+  QCPAxis *keyAxis = mKeyAxis.data();
+  QCPAxis *valueAxis = mValueAxis.data();
+  double baseValue = 0;
+  if (valueAxis->scaleType() == QCPAxis::stLogarithmic) // zero can't be displayed, fill down to the end of the axis range instead
+    baseValue = valueAxis->range().upper < 0 ? valueAxis->range().upper : valueAxis->range().lower;
+  const double basePixel = valueAxis->coordToPixel(baseValue);
+  const double firstKeyPixel = keyAxis->coordToPixel(mKeys.at(begin));
+  const double lastKeyPixel = keyAxis->coordToPixel(mKeys.at(end-1));
+  
+  // draw fills:
+  applyFillAntialiasingHint(painter);
+  painter->setPen(Qt::NoPen);
+  QPolygonF polygon;
+  for (int l=0; l<boundaries.size(); ++l)
+  {
+    const QVector<QPointF> &upper = boundaries.at(l);
+    polygon.resize(0);
+    polygon.reserve(upper.size() + (l > 0 ? boundaries.at(l-1).size() : 2));
+    polygon << upper;
+    if (l > 0)
+    {
+      const QVector<QPointF> &lower = boundaries.at(l-1);
+      for (int i=lower.size()-1; i>=0; --i) // insert reversed, otherwise the polygon will be twisted
+        polygon << lower.at(i);
+    } else
+    {
+      polygon << pixelPoint(lastKeyPixel, basePixel) << pixelPoint(firstKeyPixel, basePixel);
+    }
+    painter->setBrush(mLayers.at(l).brush);
+    painter->drawPolygon(polygon);
+  }
+  
+  // draw boundary lines on top of all fills:
+  applyDefaultAntialiasingHint(painter);
+  painter->setBrush(Qt::NoBrush);
+  const bool drawSelected = selected() && mSelectionDecorator;
+  for (int l=0; l<boundaries.size(); ++l)
+  {
+    if (drawSelected)
+      mSelectionDecorator->applyPen(painter);
+    else
+      painter->setPen(mLayers.at(l).pen);
+    if (painter->pen().style() != Qt::NoPen && painter->pen().color().alpha() != 0)
+      painter->drawPolyline(boundaries.at(l).constData(), boundaries.at(l).size());
+  }
+  
+  // draw other selection decoration that isn't just line/scatter pens and brushes:
+  if (mSelectionDecorator)
+    mSelectionDecorator->drawDecoration(painter, selection());
+}
+
+/* inherits documentation from base class */
+void QCPStackedArea::drawLegendIcon(QCPPainter *painter, const QRectF &rect) const
+{
+  applyDefaultAntialiasingHint(painter);
+  QRectF r = QRectF(0, 0, rect.width()*0.67, rect.height()*0.67);
+  r.moveCenter(rect.center());
+  const int bandCount = qMin(mLayers.size(), 4);
+  if (bandCount == 0)
+  {
+    painter->setBrush(mBrush);
+    painter->setPen(mPen);
+    painter->drawRect(r);
+    return;
+  }
+  // draw the lowest layers as stacked bands:
+  const double bandHeight = r.height()/bandCount;
+  painter->setPen(Qt::NoPen);
+  for (int i=0; i<bandCount; ++i)
+  {
+    painter->setBrush(mLayers.at(i).brush);
+    painter->drawRect(QRectF(r.left(), r.bottom()-(i+1)*bandHeight, r.width(), bandHeight));
+  }
+}
+
+/*! \internal
+  
+  Recomputes the cumulative sums of all layers, if the data was changed since the last call. The
+  sums are stored layer after layer in \a mCumulative, so the boundary of each layer is contiguous
+  in memory.
+  
+  For large data sets, the key indices are split into chunks that are summed concurrently, one
+  chunk per available core.
+*/
+void QCPStackedArea::updateCumulative() const
+{
+  if (!mCumulativeDirty)
+    return;
+  mCumulativeDirty = false;
+  
+  const int n = mKeys.size();
+  mCumulative.resize(n*mLayers.size());
+  if (mCumulative.isEmpty())
+    return;
+  QVector<const double*> layers(mLayers.size());
+  for (int l=0; l<mLayers.size(); ++l)
+    layers[l] = mLayers.at(l).values.constData();
+  
+  const qint64 parallelThreshold = 1<<18; // number of values below which threading overhead dominates
+  const int chunkCount = (int)qBound(Q_INT64_C(1), qint64(n)*mLayers.size()/parallelThreshold, (qint64)qMax(1, qMin(QThread::idealThreadCount(), n)));
+  if (chunkCount == 1)
+  {
+    QCPStackedAreaSumJob(layers, mCumulative.data(), n, 0, n).run();
+  } else
+  {
+    QList<QCPStackedAreaSumJob*> jobs;
+    for (int i=0; i<chunkCount; ++i)
+      jobs.append(new QCPStackedAreaSumJob(layers, mCumulative.data(), n, int(qint64(n)*i/chunkCount), int(qint64(n)*(i+1)/chunkCount)));
+    QThreadPool pool;
+    pool.setMaxThreadCount(chunkCount);
+    for (int i=0; i<jobs.size(); ++i)
+      pool.start(jobs.at(i));
+    pool.waitForDone();
+    qDeleteAll(jobs);
+  }
+}
+
+/*! \internal
+  
+  Returns the index range [\a begin, \a end) of keys that need to be drawn at the current key axis
+  range. One key beyond the visible range is included on either side, so the areas extend to the
+  axis rect borders.
+*/
+void QCPStackedArea::getVisibleIndexBounds(int &begin, int &end) const
+{
+  const QCPRange range = mKeyAxis.data()->range();
+  begin = qMax(0, int(std::lower_bound(mKeys.constBegin(), mKeys.constEnd(), range.lower)-mKeys.constBegin())-1);
+  end = qMin(mKeys.size(), int(std::upper_bound(mKeys.constBegin(), mKeys.constEnd(), range.upper)-mKeys.constBegin())+1);
+}
+
+/*! \internal
+  
+  Fills \a boundaries with the upper boundary line of every layer in pixel coordinates, for the
+  key indices [\a begin, \a end). The key pixel of every data point is calculated only once for
+  all layers.
+  
+  If adaptive sampling is enabled (\ref setAdaptiveSampling), consecutive data points that fall
+  into the same pixel column are processed as a group: Groups of more than four points are reduced
+  to the first, minimum, maximum and last value of each layer. Since the cumulative sums are stored
+  layer by layer, the values of one layer within a group are contiguous in memory.
+*/
+void QCPStackedArea::getBoundaries(QVector<QVector<QPointF> > *boundaries, int begin, int end) const
+{
+  QCPAxis *keyAxis = mKeyAxis.data();
+  QCPAxis *valueAxis = mValueAxis.data();
+  const int n = mKeys.size();
+  const int layerCount = mLayers.size();
+  const double *keys = mKeys.constData();
+  const double *cumulative = mCumulative.constData();
+  
+  double keyPixel = keyAxis->coordToPixel(keys[begin]);
+  const double keyPixelSpan = qAbs(keyAxis->coordToPixel(keys[end-1])-keyPixel);
+  const bool sample = mAdaptiveSampling && end-begin > 2*keyPixelSpan;
+  boundaries->resize(layerCount);
+  for (int l=0; l<layerCount; ++l)
+  {
+    (*boundaries)[l].resize(0);
+    (*boundaries)[l].reserve(sample ? qMin(end-begin, 4*int(keyPixelSpan)+8) : end-begin);
+  }
+  
+  double groupKeyPixels[4];
+  int i = begin;
+  while (i < end)
+  {
+    // find the data points that fall into the pixel column of data point i:
+    int groupEnd = i+1;
+    double nextKeyPixel = groupEnd < end ? keyAxis->coordToPixel(keys[groupEnd]) : 0;
+    double lastKeyPixel = keyPixel;
+    if (sample)
+    {
+      const double column = qFloor(keyPixel);
+      while (groupEnd < end && qFloor(nextKeyPixel) == column)
+      {
+        lastKeyPixel = nextKeyPixel;
+        ++groupEnd;
+        if (groupEnd < end)
+          nextKeyPixel = keyAxis->coordToPixel(keys[groupEnd]);
+      }
+    }
+    
+    const int groupSize = groupEnd-i;
+    if (groupSize <= 4) // few points, use them as they are
+    {
+      groupKeyPixels[0] = keyPixel;
+      for (int k=1; k<groupSize; ++k)
+        groupKeyPixels[k] = keyAxis->coordToPixel(keys[i+k]);
+      for (int l=0; l<layerCount; ++l)
+      {
+        const double *sum = cumulative+l*(qint64)n;
+        QVector<QPointF> &boundary = (*boundaries)[l];
+        for (int k=0; k<groupSize; ++k)
+          boundary.append(pixelPoint(groupKeyPixels[k], valueAxis->coordToPixel(sum[i+k])));
+      }
+    } else // reduce the column to first, minimum, maximum and last value of each layer
+    {
+      const double centerKeyPixel = (keyPixel+lastKeyPixel)*0.5;
+      for (int l=0; l<layerCount; ++l)
+      {
+        const double *sum = cumulative+l*(qint64)n;
+        double minValue = sum[i];
+        double maxValue = sum[i];
+        for (int k=i+1; k<groupEnd; ++k)
+        {
+          if (sum[k] < minValue)
+            minValue = sum[k];
+          else if (sum[k] > maxValue)
+            maxValue = sum[k];
+        }
+        QVector<QPointF> &boundary = (*boundaries)[l];
+        boundary.append(pixelPoint(keyPixel, valueAxis->coordToPixel(sum[i])));
+        boundary.append(pixelPoint(centerKeyPixel, valueAxis->coordToPixel(minValue)));
+        boundary.append(pixelPoint(centerKeyPixel, valueAxis->coordToPixel(maxValue)));
+        boundary.append(pixelPoint(lastKeyPixel, valueAxis->coordToPixel(sum[groupEnd-1])));
+      }
+    }
+    i = groupEnd;
+    keyPixel = nextKeyPixel;
+  }
+}
+
+/*! \internal
+  
+  Returns the pixel position of the point with key pixel coordinate \a keyPixel and value pixel
+  coordinate \a valuePixel, taking into account the orientation of the key axis.
+*/
+QPointF QCPStackedArea::pixelPoint(double keyPixel, double valuePixel) const
+{
+  if (mKeyAxis.data()->orientation() == Qt::Horizontal)
+    return QPointF(keyPixel, valuePixel);
+  else
+    return QPointF(valuePixel, keyPixel);
+}
@@ -0,0 +1,106 @@
+/***************************************************************************
+**                                                                        **
+**  QCustomPlot, an easy to use, modern plotting widget for Qt            **
+**  Copyright (C) 2011-2017 Emanuel Eichhammer                            **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+****************************************************************************
+**           Author: Emanuel Eichhammer                                   **
+**  Website/Contact: http://www.qcustomplot.com/                          **
+**             Date: 04.09.17                                             **
+**          Version: 2.0.0                                                **
+****************************************************************************/
+/*! \file */
+#ifndef QCP_PLOTTABLE_STACKEDAREA_H
+#define QCP_PLOTTABLE_STACKEDAREA_H
+
+#include "../global.h"
+#include "../axis/range.h"
+#include "../plottable.h"
+
+class QCPPainter;
+class QCPAxis;
+
+class QCP_LIB_DECL QCPStackedArea : public QCPAbstractPlottable
+{
+  Q_OBJECT
+  /// \cond INCLUDE_QPROPERTIES
+  Q_PROPERTY(bool adaptiveSampling READ adaptiveSampling WRITE setAdaptiveSampling)
+  /// \endcond
+public:
+  explicit QCPStackedArea(QCPAxis *keyAxis, QCPAxis *valueAxis);
+  virtual ~QCPStackedArea();
+  
+  // getters:
+  QVector<double> keys() const { return mKeys; }
+  int layerCount() const { return mLayers.size(); }
+  QVector<double> layerValues(int index) const;
+  QString layerName(int index) const;
+  QPen layerPen(int index) const;
+  QBrush layerBrush(int index) const;
+  bool adaptiveSampling() const { return mAdaptiveSampling; }
+  
+  // setters:
+  void setData(const QVector<double> &keys, const QVector<QVector<double> > &layerValues, bool alreadySorted=false);
+  void setLayerValues(int index, const QVector<double> &values);
+  void setLayerName(int index, const QString &name);
+  void setLayerPen(int index, const QPen &pen);
+  void setLayerBrush(int index, const QBrush &brush);
+  void setAdaptiveSampling(bool enabled);
+  
+  // non-property methods:
+  int addLayer(const QVector<double> &values, const QString &name=QString());
+  bool removeLayer(int index);
+  void clearLayers();
+  double stackedValue(int layer, int keyIndex) const;
+  int layerAt(const QPointF &pos) const;
+  
+  // reimplemented virtual methods:
+  virtual double selectTest(const QPointF &pos, bool onlySelectable, QVariant *details=0) const Q_DECL_OVERRIDE;
+  virtual QCPRange getKeyRange(bool &foundRange, QCP::SignDomain inSignDomain=QCP::sdBoth) const Q_DECL_OVERRIDE;
+  virtual QCPRange getValueRange(bool &foundRange, QCP::SignDomain inSignDomain=QCP::sdBoth, const QCPRange &inKeyRange=QCPRange()) const Q_DECL_OVERRIDE;
+  
+protected:
+  struct Layer
+  {
+    QVector<double> values;
+    QString name;
+    QPen pen;
+    QBrush brush;
+  };
+  
+  // property members:
+  QVector<double> mKeys;
+  QList<Layer> mLayers;
+  bool mAdaptiveSampling;
+  // non-property members:
+  mutable QVector<double> mCumulative;
+  mutable bool mCumulativeDirty;
+  
+  // reimplemented virtual methods:
+  virtual void draw(QCPPainter *painter) Q_DECL_OVERRIDE;
+  virtual void drawLegendIcon(QCPPainter *painter, const QRectF &rect) const Q_DECL_OVERRIDE;
+  
+  // non-virtual methods:
+  void updateCumulative() const;
+  void getVisibleIndexBounds(int &begin, int &end) const;
+  void getBoundaries(QVector<QVector<QPointF> > *boundaries, int begin, int end) const;
+  QPointF pixelPoint(double keyPixel, double valuePixel) const;
+  
+  friend class QCustomPlot;
+  friend class QCPLegend;
+};
+
+#endif // QCP_PLOTTABLE_STACKEDAREA_H
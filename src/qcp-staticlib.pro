@@ -32,16 +32,24 @@ HEADERS += \
     global.h \
     painter.h \
     paintbuffer.h \
+    linerasterizer.h \
     layer.h \
     axis/range.h \
     axis/axis.h \
+    axis/axislinkgroup.h \
     axis/axisticker.h \
     plottable.h \
     item.h \
     lineending.h \
     core.h \
+    replotcoordinator.h \
     layout.h \
     plottables/plottable-graph.h \
+    plottables/plottable-compactgraph.h \
+    plottables/plottable-lodgraph.h \
+    plottables/plottable-asyncgraph.h \
+    plottables/plottable-stackedarea.h \
+    plottables/plottable-digitaltrace.h \
     plottables/plottable-curve.h \
     plottables/plottable-bars.h \
     plottables/plottable-statisticalbox.h \
@@ -57,10 +65,13 @@ HEADERS += \
     items/item-pixmap.h \
     items/item-tracer.h \
     items/item-bracket.h \
+    snapshot.h \
+    csvimporter.h \
     layoutelements/layoutelement-axisrect.h \
     layoutelements/layoutelement-legend.h \
     layoutelements/layoutelement-textelement.h \
     layoutelements/layoutelement-colorscale.h \
+    layoutelements/layoutelement-overview.h \
     colorgradient.h \
     vector2d.h \
     axis/axistickerdatetime.h \
@@ -69,6 +80,7 @@ HEADERS += \
     axis/axistickertext.h \
     axis/axistickerpi.h \
     axis/axistickerlog.h \
+    axis/scaletransform.h \
     datacontainer.h \
     selection.h \
     selectionrect.h \
@@ -79,16 +91,24 @@ HEADERS += \
 SOURCES += \
     painter.cpp \
     paintbuffer.cpp \
+    linerasterizer.cpp \
     layer.cpp \
     axis/range.cpp \
     axis/axis.cpp \
+    axis/axislinkgroup.cpp \
     axis/axisticker.cpp \
     plottable.cpp \
     item.cpp \
     lineending.cpp \
     core.cpp \
+    replotcoordinator.cpp \
     layout.cpp \
     plottables/plottable-graph.cpp \
+    plottables/plottable-compactgraph.cpp \
+    plottables/plottable-lodgraph.cpp \
+    plottables/plottable-asyncgraph.cpp \
+    plottables/plottable-stackedarea.cpp \
+    plottables/plottable-digitaltrace.cpp \
     plottables/plottable-curve.cpp \
     plottables/plottable-bars.cpp \
     plottables/plottable-statisticalbox.cpp \
@@ -104,10 +124,13 @@ SOURCES += \
     items/item-pixmap.cpp \
     items/item-tracer.cpp \
     items/item-bracket.cpp \
+    snapshot.cpp \
+    csvimporter.cpp \
     layoutelements/layoutelement-axisrect.cpp \
     layoutelements/layoutelement-legend.cpp \
     layoutelements/layoutelement-textelement.cpp \
     layoutelements/layoutelement-colorscale.cpp \
+    layoutelements/layoutelement-overview.cpp \
     colorgradient.cpp \
     vector2d.cpp \
     axis/axistickerdatetime.cpp \
@@ -116,6 +139,7 @@ SOURCES += \
     axis/axistickertext.cpp \
     axis/axistickerpi.cpp \
     axis/axistickerlog.cpp \
+    axis/scaletransform.cpp \
     datacontainer.cpp \
     selection.cpp \
     selectionrect.cpp \
@@ -30,6 +30,7 @@
 #include "vector2d.h"
 #include "painter.h"
 #include "paintbuffer.h"
+#include "linerasterizer.h"
 #include "layer.h"
 #include "axis/range.h"
 #include "selection.h"
@@ -43,12 +44,15 @@
 #include "axis/axistickertext.h"
 #include "axis/axistickerpi.h"
 #include "axis/axistickerlog.h"
+#include "axis/scaletransform.h"
 #include "axis/axis.h"
+#include "axis/axislinkgroup.h"
 #include "scatterstyle.h"
 #include "datacontainer.h"
 #include "plottable.h"
 #include "item.h"
 #include "core.h"
+#include "replotcoordinator.h"
 #include "plottable1d.h"
 #include "colorgradient.h"
 #include "selectiondecorator-bracket.h"
@@ -56,7 +60,13 @@
 #include "layoutelements/layoutelement-legend.h"
 #include "layoutelements/layoutelement-textelement.h"
 #include "layoutelements/layoutelement-colorscale.h"
+#include "layoutelements/layoutelement-overview.h"
 #include "plottables/plottable-graph.h"
+#include "plottables/plottable-compactgraph.h"
+#include "plottables/plottable-lodgraph.h"
+#include "plottables/plottable-asyncgraph.h"
+#include "plottables/plottable-stackedarea.h"
+#include "plottables/plottable-digitaltrace.h"
 #include "plottables/plottable-curve.h"
 #include "plottables/plottable-bars.h"
 #include "plottables/plottable-statisticalbox.h"
@@ -72,5 +82,7 @@
 #include "items/item-pixmap.h"
 #include "items/item-tracer.h"
 #include "items/item-bracket.h"
+#include "snapshot.h"
+#include "csvimporter.h"
 
 #endif // QCP_H
@@ -0,0 +1,364 @@
+/***************************************************************************
+**                                                                        **
+**  QCustomPlot, an easy to use, modern plotting widget for Qt            **
+**  Copyright (C) 2011-2017 Emanuel Eichhammer                            **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+****************************************************************************
+**           Author: Emanuel Eichhammer                                   **
+**  Website/Contact: http://www.qcustomplot.com/                          **
+**             Date: 04.09.17                                             **
+**          Version: 2.0.0                                                **
+****************************************************************************/
+
+#include "replotcoordinator.h"
+
+#include "core.h"
+#include "plottable.h"
+
+/*! \internal
+
+  Prepares the geometry of the given plottables of one QCustomPlot in a worker thread, see \ref
+  QCPReplotCoordinator::replotBatch.
+*/
+class QCPReplotCoordinatorJob : public QRunnable
+{
+public:
+  explicit QCPReplotCoordinatorJob(const QList<QCPAbstractPlottable*> &plottables) :
+    mPlottables(plottables)
+  {}
+  virtual void run() Q_DECL_OVERRIDE
+  {
+    for (int i=0; i<mPlottables.size(); ++i)
+      mPlottables.at(i)->prepareDraw();
+  }
+private:
+  QList<QCPAbstractPlottable*> mPlottables;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////// QCPReplotCoordinator
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*! \class QCPReplotCoordinator
+  \brief Coordinates the replots of many QCustomPlot widgets, e.g. in a dashboard
+  
+  Applications that show many plots at once, which are all updated by the same data source or
+  linked axes (see \ref QCPAxisLinkGroup), usually replot each of them independently. Every plot
+  then runs its own replot at its own time, the geometry of all plottables is calculated on the GUI
+  thread one plot after the other, and plots that are currently scrolled out of view or covered by
+  other windows are replotted just as eagerly as the visible ones.
+  
+  A QCPReplotCoordinator takes over the queued replots (\ref QCustomPlot::rpQueuedReplot) of all
+  plots added with \ref addPlot. Instead of replotting in the next event loop iteration, they are
+  collected and performed together once per frame tick (\ref setFrameInterval):
+  
+  \li The replots of all pending plots are started together. After the layout of each plot was
+  updated, the pixel geometry of the plottables which have \ref
+  QCPAbstractPlottable::setConcurrentPreparation enabled (see \ref
+  QCPAbstractPlottable::prepareDraw) is calculated concurrently in a thread pool (\ref
+  setThreadCount), one job per plot. Then the plots are drawn on the GUI thread, reusing the
+  prepared geometry. Plottables that didn't opt in are handled entirely on the GUI thread.
+  \li Plots that are visible on screen are replotted first. Hidden plots, and plots that are
+  clipped away entirely by their parent widgets (e.g. scrolled out of view in a QScrollArea, so
+  QWidget::visibleRegion is empty), are only replotted as long as the time spent in the current
+  frame stays within \ref setFrameBudget; the rest is deferred to the next frame. Plots that are
+  merely covered by other windows can't be detected and count as visible.
+  
+  \code
+  QCPReplotCoordinator *coordinator = new QCPReplotCoordinator(this);
+  foreach (QCustomPlot *plot, plots)
+  {
+    coordinator->addPlot(plot);
+    for (int i=0; i<plot->graphCount(); ++i)
+      plot->graph(i)->setConcurrentPreparation(true); // optional, see QCPAbstractPlottable::prepareDraw
+  }
+  // ...later, anywhere in the application:
+  plot->replot(QCustomPlot::rpQueuedReplot);
+  \endcode
+  
+  Replots with any other refresh priority are still performed immediately, by the plot itself.
+*/
+
+/*!
+  Creates a replot coordinator without any plots. Add plots with \ref addPlot.
+*/
+QCPReplotCoordinator::QCPReplotCoordinator(QObject *parent) :
+  QObject(parent),
+  mFrameInterval(16),
+  mFrameBudget(8),
+  mFrameTimer(new QTimer(this))
+{
+  mThreadPool.setMaxThreadCount(qMax(1, QThread::idealThreadCount()));
+  mFrameTimer->setSingleShot(true);
+  connect(mFrameTimer, SIGNAL(timeout()), this, SLOT(processFrame()));
+}
+
+QCPReplotCoordinator::~QCPReplotCoordinator()
+{
+  QList<QCustomPlot*> allPlots = plots();
+  for (int i=0; i<allPlots.size(); ++i)
+    removePlot(allPlots.at(i));
+}
+
+/*!
+  Sets the minimum time in milliseconds between two frames, i.e. between two batches of replots.
+  The default of 16 ms limits the plots to about 60 replots per second.
+  
+  A queued replot requested when the last frame is longer ago than \a msec is performed in the
+  next event loop iteration.
+*/
+void QCPReplotCoordinator::setFrameInterval(int msec)
+{
+  mFrameInterval = qMax(0, msec);
+}
+
+/*!
+  Sets the time in milliseconds that a frame may take, before the replots of hidden plots are
+  deferred to the next frame. Visible plots are always replotted in the frame they were requested
+  in.
+  
+  The hidden plots are replotted in batches of \ref threadCount plots, and the budget is checked
+  before each batch. Thus a budget of 0 causes hidden plots to be replotted only in frames without
+  any pending visible plots.
+*/
+void QCPReplotCoordinator::setFrameBudget(int msec)
+{
+  mFrameBudget = qMax(0, msec);
+}
+
+/*!
+  Sets the number of threads used to prepare the plottable geometry of the plots in a frame. The
+  default is the number of processor cores. If \a count is 1, the geometry is still prepared for
+  all plots before drawing any of them, but in a single worker thread.
+*/
+void QCPReplotCoordinator::setThreadCount(int count)
+{
+  mThreadPool.setMaxThreadCount(qMax(1, count));
+}
+
+/*!
+  Returns the plots managed by this coordinator.
+  
+  \see addPlot, removePlot
+*/
+QList<QCustomPlot*> QCPReplotCoordinator::plots() const
+{
+  QList<QCustomPlot*> result;
+  for (int i=0; i<mPlots.size(); ++i)
+  {
+    if (!mPlots.at(i).isNull())
+      result.append(mPlots.at(i).data());
+  }
+  return result;
+}
+
+/*!
+  Returns the number of plots managed by this coordinator.
+*/
+int QCPReplotCoordinator::plotCount() const
+{
+  return plots().size();
+}
+
+/*!
+  Returns whether \a plot is managed by this coordinator.
+*/
+bool QCPReplotCoordinator::hasPlot(QCustomPlot *plot) const
+{
+  return plot && mPlots.contains(plot);
+}
+
+/*!
+  Adds \a plot to this coordinator. From now on, queued replots of \a plot (\ref
+  QCustomPlot::rpQueuedReplot) are performed by the coordinator. If \a plot was managed by a
+  different coordinator, it is removed from that one first.
+  
+  Returns false if \a plot is 0 or already managed by this coordinator.
+  
+  \see removePlot, QCustomPlot::replotCoordinator
+*/
+bool QCPReplotCoordinator::addPlot(QCustomPlot *plot)
+{
+  if (!plot)
+  {
+    qDebug() << Q_FUNC_INFO << "passed plot is zero";
+    return false;
+  }
+  if (hasPlot(plot))
+  {
+    qDebug() << Q_FUNC_INFO << "plot already managed by this coordinator:" << reinterpret_cast<quintptr>(plot);
+    return false;
+  }
+  
+  if (plot->mReplotCoordinator)
+    plot->mReplotCoordinator->removePlot(plot);
+  mPlots.removeAll(QPointer<QCustomPlot>()); // purge plots that were deleted in the meantime
+  mPlots.append(plot);
+  plot->mReplotCoordinator = this;
+  return true;
+}
+
+/*!
+  Removes \a plot from this coordinator. If a replot of \a plot is still pending, it is handed back
+  to \a plot, which performs it in the next event loop iteration.
+  
+  Returns false if \a plot is not managed by this coordinator.
+  
+  \see addPlot
+*/
+bool QCPReplotCoordinator::removePlot(QCustomPlot *plot)
+{
+  if (!hasPlot(plot))
+  {
+    qDebug() << Q_FUNC_INFO << "plot not managed by this coordinator:" << reinterpret_cast<quintptr>(plot);
+    return false;
+  }
+  
+  mPlots.removeAll(plot);
+  plot->mReplotCoordinator = 0;
+  if (mPendingPlots.removeAll(plot) > 0)
+  {
+    plot->mReplotQueued = false;
+    plot->replot(QCustomPlot::rpQueuedReplot);
+  }
+  return true;
+}
+
+/*!
+  Schedules a replot of \a plot for the next frame. Multiple requests for the same plot before the
+  next frame cause only one replot.
+  
+  This method is called by \ref QCustomPlot::replot for queued replots of managed plots, so there
+  is usually no need to call it directly.
+*/
+void QCPReplotCoordinator::requestReplot(QCustomPlot *plot)
+{
+  if (!hasPlot(plot))
+  {
+    qDebug() << Q_FUNC_INFO << "plot not managed by this coordinator:" << reinterpret_cast<quintptr>(plot);
+    return;
+  }
+  if (!mPendingPlots.contains(plot))
+    mPendingPlots.append(plot);
+  scheduleFrame();
+}
+
+/*! \internal
+
+  Starts the frame timer such that the next frame happens \ref setFrameInterval milliseconds after
+  the last one, or in the next event loop iteration if that time has already passed. Does nothing
+  if a frame is already scheduled.
+*/
+void QCPReplotCoordinator::scheduleFrame()
+{
+  if (mFrameTimer->isActive())
+    return;
+  int delay = 0;
+  if (mLastFrame.isValid())
+    delay = qBound(0, mFrameInterval-mLastFrame.elapsed(), mFrameInterval); // bound in case QTime wrapped around at midnight
+  mFrameTimer->start(delay);
+}
+
+/*! \internal
+
+  Performs the replots of all pending plots. Visible plots are replotted first, in one batch.
+  Hidden plots follow in batches of \ref threadCount plots, as long as the frame budget (\ref
+  setFrameBudget) permits. The remaining hidden plots stay pending for the next frame.
+  
+  A plot counts as hidden if it isn't visible or its QWidget::visibleRegion is empty, i.e. it is
+  clipped away entirely by its parent widgets. The visible region doesn't reflect overlapping top
+  level windows, so a plot covered by another window is replotted like a visible one.
+*/
+void QCPReplotCoordinator::processFrame()
+{
+  mLastFrame.start();
+  QList<QPointer<QCustomPlot> > pending = mPendingPlots;
+  mPendingPlots.clear(); // replots requested while processing this frame go to the next one
+  
+  QList<QPointer<QCustomPlot> > visiblePlots, hiddenPlots;
+  for (int i=0; i<pending.size(); ++i)
+  {
+    QCustomPlot *plot = pending.at(i).data();
+    if (!plot)
+      continue;
+    if (plot->isVisible() && !plot->visibleRegion().isEmpty())
+      visiblePlots.append(plot);
+    else
+      hiddenPlots.append(plot);
+  }
+  
+  replotBatch(visiblePlots);
+  
+  const int batchSize = mThreadPool.maxThreadCount();
+  int index = 0;
+  while (index < hiddenPlots.size() && mLastFrame.elapsed() < mFrameBudget)
+  {
+    replotBatch(hiddenPlots.mid(index, batchSize));
+    index += batchSize;
+  }
+  for (; index < hiddenPlots.size(); ++index)
+  {
+    if (!hiddenPlots.at(index).isNull() && !mPendingPlots.contains(hiddenPlots.at(index)))
+      mPendingPlots.append(hiddenPlots.at(index));
+  }
+  
+  if (!mPendingPlots.isEmpty())
+    scheduleFrame();
+}
+
+/*! \internal
+
+  Replots all \a plots together. First, \ref QCustomPlot::startReplot is called on each plot, which
+  updates the layouts. Then the plottable geometry of each plot is prepared concurrently with \ref
+  QCPAbstractPlottable::prepareDraw, one job per plot, for those plottables which opted in with
+  \ref QCPAbstractPlottable::setConcurrentPreparation. The plottables of a single plot are always
+  prepared in the same job, because they share axes and, via channel fills, geometry caches.
+  Finally each plot is drawn and refreshed with \ref QCustomPlot::finishReplot.
+*/
+void QCPReplotCoordinator::replotBatch(const QList<QPointer<QCustomPlot> > &plots)
+{
+  QList<QPointer<QCustomPlot> > startedPlots;
+  for (int i=0; i<plots.size(); ++i)
+  {
+    QCustomPlot *plot = plots.at(i).data();
+    if (plot && plot->startReplot())
+      startedPlots.append(plot);
+  }
+  
+  if (startedPlots.size() > 1) // a single plot gains nothing from preparing its geometry in advance
+  {
+    for (int i=0; i<startedPlots.size(); ++i)
+    {
+      if (startedPlots.at(i).isNull())
+        continue;
+      QList<QCPAbstractPlottable*> plottables;
+      foreach (QCPAbstractPlottable *plottable, startedPlots.at(i).data()->mPlottables)
+      {
+        if (plottable->concurrentPreparation() && plottable->realVisibility())
+          plottables.append(plottable);
+      }
+      if (!plottables.isEmpty())
+        mThreadPool.start(new QCPReplotCoordinatorJob(plottables));
+    }
+    mThreadPool.waitForDone();
+  }
+  
+  for (int i=0; i<startedPlots.size(); ++i)
+  {
+    if (!startedPlots.at(i).isNull())
+      startedPlots.at(i).data()->finishReplot(QCustomPlot::rpRefreshHint);
+  }
+}
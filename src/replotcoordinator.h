@@ -0,0 +1,84 @@
+/***************************************************************************
+**                                                                        **
+**  QCustomPlot, an easy to use, modern plotting widget for Qt            **
+**  Copyright (C) 2011-2017 Emanuel Eichhammer                            **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+****************************************************************************
+**           Author: Emanuel Eichhammer                                   **
+**  Website/Contact: http://www.qcustomplot.com/                          **
+**             Date: 04.09.17                                             **
+**          Version: 2.0.0                                                **
+****************************************************************************/
+
+#ifndef QCP_REPLOTCOORDINATOR_H
+#define QCP_REPLOTCOORDINATOR_H
+
+#include "global.h"
+
+class QCustomPlot;
+
+class QCP_LIB_DECL QCPReplotCoordinator : public QObject
+{
+  Q_OBJECT
+  /// \cond INCLUDE_QPROPERTIES
+  Q_PROPERTY(int frameInterval READ frameInterval WRITE setFrameInterval)
+  Q_PROPERTY(int frameBudget READ frameBudget WRITE setFrameBudget)
+  Q_PROPERTY(int threadCount READ threadCount WRITE setThreadCount)
+  /// \endcond
+public:
+  explicit QCPReplotCoordinator(QObject *parent=0);
+  virtual ~QCPReplotCoordinator();
+  
+  // getters:
+  int frameInterval() const { return mFrameInterval; }
+  int frameBudget() const { return mFrameBudget; }
+  int threadCount() const { return mThreadPool.maxThreadCount(); }
+  
+  // setters:
+  void setFrameInterval(int msec);
+  void setFrameBudget(int msec);
+  void setThreadCount(int count);
+  
+  // non-property methods:
+  QList<QCustomPlot*> plots() const;
+  int plotCount() const;
+  bool hasPlot(QCustomPlot *plot) const;
+  bool addPlot(QCustomPlot *plot);
+  bool removePlot(QCustomPlot *plot);
+  void requestReplot(QCustomPlot *plot);
+  
+protected:
+  // property members:
+  int mFrameInterval;
+  int mFrameBudget;
+  QThreadPool mThreadPool;
+  
+  // non-property members:
+  QList<QPointer<QCustomPlot> > mPlots;
+  QList<QPointer<QCustomPlot> > mPendingPlots;
+  QTimer *mFrameTimer;
+  QTime mLastFrame;
+  
+  // non-virtual methods:
+  void scheduleFrame();
+  void replotBatch(const QList<QPointer<QCustomPlot> > &plots);
+  Q_SLOT void processFrame();
+  
+private:
+  Q_DISABLE_COPY(QCPReplotCoordinator)
+};
+
+#endif // QCP_REPLOTCOORDINATOR_H
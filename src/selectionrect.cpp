@@ -51,8 +51,11 @@
   The appearance of the selection rect can be controlled via \ref setPen and \ref setBrush.
 
   If you wish to provide custom behaviour, e.g. a different visual representation of the selection
-  rect (\ref QCPSelectionRect::draw), you can subclass QCPSelectionRect and pass an instance of
-  your subclass to \ref QCustomPlot::setSelectionRect.
+  rect (\ref QCPSelectionRect::drawSelection), you can subclass QCPSelectionRect and pass an
+  instance of your subclass to \ref QCustomPlot::setSelectionRect.
+  
+  For plots with a lot of data, consider enabling \ref setOverlay. The selection rect is then
+  drawn on top of the cached paint buffers, so dragging it doesn't replot any layer.
 */
 
 /* start of documentation of inline functions */
@@ -115,6 +118,7 @@ QCPSelectionRect::QCPSelectionRect(QCustomPlot *parentPlot) :
   QCPLayerable(parentPlot),
   mPen(QBrush(Qt::gray), 0, Qt::DashLine),
   mBrush(Qt::NoBrush),
+  mOverlay(false),
   mActive(false)
 {
 }
@@ -164,6 +168,25 @@ void QCPSelectionRect::setBrush(const QBrush &brush)
   mBrush = brush;
 }
 
+/*!
+  Sets whether the selection rect is drawn as an overlay. An overlay is painted directly onto the
+  widget surface in \ref QCustomPlot::paintEvent, on top of the paint buffers, and moving it only
+  repaints the widget area covered by the old and new rect. If disabled, the selection rect is
+  drawn by its layer like any other layerable, so each mouse move replots that layer, or the whole
+  plot if the layer isn't in mode \ref QCPLayer::lmBuffered.
+  
+  The overlay is disabled by default. When enabled, the selection rect is drawn by calling \ref
+  drawSelection directly, bypassing \ref draw, so subclasses which reimplement \ref draw to change
+  the appearance must reimplement \ref drawSelection instead before enabling the overlay. Also,
+  only the area around \ref rect is repainted, so \ref drawSelection must not draw outside of it.
+  The overlay isn't part of the paint buffers, so it doesn't appear in exports like \ref
+  QCustomPlot::savePng while a selection is active.
+*/
+void QCPSelectionRect::setOverlay(bool enabled)
+{
+  mOverlay = enabled;
+}
+
 /*!
   If there is currently a selection interaction going on (\ref isActive), the interaction is
   canceled. The selection rect will emit the \ref canceled signal.
@@ -173,6 +196,8 @@ void QCPSelectionRect::cancel()
   if (mActive)
   {
     mActive = false;
+    if (mOverlay)
+      updateOverlay(mRect);
     emit canceled(mRect, 0);
   }
 }
@@ -198,9 +223,13 @@ void QCPSelectionRect::startSelection(QMouseEvent *event)
 */
 void QCPSelectionRect::moveSelection(QMouseEvent *event)
 {
+  const QRect previousRect = mRect;
   mRect.setBottomRight(event->pos());
   emit changed(mRect, event);
-  layer()->replot();
+  if (mOverlay)
+    updateOverlay(previousRect);
+  else
+    layer()->replot();
 }
 
 /*! \internal
@@ -211,8 +240,11 @@ void QCPSelectionRect::moveSelection(QMouseEvent *event)
 */
 void QCPSelectionRect::endSelection(QMouseEvent *event)
 {
+  const QRect previousRect = mRect;
   mRect.setBottomRight(event->pos());
   mActive = false;
+  if (mOverlay)
+    updateOverlay(previousRect);
   emit accepted(mRect, event);
 }
 
@@ -227,6 +259,8 @@ void QCPSelectionRect::keyPressEvent(QKeyEvent *event)
   if (event->key() == Qt::Key_Escape && mActive)
   {
     mActive = false;
+    if (mOverlay)
+      updateOverlay(mRect);
     emit canceled(mRect, event);
   }
 }
@@ -239,17 +273,43 @@ void QCPSelectionRect::applyDefaultAntialiasingHint(QCPPainter *painter) const
 
 /*! \internal
   
-  If the selection rect is active (\ref isActive), draws the selection rect defined by \a mRect.
+  Draws the selection rect defined by \a mRect. This is called by \ref draw if the selection rect
+  is drawn by its layer, or by \ref QCustomPlot::paintEvent if it is an overlay (\ref
+  setOverlay). In both cases it is only called while the selection rect is active.
+  
+  Reimplement this method to change the visual representation of the selection rect.
+*/
+void QCPSelectionRect::drawSelection(QCPPainter *painter)
+{
+  painter->setPen(mPen);
+  painter->setBrush(mBrush);
+  painter->drawRect(mRect);
+}
+
+/*! \internal
+  
+  If the selection rect is active (\ref isActive) and not drawn as an overlay (\ref setOverlay),
+  draws the selection rect with \ref drawSelection.
   
   \seebaseclassmethod
 */
 void QCPSelectionRect::draw(QCPPainter *painter)
 {
-  if (mActive)
-  {
-    painter->setPen(mPen);
-    painter->setBrush(mBrush);
-    painter->drawRect(mRect);
-  }
+  if (mActive && !mOverlay)
+    drawSelection(painter);
+}
+
+/*! \internal
+  
+  Schedules a repaint of the widget area covered by the overlay at \a previousRect and at the
+  current rect, so the overlay is moved (or removed, if the selection rect isn't active anymore)
+  without touching the rest of the widget.
+*/
+void QCPSelectionRect::updateOverlay(const QRect &previousRect)
+{
+  const int margin = int(mPen.widthF())+2; // pen is centered on the rect outline, plus antialiasing
+  QRegion region(previousRect.normalized().adjusted(-margin, -margin, margin, margin));
+  region += mRect.normalized().adjusted(-margin, -margin, margin, margin);
+  mParentPlot->update(region);
 }
 
@@ -35,6 +35,9 @@ class QCPAxis;
 class QCP_LIB_DECL QCPSelectionRect : public QCPLayerable
 {
   Q_OBJECT
+  /// \cond INCLUDE_QPROPERTIES
+  Q_PROPERTY(bool overlay READ overlay WRITE setOverlay)
+  /// \endcond
 public:
   explicit QCPSelectionRect(QCustomPlot *parentPlot);
   virtual ~QCPSelectionRect();
@@ -45,10 +48,12 @@ public:
   QPen pen() const { return mPen; }
   QBrush brush() const { return mBrush; }
   bool isActive() const { return mActive; }
+  bool overlay() const { return mOverlay; }
   
   // setters:
   void setPen(const QPen &pen);
   void setBrush(const QBrush &brush);
+  void setOverlay(bool enabled);
   
   // non-property methods:
   Q_SLOT void cancel();
@@ -64,6 +69,7 @@ protected:
   QRect mRect;
   QPen mPen;
   QBrush mBrush;
+  bool mOverlay;
   // non-property members:
   bool mActive;
   
@@ -72,11 +78,15 @@ protected:
   virtual void moveSelection(QMouseEvent *event);
   virtual void endSelection(QMouseEvent *event);
   virtual void keyPressEvent(QKeyEvent *event);
+  virtual void drawSelection(QCPPainter *painter);
   
   // reimplemented virtual methods
   virtual void applyDefaultAntialiasingHint(QCPPainter *painter) const Q_DECL_OVERRIDE;
   virtual void draw(QCPPainter *painter) Q_DECL_OVERRIDE;
   
+  // non-virtual methods:
+  void updateOverlay(const QRect &previousRect);
+  
   friend class QCustomPlot;
 };
 
@@ -0,0 +1,1185 @@
+/***************************************************************************
+**                                                                        **
+**  QCustomPlot, an easy to use, modern plotting widget for Qt            **
+**  Copyright (C) 2011-2017 Emanuel Eichhammer                            **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+****************************************************************************
+**           Author: Emanuel Eichhammer                                   **
+**  Website/Contact: http://www.qcustomplot.com/                          **
+**             Date: 04.09.17                                             **
+**          Version: 2.0.0                                                **
+****************************************************************************/
+
+#include "snapshot.h"
+
+#include "core.h"
+#include "layout.h"
+#include "axis/axis.h"
+#include "scatterstyle.h"
+#include "lineending.h"
+#include "colorgradient.h"
+#include "layoutelements/layoutelement-axisrect.h"
+#include "plottables/plottable-graph.h"
+#include "plottables/plottable-compactgraph.h"
+#include "plottables/plottable-curve.h"
+#include "plottables/plottable-bars.h"
+#include "plottables/plottable-statisticalbox.h"
+#include "plottables/plottable-colormap.h"
+#include "plottables/plottable-financial.h"
+#include "plottables/plottable-errorbar.h"
+#include "items/item-straightline.h"
+#include "items/item-line.h"
+#include "items/item-curve.h"
+#include "items/item-rect.h"
+#include "items/item-text.h"
+#include "items/item-ellipse.h"
+#include "items/item-pixmap.h"
+#include "items/item-tracer.h"
+#include "items/item-bracket.h"
+
+/*! \internal
+  
+  Returns the raw memory of the data points in \a container as a pointer/byte count pair, as
+  expected by \ref QCPSnapshot::writeSection. Only valid for data types declared as \c
+  Q_PRIMITIVE_TYPE.
+*/
+template <class DataType>
+QPair<const char*, qint64> qcpSnapshotArray(const QCPDataContainer<DataType> &container)
+{
+  if (container.isEmpty())
+    return qMakePair((const char*)0, (qint64)0);
+  return qMakePair(reinterpret_cast<const char*>(&*container.constBegin()), (qint64)(container.size()*sizeof(DataType)));
+}
+
+/*! \internal
+  
+  Returns whether \a value is a value of the enum \a enumName registered (via \c Q_ENUMS) in \a
+  metaObject. Used to validate enum values read from a snapshot before they are cast to the enum
+  type.
+*/
+static bool qcpSnapshotEnumValid(const QMetaObject &metaObject, const char *enumName, int value)
+{
+  const int index = metaObject.indexOfEnumerator(enumName);
+  return index >= 0 && metaObject.enumerator(index).valueToKey(value) != 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////// QCPSnapshot
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*! \class QCPSnapshot
+  \brief Saves and restores the state of a QCustomPlot in a versioned binary file format
+
+  A snapshot contains the axis rects of a plot with the state of their axes, all plottables with
+  their properties and complete data, and all items with their properties and positions. It is
+  meant for quickly saving and restoring analysis sessions with large data sets. The most
+  convenient way to use it is via \ref QCustomPlot::saveSnapshot and \ref
+  QCustomPlot::loadSnapshot.
+
+  The file is written sequentially. It starts with a header (magic number, format version and byte
+  order), followed by one section per axis rect, plottable and item. Each section holds a block of
+  metadata written with QDataStream, followed by the raw, 8-byte aligned data arrays of the object,
+  e.g. the contents of a \ref QCPDataContainer or the cells of a \ref QCPColorMapData. Unknown
+  section types are skipped when loading, so later format revisions can add sections without
+  breaking older readers.
+
+  When loading, the file is memory-mapped and the data arrays are transferred with a single memory
+  copy each into the (already sorted) data containers of the recreated plottables. There is no
+  parsing, no per-point \c addData and no sorting, so restoring is dominated by disk bandwidth. The
+  raw arrays use the native byte order; snapshots are thus only portable between platforms of the
+  same endianness.
+
+  Object properties are stored generically via the Qt property system (all readable and writable
+  properties of built-in Qt types and enums). Properties of QCustomPlot value types such as scatter
+  styles, line endings, color gradients and axis ranges, as well as references between objects
+  (channel fill graphs, stacked bars, error bar data plottables, tracer graphs), are stored
+  explicitly. Plottable and item types not provided by QCustomPlot are skipped, as is the layout
+  apart from the grid cells of the axis rects in the main layout.
+*/
+
+/*!
+  Creates a QCPSnapshot instance. Use \ref save and \ref load to write and read snapshot files.
+*/
+QCPSnapshot::QCPSnapshot() :
+  mPlot(0),
+  mFile(0),
+  mMappedData(0)
+{
+}
+
+/*!
+  Writes a snapshot of \a plot to the file \a fileName. Returns true on success.
+
+  \see load, QCustomPlot::saveSnapshot
+*/
+bool QCPSnapshot::save(QCustomPlot *plot, const QString &fileName)
+{
+  if (!plot)
+  {
+    qDebug() << Q_FUNC_INFO << "invalid plot";
+    return false;
+  }
+  QFile file(fileName);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+  {
+    qDebug() << Q_FUNC_INFO << "Couldn't open file for writing:" << fileName << file.errorString();
+    return false;
+  }
+  
+  mPlot = plot;
+  mAxisRects = plot->axisRects();
+  mPlottables.clear();
+  for (int i=0; i<plot->plottableCount(); ++i)
+    mPlottables.append(plot->plottable(i));
+  
+  QDataStream stream(&file);
+  stream.setVersion(QDataStream::Qt_4_6);
+  stream << (quint32)magicNumber << (quint32)formatVersion << (quint8)(QSysInfo::ByteOrder == QSysInfo::LittleEndian);
+  for (int i=0; i<mAxisRects.size(); ++i)
+    writeAxisRect(stream, i);
+  for (int i=0; i<mPlottables.size(); ++i)
+    writePlottable(stream, mPlottables.at(i));
+  for (int i=0; i<plot->itemCount(); ++i)
+    writeItem(stream, plot->item(i));
+  stream << (quint32)stEnd;
+  
+  mPlot = 0;
+  mAxisRects.clear();
+  mPlottables.clear();
+  if (file.error() != QFile::NoError)
+  {
+    qDebug() << Q_FUNC_INFO << "Error while writing snapshot:" << fileName << file.errorString();
+    return false;
+  }
+  return true;
+}
+
+/*!
+  Restores the snapshot in the file \a fileName into \a plot. Returns true on success.
+
+  All plottables and items of \a plot are removed and replaced by the ones stored in the snapshot.
+  The whole file is read and decoded first, including checks of all indices and enum values, so if
+  it is truncated or corrupt, \a plot is left unchanged and false is returned. Axis rects and axes
+  are matched by their order; missing ones are created, placed in the grid cell of the main layout
+  they occupied when the snapshot was written.
+
+  \see save, QCustomPlot::loadSnapshot
+*/
+bool QCPSnapshot::load(QCustomPlot *plot, const QString &fileName)
+{
+  if (!plot)
+  {
+    qDebug() << Q_FUNC_INFO << "invalid plot";
+    return false;
+  }
+  QFile file(fileName);
+  if (!file.open(QIODevice::ReadOnly))
+  {
+    qDebug() << Q_FUNC_INFO << "Couldn't open file for reading:" << fileName << file.errorString();
+    return false;
+  }
+  
+  QDataStream stream(&file);
+  stream.setVersion(QDataStream::Qt_4_6);
+  quint32 magic, version;
+  quint8 littleEndian;
+  stream >> magic >> version >> littleEndian;
+  if (stream.status() != QDataStream::Ok || magic != (quint32)magicNumber)
+  {
+    qDebug() << Q_FUNC_INFO << "Not a snapshot file:" << fileName;
+    return false;
+  }
+  if (version > (quint32)formatVersion)
+  {
+    qDebug() << Q_FUNC_INFO << "Unsupported snapshot format version" << version << "in" << fileName;
+    return false;
+  }
+  if ((littleEndian != 0) != (QSysInfo::ByteOrder == QSysInfo::LittleEndian))
+  {
+    qDebug() << Q_FUNC_INFO << "Snapshot was written on a platform with different byte order:" << fileName;
+    return false;
+  }
+  
+  mPlot = plot;
+  mFile = &file;
+  mMappedData = file.map(0, file.size()); // if mapping isn't possible, copyArray falls back to reading via the file
+  
+  // read and decode all sections before touching the plot, so a truncated or corrupt file leaves
+  // the current plot contents intact:
+  QList<AxisRectState> axisRects;
+  QList<PlottableState> plottables;
+  QList<ItemState> items;
+  bool result = true;
+  forever
+  {
+    Section section;
+    if (!readSection(stream, section.type, section.meta, section.arrays))
+    {
+      result = false;
+      break;
+    }
+    if (section.type == stEnd)
+      break;
+    QDataStream meta(section.meta);
+    meta.setVersion(QDataStream::Qt_4_6);
+    switch (section.type)
+    {
+      case stAxisRect:
+      {
+        axisRects.append(AxisRectState());
+        result = decodeAxisRect(meta, axisRects.last());
+        break;
+      }
+      case stPlottable:
+      {
+        plottables.append(PlottableState());
+        result = decodePlottable(meta, section.arrays, plottables.last());
+        break;
+      }
+      case stItem:
+      {
+        items.append(ItemState());
+        result = decodeItem(meta, items.last());
+        break;
+      }
+      default: break; // section types of later format revisions are skipped
+    }
+    if (!result)
+    {
+      qDebug() << Q_FUNC_INFO << "Corrupt section in snapshot file:" << fileName;
+      break;
+    }
+  }
+  if (!result)
+  {
+    if (mMappedData)
+      file.unmap(const_cast<uchar*>(mMappedData));
+    mMappedData = 0;
+    mFile = 0;
+    mPlot = 0;
+    return false;
+  }
+  
+  mAxisRects = plot->axisRects();
+  mPlottables.clear();
+  plot->clearPlottables();
+  plot->clearItems();
+  QList<QPair<QCPAbstractPlottable*, int> > plottableLinks;
+  QList<QPair<QCPAbstractItem*, int> > itemLinks;
+  for (int i=0; i<axisRects.size(); ++i)
+    restoreAxisRect(axisRects.at(i));
+  for (int i=0; i<plottables.size(); ++i)
+    restorePlottable(plottables.at(i), plottableLinks);
+  for (int i=0; i<items.size(); ++i)
+    restoreItem(items.at(i), itemLinks);
+  
+  // restore references between objects, now that all of them exist:
+  for (int i=0; i<plottableLinks.size(); ++i)
+  {
+    QCPAbstractPlottable *source = plottableLinks.at(i).first;
+    const int targetIndex = plottableLinks.at(i).second;
+    QCPAbstractPlottable *target = targetIndex >= 0 && targetIndex < mPlottables.size() ? mPlottables.at(targetIndex) : 0;
+    if (!target)
+      continue;
+    if (QCPGraph *graph = qobject_cast<QCPGraph*>(source))
+      graph->setChannelFillGraph(qobject_cast<QCPGraph*>(target));
+    else if (QCPBars *bars = qobject_cast<QCPBars*>(source))
+      bars->moveAbove(qobject_cast<QCPBars*>(target));
+    else if (QCPErrorBars *errorBars = qobject_cast<QCPErrorBars*>(source))
+      errorBars->setDataPlottable(target);
+  }
+  for (int i=0; i<itemLinks.size(); ++i)
+  {
+    const int targetIndex = itemLinks.at(i).second;
+    if (QCPItemTracer *tracer = qobject_cast<QCPItemTracer*>(itemLinks.at(i).first))
+      tracer->setGraph(targetIndex >= 0 && targetIndex < mPlottables.size() ? qobject_cast<QCPGraph*>(mPlottables.at(targetIndex)) : 0);
+  }
+  
+  if (mMappedData)
+    file.unmap(const_cast<uchar*>(mMappedData));
+  mMappedData = 0;
+  mFile = 0;
+  mPlot = 0;
+  mAxisRects.clear();
+  mPlottables.clear();
+  return result;
+}
+
+/*! \internal
+
+  Writes a section of type \a type to \a stream. The section consists of the metadata block \a
+  meta, followed by the raw data \a arrays (each given as pointer and byte count). Every array is
+  preceded by its byte count and aligned to 8 bytes within the file.
+*/
+void QCPSnapshot::writeSection(QDataStream &stream, SectionType type, const QByteArray &meta, const QList<QPair<const char*, qint64> > &arrays) const
+{
+  stream << (quint32)type << meta << (quint32)arrays.size();
+  for (int i=0; i<arrays.size(); ++i)
+  {
+    const char *data = arrays.at(i).first;
+    qint64 remaining = data ? arrays.at(i).second : 0;
+    stream << (quint64)remaining;
+    writePadding(stream);
+    while (remaining > 0) // QDataStream::writeRawData takes an int length, so write very large arrays in chunks
+    {
+      const int chunk = (int)qMin(remaining, (qint64)(1<<30));
+      stream.writeRawData(data, chunk);
+      data += chunk;
+      remaining -= chunk;
+    }
+    writePadding(stream);
+  }
+}
+
+/*! \internal
+
+  Writes the axis rect with index \a index in \ref mAxisRects, including the state of all its axes.
+*/
+void QCPSnapshot::writeAxisRect(QDataStream &stream, int index) const
+{
+  QCPAxisRect *rect = mAxisRects.at(index);
+  QByteArray metaData;
+  QDataStream meta(&metaData, QIODevice::WriteOnly);
+  meta.setVersion(QDataStream::Qt_4_6);
+  
+  // find grid cell in main layout, if the axis rect is placed there directly:
+  int row = -1;
+  int column = -1;
+  QCPLayoutGrid *grid = mPlot->plotLayout();
+  for (int r=0; r<grid->rowCount() && row < 0; ++r)
+  {
+    for (int c=0; c<grid->columnCount(); ++c)
+    {
+      if (grid->element(r, c) == rect)
+      {
+        row = r;
+        column = c;
+        break;
+      }
+    }
+  }
+  meta << (qint32)index << (qint32)row << (qint32)column;
+  writeProperties(meta, rect);
+  
+  QList<QCPAxis*> axes = rect->axes();
+  meta << (qint32)axes.size();
+  foreach (QCPAxis *axis, axes)
+  {
+    meta << (qint32)axis->axisType() << (qint32)rect->axes(axis->axisType()).indexOf(axis);
+    writeProperties(meta, axis);
+    meta << axis->range().lower << axis->range().upper;
+  }
+  writeSection(stream, stAxisRect, metaData, QList<QPair<const char*, qint64> >());
+}
+
+/*! \internal
+
+  Writes \a plottable with its axes, properties and data. Data of primitive data types is written
+  as raw arrays. Plottables of types unknown to the snapshot format are written with their class
+  name only, so the plottable indices used for references stay consistent.
+*/
+void QCPSnapshot::writePlottable(QDataStream &stream, QCPAbstractPlottable *plottable) const
+{
+  QByteArray metaData;
+  QDataStream meta(&metaData, QIODevice::WriteOnly);
+  meta.setVersion(QDataStream::Qt_4_6);
+  QList<QPair<const char*, qint64> > arrays;
+  
+  meta << QString::fromLatin1(plottable->metaObject()->className());
+  writeAxisReference(meta, plottable->keyAxis());
+  writeAxisReference(meta, plottable->valueAxis());
+  writeProperties(meta, plottable);
+  
+  if (QCPCompactGraph *compactGraph = qobject_cast<QCPCompactGraph*>(plottable))
+  {
+    compactGraph->syncDataView(); // the compact columns are written directly, apply pending changes made through data()
+    writeScatterStyle(meta, compactGraph->scatterStyle());
+    meta << (qint32)mPlottables.indexOf(compactGraph->channelFillGraph());
+    meta << (qint32)compactGraph->mValueStorage << compactGraph->mValueScale << compactGraph->mValueOffset << (qint64)compactGraph->mKeys.size();
+    arrays << qMakePair(reinterpret_cast<const char*>(compactGraph->mKeys.constData()), (qint64)(compactGraph->mKeys.size()*sizeof(double)));
+    switch (compactGraph->mValueStorage)
+    {
+      case QCPCompactGraph::vsFloat: arrays << qMakePair(reinterpret_cast<const char*>(compactGraph->mFloatValues.constData()), (qint64)(compactGraph->mFloatValues.size()*sizeof(float))); break;
+      case QCPCompactGraph::vsInt16: arrays << qMakePair(reinterpret_cast<const char*>(compactGraph->mInt16Values.constData()), (qint64)(compactGraph->mInt16Values.size()*sizeof(qint16))); break;
+      case QCPCompactGraph::vsInt32: arrays << qMakePair(reinterpret_cast<const char*>(compactGraph->mInt32Values.constData()), (qint64)(compactGraph->mInt32Values.size()*sizeof(qint32))); break;
+    }
+  } else if (QCPGraph *graph = qobject_cast<QCPGraph*>(plottable))
+  {
+    writeScatterStyle(meta, graph->scatterStyle());
+    meta << (qint32)mPlottables.indexOf(graph->channelFillGraph());
+    meta << (qint64)graph->data()->size();
+    arrays << qcpSnapshotArray(*graph->data());
+  } else if (QCPCurve *curve = qobject_cast<QCPCurve*>(plottable))
+  {
+    writeScatterStyle(meta, curve->scatterStyle());
+    meta << (qint64)curve->data()->size();
+    arrays << qcpSnapshotArray(*curve->data());
+  } else if (QCPBars *bars = qobject_cast<QCPBars*>(plottable))
+  {
+    meta << (qint32)mPlottables.indexOf(bars->barBelow());
+    meta << (qint64)bars->data()->size();
+    arrays << qcpSnapshotArray(*bars->data());
+  } else if (QCPFinancial *financial = qobject_cast<QCPFinancial*>(plottable))
+  {
+    meta << (qint64)financial->data()->size();
+    arrays << qcpSnapshotArray(*financial->data());
+  } else if (QCPStatisticalBox *box = qobject_cast<QCPStatisticalBox*>(plottable))
+  {
+    // statistical box data holds a vector of outliers per data point, so it's written to the metadata element-wise:
+    writeScatterStyle(meta, box->outlierStyle());
+    meta << (qint64)box->data()->size();
+    for (QCPStatisticalBoxDataContainer::const_iterator it=box->data()->constBegin(); it!=box->data()->constEnd(); ++it)
+      meta << it->key << it->minimum << it->lowerQuartile << it->median << it->upperQuartile << it->maximum << it->outliers;
+  } else if (QCPColorMap *colorMap = qobject_cast<QCPColorMap*>(plottable))
+  {
+    const QCPColorMapData *mapData = colorMap->data();
+    const QCPColorGradient gradient = colorMap->gradient();
+    meta << colorMap->dataRange().lower << colorMap->dataRange().upper;
+    meta << gradient.colorStops() << (qint32)gradient.colorInterpolation() << gradient.periodic() << (qint32)gradient.levelCount();
+    meta << (qint32)mapData->keySize() << (qint32)mapData->valueSize();
+    meta << mapData->keyRange().lower << mapData->keyRange().upper << mapData->valueRange().lower << mapData->valueRange().upper;
+    meta << mapData->mDataBounds.lower << mapData->mDataBounds.upper << (bool)(mapData->mAlpha != 0);
+    const qint64 cellCount = mapData->mData ? (qint64)mapData->keySize()*(qint64)mapData->valueSize() : 0;
+    arrays << qMakePair(reinterpret_cast<const char*>(mapData->mData), (qint64)(cellCount*sizeof(double)));
+    if (mapData->mAlpha)
+      arrays << qMakePair(reinterpret_cast<const char*>(mapData->mAlpha), cellCount);
+  } else if (QCPErrorBars *errorBars = qobject_cast<QCPErrorBars*>(plottable))
+  {
+    const QSharedPointer<QCPErrorBarsDataContainer> errorData = errorBars->data();
+    meta << (qint32)mPlottables.indexOf(errorBars->dataPlottable());
+    meta << (qint64)errorData->size();
+    arrays << qMakePair(reinterpret_cast<const char*>(errorData->constData()), (qint64)(errorData->size()*sizeof(QCPErrorBarsData)));
+  } else
+    qDebug() << Q_FUNC_INFO << "Data of plottable type not supported by snapshot format is skipped:" << plottable->metaObject()->className();
+  
+  writeSection(stream, stPlottable, metaData, arrays);
+}
+
+/*! \internal
+
+  Writes \a item with its properties, clip axis rect and the coordinates of all its positions.
+  Parent anchors of positions are not stored.
+*/
+void QCPSnapshot::writeItem(QDataStream &stream, QCPAbstractItem *item) const
+{
+  QByteArray metaData;
+  QDataStream meta(&metaData, QIODevice::WriteOnly);
+  meta.setVersion(QDataStream::Qt_4_6);
+  
+  meta << QString::fromLatin1(item->metaObject()->className());
+  writeProperties(meta, item);
+  meta << (qint32)mAxisRects.indexOf(item->clipAxisRect());
+  QList<QCPItemPosition*> positions = item->positions();
+  meta << (qint32)positions.size();
+  foreach (QCPItemPosition *position, positions)
+  {
+    meta << (qint32)position->typeX() << (qint32)position->typeY() << position->key() << position->value();
+    writeAxisReference(meta, position->keyAxis());
+    writeAxisReference(meta, position->valueAxis());
+    meta << (qint32)mAxisRects.indexOf(position->axisRect());
+  }
+  if (QCPItemLine *line = qobject_cast<QCPItemLine*>(item))
+  {
+    writeLineEnding(meta, line->head());
+    writeLineEnding(meta, line->tail());
+  } else if (QCPItemCurve *curve = qobject_cast<QCPItemCurve*>(item))
+  {
+    writeLineEnding(meta, curve->head());
+    writeLineEnding(meta, curve->tail());
+  } else if (QCPItemTracer *tracer = qobject_cast<QCPItemTracer*>(item))
+    meta << (qint32)mPlottables.indexOf(tracer->graph());
+  
+  writeSection(stream, stItem, metaData, QList<QPair<const char*, qint64> >());
+}
+
+/*! \internal
+
+  Writes all readable and writable properties of \a object whose values are of a built-in Qt type
+  or an enum/flag type (stored as integer) to \a meta. Properties of other types (pointers to
+  QCustomPlot objects, QCustomPlot value types) are skipped, they must be handled explicitly.
+*/
+void QCPSnapshot::writeProperties(QDataStream &meta, const QObject *object) const
+{
+  const QMetaObject *metaObject = object->metaObject();
+  QList<QPair<QByteArray, QVariant> > properties;
+  for (int i=0; i<metaObject->propertyCount(); ++i)
+  {
+    QMetaProperty property = metaObject->property(i);
+    if (!property.isReadable() || !property.isWritable())
+      continue;
+    QVariant value = property.read(object);
+    if (!value.isValid())
+      continue;
+    if (property.isEnumType())
+    {
+      if (!property.enumerator().isValid() || !value.convert(QVariant::Int))
+        continue;
+    }
+    else if (value.userType() >= QMetaType::User || value.userType() == QMetaType::QObjectStar || value.userType() == QMetaType::VoidStar)
+      continue;
+    properties.append(qMakePair(QByteArray(property.name()), value));
+  }
+  meta << (qint32)properties.size();
+  for (int i=0; i<properties.size(); ++i)
+    meta << properties.at(i).first << properties.at(i).second;
+}
+
+/*! \internal
+
+  Writes a reference to \a axis, consisting of the index of its axis rect, its axis type and its
+  index among the axes of that type. A null \a axis is written as an invalid reference.
+*/
+void QCPSnapshot::writeAxisReference(QDataStream &meta, QCPAxis *axis) const
+{
+  if (axis)
+    meta << (qint32)mAxisRects.indexOf(axis->axisRect()) << (qint32)axis->axisType() << (qint32)axis->axisRect()->axes(axis->axisType()).indexOf(axis);
+  else
+    meta << (qint32)-1 << (qint32)0 << (qint32)-1;
+}
+
+/*! \internal
+
+  Writes the scatter style \a style to \a meta.
+*/
+void QCPSnapshot::writeScatterStyle(QDataStream &meta, const QCPScatterStyle &style) const
+{
+  meta << (qint32)style.shape() << style.size() << style.isPenDefined() << style.pen() << style.brush() << style.pixmap() << style.customPath();
+}
+
+/*! \internal
+
+  Writes the line ending \a ending to \a meta.
+*/
+void QCPSnapshot::writeLineEnding(QDataStream &meta, const QCPLineEnding &ending) const
+{
+  meta << (qint32)ending.style() << ending.width() << ending.length() << ending.inverted();
+}
+
+/*! \internal
+
+  Writes zero bytes to \a stream until the current file position is a multiple of 8.
+*/
+void QCPSnapshot::writePadding(QDataStream &stream) const
+{
+  static const char zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  const int padding = (8-stream.device()->pos()%8)%8;
+  if (padding > 0)
+    stream.writeRawData(zeros, padding);
+}
+
+/*! \internal
+
+  Reads the next section header from \a stream. The section type is returned via \a type, the
+  metadata block via \a meta. The data arrays aren't read, but their file offsets and byte counts
+  are returned in \a arrays, so they can later be transferred directly to their destination with
+  \ref copyArray.
+
+  Returns false if the file is truncated or corrupt.
+*/
+bool QCPSnapshot::readSection(QDataStream &stream, quint32 &type, QByteArray &meta, QList<QPair<qint64, qint64> > &arrays)
+{
+  stream >> type;
+  if (stream.status() != QDataStream::Ok)
+  {
+    qDebug() << Q_FUNC_INFO << "Unexpected end of snapshot file";
+    return false;
+  }
+  if (type == stEnd)
+    return true;
+  
+  quint32 arrayCount;
+  stream >> meta >> arrayCount;
+  for (quint32 i=0; i<arrayCount && stream.status() == QDataStream::Ok; ++i)
+  {
+    quint64 byteCount;
+    stream >> byteCount;
+    skipPadding();
+    const qint64 offset = mFile->pos();
+    if (byteCount > (quint64)(mFile->size()-offset))
+    {
+      qDebug() << Q_FUNC_INFO << "Snapshot file is truncated";
+      return false;
+    }
+    arrays.append(qMakePair(offset, (qint64)byteCount));
+    mFile->seek(offset+(qint64)byteCount);
+    skipPadding();
+  }
+  if (stream.status() != QDataStream::Ok)
+  {
+    qDebug() << Q_FUNC_INFO << "Corrupt section in snapshot file";
+    return false;
+  }
+  return true;
+}
+
+/*! \internal
+
+  Decodes the metadata \a meta of an axis rect section into \a state. Returns false if the metadata
+  is truncated or contains invalid indices or axis types.
+*/
+bool QCPSnapshot::decodeAxisRect(QDataStream &meta, AxisRectState &state) const
+{
+  meta >> state.index >> state.row >> state.column;
+  if (!readProperties(meta, state.properties))
+    return false;
+  qint32 axisCount;
+  meta >> axisCount;
+  if (meta.status() != QDataStream::Ok || state.index < 0 || axisCount < 0)
+    return false;
+  for (int i=0; i<axisCount; ++i)
+  {
+    AxisState axis;
+    meta >> axis.type >> axis.typeIndex;
+    if (meta.status() != QDataStream::Ok || !qcpSnapshotEnumValid(QCPAxis::staticMetaObject, "AxisType", axis.type) || axis.typeIndex < 0)
+      return false;
+    if (!readProperties(meta, axis.properties))
+      return false;
+    meta >> axis.lower >> axis.upper;
+    if (meta.status() != QDataStream::Ok)
+      return false;
+    state.axes.append(axis);
+  }
+  return true;
+}
+
+/*! \internal
+
+  Decodes the metadata \a meta of a plottable section into \a state, and checks that the data \a
+  arrays of the section have the sizes the metadata announces. Returns false if the metadata is
+  truncated or contains invalid enum values, or if the arrays don't match.
+  
+  Sections of plottable types unknown to the snapshot format only carry the class name, axes and
+  properties, their plottable is skipped when restoring.
+*/
+bool QCPSnapshot::decodePlottable(QDataStream &meta, const QList<QPair<qint64, qint64> > &arrays, PlottableState &state) const
+{
+  meta >> state.className;
+  if (!readAxisReference(meta, state.keyAxis) || !readAxisReference(meta, state.valueAxis) || !readProperties(meta, state.properties))
+    return false;
+  state.arrays = arrays;
+  
+  const QString &className = state.className;
+  if (className == QLatin1String("QCPCompactGraph"))
+  {
+    if (!readScatterStyle(meta, state.scatterStyle))
+      return false;
+    meta >> state.linkIndex >> state.valueStorage >> state.valueScale >> state.valueOffset >> state.count;
+    if (meta.status() != QDataStream::Ok || !qcpSnapshotEnumValid(QCPCompactGraph::staticMetaObject, "ValueStorage", state.valueStorage))
+      return false;
+    qint64 valueSize = sizeof(float);
+    if (state.valueStorage == QCPCompactGraph::vsInt16)
+      valueSize = sizeof(qint16);
+    else if (state.valueStorage == QCPCompactGraph::vsInt32)
+      valueSize = sizeof(qint32);
+    return checkArray(arrays, 0, state.count, sizeof(double)) && checkArray(arrays, 1, state.count, valueSize);
+  } else if (className == QLatin1String("QCPGraph"))
+  {
+    if (!readScatterStyle(meta, state.scatterStyle))
+      return false;
+    meta >> state.linkIndex >> state.count;
+    return meta.status() == QDataStream::Ok && checkArray(arrays, 0, state.count, sizeof(QCPGraphData));
+  } else if (className == QLatin1String("QCPCurve"))
+  {
+    if (!readScatterStyle(meta, state.scatterStyle))
+      return false;
+    meta >> state.count;
+    return meta.status() == QDataStream::Ok && checkArray(arrays, 0, state.count, sizeof(QCPCurveData));
+  } else if (className == QLatin1String("QCPBars"))
+  {
+    meta >> state.linkIndex >> state.count;
+    return meta.status() == QDataStream::Ok && checkArray(arrays, 0, state.count, sizeof(QCPBarsData));
+  } else if (className == QLatin1String("QCPFinancial"))
+  {
+    meta >> state.count;
+    return meta.status() == QDataStream::Ok && checkArray(arrays, 0, state.count, sizeof(QCPFinancialData));
+  } else if (className == QLatin1String("QCPStatisticalBox"))
+  {
+    if (!readScatterStyle(meta, state.scatterStyle))
+      return false;
+    meta >> state.count;
+    if (meta.status() != QDataStream::Ok || state.count < 0 || state.count > std::numeric_limits<int>::max())
+      return false;
+    for (qint64 i=0; i<state.count; ++i)
+    {
+      QCPStatisticalBoxData element;
+      meta >> element.key >> element.minimum >> element.lowerQuartile >> element.median >> element.upperQuartile >> element.maximum >> element.outliers;
+      if (meta.status() != QDataStream::Ok)
+        return false;
+      state.boxData.append(element);
+    }
+  } else if (className == QLatin1String("QCPColorMap"))
+  {
+    QMap<double, QColor> colorStops;
+    qint32 interpolation, levelCount;
+    bool periodic;
+    meta >> state.dataRange.lower >> state.dataRange.upper;
+    meta >> colorStops >> interpolation >> periodic >> levelCount;
+    meta >> state.keySize >> state.valueSize;
+    meta >> state.keyRange.lower >> state.keyRange.upper >> state.valueRange.lower >> state.valueRange.upper;
+    meta >> state.dataBounds.lower >> state.dataBounds.upper >> state.hasAlpha;
+    if (meta.status() != QDataStream::Ok || !qcpSnapshotEnumValid(QCPColorGradient::staticMetaObject, "ColorInterpolation", interpolation) || state.keySize < 0 || state.valueSize < 0)
+      return false;
+    state.gradient.setColorStops(colorStops);
+    state.gradient.setColorInterpolation((QCPColorGradient::ColorInterpolation)interpolation);
+    state.gradient.setPeriodic(periodic);
+    state.gradient.setLevelCount(levelCount);
+    const qint64 cellCount = (qint64)state.keySize*(qint64)state.valueSize;
+    if (cellCount > 0 && (!checkArray(arrays, 0, cellCount, sizeof(double)) || (state.hasAlpha && !checkArray(arrays, 1, cellCount, 1))))
+      return false;
+  } else if (className == QLatin1String("QCPErrorBars"))
+  {
+    meta >> state.linkIndex >> state.count;
+    return meta.status() == QDataStream::Ok && checkArray(arrays, 0, state.count, sizeof(QCPErrorBarsData));
+  }
+  return meta.status() == QDataStream::Ok;
+}
+
+/*! \internal
+
+  Decodes the metadata \a meta of an item section into \a state. Returns false if the metadata is
+  truncated or contains invalid position types or line ending styles.
+*/
+bool QCPSnapshot::decodeItem(QDataStream &meta, ItemState &state) const
+{
+  meta >> state.className;
+  if (!readProperties(meta, state.properties))
+    return false;
+  qint32 positionCount;
+  meta >> state.clipRectIndex >> positionCount;
+  if (meta.status() != QDataStream::Ok || positionCount < 0)
+    return false;
+  for (int i=0; i<positionCount; ++i)
+  {
+    PositionState position;
+    meta >> position.typeX >> position.typeY >> position.key >> position.value;
+    if (!readAxisReference(meta, position.keyAxis) || !readAxisReference(meta, position.valueAxis))
+      return false;
+    meta >> position.axisRectIndex;
+    if (meta.status() != QDataStream::Ok ||
+        !qcpSnapshotEnumValid(QCPItemPosition::staticMetaObject, "PositionType", position.typeX) ||
+        !qcpSnapshotEnumValid(QCPItemPosition::staticMetaObject, "PositionType", position.typeY))
+      return false;
+    state.positions.append(position);
+  }
+  if (state.className == QLatin1String("QCPItemLine") || state.className == QLatin1String("QCPItemCurve"))
+    return readLineEnding(meta, state.head) && readLineEnding(meta, state.tail);
+  else if (state.className == QLatin1String("QCPItemTracer"))
+    meta >> state.linkIndex;
+  return meta.status() == QDataStream::Ok;
+}
+
+/*! \internal
+
+  Reads the properties written by \ref writeProperties from \a meta into \a properties. Returns
+  false if the metadata is truncated.
+*/
+bool QCPSnapshot::readProperties(QDataStream &meta, PropertyList &properties) const
+{
+  qint32 count;
+  meta >> count;
+  if (meta.status() != QDataStream::Ok || count < 0)
+    return false;
+  for (int i=0; i<count; ++i)
+  {
+    QByteArray name;
+    QVariant value;
+    meta >> name >> value;
+    if (meta.status() != QDataStream::Ok)
+      return false;
+    if (value.isValid())
+      properties.append(qMakePair(name, value));
+  }
+  return true;
+}
+
+/*! \internal
+
+  Reads an axis reference written by \ref writeAxisReference into \a reference. Returns false if
+  the metadata is truncated, or if a reference to an existing axis has an invalid axis type or a
+  negative index. The axis itself is looked up by \ref resolveAxisReference once the axis rects
+  are restored.
+*/
+bool QCPSnapshot::readAxisReference(QDataStream &meta, AxisReference &reference) const
+{
+  meta >> reference.rectIndex >> reference.type >> reference.typeIndex;
+  if (meta.status() != QDataStream::Ok)
+    return false;
+  return reference.rectIndex < 0 || (qcpSnapshotEnumValid(QCPAxis::staticMetaObject, "AxisType", reference.type) && reference.typeIndex >= 0);
+}
+
+/*! \internal
+
+  Reads a scatter style written by \ref writeScatterStyle into \a style. Returns false if the
+  metadata is truncated or the scatter shape is invalid.
+*/
+bool QCPSnapshot::readScatterStyle(QDataStream &meta, QCPScatterStyle &style) const
+{
+  qint32 shape;
+  double size;
+  bool penDefined;
+  QPen pen;
+  QBrush brush;
+  QPixmap pixmap;
+  QPainterPath customPath;
+  meta >> shape >> size >> penDefined >> pen >> brush >> pixmap >> customPath;
+  if (meta.status() != QDataStream::Ok || !qcpSnapshotEnumValid(QCPScatterStyle::staticMetaObject, "ScatterShape", shape))
+    return false;
+  
+  style = QCPScatterStyle();
+  style.setSize(size);
+  if (penDefined)
+    style.setPen(pen);
+  style.setBrush(brush);
+  if (!pixmap.isNull())
+    style.setPixmap(pixmap);
+  if (!customPath.isEmpty())
+    style.setCustomPath(customPath);
+  style.setShape((QCPScatterStyle::ScatterShape)shape); // set last, because setPixmap and setCustomPath change the shape
+  return true;
+}
+
+/*! \internal
+
+  Reads a line ending written by \ref writeLineEnding into \a ending. Returns false if the metadata
+  is truncated or the ending style is invalid.
+*/
+bool QCPSnapshot::readLineEnding(QDataStream &meta, QCPLineEnding &ending) const
+{
+  qint32 style;
+  double width, length;
+  bool inverted;
+  meta >> style >> width >> length >> inverted;
+  if (meta.status() != QDataStream::Ok || !qcpSnapshotEnumValid(QCPLineEnding::staticMetaObject, "EndingStyle", style))
+    return false;
+  ending = QCPLineEnding((QCPLineEnding::EndingStyle)style, width, length, inverted);
+  return true;
+}
+
+/*! \internal
+
+  Returns whether \a arrays contains an array at \a index that holds exactly \a count elements of
+  \a elementSize bytes each.
+*/
+bool QCPSnapshot::checkArray(const QList<QPair<qint64, qint64> > &arrays, int index, qint64 count, qint64 elementSize) const
+{
+  if (count < 0 || count > std::numeric_limits<int>::max())
+  {
+    qDebug() << Q_FUNC_INFO << "Invalid data count" << count;
+    return false;
+  }
+  if (index >= arrays.size())
+  {
+    qDebug() << Q_FUNC_INFO << "Missing data array" << index;
+    return false;
+  }
+  if (arrays.at(index).second != count*elementSize)
+  {
+    qDebug() << Q_FUNC_INFO << "Data array size mismatch:" << arrays.at(index).second << "!=" << count*elementSize;
+    return false;
+  }
+  return true;
+}
+
+/*! \internal
+
+  Copies the data array \a array (file offset and byte count, as returned by \ref readSection) to
+  \a destination, which must have room for exactly \a destinationSize bytes. If the file is
+  memory-mapped, this is a single memory copy, otherwise the array is read via the file device.
+*/
+bool QCPSnapshot::copyArray(const QPair<qint64, qint64> &array, void *destination, qint64 destinationSize) const
+{
+  if (array.second != destinationSize)
+  {
+    qDebug() << Q_FUNC_INFO << "Data array size mismatch:" << array.second << "!=" << destinationSize;
+    return false;
+  }
+  if (destinationSize == 0)
+    return true;
+  if (mMappedData)
+  {
+    memcpy(destination, mMappedData+array.first, (size_t)destinationSize);
+    return true;
+  }
+  const qint64 oldPos = mFile->pos();
+  const bool result = mFile->seek(array.first) && mFile->read(static_cast<char*>(destination), destinationSize) == destinationSize;
+  mFile->seek(oldPos);
+  return result;
+}
+
+/*! \internal
+
+  Replaces the contents of \a container with the \a count data points stored in \a array. Since
+  snapshots are written from sorted containers, no sorting is performed.
+*/
+template <class DataType>
+bool QCPSnapshot::copyContainer(const QPair<qint64, qint64> &array, qint64 count, QCPDataContainer<DataType> *container) const
+{
+  QVector<DataType> data((int)count);
+  if (!copyArray(array, data.data(), count*(qint64)sizeof(DataType)))
+    return false;
+  container->set(data, true);
+  return true;
+}
+
+/*! \internal
+
+  Restores the axis rect decoded into \a state. The axis rect is matched by its index; if the plot
+  has fewer axis rects, a new one is created in the grid cell of the main layout stored in the
+  snapshot.
+*/
+void QCPSnapshot::restoreAxisRect(const AxisRectState &state)
+{
+  QCPAxisRect *rect = 0;
+  if (state.index < mAxisRects.size())
+  {
+    rect = mAxisRects.at(state.index);
+  } else
+  {
+    rect = new QCPAxisRect(mPlot, false);
+    QCPLayoutGrid *grid = mPlot->plotLayout();
+    if (state.row < 0 || state.column < 0 || grid->hasElement(state.row, state.column) || !grid->addElement(state.row, state.column, rect))
+      grid->addElement(grid->rowCount(), 0, rect);
+    mAxisRects.append(rect);
+  }
+  applyProperties(rect, state.properties);
+  
+  for (int i=0; i<state.axes.size(); ++i)
+  {
+    const AxisState &axisState = state.axes.at(i);
+    const QCPAxis::AxisType axisType = (QCPAxis::AxisType)axisState.type;
+    QList<QCPAxis*> existingAxes = rect->axes(axisType);
+    QCPAxis *axis = axisState.typeIndex < existingAxes.size() ? existingAxes.at(axisState.typeIndex) : rect->addAxis(axisType);
+    applyProperties(axis, axisState.properties); // restores scale type before the range, so a logarithmic range isn't sanitized for linear scale
+    axis->setRange(axisState.lower, axisState.upper);
+  }
+}
+
+/*! \internal
+
+  Restores the plottable decoded into \a state by creating the plottable, restoring its
+  properties and adopting its data from the arrays of the section. The created plottable is
+  appended to \ref mPlottables (or a null pointer if the plottable type is unknown). References to
+  other plottables are appended to \a links and resolved once all plottables exist.
+*/
+void QCPSnapshot::restorePlottable(const PlottableState &state, QList<QPair<QCPAbstractPlottable*, int> > &links)
+{
+  const QString &className = state.className;
+  QCPAxis *keyAxis = resolveAxisReference(state.keyAxis);
+  QCPAxis *valueAxis = resolveAxisReference(state.valueAxis);
+  QCPAbstractPlottable *plottable = 0;
+  if (keyAxis && valueAxis)
+  {
+    if (className == QLatin1String("QCPGraph"))
+      plottable = new QCPGraph(keyAxis, valueAxis);
+    else if (className == QLatin1String("QCPCompactGraph"))
+      plottable = new QCPCompactGraph(keyAxis, valueAxis);
+    else if (className == QLatin1String("QCPCurve"))
+      plottable = new QCPCurve(keyAxis, valueAxis);
+    else if (className == QLatin1String("QCPBars"))
+      plottable = new QCPBars(keyAxis, valueAxis);
+    else if (className == QLatin1String("QCPFinancial"))
+      plottable = new QCPFinancial(keyAxis, valueAxis);
+    else if (className == QLatin1String("QCPStatisticalBox"))
+      plottable = new QCPStatisticalBox(keyAxis, valueAxis);
+    else if (className == QLatin1String("QCPColorMap"))
+      plottable = new QCPColorMap(keyAxis, valueAxis);
+    else if (className == QLatin1String("QCPErrorBars"))
+      plottable = new QCPErrorBars(keyAxis, valueAxis);
+  }
+  mPlottables.append(plottable);
+  if (!plottable)
+  {
+    qDebug() << Q_FUNC_INFO << "Couldn't restore plottable of type" << className;
+    return;
+  }
+  applyProperties(plottable, state.properties);
+  
+  const QList<QPair<qint64, qint64> > &arrays = state.arrays;
+  if (QCPCompactGraph *compactGraph = qobject_cast<QCPCompactGraph*>(plottable))
+  {
+    compactGraph->setScatterStyle(state.scatterStyle);
+    links.append(qMakePair(plottable, (int)state.linkIndex));
+    compactGraph->setValueStorage((QCPCompactGraph::ValueStorage)state.valueStorage);
+    compactGraph->setValueScaling(state.valueScale, state.valueOffset);
+    QVector<double> keys((int)state.count);
+    if (!copyArray(arrays.at(0), keys.data(), state.count*(qint64)sizeof(double)))
+      return;
+    switch (compactGraph->valueStorage())
+    {
+      case QCPCompactGraph::vsFloat:
+      {
+        QVector<float> values((int)state.count);
+        if (copyArray(arrays.at(1), values.data(), state.count*(qint64)sizeof(float)))
+          compactGraph->setData(keys, values, true);
+        break;
+      }
+      case QCPCompactGraph::vsInt16:
+      {
+        QVector<qint16> values((int)state.count);
+        if (copyArray(arrays.at(1), values.data(), state.count*(qint64)sizeof(qint16)))
+          compactGraph->setRawData(keys, values, true);
+        break;
+      }
+      case QCPCompactGraph::vsInt32:
+      {
+        QVector<qint32> values((int)state.count);
+        if (copyArray(arrays.at(1), values.data(), state.count*(qint64)sizeof(qint32)))
+          compactGraph->setRawData(keys, values, true);
+        break;
+      }
+    }
+  } else if (QCPGraph *graph = qobject_cast<QCPGraph*>(plottable))
+  {
+    graph->setScatterStyle(state.scatterStyle);
+    links.append(qMakePair(plottable, (int)state.linkIndex));
+    copyContainer(arrays.first(), state.count, graph->data().data());
+  } else if (QCPCurve *curve = qobject_cast<QCPCurve*>(plottable))
+  {
+    curve->setScatterStyle(state.scatterStyle);
+    copyContainer(arrays.first(), state.count, curve->data().data());
+  } else if (QCPBars *bars = qobject_cast<QCPBars*>(plottable))
+  {
+    links.append(qMakePair(plottable, (int)state.linkIndex));
+    copyContainer(arrays.first(), state.count, bars->data().data());
+  } else if (QCPFinancial *financial = qobject_cast<QCPFinancial*>(plottable))
+  {
+    copyContainer(arrays.first(), state.count, financial->data().data());
+  } else if (QCPStatisticalBox *box = qobject_cast<QCPStatisticalBox*>(plottable))
+  {
+    box->setOutlierStyle(state.scatterStyle);
+    box->data()->set(state.boxData, true);
+  } else if (QCPColorMap *colorMap = qobject_cast<QCPColorMap*>(plottable))
+  {
+    colorMap->setGradient(state.gradient);
+    colorMap->setDataRange(state.dataRange);
+    
+    QCPColorMapData *mapData = new QCPColorMapData(state.keySize, state.valueSize, state.keyRange, state.valueRange);
+    const qint64 cellCount = mapData->mData ? (qint64)state.keySize*(qint64)state.valueSize : 0;
+    if (cellCount > 0 && copyArray(arrays.at(0), mapData->mData, cellCount*(qint64)sizeof(double)))
+    {
+      mapData->mDataBounds = state.dataBounds;
+      if (state.hasAlpha && mapData->createAlpha(false))
+        copyArray(arrays.at(1), mapData->mAlpha, cellCount);
+      mapData->mDataModified = true;
+    }
+    colorMap->setData(mapData, false);
+  } else if (QCPErrorBars *errorBars = qobject_cast<QCPErrorBars*>(plottable))
+  {
+    links.append(qMakePair(plottable, (int)state.linkIndex));
+    QSharedPointer<QCPErrorBarsDataContainer> errorData(new QCPErrorBarsDataContainer((int)state.count));
+    if (copyArray(arrays.first(), errorData->data(), state.count*(qint64)sizeof(QCPErrorBarsData)))
+      errorBars->setData(errorData);
+  }
+}
+
+/*! \internal
+
+  Restores the item decoded into \a state by creating the item and restoring its properties and
+  positions. References to plottables (tracer graphs) are appended to \a links and resolved once
+  all objects exist.
+*/
+void QCPSnapshot::restoreItem(const ItemState &state, QList<QPair<QCPAbstractItem*, int> > &links)
+{
+  const QString &className = state.className;
+  QCPAbstractItem *item = 0;
+  if (className == QLatin1String("QCPItemStraightLine"))
+    item = new QCPItemStraightLine(mPlot);
+  else if (className == QLatin1String("QCPItemLine"))
+    item = new QCPItemLine(mPlot);
+  else if (className == QLatin1String("QCPItemCurve"))
+    item = new QCPItemCurve(mPlot);
+  else if (className == QLatin1String("QCPItemRect"))
+    item = new QCPItemRect(mPlot);
+  else if (className == QLatin1String("QCPItemText"))
+    item = new QCPItemText(mPlot);
+  else if (className == QLatin1String("QCPItemEllipse"))
+    item = new QCPItemEllipse(mPlot);
+  else if (className == QLatin1String("QCPItemPixmap"))
+    item = new QCPItemPixmap(mPlot);
+  else if (className == QLatin1String("QCPItemTracer"))
+    item = new QCPItemTracer(mPlot);
+  else if (className == QLatin1String("QCPItemBracket"))
+    item = new QCPItemBracket(mPlot);
+  if (!item)
+  {
+    qDebug() << Q_FUNC_INFO << "Couldn't restore item of type" << className;
+    return;
+  }
+  applyProperties(item, state.properties);
+  
+  if (state.clipRectIndex >= 0 && state.clipRectIndex < mAxisRects.size())
+    item->setClipAxisRect(mAxisRects.at(state.clipRectIndex));
+  QList<QCPItemPosition*> positions = item->positions();
+  for (int i=0; i<state.positions.size() && i<positions.size(); ++i)
+  {
+    const PositionState &positionState = state.positions.at(i);
+    QCPItemPosition *position = positions.at(i);
+    QCPAxis *keyAxis = resolveAxisReference(positionState.keyAxis);
+    QCPAxis *valueAxis = resolveAxisReference(positionState.valueAxis);
+    if (keyAxis && valueAxis)
+      position->setAxes(keyAxis, valueAxis);
+    if (positionState.axisRectIndex >= 0 && positionState.axisRectIndex < mAxisRects.size())
+      position->setAxisRect(mAxisRects.at(positionState.axisRectIndex));
+    position->setTypeX((QCPItemPosition::PositionType)positionState.typeX);
+    position->setTypeY((QCPItemPosition::PositionType)positionState.typeY);
+    position->setCoords(positionState.key, positionState.value);
+  }
+  if (QCPItemLine *line = qobject_cast<QCPItemLine*>(item))
+  {
+    line->setHead(state.head);
+    line->setTail(state.tail);
+  } else if (QCPItemCurve *curve = qobject_cast<QCPItemCurve*>(item))
+  {
+    curve->setHead(state.head);
+    curve->setTail(state.tail);
+  } else if (qobject_cast<QCPItemTracer*>(item))
+    links.append(qMakePair(item, (int)state.linkIndex));
+}
+
+/*! \internal
+
+  Applies the \a properties decoded by \ref readProperties to \a object.
+*/
+void QCPSnapshot::applyProperties(QObject *object, const PropertyList &properties) const
+{
+  for (int i=0; i<properties.size(); ++i)
+    object->setProperty(properties.at(i).first.constData(), properties.at(i).second);
+}
+
+/*! \internal
+
+  Returns the axis \a reference refers to, or 0 if it doesn't exist (anymore).
+*/
+QCPAxis *QCPSnapshot::resolveAxisReference(const AxisReference &reference) const
+{
+  if (reference.rectIndex < 0 || reference.rectIndex >= mAxisRects.size())
+    return 0;
+  QList<QCPAxis*> axes = mAxisRects.at(reference.rectIndex)->axes((QCPAxis::AxisType)reference.type);
+  return reference.typeIndex < axes.size() ? axes.at(reference.typeIndex) : 0;
+}
+
+/*! \internal
+
+  Advances the file position to the next multiple of 8, skipping the padding written by \ref
+  writePadding.
+*/
+void QCPSnapshot::skipPadding() const
+{
+  const qint64 pos = mFile->pos();
+  const int padding = (8-pos%8)%8;
+  if (padding > 0)
+    mFile->seek(pos+padding);
+}
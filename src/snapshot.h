@@ -0,0 +1,196 @@
+/***************************************************************************
+**                                                                        **
+**  QCustomPlot, an easy to use, modern plotting widget for Qt            **
+**  Copyright (C) 2011-2017 Emanuel Eichhammer                            **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+****************************************************************************
+**           Author: Emanuel Eichhammer                                   **
+**  Website/Contact: http://www.qcustomplot.com/                          **
+**             Date: 04.09.17                                             **
+**          Version: 2.0.0                                                **
+****************************************************************************/
+/*! \file */
+#ifndef QCP_SNAPSHOT_H
+#define QCP_SNAPSHOT_H
+
+#include "global.h"
+#include "axis/range.h"
+#include "scatterstyle.h"
+#include "lineending.h"
+#include "colorgradient.h"
+#include "plottables/plottable-statisticalbox.h"
+
+class QCustomPlot;
+class QCPAxis;
+class QCPAxisRect;
+class QCPAbstractPlottable;
+class QCPAbstractItem;
+template <class DataType> class QCPDataContainer;
+
+class QCP_LIB_DECL QCPSnapshot
+{
+public:
+  QCPSnapshot();
+  
+  // non-property methods:
+  bool save(QCustomPlot *plot, const QString &fileName);
+  bool load(QCustomPlot *plot, const QString &fileName);
+  
+protected:
+  enum { magicNumber = 0x51435053 // "QCPS", first four bytes of every snapshot file
+         ,formatVersion = 1       // incremented whenever the layout of the sections changes
+       };
+  
+  /*!
+    The types of the sections that make up a snapshot file. Each section consists of the section
+    type, a block of metadata written with QDataStream, and a number of raw data arrays.
+  */
+  enum SectionType { stAxisRect = 1 ///< axis rect with the state of its axes
+                     ,stPlottable   ///< plottable with its properties and data
+                     ,stItem        ///< item with its properties and positions
+                     ,stEnd = 0xFFFF ///< marks the end of the snapshot
+                   };
+  
+  /*! \internal
+    A section as read by \ref readSection, kept until the whole file has been validated.
+  */
+  struct Section
+  {
+    quint32 type;
+    QByteArray meta;
+    QList<QPair<qint64, qint64> > arrays;
+  };
+  
+  typedef QList<QPair<QByteArray, QVariant> > PropertyList;
+  
+  /*! \internal
+    A reference to an axis as written by \ref writeAxisReference. A negative \a rectIndex denotes
+    a null axis.
+  */
+  struct AxisReference
+  {
+    qint32 rectIndex, type, typeIndex;
+  };
+  
+  /*! \internal
+    The decoded state of an axis within an axis rect section.
+  */
+  struct AxisState
+  {
+    qint32 type, typeIndex;
+    PropertyList properties;
+    double lower, upper;
+  };
+  
+  /*! \internal
+    The decoded content of an axis rect section, see \ref decodeAxisRect.
+  */
+  struct AxisRectState
+  {
+    qint32 index, row, column;
+    PropertyList properties;
+    QList<AxisState> axes;
+  };
+  
+  /*! \internal
+    The decoded content of a plottable section, see \ref decodePlottable. Only the members used by
+    the type given by \a className are set. The data arrays are validated, but stay in the file
+    until the plottable is restored.
+  */
+  struct PlottableState
+  {
+    QString className;
+    AxisReference keyAxis, valueAxis;
+    PropertyList properties;
+    QCPScatterStyle scatterStyle;
+    qint32 linkIndex;
+    qint64 count;
+    qint32 valueStorage;
+    double valueScale, valueOffset;
+    QVector<QCPStatisticalBoxData> boxData;
+    QCPColorGradient gradient;
+    QCPRange dataRange, keyRange, valueRange, dataBounds;
+    qint32 keySize, valueSize;
+    bool hasAlpha;
+    QList<QPair<qint64, qint64> > arrays;
+  };
+  
+  /*! \internal
+    The decoded state of an item position within an item section.
+  */
+  struct PositionState
+  {
+    qint32 typeX, typeY;
+    double key, value;
+    AxisReference keyAxis, valueAxis;
+    qint32 axisRectIndex;
+  };
+  
+  /*! \internal
+    The decoded content of an item section, see \ref decodeItem. Only the members used by the type
+    given by \a className are set.
+  */
+  struct ItemState
+  {
+    QString className;
+    PropertyList properties;
+    qint32 clipRectIndex;
+    QList<PositionState> positions;
+    QCPLineEnding head, tail;
+    qint32 linkIndex;
+  };
+  
+  // non-property members:
+  QCustomPlot *mPlot;
+  QList<QCPAxisRect*> mAxisRects;
+  QList<QCPAbstractPlottable*> mPlottables;
+  QFile *mFile;
+  const uchar *mMappedData;
+  
+  // non-virtual methods (writing):
+  void writeSection(QDataStream &stream, SectionType type, const QByteArray &meta, const QList<QPair<const char*, qint64> > &arrays) const;
+  void writeAxisRect(QDataStream &stream, int index) const;
+  void writePlottable(QDataStream &stream, QCPAbstractPlottable *plottable) const;
+  void writeItem(QDataStream &stream, QCPAbstractItem *item) const;
+  void writeProperties(QDataStream &meta, const QObject *object) const;
+  void writeAxisReference(QDataStream &meta, QCPAxis *axis) const;
+  void writeScatterStyle(QDataStream &meta, const QCPScatterStyle &style) const;
+  void writeLineEnding(QDataStream &meta, const QCPLineEnding &ending) const;
+  void writePadding(QDataStream &stream) const;
+  
+  // non-virtual methods (reading):
+  bool readSection(QDataStream &stream, quint32 &type, QByteArray &meta, QList<QPair<qint64, qint64> > &arrays);
+  bool decodeAxisRect(QDataStream &meta, AxisRectState &state) const;
+  bool decodePlottable(QDataStream &meta, const QList<QPair<qint64, qint64> > &arrays, PlottableState &state) const;
+  bool decodeItem(QDataStream &meta, ItemState &state) const;
+  bool readProperties(QDataStream &meta, PropertyList &properties) const;
+  bool readAxisReference(QDataStream &meta, AxisReference &reference) const;
+  bool readScatterStyle(QDataStream &meta, QCPScatterStyle &style) const;
+  bool readLineEnding(QDataStream &meta, QCPLineEnding &ending) const;
+  bool checkArray(const QList<QPair<qint64, qint64> > &arrays, int index, qint64 count, qint64 elementSize) const;
+  void skipPadding() const;
+  
+  // non-virtual methods (restoring):
+  bool copyArray(const QPair<qint64, qint64> &array, void *destination, qint64 destinationSize) const;
+  template <class DataType> bool copyContainer(const QPair<qint64, qint64> &array, qint64 count, QCPDataContainer<DataType> *container) const;
+  void restoreAxisRect(const AxisRectState &state);
+  void restorePlottable(const PlottableState &state, QList<QPair<QCPAbstractPlottable*, int> > &links);
+  void restoreItem(const ItemState &state, QList<QPair<QCPAbstractItem*, int> > &links);
+  void applyProperties(QObject *object, const PropertyList &properties) const;
+  QCPAxis *resolveAxisReference(const AxisReference &reference) const;
+};
+
+#endif // QCP_SNAPSHOT_H
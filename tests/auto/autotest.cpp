@@ -7,6 +7,12 @@
 #include "test-qcplayout/test-qcplayout.h"
 #include "test-qcpaxisrect/test-qcpaxisrect.h"
 #include "test-datacontainer/test-datacontainer.h"
+#include "test-csvimporter/test-csvimporter.h"
+#include "test-qcpstackedarea/test-qcpstackedarea.h"
+#include "test-qcplinerasterizer/test-qcplinerasterizer.h"
+#include "test-qcpdigitaltrace/test-qcpdigitaltrace.h"
+#include "test-qcperrorbars/test-qcperrorbars.h"
+#include "test-qcpscaletransform/test-qcpscaletransform.h"
 
 #define QCPTEST(t) t t##instance; QTest::qExec(&t##instance)
 
@@ -23,6 +29,12 @@ int main(int argc, char **argv)
   QCPTEST(TestQCPLayout);
   QCPTEST(TestQCPAxisRect);
   QCPTEST(TestDatacontainer);
+  QCPTEST(TestQCPCsvImporter);
+  QCPTEST(TestQCPStackedArea);
+  QCPTEST(TestQCPLineRasterizer);
+  QCPTEST(TestQCPDigitalTrace);
+  QCPTEST(TestQCPErrorBars);
+  QCPTEST(TestQCPScaleTransform);
   
   return 0;
 }
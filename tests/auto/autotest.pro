@@ -8,6 +8,7 @@ DEPENDPATH = .
 INCLUDEPATH = .
 
 HEADERS += ../../qcustomplot.h \
+    probes.h \
     test-qcustomplot/test-qcustomplot.h\
     test-qcpgraph/test-qcpgraph.h \
     test-qcpcurve/test-qcpcurve.h \
@@ -16,7 +17,13 @@ HEADERS += ../../qcustomplot.h \
     test-qcplayout/test-qcplayout.h \
     test-qcpaxisrect/test-qcpaxisrect.h \
     test-colormap/test-colormap.h \
-    test-datacontainer/test-datacontainer.h
+    test-datacontainer/test-datacontainer.h \
+    test-csvimporter/test-csvimporter.h \
+    test-qcpstackedarea/test-qcpstackedarea.h \
+    test-qcplinerasterizer/test-qcplinerasterizer.h \
+    test-qcpdigitaltrace/test-qcpdigitaltrace.h \
+    test-qcperrorbars/test-qcperrorbars.h \
+    test-qcpscaletransform/test-qcpscaletransform.h
 
 SOURCES += ../../qcustomplot.cpp \
            autotest.cpp \
@@ -28,5 +35,11 @@ SOURCES += ../../qcustomplot.cpp \
     test-qcplayout/test-qcplayout.cpp \
     test-qcpaxisrect/test-qcpaxisrect.cpp \
     test-colormap/test-colormap.cpp \
-    test-datacontainer/test-datacontainer.cpp
+    test-datacontainer/test-datacontainer.cpp \
+    test-csvimporter/test-csvimporter.cpp \
+    test-qcpstackedarea/test-qcpstackedarea.cpp \
+    test-qcplinerasterizer/test-qcplinerasterizer.cpp \
+    test-qcpdigitaltrace/test-qcpdigitaltrace.cpp \
+    test-qcperrorbars/test-qcperrorbars.cpp \
+    test-qcpscaletransform/test-qcpscaletransform.cpp
     
@@ -0,0 +1,92 @@
+#ifndef QCP_TEST_PROBES_H
+#define QCP_TEST_PROBES_H
+
+#include "../../qcustomplot.h"
+
+/*
+  Subclasses shared by the tests, which give access to protected internals of the plottables and
+  layout elements under test. Keep this the only place where such accessors are defined, so tests
+  of different modules don't grow their own copies.
+*/
+
+/*
+  Gives the test access to the line generation of QCPGraph or a subclass of it (e.g. QCPLodGraph).
+*/
+template <class GraphType>
+class GraphProbeBase : public GraphType
+{
+public:
+  GraphProbeBase(QCPAxis *keyAxis, QCPAxis *valueAxis) : GraphType(keyAxis, valueAxis) {}
+
+  // the lines of the whole data range, as drawn:
+  void lines(QVector<QPointF> *lines) const { this->getLines(lines, QCPDataRange(0, this->dataCount())); }
+
+  // the step lines of the current line style, without and with merging of redundant points:
+  QVector<QPointF> unmergedLines(const QVector<QCPGraphData> &data) const
+  {
+    switch (this->lineStyle())
+    {
+      case QCPGraph::lsStepLeft: return this->dataToStepLeftLines(data);
+      case QCPGraph::lsStepRight: return this->dataToStepRightLines(data);
+      case QCPGraph::lsStepCenter: return this->dataToStepCenterLines(data);
+      default: return QVector<QPointF>();
+    }
+  }
+  QVector<QPointF> mergedLines(const QVector<QCPGraphData> &data) const { return this->dataToLineStyleLines(data); }
+
+  // whether the cached logarithmic keys match the data:
+  bool logKeysValid() const
+  {
+    const double *logKey = this->logKeys();
+    for (QCPGraphDataContainer::const_iterator it=this->mDataContainer->constBegin(); it!=this->mDataContainer->constEnd(); ++it, ++logKey)
+    {
+      if (*logKey != qLn(it->key))
+        return false;
+    }
+    return true;
+  }
+};
+
+typedef GraphProbeBase<QCPGraph> GraphProbe;
+typedef GraphProbeBase<QCPLodGraph> LodGraphProbe;
+
+/*
+  Gives the test access to the accumulation of channel changes used when drawing.
+*/
+class DigitalTraceProbe : public QCPDigitalTrace
+{
+public:
+  DigitalTraceProbe(QCPAxis *keyAxis, QCPAxis *valueAxis) : QCPDigitalTrace(keyAxis, valueAxis) {}
+  void changes(int begin, int end, quint64 *once, quint64 *twice) const
+  {
+    updateChangeBlocks();
+    accumulateChanges(begin, end, once, twice);
+  }
+};
+
+/*
+  Gives the test access to the merging of error bar lines.
+*/
+class ErrorBarsProbe : public QCPErrorBars
+{
+public:
+  ErrorBarsProbe(QCPAxis *keyAxis, QCPAxis *valueAxis) : QCPErrorBars(keyAxis, valueAxis) {}
+  QVector<QLineF> merged(const QVector<QLineF> &lines) const
+  {
+    QVector<QLineF> result(lines);
+    mergeLineSpans(result);
+    return result;
+  }
+};
+
+/*
+  Exposes the column range of a QCPOverview.
+*/
+class OverviewProbe : public QCPOverview
+{
+public:
+  explicit OverviewProbe(QCustomPlot *parentPlot) : QCPOverview(parentPlot) {}
+  QCPRange binRange() const { return mBinRange; }
+};
+
+#endif // QCP_TEST_PROBES_H
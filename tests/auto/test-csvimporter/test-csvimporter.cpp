@@ -0,0 +1,118 @@
+#include "test-csvimporter.h"
+
+void TestQCPCsvImporter::init()
+{
+  mImporter = new QCPCsvImporter;
+}
+
+void TestQCPCsvImporter::cleanup()
+{
+  delete mImporter;
+}
+
+void TestQCPCsvImporter::parseNumber()
+{
+  const char *fastPath[] = {"0", "-0", "1", "-1", "+2.5", "3.14159", "1e3", "-1.5E-7", "123456789012345678", "0.1", "1e22", "1e-22", ".5", "5."};
+  for (size_t i=0; i<sizeof(fastPath)/sizeof(fastPath[0]); ++i)
+  {
+    const QByteArray text(fastPath[i]);
+    QCOMPARE(QCPCsvImporter::parseNumber(text.constData(), text.constData()+text.size()), text.toDouble());
+  }
+  // slow path (too many digits or too large exponent) must agree with Qt's conversion:
+  const char *slowPath[] = {"12345678901234567890123", "1e300", "-2.5e-300", "0.30000000000000004441"};
+  for (size_t i=0; i<sizeof(slowPath)/sizeof(slowPath[0]); ++i)
+  {
+    const QByteArray text(slowPath[i]);
+    QCOMPARE(QCPCsvImporter::parseNumber(text.constData(), text.constData()+text.size()), text.toDouble());
+  }
+  // whitespace and quotes are ignored:
+  const QByteArray quoted(" \"42.5\"\t");
+  QCOMPARE(QCPCsvImporter::parseNumber(quoted.constData(), quoted.constData()+quoted.size()), 42.5);
+  // non-numbers become NaN:
+  const char *invalid[] = {"", "  ", "abc", "1.2.3", "1e", "--1", "12abc"};
+  for (size_t i=0; i<sizeof(invalid)/sizeof(invalid[0]); ++i)
+  {
+    const QByteArray text(invalid[i]);
+    QVERIFY2(qIsNaN(QCPCsvImporter::parseNumber(text.constData(), text.constData()+text.size())), invalid[i]);
+  }
+}
+
+void TestQCPCsvImporter::malformedRows()
+{
+  mImporter->setHeaderLines(1);
+  QVERIFY(mImporter->parse("time, \"value\" ,note\r\n1,2,3\r\n\r\n2,x\n3,4,5,6\n4,,7"));
+  QCOMPARE(mImporter->columnNames(), QStringList() << QLatin1String("time") << QLatin1String("value") << QLatin1String("note"));
+  QCOMPARE(mImporter->columnIndex(QLatin1String("value")), 1);
+  QCOMPARE(mImporter->columnCount(), 3);
+  QCOMPARE(mImporter->rowCount(), 4); // the empty line is skipped
+  const QVector<double> time = mImporter->column(0);
+  const QVector<double> value = mImporter->column(1);
+  const QVector<double> note = mImporter->column(2);
+  QCOMPARE(time, QVector<double>() << 1 << 2 << 3 << 4);
+  QCOMPARE(value.at(0), 2.0);
+  QVERIFY(qIsNaN(value.at(1))); // non-numeric field
+  QCOMPARE(value.at(2), 4.0);
+  QVERIFY(qIsNaN(value.at(3))); // empty field
+  QVERIFY(qIsNaN(note.at(1))); // short line is padded
+  QCOMPARE(note.at(2), 5.0); // surplus field is ignored
+  QVERIFY(mImporter->column(3).isEmpty());
+  QVERIFY(!mImporter->isColumnSorted(3));
+}
+
+void TestQCPCsvImporter::sortedness()
+{
+  QVERIFY(mImporter->parse("1;5;1\n2;4;\n2;3;3\n4;2;4\n"));
+  QVERIFY(!mImporter->isColumnSorted(0)); // delimiter mismatch, single column of NaN
+  mImporter->setDelimiter(';');
+  QVERIFY(mImporter->parse("1;5;1\n2;4;\n2;3;3\n4;2;4\n"));
+  QVERIFY(mImporter->isColumnSorted(0)); // equal neighbours are sorted
+  QVERIFY(!mImporter->isColumnSorted(1));
+  QVERIFY(!mImporter->isColumnSorted(2)); // NaN makes a column unsorted
+
+}
+
+void TestQCPCsvImporter::chunkMerging()
+{
+  // large enough to be split into four chunks (at least about one megabyte each). All lines have the
+  // same length, so the chunk boundaries are known: the first chunk ends after line n/4.
+  const int n = 400000;
+  const int boundary = n/4+1;
+  QByteArray text, descending;
+  text.reserve(n*12);
+  descending.reserve(n*12);
+  for (int i=0; i<n; ++i)
+  {
+    const QByteArray value = QByteArray::number((i*7919)%1000).rightJustified(3, '0');
+    text += QByteArray::number(i).rightJustified(7, '0') + ',' + value + '\n';
+    descending += QByteArray::number(i < boundary ? i : i-1000).rightJustified(7, '0') + ',' + value + '\n';
+  }
+  QVERIFY(text.size() > 4*(1<<20));
+  mImporter->setThreadCount(4);
+  QVERIFY(mImporter->parse(text));
+  QCOMPARE(mImporter->rowCount(), n);
+  const QVector<double> keys = mImporter->column(0);
+  const QVector<double> values = mImporter->column(1);
+  QCOMPARE(keys.size(), n);
+  QCOMPARE(values.size(), n);
+  for (int i=0; i<n; ++i)
+  {
+    if (keys.at(i) != i || values.at(i) != (i*7919)%1000)
+      QFAIL(qPrintable(QString(QLatin1String("mismatch at row %1")).arg(i)));
+  }
+  QVERIFY(mImporter->isColumnSorted(0));
+  QVERIFY(!mImporter->isColumnSorted(1));
+  
+  // each chunk is sorted by itself, the descent between the first and second chunk must be detected
+  // by the merge:
+  QVERIFY(mImporter->parse(descending));
+  QCOMPARE(mImporter->column(0).at(boundary-1), double(boundary-1));
+  QCOMPARE(mImporter->column(0).at(boundary), double(boundary-1000));
+  QVERIFY(!mImporter->isColumnSorted(0));
+  
+  // the same result as a single thread:
+  QCPCsvImporter single;
+  single.setThreadCount(1);
+  QVERIFY(single.parse(text));
+  QCOMPARE(single.column(0), keys);
+  QCOMPARE(single.column(1), values);
+}
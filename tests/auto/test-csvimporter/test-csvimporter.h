@@ -0,0 +1,18 @@
+#include <QtTest/QtTest>
+#include "../../../qcustomplot.h"
+
+class TestQCPCsvImporter : public QObject
+{
+  Q_OBJECT
+private slots:
+  void init();
+  void cleanup();
+  
+  void parseNumber();
+  void malformedRows();
+  void sortedness();
+  void chunkMerging();
+  
+private:
+  QCPCsvImporter *mImporter;
+};
@@ -234,6 +234,125 @@ void TestDatacontainer::removeAfter()
   }
 }
 
+void TestDatacontainer::gapIndex()
+{
+  // every third point is a gap:
+  QVector<QCPGraphData> data;
+  for (int i=0; i<30; ++i)
+    data << QCPGraphData(i, i%3 == 2 ? qQNaN() : i);
+  mData->setGapIndexEnabled(true);
+  mData->set(data, true);
+  QCOMPARE(mData->gapCount(), 10);
+  QCPGraphDataContainer::const_iterator gap = mData->findGap(mData->constBegin(), mData->constEnd());
+  QCOMPARE(gap->key, 2.0);
+  QCOMPARE(mData->findGapEnd(gap, mData->constEnd())->key, 3.0);
+  QVERIFY(mData->findGap(mData->constBegin(), mData->constBegin()+2) == mData->constBegin()+2);
+  QCOMPARE(mData->findGap(mData->constBegin()+3, mData->constEnd())->key, 5.0);
+  
+  // index follows adding and removing:
+  mData->add(QCPGraphData(3.5, qQNaN()));
+  mData->add(QVector<QCPGraphData>() << QCPGraphData(-1, qQNaN()) << QCPGraphData(40, qQNaN()) << QCPGraphData(10.5, 1), false);
+  QCOMPARE(mData->gapCount(), 13);
+  QCOMPARE(mData->findGap(mData->constBegin(), mData->constEnd())->key, -1.0);
+  QCOMPARE(mData->findGap(mData->findBegin(3, false), mData->constEnd())->key, 3.5);
+  mData->removeBefore(2.5);
+  mData->removeAfter(39);
+  mData->remove(3.5);
+  mData->remove(7.5, 11.5);
+  int expectedGaps = 0;
+  for (QCPGraphDataContainer::const_iterator it=mData->constBegin(); it!=mData->constEnd(); ++it)
+  {
+    if (qIsNaN(it->value))
+      ++expectedGaps;
+  }
+  QCOMPARE(mData->gapCount(), expectedGaps);
+  QCOMPARE(mData->findGap(mData->constBegin(), mData->constEnd())->key, 5.0);
+  
+  // without gaps in the range, end is returned:
+  QCPGraphDataContainer::const_iterator end = mData->findBegin(13.5, false);
+  QVERIFY(mData->findGap(mData->findBegin(11.5, false), end) == end);
+  
+  // manipulation through iterators requires a rebuild:
+  mData->begin()->value = qQNaN();
+  mData->rebuildGapIndex();
+  QCOMPARE(mData->gapCount(), expectedGaps+1);
+  mData->clear();
+  QCOMPARE(mData->gapCount(), 0);
+}
+
+void TestDatacontainer::revisionTracking()
+{
+  QVector<QCPGraphData> data;
+  for (int i=0; i<10; ++i)
+    data << QCPGraphData(i, i);
+  mData->set(data, true);
+  quint64 revision = mData->revision();
+  quint64 editRevision = mData->editRevision();
+  QCOMPARE(editRevision, revision);
+  
+  // read-only access, also through non-const iterators, isn't a change:
+  double sum = 0;
+  for (QCPGraphDataContainer::iterator it=mData->begin(); it!=mData->end(); ++it)
+    sum += it->value;
+  QCOMPARE(sum, 45.0);
+  mData->squeeze();
+  QCOMPARE(mData->revision(), revision);
+  
+  // adding data that must be merged is an edit:
+  mData->add(QVector<QCPGraphData>() << QCPGraphData(5.5, 0), true);
+  QVERIFY(mData->editRevision() > editRevision);
+  mData->set(data, true);
+  revision = mData->revision();
+  editRevision = mData->editRevision();
+  
+  // appending and removing at the front aren't edits:
+  mData->add(QCPGraphData(10, 10));
+  mData->add(QVector<QCPGraphData>() << QCPGraphData(12, 12) << QCPGraphData(11, 11), false);
+  QVERIFY(mData->revision() > revision);
+  QCOMPARE(mData->editRevision(), editRevision);
+  const quint64 frontRemovals = mData->frontRemovalCount();
+  mData->removeBefore(2.5);
+  mData->remove(3);
+  mData->remove(3.5, 5.5);
+  QCOMPARE(mData->frontRemovalCount()-frontRemovals, quint64(6));
+  QCOMPARE(mData->editRevision(), editRevision);
+  QCOMPARE(mData->constBegin()->key, 6.0);
+  revision = mData->revision();
+  mData->removeBefore(-10); // nothing removed
+  mData->removeAfter(100);
+  mData->remove(50);
+  QCOMPARE(mData->revision(), revision);
+  
+  // other changes are edits:
+  mData->add(QCPGraphData(7.5, 0)); // insert
+  QVERIFY(mData->editRevision() > editRevision);
+  editRevision = mData->editRevision();
+  mData->remove(9);
+  QVERIFY(mData->editRevision() > editRevision);
+  editRevision = mData->editRevision();
+  mData->removeAfter(11.5);
+  QVERIFY(mData->editRevision() > editRevision);
+  editRevision = mData->editRevision();
+  mData->begin()->value = -1;
+  mData->markModified();
+  QVERIFY(mData->editRevision() > editRevision);
+  QCOMPARE(mData->editRevision(), mData->revision());
+  editRevision = mData->editRevision();
+  mData->sort();
+  QVERIFY(mData->editRevision() > editRevision);
+  
+  // assignment always advances the revision, also beyond the one of the source:
+  QCPGraphDataContainer other;
+  for (int i=0; i<100; ++i)
+    other.add(QCPGraphData(i, i));
+  revision = mData->revision();
+  *mData = other;
+  QVERIFY(mData->revision() > revision);
+  QVERIFY(mData->revision() > other.revision());
+  QCOMPARE(mData->editRevision(), mData->revision());
+  QCOMPARE(mData->size(), 100);
+}
+
 bool TestDatacontainer::isSorted()
 {
   if (mData->isEmpty())
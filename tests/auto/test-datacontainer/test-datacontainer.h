@@ -16,6 +16,8 @@ private slots:
   void remove();
   void removeBefore();
   void removeAfter();
+  void gapIndex();
+  void revisionTracking();
   
 private:
   bool isSorted();
@@ -240,15 +240,286 @@ void TestQCPAxisRect::axisRectRemovalConveniencePointers()
   QCOMPARE(mPlot->legend, leg);
 }
 
+void TestQCPAxisRect::rangeAnimation()
+{
+  QCPAxisRect *ar = mPlot->axisRect();
+  mPlot->xAxis->setRange(0, 10);
+  mPlot->yAxis->setScaleType(QCPAxis::stLogarithmic);
+  mPlot->yAxis->setRange(1, 10);
+  QSignalSpy spy(ar, SIGNAL(rangeAnimationFinished()));
+  
+  // ranges pass through intermediate values and end exactly at the targets:
+  mPlot->xAxis->animateRange(QCPRange(100, 120), 200);
+  mPlot->yAxis->animateRange(QCPRange(100, 1000), 200);
+  QVERIFY(ar->isAnimatingRanges());
+  QTest::qWait(80);
+  QVERIFY(mPlot->xAxis->range().lower > 0 && mPlot->xAxis->range().lower < 100);
+  QVERIFY(mPlot->yAxis->range().lower > 1 && mPlot->yAxis->range().lower < 100);
+  QTRY_COMPARE(spy.count(), 1);
+  QVERIFY(!ar->isAnimatingRanges());
+  QCOMPARE(mPlot->xAxis->range(), QCPRange(100, 120));
+  QCOMPARE(mPlot->yAxis->range(), QCPRange(100, 1000));
+  
+  // stopping keeps the intermediate range, or jumps to the target:
+  mPlot->xAxis->animateRange(QCPRange(0, 10), 1000);
+  QTest::qWait(50);
+  ar->stopRangeAnimations();
+  QVERIFY(!ar->isAnimatingRanges());
+  QVERIFY(mPlot->xAxis->range().lower > 0 && mPlot->xAxis->range().lower < 100);
+  mPlot->xAxis->animateRange(QCPRange(0, 10), 1000);
+  ar->stopRangeAnimations(true);
+  QCOMPARE(mPlot->xAxis->range(), QCPRange(0, 10));
+  QCOMPARE(spy.count(), 1);
+  
+  // by default, intermediate frames are drawn without antialiasing, and the settings are restored
+  // afterwards:
+  QVERIFY(ar->rangeAnimationDegraded());
+  mPlot->setNotAntialiasedElements(QCP::aeLegend);
+  mPlot->xAxis->animateRange(QCPRange(20, 30), 100);
+  QCOMPARE(mPlot->notAntialiasedElements(), QCP::AntialiasedElements(QCP::aeAll));
+  QTRY_COMPARE(spy.count(), 2);
+  QCOMPARE(mPlot->notAntialiasedElements(), QCP::AntialiasedElements(QCP::aeLegend));
+  
+  // without degraded frames, the antialiasing settings stay untouched:
+  ar->setRangeAnimationDegraded(false);
+  mPlot->xAxis->animateRange(QCPRange(10, 20), 100);
+  QCOMPARE(mPlot->notAntialiasedElements(), QCP::AntialiasedElements(QCP::aeLegend));
+  QTRY_COMPARE(spy.count(), 3);
+  ar->setRangeAnimationDegraded(true);
+  
+  // an animation started during a range drag leaves the antialiasing settings to the drag, so
+  // settings changed after the drag ended aren't overwritten when the animation finishes:
+  mPlot->setNoAntialiasingOnDrag(true);
+  mPlot->setInteractions(QCP::iRangeDrag);
+  const QPoint center = ar->rect().center();
+  QMouseEvent pressEvent(QEvent::MouseButtonPress, center, Qt::LeftButton, Qt::LeftButton, Qt::NoModifier);
+  QCoreApplication::sendEvent(mPlot, &pressEvent);
+  mPlot->xAxis->animateRange(QCPRange(40, 50), 200);
+  QMouseEvent releaseEvent(QEvent::MouseButtonRelease, center, Qt::LeftButton, Qt::NoButton, Qt::NoModifier);
+  QCoreApplication::sendEvent(mPlot, &releaseEvent);
+  QCOMPARE(mPlot->notAntialiasedElements(), QCP::AntialiasedElements(QCP::aeLegend));
+  mPlot->setNotAntialiasedElements(QCP::aeAxes);
+  QTRY_COMPARE(spy.count(), 4);
+  QCOMPARE(mPlot->xAxis->range(), QCPRange(40, 50));
+  QCOMPARE(mPlot->notAntialiasedElements(), QCP::AntialiasedElements(QCP::aeAxes));
+}
 
+/*
+  Records the clip region of the last draw call, to tell whether the graph was drawn only into the
+  strip uncovered by a blitted range drag.
+*/
+class BlitGraphProbe : public QCPGraph
+{
+public:
+  BlitGraphProbe(QCPAxis *keyAxis, QCPAxis *valueAxis) : QCPGraph(keyAxis, valueAxis), drawCount(0) {}
+  QRectF lastClip;
+  int drawCount;
+protected:
+  virtual void draw(QCPPainter *painter) Q_DECL_OVERRIDE
+  {
+    lastClip = painter->clipBoundingRect();
+    ++drawCount;
+    QCPGraph::draw(painter);
+  }
+};
 
+/*
+  Returns the number of pixels in which \a a and \a b differ by more than \a tolerance in any
+  channel.
+*/
+static int differingPixels(const QImage &a, const QImage &b, int tolerance)
+{
+  if (a.size() != b.size())
+    return qMax(a.width()*a.height(), b.width()*b.height());
+  int result = 0;
+  for (int y=0; y<a.height(); ++y)
+  {
+    const QRgb *lineA = reinterpret_cast<const QRgb*>(a.constScanLine(y));
+    const QRgb *lineB = reinterpret_cast<const QRgb*>(b.constScanLine(y));
+    for (int x=0; x<a.width(); ++x)
+    {
+      if (qAbs(qRed(lineA[x])-qRed(lineB[x])) > tolerance || qAbs(qGreen(lineA[x])-qGreen(lineB[x])) > tolerance ||
+          qAbs(qBlue(lineA[x])-qBlue(lineB[x])) > tolerance || qAbs(qAlpha(lineA[x])-qAlpha(lineB[x])) > tolerance)
+        ++result;
+    }
+  }
+  return result;
+}
 
+void TestQCPAxisRect::rangeDragBlitting()
+{
+  QCPAxisRect *ar = mPlot->axisRect();
+  mPlot->setGeometry(50, 50, 500, 400);
+  mPlot->setInteractions(QCP::iRangeDrag);
+  mPlot->layer("main")->setMode(QCPLayer::lmBuffered);
+  ar->setRangeDragBlitting(true);
+  ar->setAutoMargins(QCP::msNone); // changing tick label widths must not resize the axis rect during the drag
+  ar->setMargins(QMargins(60, 40, 60, 40));
+  mPlot->xAxis->setRange(0, 10);
+  mPlot->yAxis->setRange(-2, 2);
+  mPlot->xAxis2->setVisible(true);
+  mPlot->yAxis2->setVisible(true);
+  mPlot->xAxis2->setRange(0, 10);
+  mPlot->yAxis2->setRange(-2, 2);
+  mPlot->legend->setVisible(true);
+  
+  QVector<double> keys, values;
+  for (int i=0; i<200; ++i)
+  {
+    keys << i*0.1-5;
+    values << qSin(i*0.1)+0.3*qCos(i*0.7);
+  }
+  BlitGraphProbe *graph = new BlitGraphProbe(mPlot->xAxis, mPlot->yAxis);
+  graph->setData(keys, values, true);
+  graph->setPen(QPen(Qt::blue, 2));
+  graph->setBrush(QColor(0, 0, 255, 40));
+  graph->setName("dragged");
+  // layerables that don't move with the drag, on their own buffered layer:
+  mPlot->addLayer("static", mPlot->layer("main"), QCustomPlot::limAbove);
+  mPlot->layer("static")->setMode(QCPLayer::lmBuffered);
+  QCPGraph *staticGraph = mPlot->addGraph(mPlot->xAxis2, mPlot->yAxis2); // axes not dragged
+  staticGraph->setData(keys, values, true);
+  staticGraph->setPen(QPen(Qt::red));
+  staticGraph->setLayer("static");
+  QCPItemText *label = new QCPItemText(mPlot);
+  label->position->setType(QCPItemPosition::ptAxisRectRatio);
+  label->position->setCoords(0.5, 0.1);
+  label->setText("fixed");
+  label->setLayer("static");
+  mPlot->replot();
+  
+  // drag once with the label on its own layer, and once with it on the layer of the dragged graph,
+  // so that buffer can't be shifted. Each drag step is blitted, and then compared with a full replot
+  // of the same ranges:
+  const QPoint start(ar->left()+ar->width()/2, mPlot->yAxis->coordToPixel(1.8));
+  const QList<QPoint> offsets = QList<QPoint>() << QPoint(30, 0) << QPoint(30, 25) << QPoint(-15, 25);
+  for (int pass=0; pass<2; ++pass)
+  {
+    const bool labelMoves = pass == 0;
+    label->setLayer(labelMoves ? "static" : "main");
+    mPlot->replot();
+    QMouseEvent pressEvent(QEvent::MouseButtonPress, start, Qt::LeftButton, Qt::LeftButton, Qt::NoModifier);
+    QCoreApplication::sendEvent(mPlot, &pressEvent);
+    for (int i=0; i<offsets.size(); ++i)
+    {
+      QMouseEvent moveEvent(QEvent::MouseMove, start+offsets.at(i), Qt::NoButton, Qt::LeftButton, Qt::NoModifier);
+      QCoreApplication::sendEvent(mPlot, &moveEvent);
+      const int drawCountBefore = graph->drawCount;
+      mPlot->replot();
+      QCOMPARE(graph->drawCount, drawCountBefore+1);
+      const QRectF blitClip = graph->lastClip;
+      const QImage blitted = mPlot->grab().toImage().convertToFormat(QImage::Format_ARGB32);
+      
+      mPlot->replot(); // no pending shift, redraws everything
+      QVERIFY(graph->lastClip.width() >= ar->width() && graph->lastClip.height() >= ar->height());
+      const QImage full = mPlot->grab().toImage().convertToFormat(QImage::Format_ARGB32);
+      QVERIFY2(differingPixels(blitted, full, 16) == 0, qPrintable(QString("pass %1, drag step %2").arg(pass).arg(i)));
+      
+      // the graph was only drawn into the uncovered strip, unless its buffer holds the label:
+      const QPoint delta = offsets.at(i)-(i > 0 ? offsets.at(i-1) : QPoint());
+      if (!labelMoves)
+        QVERIFY(blitClip.width() >= ar->width() && blitClip.height() >= ar->height());
+      else if (delta.x() != 0)
+        QVERIFY(blitClip.width() <= qAbs(delta.x())+1 && blitClip.height() >= ar->height());
+      else
+        QVERIFY(blitClip.height() <= qAbs(delta.y())+1 && blitClip.width() >= ar->width());
+    }
+    QMouseEvent releaseEvent(QEvent::MouseButtonRelease, start+offsets.last(), Qt::LeftButton, Qt::NoButton, Qt::NoModifier);
+    QCoreApplication::sendEvent(mPlot, &releaseEvent);
+    mPlot->replot();
+  }
+  QVERIFY(qAbs(mPlot->xAxis->range().lower-(-2*offsets.last().x()*10.0/ar->width())) < 1e-6);
+}
 
+void TestQCPAxisRect::rangeZoomPreview()
+{
+  QCPAxisRect *ar = mPlot->axisRect();
+  mPlot->setGeometry(50, 50, 500, 400);
+  mPlot->setInteractions(QCP::iRangeZoom);
+  ar->setRangeZoomPreviewDelay(100);
+  QCPGraph *graph = mPlot->addGraph();
+  for (int i=0; i<100; ++i)
+    graph->addData(i, qSin(i/10.0));
+  mPlot->xAxis->setRange(0, 100);
+  mPlot->yAxis->setRange(-2, 2);
+  mPlot->replot();
+  QSignalSpy spy(mPlot, SIGNAL(afterReplot()));
+  const QPoint center = ar->rect().center();
+  
+  // the graph shares its paint buffer with the axes, so no preview can be drawn and the wheel step
+  // is replotted in full quality right away, without a follow-up replot:
+  QWheelEvent wheelEvent1(center, 120, Qt::NoButton, Qt::NoModifier);
+  QCoreApplication::sendEvent(mPlot, &wheelEvent1);
+  QCOMPARE(spy.count(), 1);
+  QTest::qWait(250);
+  QCOMPARE(spy.count(), 1);
+  
+  // with the graph on its own buffered layer, wheel steps show previews, followed by a single full
+  // quality replot once zooming settles:
+  mPlot->layer("main")->setMode(QCPLayer::lmBuffered);
+  mPlot->replot();
+  spy.clear();
+  const QCPRange rangeBefore = mPlot->xAxis->range();
+  QWheelEvent wheelEvent2(center, 120, Qt::NoButton, Qt::NoModifier);
+  QCoreApplication::sendEvent(mPlot, &wheelEvent2);
+  QWheelEvent wheelEvent3(center, -240, Qt::NoButton, Qt::NoModifier);
+  QCoreApplication::sendEvent(mPlot, &wheelEvent3);
+  QCOMPARE(spy.count(), 2);
+  QVERIFY(mPlot->xAxis->range().size() > rangeBefore.size());
+  QTRY_COMPARE(spy.count(), 3);
+  QTest::qWait(250);
+  QCOMPARE(spy.count(), 3);
+  
+  // a zoom step that can't be previewed, because the range is limited, cancels the pending
+  // full quality replot:
+  QWheelEvent wheelEvent4(center, 120, Qt::NoButton, Qt::NoModifier);
+  QCoreApplication::sendEvent(mPlot, &wheelEvent4);
+  QCOMPARE(spy.count(), 4);
+  mPlot->xAxis->setRange(-4.9e249, 4.9e249); // can't be zoomed out further (QCPRange::maxRange), so the contents aren't scaled
+  QWheelEvent wheelEvent5(center, -120, Qt::NoButton, Qt::NoModifier);
+  QCoreApplication::sendEvent(mPlot, &wheelEvent5);
+  QCOMPARE(spy.count(), 5);
+  QTest::qWait(250);
+  QCOMPARE(spy.count(), 5);
+}
 
-
-
-
-
-
-
-
+void TestQCPAxisRect::rangeAnimationBlitting()
+{
+  QCPAxisRect *ar = mPlot->axisRect();
+  mPlot->setGeometry(50, 50, 500, 400);
+  mPlot->layer("main")->setMode(QCPLayer::lmBuffered);
+  mPlot->xAxis->setRange(0, 10);
+  mPlot->yAxis->setRange(-2, 2);
+  BlitGraphProbe *graph = new BlitGraphProbe(mPlot->xAxis, mPlot->yAxis);
+  for (int i=0; i<400; ++i)
+    graph->addData(i*0.1-10, qSin(i*0.1));
+  mPlot->replot();
+  QSignalSpy spy(ar, SIGNAL(rangeAnimationFinished()));
+  
+  // intermediate frames of an animated pan shift the previous frame and only draw the graph into
+  // the uncovered strip, the final frame is drawn entirely:
+  mPlot->xAxis->animateRange(QCPRange(-5, 5), 300);
+  double narrowestClip = ar->width();
+  while (ar->isAnimatingRanges())
+  {
+    QTest::qWait(5);
+    if (ar->isAnimatingRanges())
+      narrowestClip = qMin(narrowestClip, graph->lastClip.width());
+  }
+  QCOMPARE(spy.count(), 1);
+  QVERIFY(narrowestClip < ar->width()/2);
+  QTRY_VERIFY(graph->lastClip.width() >= ar->width());
+  QCOMPARE(mPlot->xAxis->range(), QCPRange(-5, 5));
+  
+  // without degraded frames, every frame draws the graph entirely:
+  ar->setRangeAnimationDegraded(false);
+  mPlot->xAxis->animateRange(QCPRange(0, 10), 300);
+  narrowestClip = ar->width();
+  while (ar->isAnimatingRanges())
+  {
+    QTest::qWait(5);
+    narrowestClip = qMin(narrowestClip, graph->lastClip.width());
+  }
+  QVERIFY(narrowestClip >= ar->width());
+  QCOMPARE(spy.count(), 2);
+}
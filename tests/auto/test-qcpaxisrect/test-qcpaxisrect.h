@@ -15,6 +15,10 @@ private slots:
   void axisRectRemovalConsequencesToPlottables();
   void axisRectRemovalConsequencesToItems();
   void axisRectRemovalConveniencePointers();
+  void rangeAnimation();
+  void rangeDragBlitting();
+  void rangeZoomPreview();
+  void rangeAnimationBlitting();
   
 private:
   QCustomPlot *mPlot;
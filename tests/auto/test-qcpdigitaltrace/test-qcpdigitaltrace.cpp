@@ -0,0 +1,165 @@
+#include "test-qcpdigitaltrace.h"
+#include "../probes.h"
+
+void TestQCPDigitalTrace::init()
+{
+  mPlot = new QCustomPlot(0);
+  mPlot->setGeometry(0, 0, 500, 400);
+  mTrace = new QCPDigitalTrace(mPlot->xAxis, mPlot->yAxis);
+  mTrace->setChannelCount(8);
+}
+
+void TestQCPDigitalTrace::cleanup()
+{
+  delete mPlot;
+}
+
+void TestQCPDigitalTrace::setDataSorting()
+{
+  // unsorted input is sorted, transitions that don't change the state are dropped:
+  mTrace->setData(QVector<double>() << 3 << 1 << 2 << 0, QVector<quint64>() << 5 << 5 << 6 << 5);
+  QCOMPARE(mTrace->timestamps(), QVector<double>() << 0 << 2 << 3);
+  QCOMPARE(mTrace->states(), QVector<quint64>() << 5 << 6 << 5);
+  // surplus entries of the longer vector are ignored:
+  mTrace->setData(QVector<double>() << 0 << 1 << 2, QVector<quint64>() << 1 << 2, true);
+  QCOMPARE(mTrace->transitionCount(), 2);
+  mTrace->clearData();
+  QCOMPARE(mTrace->transitionCount(), 0);
+}
+
+void TestQCPDigitalTrace::findBeginEnd()
+{
+  mTrace->setData(QVector<double>() << 0 << 1 << 2 << 3, QVector<quint64>() << 1 << 2 << 3 << 4, true);
+  QCOMPARE(mTrace->findBegin(1.5), 1);
+  QCOMPARE(mTrace->findBegin(1.5, false), 2);
+  QCOMPARE(mTrace->findBegin(1), 0);
+  QCOMPARE(mTrace->findBegin(1, false), 1);
+  QCOMPARE(mTrace->findBegin(-1), 0);
+  QCOMPARE(mTrace->findBegin(10), 3);
+  QCOMPARE(mTrace->findBegin(10, false), 4);
+  
+  QCOMPARE(mTrace->findEnd(1.5), 3);
+  QCOMPARE(mTrace->findEnd(1.5, false), 2);
+  QCOMPARE(mTrace->findEnd(1), 3);
+  QCOMPARE(mTrace->findEnd(1, false), 2);
+  QCOMPARE(mTrace->findEnd(-1), 1);
+  QCOMPARE(mTrace->findEnd(-1, false), 0);
+  QCOMPARE(mTrace->findEnd(3), 4);
+  QCOMPARE(mTrace->findEnd(10, false), 4);
+  
+  mTrace->clearData();
+  QCOMPARE(mTrace->findBegin(0), 0);
+  QCOMPARE(mTrace->findEnd(0), 0);
+}
+
+void TestQCPDigitalTrace::stateAt()
+{
+  QCOMPARE(mTrace->stateAt(0), quint64(0));
+  mTrace->setData(QVector<double>() << 0 << 1 << 2 << 3, QVector<quint64>() << 1 << 2 << 3 << 4, true);
+  QCOMPARE(mTrace->stateAt(-1), quint64(0)); // before the first transition
+  QCOMPARE(mTrace->stateAt(0), quint64(1));
+  QCOMPARE(mTrace->stateAt(1.5), quint64(2));
+  QCOMPARE(mTrace->stateAt(2), quint64(3));
+  QCOMPARE(mTrace->stateAt(3), quint64(4));
+  QCOMPARE(mTrace->stateAt(100), quint64(4));
+}
+
+void TestQCPDigitalTrace::addTransition()
+{
+  mTrace->setData(QVector<double>() << 0 << 1 << 2 << 3, QVector<quint64>() << 1 << 2 << 3 << 4, true);
+  // appending:
+  mTrace->addTransition(4, 4); // no change, dropped
+  QCOMPARE(mTrace->transitionCount(), 4);
+  mTrace->addTransition(4, 5);
+  QCOMPARE(mTrace->transitionCount(), 5);
+  QCOMPARE(mTrace->stateAt(4), quint64(5));
+  // inserting:
+  mTrace->addTransition(1.5, 2); // same as preceding state, dropped
+  QCOMPARE(mTrace->transitionCount(), 5);
+  mTrace->addTransition(1.5, 3); // following transition becomes redundant and is moved
+  QCOMPARE(mTrace->timestamps(), QVector<double>() << 0 << 1 << 1.5 << 3 << 4);
+  QCOMPARE(mTrace->states(), QVector<quint64>() << 1 << 2 << 3 << 4 << 5);
+  mTrace->addTransition(2.5, 7);
+  QCOMPARE(mTrace->timestamps(), QVector<double>() << 0 << 1 << 1.5 << 2.5 << 3 << 4);
+  QCOMPARE(mTrace->stateAt(2.7), quint64(7));
+  QCOMPARE(mTrace->stateAt(3), quint64(4));
+  
+  // addTransitions appends sorted data and merges everything else:
+  mTrace->addTransitions(QVector<double>() << 5 << 6, QVector<quint64>() << 5 << 6, true);
+  QCOMPARE(mTrace->transitionCount(), 7); // 5 at key 5 is redundant
+  mTrace->addTransitions(QVector<double>() << 0.5, QVector<quint64>() << 9);
+  QCOMPARE(mTrace->transitionCount(), 8);
+  QCOMPARE(mTrace->stateAt(0.7), quint64(9));
+  QCOMPARE(mTrace->stateAt(1), quint64(2));
+}
+
+/*
+  Compares the block-wise accumulation of channel changes with a transition-wise scan, for random
+  ranges. Returns the number of mismatching ranges.
+*/
+static int changeMismatches(const DigitalTraceProbe *trace)
+{
+  const QVector<quint64> states = trace->states();
+  const int n = states.size();
+  int mismatches = 0;
+  for (int r=0; r<500; ++r)
+  {
+    int begin = 1+qrand()%(n-1), end = 1+qrand()%n;
+    if (begin > end)
+      qSwap(begin, end);
+    quint64 expectedOnce = 0, expectedTwice = 0;
+    for (int k=begin; k<end; ++k)
+    {
+      const quint64 changed = states.at(k)^states.at(k-1);
+      expectedTwice |= expectedOnce & changed;
+      expectedOnce |= changed;
+    }
+    quint64 once = 0, twice = 0;
+    trace->changes(begin, end, &once, &twice);
+    if (once != expectedOnce || twice != expectedTwice)
+      ++mismatches;
+  }
+  return mismatches;
+}
+
+void TestQCPDigitalTrace::changeAccumulation()
+{
+  qsrand(1);
+  DigitalTraceProbe *trace = new DigitalTraceProbe(mPlot->xAxis, mPlot->yAxis);
+  trace->setChannelCount(16);
+  QVector<double> timestamps;
+  QVector<quint64> states;
+  quint64 state = 0;
+  for (int i=0; i<5000; ++i)
+  {
+    // mostly single toggles of the low channels, occasionally of a high channel:
+    state ^= Q_UINT64_C(1) << (i%97 == 0 ? 8+qrand()%8 : qrand()%8);
+    timestamps.append(i);
+    states.append(state);
+  }
+  trace->setData(timestamps, states, true);
+  QCOMPARE(trace->transitionCount(), 5000);
+  QCOMPARE(changeMismatches(trace), 0);
+  
+  // channels toggling repeatedly within a range spanning several blocks count as changing twice:
+  quint64 once = 0, twice = 0;
+  trace->changes(1, 97*3, &once, &twice);
+  QVERIFY(twice & 0xFF);
+  
+  // inserting shifts the transitions, so cached blocks must be discarded:
+  trace->addTransition(1000.5, trace->stateAt(1000)^(Q_UINT64_C(1) << 15));
+  QCOMPARE(trace->transitionCount(), 5001);
+  QCOMPARE(changeMismatches(trace), 0);
+  // appending keeps them valid:
+  for (int i=0; i<300; ++i)
+  {
+    state ^= Q_UINT64_C(1) << (qrand()%16);
+    trace->addTransition(5000+i, state);
+  }
+  QCOMPARE(changeMismatches(trace), 0);
+  
+  // drawing with many transitions per pixel column works without issues:
+  mPlot->xAxis->setRange(-10, 6000);
+  mPlot->yAxis->setRange(0, 16);
+  mPlot->replot();
+}
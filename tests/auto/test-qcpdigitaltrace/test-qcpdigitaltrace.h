@@ -0,0 +1,20 @@
+#include <QtTest/QtTest>
+#include "../../../qcustomplot.h"
+
+class TestQCPDigitalTrace : public QObject
+{
+  Q_OBJECT
+private slots:
+  void init();
+  void cleanup();
+  
+  void setDataSorting();
+  void findBeginEnd();
+  void stateAt();
+  void addTransition();
+  void changeAccumulation();
+  
+private:
+  QCustomPlot *mPlot;
+  QCPDigitalTrace *mTrace;
+};
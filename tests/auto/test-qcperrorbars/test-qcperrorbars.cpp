@@ -0,0 +1,37 @@
+#include "test-qcperrorbars.h"
+#include "../probes.h"
+
+void TestQCPErrorBars::init()
+{
+  mPlot = new QCustomPlot(0);
+}
+
+void TestQCPErrorBars::cleanup()
+{
+  delete mPlot;
+}
+
+void TestQCPErrorBars::mergeLineSpans()
+{
+  ErrorBarsProbe *errorBars = new ErrorBarsProbe(mPlot->xAxis, mPlot->yAxis);
+  
+  // overlapping and touching spans in the same pixel column are merged:
+  QCOMPARE(errorBars->merged(QVector<QLineF>() << QLineF(5.2, 10, 5.2, 20) << QLineF(5.7, 15, 5.7, 30)),
+           QVector<QLineF>() << QLineF(5.2, 10, 5.2, 30));
+  QCOMPARE(errorBars->merged(QVector<QLineF>() << QLineF(5.2, 20, 5.2, 10) << QLineF(5.4, 20, 5.4, 30)),
+           QVector<QLineF>() << QLineF(5.2, 10, 5.2, 30));
+  // spans with a gap in between are kept, even if the gap is below a pixel:
+  QVector<QLineF> gap = QVector<QLineF>() << QLineF(5.2, 10, 5.2, 20) << QLineF(5.2, 20.5, 5.2, 30);
+  QCOMPARE(errorBars->merged(gap), gap);
+  gap = QVector<QLineF>() << QLineF(5.2, 10, 5.2, 20) << QLineF(5.2, 22, 5.2, 30);
+  QCOMPARE(errorBars->merged(gap), gap);
+  // different pixel columns and orientations aren't merged:
+  QVector<QLineF> separate = QVector<QLineF>() << QLineF(5.9, 10, 5.9, 20) << QLineF(6.1, 10, 6.1, 20) << QLineF(3, 6.5, 9, 6.5);
+  QCOMPARE(errorBars->merged(separate), separate);
+  // horizontal lines are merged along x:
+  QCOMPARE(errorBars->merged(QVector<QLineF>() << QLineF(10, 7.1, 20, 7.1) << QLineF(20, 7.8, 25, 7.8) << QLineF(25.5, 7.3, 40, 7.3)),
+           QVector<QLineF>() << QLineF(10, 7.1, 25, 7.1) << QLineF(25.5, 7.3, 40, 7.3));
+  // alternating plus and minus lines of consecutive points, compared with the two previous lines:
+  QCOMPARE(errorBars->merged(QVector<QLineF>() << QLineF(5.1, 50, 5.1, 40) << QLineF(5.1, 70, 5.1, 60) << QLineF(5.3, 48, 5.3, 35) << QLineF(5.3, 65, 5.3, 75)),
+           QVector<QLineF>() << QLineF(5.1, 35, 5.1, 50) << QLineF(5.1, 60, 5.1, 75));
+}
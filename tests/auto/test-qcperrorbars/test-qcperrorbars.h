@@ -0,0 +1,15 @@
+#include <QtTest/QtTest>
+#include "../../../qcustomplot.h"
+
+class TestQCPErrorBars : public QObject
+{
+  Q_OBJECT
+private slots:
+  void init();
+  void cleanup();
+  
+  void mergeLineSpans();
+  
+private:
+  QCustomPlot *mPlot;
+};
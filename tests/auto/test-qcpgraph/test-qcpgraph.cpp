@@ -1,4 +1,5 @@
 #include "test-qcpgraph.h"
+#include "../probes.h"
 #include <QMainWindow>
 
 void TestQCPGraph::init()
@@ -200,4 +201,570 @@ void TestQCPGraph::channelFill()
   mPlot->replot();
 }
 
+void TestQCPGraph::compactGraph()
+{
+  QCPCompactGraph *graph = new QCPCompactGraph(mPlot->xAxis, mPlot->yAxis, QCPCompactGraph::vsInt16);
+  QCOMPARE(mPlot->graphCount(), 2);
+  QCOMPARE(graph->dataCount(), 0);
+  
+  // raw samples are interpreted with the value scaling, minimum integer marks a gap:
+  graph->setValueScaling(0.5, -1.0);
+  QVector<double> x;
+  QVector<qint16> raw;
+  x << 2 << 0 << 1 << 3;
+  raw << 6 << 2 << std::numeric_limits<qint16>::min() << 10;
+  graph->setRawData(x, raw);
+  QCOMPARE(graph->dataCount(), 4);
+  QCOMPARE(graph->dataMainKey(0), 0.0);
+  QCOMPARE(graph->dataMainKey(3), 3.0);
+  QCOMPARE(graph->value(0), 0.0);
+  QVERIFY(qIsNaN(graph->value(1)));
+  QCOMPARE(graph->value(2), 2.0);
+  QCOMPARE(graph->value(3), 4.0);
+  
+  bool found = false;
+  QCPRange valueRange = graph->getValueRange(found);
+  QVERIFY(found);
+  QCOMPARE(valueRange.lower, 0.0);
+  QCOMPARE(valueRange.upper, 4.0);
+  QCPRange keyRange = graph->getKeyRange(found);
+  QVERIFY(found);
+  QCOMPARE(keyRange.lower, 0.0);
+  QCOMPARE(keyRange.upper, 3.0);
+  QCOMPARE(graph->findBegin(1.5), 1);
+  QCOMPARE(graph->findEnd(1.5), 3);
+  
+  // plot values are encoded, out of range values clamped:
+  graph->addData(QVector<double>() << 5 << 4, QVector<double>() << 1e9 << 1.0);
+  QCOMPARE(graph->dataCount(), 6);
+  QCOMPARE(graph->dataMainKey(4), 4.0);
+  QCOMPARE(graph->value(4), 1.0);
+  QCOMPARE(graph->value(5), std::numeric_limits<qint16>::max()*0.5-1.0);
+  
+  // conversion between storage types keeps values:
+  graph->setValueStorage(QCPCompactGraph::vsFloat);
+  QCOMPARE(graph->value(0), 0.0);
+  QVERIFY(qIsNaN(graph->value(1)));
+  QCOMPARE(graph->value(4), 1.0);
+  
+  // dense data exercises adaptive sampling on the compact column:
+  QVector<double> denseKeys(100000);
+  QVector<float> denseValues(100000);
+  for (int i=0; i<denseKeys.size(); ++i)
+  {
+    denseKeys[i] = i;
+    denseValues[i] = qSin(i/1000.0);
+  }
+  graph->setData(denseKeys, denseValues, true);
+  QCOMPARE(graph->dataCount(), 100000);
+  graph->setBrush(Qt::black);
+  graph->setScatterStyle(QCPScatterStyle::ssDisc);
+  mGraph->setChannelFillGraph(graph);
+  mGraph->setData(QVector<double>() << 0 << 100000, QVector<double>() << -1 << 1);
+  mGraph->setBrush(Qt::black);
+  mPlot->rescaleAxes();
+  mPlot->replot();
+  
+  // the tracer reads the data via the index based interface:
+  QCPItemTracer *tracer = new QCPItemTracer(mPlot);
+  tracer->setGraph(graph);
+  tracer->setGraphKey(2000);
+  tracer->updatePosition();
+  QCOMPARE(tracer->position->value(), (double)denseValues.at(2000));
+  mPlot->removeItem(tracer);
+  
+  // data passed through a QCPGraph pointer is stored in the compact columns, out of order points are merged into place:
+  QCPGraph *asGraph = mPlot->graph(1);
+  QCOMPARE(asGraph, static_cast<QCPGraph*>(graph));
+  asGraph->addData(100000, 5);
+  QCOMPARE(graph->dataCount(), 100001);
+  QCOMPARE(graph->value(100000), 5.0);
+  asGraph->addData(QVector<double>() << 0.5 << 99999.5, QVector<double>() << 2 << 3);
+  QCOMPARE(graph->dataCount(), 100003);
+  QCOMPARE(graph->dataMainKey(1), 0.5);
+  QCOMPARE(graph->value(1), 2.0);
+  QCOMPARE(graph->dataMainKey(100001), 99999.5);
+  QCOMPARE(graph->value(100001), 3.0);
+  QCOMPARE(graph->dataMainKey(100002), 100000.0);
+  asGraph->addData(-1, 7);
+  QCOMPARE(graph->dataCount(), 100004);
+  QCOMPARE(graph->dataMainKey(0), -1.0);
+  QCOMPARE(graph->value(0), 7.0);
+  QCOMPARE(graph->dataMainKey(1), 0.0);
+  
+  // the container returned by data() is kept up to date while held, changes to it are written back:
+  {
+    QSharedPointer<QCPGraphDataContainer> view = asGraph->data();
+    QCOMPARE(view->size(), 100004);
+    graph->addData(200000, 1);
+    QCOMPARE(view->size(), 100005);
+    QCOMPARE((view->constEnd()-1)->value, 1.0);
+    view->add(QCPGraphData(300000, 4));
+    QCOMPARE(graph->dataCount(), 100006);
+    QCOMPARE(graph->dataMainKey(100005), 300000.0);
+    QCOMPARE(graph->value(100005), 4.0);
+  }
+  
+  // setting a container takes over its data, later changes to it are written back as well:
+  QSharedPointer<QCPGraphDataContainer> container(new QCPGraphDataContainer);
+  container->add(QCPGraphData(1, 2));
+  container->add(QCPGraphData(3, 4));
+  asGraph->setData(container);
+  QCOMPARE(graph->dataCount(), 2);
+  QCOMPARE(graph->value(1), 4.0);
+  container->add(QCPGraphData(5, 6));
+  QCOMPARE(graph->dataCount(), 3);
+  container.clear();
+  QCOMPARE(graph->dataCount(), 3);
+  QCOMPARE(graph->value(2), 6.0);
+  mPlot->replot();
+  
+  mPlot->removeGraph(graph);
+  QCOMPARE(mPlot->graphCount(), 1);
+}
+
+void TestQCPGraph::lodGraph()
+{
+  const QString fileName = QDir::temp().filePath(QLatin1String("qcp-test-lodgraph.qcpl"));
+  QVector<double> keys(100000), values(100000);
+  for (int i=0; i<keys.size(); ++i)
+  {
+    keys[i] = i;
+    values[i] = i == 500 ? qQNaN() : qSin(i/1000.0)*(i+1);
+  }
+  
+  // data is written in blocks, keys must be ascending:
+  QCPLodFileWriter writer(64, 4);
+  QVERIFY(writer.open(fileName));
+  QVERIFY(writer.append(keys.mid(0, 30000), values.mid(0, 30000)));
+  QVERIFY(!writer.append(QVector<double>() << 0, QVector<double>() << 0));
+  QVERIFY(writer.append(keys.mid(30000), values.mid(30000)));
+  QCOMPARE(writer.count(), (qint64)100000);
+  QVERIFY(writer.close());
+  
+  LodGraphProbe *graph = new LodGraphProbe(mPlot->xAxis, mPlot->yAxis);
+  QCOMPARE(mPlot->graphCount(), 2);
+  QVERIFY(graph->openFile(fileName));
+  QVERIFY(graph->levelCount() > 1);
+  QCOMPARE(graph->dataCount(), 100000);
+  QCOMPARE(graph->dataMainKey(12345), 12345.0);
+  QCOMPARE(graph->value(12345), values.at(12345));
+  QVERIFY(qIsNaN(graph->value(500)));
+  QCOMPARE(graph->findBegin(1000.5), 1000);
+  QCOMPARE(graph->findEnd(1000.5), 1002);
+  
+  // value range from pyramid must match a full scan, also for arbitrary key ranges:
+  QList<QCPRange> keyRanges;
+  keyRanges << QCPRange() << QCPRange(10, 20) << QCPRange(63, 130) << QCPRange(777, 98765);
+  foreach (const QCPRange &keyRange, keyRanges)
+  {
+    bool found = false;
+    const QCPRange valueRange = graph->getValueRange(found, QCP::sdBoth, keyRange);
+    QVERIFY(found);
+    QCPRange expected(std::numeric_limits<double>::max(), -std::numeric_limits<double>::max());
+    for (int i=0; i<values.size(); ++i)
+    {
+      if (qIsNaN(values.at(i)) || (keyRange != QCPRange() && !keyRange.contains(keys.at(i))))
+        continue;
+      expected.lower = qMin(expected.lower, values.at(i));
+      expected.upper = qMax(expected.upper, values.at(i));
+    }
+    QCOMPARE(valueRange.lower, expected.lower);
+    QCOMPARE(valueRange.upper, expected.upper);
+  }
+  
+  // drawing at different zoom levels uses pyramid and raw data:
+  graph->setScatterStyle(QCPScatterStyle::ssDisc);
+  mPlot->rescaleAxes();
+  mPlot->replot();
+  mPlot->xAxis->setRange(1000, 1100);
+  mPlot->replot();
+  
+  // between one and bucket size points per pixel, the raw data is reduced by adaptive sampling:
+  mPlot->setGeometry(0, 0, 400, 300);
+  mPlot->xAxis->setRange(0, 8000);
+  mPlot->replot();
+  const int pixelWidth = mPlot->axisRect()->width();
+  QVERIFY(8000/pixelWidth > 2 && 8000/pixelWidth < 64);
+  QVector<QPointF> lines;
+  graph->lines(&lines);
+  QVERIFY(lines.size() > pixelWidth);
+  QVERIFY(lines.size() <= 4*pixelWidth+8);
+  graph->setAdaptiveSampling(false);
+  graph->lines(&lines);
+  QVERIFY(lines.size() >= 8000);
+  
+  graph->closeFile();
+  QCOMPARE(graph->dataCount(), 0);
+  mPlot->removeGraph(graph);
+  QFile::remove(fileName);
+}
+
+void TestQCPGraph::asyncGraph()
+{
+  const QString fileName = QDir::temp().filePath(QLatin1String("qcp-test-asyncgraph.bin"));
+  QVector<double> keys(100000), values(100000);
+  for (int i=0; i<keys.size(); ++i)
+  {
+    keys[i] = i;
+    values[i] = qSin(i/100.0);
+  }
+  QVERIFY(QCPBinaryFileDataProvider::writeFile(fileName, keys, values));
+  
+  mPlot->setGeometry(0, 0, 400, 300);
+  QCPBinaryFileDataProvider *provider = new QCPBinaryFileDataProvider(fileName, mPlot);
+  QCPAsyncGraph *graph = new QCPAsyncGraph(mPlot->xAxis, mPlot->yAxis);
+  graph->setDataProvider(provider);
+  graph->setSelectable(QCP::stDataRange);
+  graph->rescaleKeyAxis();
+  QCOMPARE(mPlot->xAxis->range().lower, 0.0);
+  QCOMPARE(mPlot->xAxis->range().upper, 99999.0);
+  mPlot->replot();
+  QTRY_VERIFY(!provider->isLoading());
+  mPlot->replot();
+  QVERIFY(!graph->data()->isEmpty());
+  
+  // container stays the same as long as no new data arrives, so selection indices are stable:
+  const QSharedPointer<QCPGraphDataContainer> oldData = graph->data();
+  const int begin = int(oldData->findBegin(40000, false)-oldData->constBegin());
+  const int end = int(oldData->findEnd(41000, false)-oldData->constBegin());
+  QVERIFY(begin < end);
+  graph->setSelection(QCPDataSelection(QCPDataRange(begin, end)));
+  const double lowerKey = oldData->at(begin)->key;
+  const double upperKey = oldData->at(end-1)->key;
+  mPlot->replot();
+  QCOMPARE(graph->data(), oldData);
+  QCOMPARE(graph->selection(), QCPDataSelection(QCPDataRange(begin, end)));
+  
+  // zooming in loads finer data, the selection must still cover the same keys:
+  mPlot->xAxis->setRange(39000, 42000);
+  mPlot->replot();
+  QTRY_VERIFY(!provider->isLoading());
+  mPlot->replot();
+  const QSharedPointer<QCPGraphDataContainer> newData = graph->data();
+  QVERIFY(newData != oldData);
+  QVERIFY(newData->size() > 0);
+  QCOMPARE(graph->selection().dataRangeCount(), 1);
+  const QCPDataRange selected = graph->selection().dataRange(0);
+  QVERIFY(selected.end() <= newData->size());
+  QVERIFY(selected.size() > end-begin); // finer data, more points in the same key span
+  QVERIFY(newData->at(selected.begin())->key >= lowerKey);
+  QVERIFY(newData->at(selected.end()-1)->key <= upperKey);
+  if (selected.begin() > 0)
+    QVERIFY((newData->at(selected.begin()-1))->key < lowerKey);
+  if (selected.end() < newData->size())
+    QVERIFY(newData->at(selected.end())->key > upperKey);
+  
+  // destroying a provider while it is loading waits for the fetch:
+  QCPBinaryFileDataProvider *busyProvider = new QCPBinaryFileDataProvider(fileName);
+  busyProvider->requestRange(QCPRange(0, 99999), 1000);
+  QVERIFY(busyProvider->isLoading());
+  delete busyProvider;
+  
+  mPlot->removeGraph(graph);
+  delete provider;
+  QFile::remove(fileName);
+}
+
+void TestQCPGraph::denseFill()
+{
+  // only the fill is drawn, so the raster (span) and vectorized (polygon) renderings can be compared:
+  QList<QCPAxis*> axes = mPlot->axisRect()->axes();
+  foreach (QCPAxis *axis, axes)
+  {
+    axis->setVisible(false);
+    axis->grid()->setVisible(false);
+  }
+  QVector<double> keys(20000), values(20000), otherValues(20000);
+  for (int i=0; i<keys.size(); ++i)
+  {
+    keys[i] = i;
+    values[i] = qSin(i/2000.0)+0.3*qSin(i*0.7);
+    otherValues[i] = -2+0.2*qCos(i*1.3);
+  }
+  mGraph->setData(keys, values, true);
+  mGraph->setPen(Qt::NoPen);
+  mGraph->setBrush(QColor(0, 0, 255));
+  mGraph->setAntialiasedFill(false);
+  mPlot->xAxis->setRange(-100, 20100);
+  mPlot->yAxis->setRange(-3, 2);
+  QCPGraph *otherGraph = mPlot->addGraph();
+  otherGraph->setData(keys, otherValues, true);
+  otherGraph->setPen(Qt::NoPen);
+  
+  const int width = 400, height = 300;
+  QImage baseFillSpans;
+  for (int pass=0; pass<2; ++pass)
+  {
+    mGraph->setChannelFillGraph(pass == 0 ? 0 : otherGraph);
+    const QImage spans = mPlot->toPixmap(width, height).toImage().convertToFormat(QImage::Format_RGB32);
+    if (pass == 0)
+      baseFillSpans = spans;
+    QImage polygon(width, height, QImage::Format_RGB32);
+    polygon.fill(Qt::white);
+    {
+      QCPPainter painter(&polygon);
+      painter.setMode(QCPPainter::pmVectorized); // forces the polygon path
+      mPlot->toPainter(&painter, width, height);
+    }
+    // the spans may differ from the polygon rasterization by at most one pixel at each edge per column:
+    int filled = 0, different = 0;
+    for (int y=0; y<height; ++y)
+    {
+      for (int x=0; x<width; ++x)
+      {
+        if (spans.pixel(x, y) != qRgb(255, 255, 255))
+          ++filled;
+        if (spans.pixel(x, y) != polygon.pixel(x, y))
+          ++different;
+      }
+    }
+    QVERIFY(filled > width*height/10);
+    QVERIFY2(different <= 2*width, qPrintable(QString(QLatin1String("pass %1: %2 pixels differ")).arg(pass).arg(different)));
+  }
+  
+  // antialiased fills blend the spans, so their edges have intermediate colors, and they cover no
+  // pixel that the aliased spans leave empty. Both the temporary image (pixmap target) and the
+  // direct path (image target) are checked:
+  mGraph->setChannelFillGraph(0);
+  mGraph->setAntialiasedFill(true);
+  for (int pass=0; pass<2; ++pass)
+  {
+    QImage antialiased;
+    if (pass == 0)
+    {
+      antialiased = mPlot->toPixmap(width, height).toImage().convertToFormat(QImage::Format_RGB32);
+    } else
+    {
+      QImage image(width, height, QImage::Format_ARGB32_Premultiplied);
+      image.fill(Qt::white);
+      {
+        QCPPainter painter(&image);
+        mPlot->toPainter(&painter, width, height);
+      }
+      antialiased = image.convertToFormat(QImage::Format_RGB32);
+    }
+    int intermediate = 0, outside = 0;
+    for (int y=0; y<height; ++y)
+    {
+      for (int x=0; x<width; ++x)
+      {
+        const QRgb pixel = antialiased.pixel(x, y);
+        if (pixel != qRgb(255, 255, 255) && pixel != qRgb(0, 0, 255))
+          ++intermediate;
+        if (pixel != qRgb(255, 255, 255) && baseFillSpans.pixel(x, y) == qRgb(255, 255, 255))
+          ++outside;
+      }
+    }
+    QVERIFY(intermediate > 0);
+    QCOMPARE(outside, 0);
+  }
+}
+
+void TestQCPGraph::denseGaps()
+{
+  // every tenth data point is a gap, so there are many more gaps than pixel columns:
+  const int n = 100000;
+  QVector<double> keys(n), values(n);
+  for (int i=0; i<n; ++i)
+  {
+    keys[i] = i;
+    values[i] = i%10 == 5 ? qQNaN() : qSin(i/1000.0)+(i%7)*0.01;
+  }
+  GraphProbe *graph = new GraphProbe(mPlot->xAxis, mPlot->yAxis);
+  graph->setData(keys, values, true);
+  graph->data()->setGapIndexEnabled(true);
+  QCOMPARE(graph->data()->gapCount(), n/10);
+  mPlot->setGeometry(0, 0, 400, 300);
+  mPlot->xAxis->setRange(0, n);
+  mPlot->yAxis->setRange(-2, 2);
+  mPlot->replot();
+  const int pixelWidth = mPlot->axisRect()->width();
+  QVERIFY(n/10 > 16*pixelWidth);
+  
+  QVector<QPointF> lines;
+  graph->lines(&lines);
+  QVERIFY2(lines.size() <= 16*pixelWidth, qPrintable(QString::number(lines.size()))); // a few points per column, independent of the gap count
+  // gaps stay visible in every pixel column and the value envelope is preserved:
+  int nanCount = 0;
+  double minPixel = std::numeric_limits<double>::max(), maxPixel = -std::numeric_limits<double>::max();
+  for (int i=0; i<lines.size(); ++i)
+  {
+    if (qIsNaN(lines.at(i).y()))
+    {
+      ++nanCount;
+      continue;
+    }
+    minPixel = qMin(minPixel, lines.at(i).y());
+    maxPixel = qMax(maxPixel, lines.at(i).y());
+  }
+  QVERIFY(nanCount >= pixelWidth/2);
+  QVERIFY(qAbs(minPixel-mPlot->yAxis->coordToPixel(1.06)) < 2); // maximum value (pixel y axis points down)
+  QVERIFY(qAbs(maxPixel-mPlot->yAxis->coordToPixel(-1.0)) < 2);
+  
+  // without adaptive sampling, every gap is kept:
+  graph->setAdaptiveSampling(false);
+  graph->lines(&lines);
+  QVERIFY(lines.size() >= n);
+}
+
+/*
+  Draws the polyline \a lines (interrupted at NaN points) aliased into an image of size \a size.
+*/
+static QImage renderStepLines(const QVector<QPointF> &lines, const QSize &size)
+{
+  QImage image(size, QImage::Format_ARGB32_Premultiplied);
+  image.fill(0);
+  QPainter painter(&image);
+  painter.setPen(QPen(Qt::black, 1));
+  for (int i=1; i<lines.size(); ++i)
+  {
+    const QPointF &a = lines.at(i-1), &b = lines.at(i);
+    if (qIsNaN(a.x()) || qIsNaN(a.y()) || qIsNaN(b.x()) || qIsNaN(b.y()))
+      continue;
+    if (a == b)
+      painter.drawPoint(a);
+    else
+      painter.drawLine(a, b);
+  }
+  return image;
+}
+
+/*
+  Returns the number of set pixels in \a a that have no set pixel in their 3x3 neighbourhood in
+  \a b. Aliased lines of the same shape may differ by one pixel where a short diagonal connects
+  the collapsed points of a pixel column.
+*/
+static int unmatchedPixels(const QImage &a, const QImage &b)
+{
+  int unmatched = 0;
+  for (int y=0; y<a.height(); ++y)
+  {
+    for (int x=0; x<a.width(); ++x)
+    {
+      if (qAlpha(a.pixel(x, y)) == 0)
+        continue;
+      bool found = false;
+      for (int dy=-1; dy<=1 && !found; ++dy)
+      {
+        for (int dx=-1; dx<=1 && !found; ++dx)
+        {
+          const int bx = x+dx, by = y+dy;
+          if (bx >= 0 && by >= 0 && bx < b.width() && by < b.height() && qAlpha(b.pixel(bx, by)) != 0)
+            found = true;
+        }
+      }
+      if (!found)
+        ++unmatched;
+    }
+  }
+  return unmatched;
+}
+
+void TestQCPGraph::mergedStepLines()
+{
+  // dense noisy steps, a long constant stretch, sparse steps and a gap:
+  QVector<QCPGraphData> data;
+  for (int i=0; i<20000; ++i)
+    data.append(QCPGraphData(i*0.01, qSin(i/500.0)+((i*7919)%13)*0.05));
+  for (int i=0; i<50; ++i)
+    data.append(QCPGraphData(200+i, 0.5));
+  for (int i=0; i<20; ++i)
+    data.append(QCPGraphData(250+i*10, i%3-1));
+  data.append(QCPGraphData(455, qQNaN()));
+  for (int i=0; i<5000; ++i)
+    data.append(QCPGraphData(460+i*0.01, qCos(i/100.0)));
+  
+  GraphProbe *graph = new GraphProbe(mPlot->xAxis, mPlot->yAxis);
+  mPlot->setGeometry(0, 0, 500, 300);
+  mPlot->xAxis->setRange(-5, 515);
+  mPlot->yAxis->setRange(-2, 2);
+  mPlot->replot();
+  const QSize size = mPlot->viewport().size();
+  
+  QList<QCPGraph::LineStyle> styles = QList<QCPGraph::LineStyle>() << QCPGraph::lsStepLeft << QCPGraph::lsStepRight << QCPGraph::lsStepCenter;
+  for (int swapAxes=0; swapAxes<2; ++swapAxes)
+  {
+    if (swapAxes)
+    {
+      graph->setKeyAxis(mPlot->yAxis);
+      graph->setValueAxis(mPlot->xAxis);
+      mPlot->yAxis->setRange(-5, 515);
+      mPlot->xAxis->setRange(-2, 2);
+      mPlot->replot();
+    }
+    foreach (QCPGraph::LineStyle style, styles)
+    {
+      graph->setLineStyle(style);
+      const QVector<QPointF> unmerged = graph->unmergedLines(data);
+      const QVector<QPointF> merged = graph->mergedLines(data);
+      QVERIFY(merged.size() < unmerged.size()/4);
+      QCOMPARE(merged.first(), unmerged.first());
+      QCOMPARE(merged.last(), unmerged.last());
+      // the gap is preserved:
+      int unmergedNans = 0, mergedNans = 0;
+      for (int i=0; i<unmerged.size(); ++i)
+        if (qIsNaN(unmerged.at(i).x()) || qIsNaN(unmerged.at(i).y())) ++unmergedNans;
+      for (int i=0; i<merged.size(); ++i)
+        if (qIsNaN(merged.at(i).x()) || qIsNaN(merged.at(i).y())) ++mergedNans;
+      QVERIFY(unmergedNans > 0);
+      QCOMPARE(mergedNans, unmergedNans);
+      // the drawn shape is the same:
+      const QImage unmergedImage = renderStepLines(unmerged, size);
+      const QImage mergedImage = renderStepLines(merged, size);
+      const int unmatchedMerged = unmatchedPixels(mergedImage, unmergedImage);
+      const int unmatchedUnmerged = unmatchedPixels(unmergedImage, mergedImage);
+      QVERIFY2(unmatchedMerged == 0, qPrintable(QString(QLatin1String("style %1, swapped %2: %3 extra pixels")).arg(style).arg(swapAxes).arg(unmatchedMerged)));
+      QVERIFY2(unmatchedUnmerged == 0, qPrintable(QString(QLatin1String("style %1, swapped %2: %3 missing pixels")).arg(style).arg(swapAxes).arg(unmatchedUnmerged)));
+    }
+  }
+}
 
+void TestQCPGraph::logKeysCache()
+{
+  GraphProbe *graph = new GraphProbe(mPlot->xAxis, mPlot->yAxis);
+  QVector<double> keys, values;
+  for (int i=1; i<=1000; ++i)
+  {
+    keys << i;
+    values << i;
+  }
+  graph->setData(keys, values, true);
+  QVERIFY(graph->logKeysValid());
+  
+  // streaming into a rolling buffer:
+  for (int i=1001; i<=5000; ++i)
+  {
+    graph->addData(i, i);
+    if (i%100 == 0)
+    {
+      graph->data()->removeBefore(i-1000);
+      QVERIFY(graph->logKeysValid());
+    }
+  }
+  QCOMPARE(graph->data()->size(), 1001);
+  
+  // edits:
+  graph->addData(2.5, 0);
+  QVERIFY(graph->logKeysValid());
+  graph->data()->removeAfter(4000);
+  QVERIFY(graph->logKeysValid());
+  for (QCPGraphDataContainer::iterator it=graph->data()->begin(); it!=graph->data()->end(); ++it)
+    it->key *= 2;
+  graph->data()->markModified();
+  QVERIFY(graph->logKeysValid());
+  
+  // replaced and reassigned containers:
+  QSharedPointer<QCPGraphDataContainer> other(new QCPGraphDataContainer);
+  for (int i=0; i<10; ++i)
+    other->add(QCPGraphData(i+0.5, i));
+  graph->setData(other);
+  QVERIFY(graph->logKeysValid());
+  QCPGraphDataContainer copy;
+  for (int i=0; i<10; ++i)
+    copy.add(QCPGraphData(i+100, i));
+  *graph->data() = copy;
+  QVERIFY(graph->logKeysValid());
+  graph->data()->clear();
+  QVERIFY(graph->logKeysValid());
+}
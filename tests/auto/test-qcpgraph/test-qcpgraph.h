@@ -12,6 +12,13 @@ private slots:
   void dataManipulation();
   void dataSharing();
   void channelFill();
+  void denseFill();
+  void denseGaps();
+  void mergedStepLines();
+  void logKeysCache();
+  void compactGraph();
+  void lodGraph();
+  void asyncGraph();
   
 private:
   QCustomPlot *mPlot;
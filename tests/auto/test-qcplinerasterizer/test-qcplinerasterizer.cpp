@@ -0,0 +1,119 @@
+#include "test-qcplinerasterizer.h"
+
+void TestQCPLineRasterizer::validity()
+{
+  QImage image(100, 100, QImage::Format_ARGB32_Premultiplied);
+  image.fill(0);
+  {
+    QCPPainter painter(&image);
+    painter.setPen(QPen(Qt::black, 1));
+    QVERIFY(QCPLineRasterizer(&painter).isValid());
+    painter.setPen(QPen(Qt::black, 4)); // too wide
+    QVERIFY(!QCPLineRasterizer(&painter).isValid());
+    const QPointF points[] = {QPointF(10, 10), QPointF(90, 90)};
+    QVERIFY(!QCPLineRasterizer::drawPolyline(&painter, points, 2));
+    painter.setPen(QPen(Qt::black, 1, Qt::DashLine)); // not solid
+    QVERIFY(!QCPLineRasterizer(&painter).isValid());
+    painter.setPen(QPen(Qt::black, 1));
+    painter.setMode(QCPPainter::pmVectorized);
+    QVERIFY(!QCPLineRasterizer(&painter).isValid());
+  }
+  QImage rgb(100, 100, QImage::Format_RGB32); // other formats aren't supported
+  QCPPainter painter(&rgb);
+  QVERIFY(!QCPLineRasterizer(&painter).isValid());
+}
+
+void TestQCPLineRasterizer::steepLine()
+{
+  compareImages(rasterizerImage(QPointF(40.3, 5.5), QPointF(52.8, 190.2), 1), painterImage(QPointF(40.3, 5.5), QPointF(52.8, 190.2), 1));
+  compareImages(rasterizerImage(QPointF(100.5, 190), QPointF(100.5, 10), 1), painterImage(QPointF(100.5, 190), QPointF(100.5, 10), 1)); // vertical
+}
+
+void TestQCPLineRasterizer::flatLine()
+{
+  compareImages(rasterizerImage(QPointF(5.2, 60.7), QPointF(195.6, 71.1), 1), painterImage(QPointF(5.2, 60.7), QPointF(195.6, 71.1), 1));
+  compareImages(rasterizerImage(QPointF(10, 100.5), QPointF(190, 100.5), 1), painterImage(QPointF(10, 100.5), QPointF(190, 100.5), 1)); // horizontal
+}
+
+void TestQCPLineRasterizer::diagonalLine()
+{
+  compareImages(rasterizerImage(QPointF(10.5, 189.5), QPointF(189.5, 10.5), 1.5), painterImage(QPointF(10.5, 189.5), QPointF(189.5, 10.5), 1.5));
+}
+
+void TestQCPLineRasterizer::offScreenLine()
+{
+  // end points far outside of the image (beyond the int range) are clipped without overflow:
+  compareImages(rasterizerImage(QPointF(-1e12, 80.5), QPointF(1e12, 80.5), 1), painterImage(QPointF(-1000, 80.5), QPointF(1000, 80.5), 1));
+  compareImages(rasterizerImage(QPointF(60.5, -1e15), QPointF(60.5, 1e15), 1), painterImage(QPointF(60.5, -1000), QPointF(60.5, 1000), 1));
+  const double slope = 0.25;
+  compareImages(rasterizerImage(QPointF(-1e10, 50-1e10*slope), QPointF(1e10, 50+1e10*slope), 1), painterImage(QPointF(-1000, 50-1000*slope), QPointF(1000, 50+1000*slope), 1));
+  // lines that miss the image entirely draw nothing:
+  const QImage empty = rasterizerImage(QPointF(-1e12, -5e11), QPointF(1e12, -4e11), 1);
+  QImage blank(empty.size(), empty.format());
+  blank.fill(0);
+  QCOMPARE(empty, blank);
+  QCOMPARE(rasterizerImage(QPointF(-1e300, 300), QPointF(1e300, 400), 1), blank);
+}
+
+void TestQCPLineRasterizer::widePen()
+{
+  compareImages(rasterizerImage(QPointF(20, 30), QPointF(180, 150), 3), painterImage(QPointF(20, 30), QPointF(180, 150), 3));
+  compareImages(rasterizerImage(QPointF(150, 10), QPointF(120, 190), 2.5), painterImage(QPointF(150, 10), QPointF(120, 190), 2.5));
+}
+
+QImage TestQCPLineRasterizer::rasterizerImage(const QPointF &p1, const QPointF &p2, double width) const
+{
+  QImage image(200, 200, QImage::Format_ARGB32_Premultiplied);
+  image.fill(0);
+  QCPPainter painter(&image);
+  painter.setPen(QPen(Qt::black, width));
+  QCPLineRasterizer rasterizer(&painter);
+  if (!rasterizer.isValid())
+    qWarning() << Q_FUNC_INFO << "rasterizer not valid";
+  rasterizer.drawLine(p1, p2);
+  return image;
+}
+
+QImage TestQCPLineRasterizer::painterImage(const QPointF &p1, const QPointF &p2, double width) const
+{
+  QImage image(200, 200, QImage::Format_ARGB32_Premultiplied);
+  image.fill(0);
+  QPainter painter(&image);
+  painter.setRenderHint(QPainter::Antialiasing);
+  QPen pen(Qt::black, width);
+  pen.setCapStyle(Qt::FlatCap);
+  painter.setPen(pen);
+  painter.drawLine(p1, p2);
+  return image;
+}
+
+/*
+  The antialiasing of the rasterizer and QPainter differs slightly in detail, so the images are
+  compared by total coverage, its centroid, and the number of pixels that differ strongly.
+*/
+void TestQCPLineRasterizer::compareImages(const QImage &rasterizer, const QImage &painter) const
+{
+  double sumA = 0, sumB = 0, xA = 0, yA = 0, xB = 0, yB = 0;
+  int strongDifferences = 0;
+  for (int y=0; y<rasterizer.height(); ++y)
+  {
+    for (int x=0; x<rasterizer.width(); ++x)
+    {
+      const int a = qAlpha(rasterizer.pixel(x, y));
+      const int b = qAlpha(painter.pixel(x, y));
+      sumA += a;
+      sumB += b;
+      xA += a*x;
+      yA += a*y;
+      xB += b*x;
+      yB += b*y;
+      if (qAbs(a-b) > 128)
+        ++strongDifferences;
+    }
+  }
+  QVERIFY(sumB > 0);
+  QVERIFY2(qAbs(sumA-sumB) <= 0.05*sumB, qPrintable(QString(QLatin1String("coverage %1 vs %2")).arg(sumA).arg(sumB)));
+  QVERIFY(qAbs(xA/sumA-xB/sumB) < 0.5);
+  QVERIFY(qAbs(yA/sumA-yB/sumB) < 0.5);
+  QVERIFY2(strongDifferences <= 0.05*sumB/255.0+2, qPrintable(QString(QLatin1String("%1 pixels differ strongly")).arg(strongDifferences)));
+}
@@ -0,0 +1,19 @@
+#include <QtTest/QtTest>
+#include "../../../qcustomplot.h"
+
+class TestQCPLineRasterizer : public QObject
+{
+  Q_OBJECT
+private slots:
+  void validity();
+  void steepLine();
+  void flatLine();
+  void diagonalLine();
+  void offScreenLine();
+  void widePen();
+  
+private:
+  QImage rasterizerImage(const QPointF &p1, const QPointF &p2, double width) const;
+  QImage painterImage(const QPointF &p1, const QPointF &p2, double width) const;
+  void compareImages(const QImage &rasterizer, const QImage &painter) const;
+};
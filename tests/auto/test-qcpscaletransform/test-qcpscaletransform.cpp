@@ -0,0 +1,269 @@
+#include "test-qcpscaletransform.h"
+#include "../probes.h"
+
+void TestQCPScaleTransform::init()
+{
+  mPlot = new QCustomPlot(0);
+  mPlot->setGeometry(0, 0, 500, 400);
+  mPlot->replot(); // set up the axis rect geometry
+}
+
+void TestQCPScaleTransform::cleanup()
+{
+  delete mPlot;
+}
+
+void TestQCPScaleTransform::roundTrip()
+{
+  QVector<double> coords;
+  coords << -1e6 << -1234.5 << -10 << -1 << -0.01 << 0 << 0.01 << 0.5 << 1 << 7 << 10 << 999 << 1e6;
+  
+  QList<QSharedPointer<QCPScaleTransform> > transforms;
+  transforms << QSharedPointer<QCPScaleTransform>(new QCPScaleTransform)
+             << QSharedPointer<QCPScaleTransform>(new QCPScaleTransformSymLog(1))
+             << QSharedPointer<QCPScaleTransform>(new QCPScaleTransformSymLog(10))
+             << QSharedPointer<QCPScaleTransform>(new QCPScaleTransformSqrt);
+  foreach (QSharedPointer<QCPScaleTransform> transform, transforms)
+  {
+    for (int i=0; i<coords.size(); ++i)
+    {
+      const double coord = coords.at(i);
+      const double result = transform->inverseTransform(transform->transform(coord));
+      QVERIFY2(qAbs(result-coord) <= 1e-9*qMax(1.0, qAbs(coord)), qPrintable(QString::number(coord)));
+      if (i > 0) // strictly increasing
+        QVERIFY(transform->transform(coord) > transform->transform(coords.at(i-1)));
+    }
+  }
+  
+  // probability transform, accurate to the precision of the normal distribution approximation:
+  QCPScaleTransformProbability probability;
+  QList<double> probabilities = QList<double>() << 1e-6 << 0.001 << 0.02 << 0.1 << 0.5 << 0.8 << 0.99 << 1-1e-6;
+  foreach (double p, probabilities)
+    QVERIFY2(qAbs(probability.inverseTransform(probability.transform(p))-p) <= 1e-6*qMin(p, 1-p), qPrintable(QString::number(p)));
+  QCOMPARE(probability.transform(0.5), 0.0);
+  QVERIFY(qAbs(probability.transform(0.975)-1.959964) < 1e-5);
+  QVERIFY(qIsNaN(probability.transform(qQNaN())));
+  
+  // broken transform, outside of the gaps:
+  QCPScaleTransformBroken broken;
+  broken.setGaps(QVector<QCPRange>() << QCPRange(10, 20) << QCPRange(30, 35));
+  QList<double> outside = QList<double>() << -5 << 0 << 9.5 << 20 << 25 << 35 << 100;
+  foreach (double coord, outside)
+    QCOMPARE(broken.inverseTransform(broken.transform(coord)), coord);
+}
+
+void TestQCPScaleTransform::bulkTransforms()
+{
+  QCPScaleTransformBroken *broken = new QCPScaleTransformBroken;
+  broken->setGaps(QVector<QCPRange>() << QCPRange(10, 20) << QCPRange(30, 35));
+  QList<QSharedPointer<QCPScaleTransform> > transforms;
+  transforms << QSharedPointer<QCPScaleTransform>(new QCPScaleTransformSymLog(2))
+             << QSharedPointer<QCPScaleTransform>(new QCPScaleTransformSqrt)
+             << QSharedPointer<QCPScaleTransform>(broken);
+  
+  // ascending, then descending and NaN coordinates (the broken transform tracks gaps incrementally for ascending input):
+  QVector<double> coords;
+  for (int i=0; i<200; ++i)
+    coords << i*0.25-5;
+  for (int i=0; i<50; ++i)
+    coords << 40-i*0.9;
+  coords << qQNaN() << 12 << 3;
+  foreach (QSharedPointer<QCPScaleTransform> transform, transforms)
+  {
+    QVector<double> values(coords.size()), back(coords.size());
+    transform->transformMany(coords.constData(), values.data(), coords.size());
+    for (int i=0; i<coords.size(); ++i)
+    {
+      const double expected = transform->transform(coords.at(i));
+      QVERIFY(values.at(i) == expected || (qIsNaN(values.at(i)) && qIsNaN(expected)));
+    }
+    transform->inverseTransformMany(values.constData(), back.data(), values.size());
+    for (int i=0; i<values.size(); ++i)
+    {
+      const double expected = transform->inverseTransform(values.at(i));
+      QVERIFY(back.at(i) == expected || (qIsNaN(back.at(i)) && qIsNaN(expected)));
+    }
+    // in-place operation:
+    QVector<double> inPlace = coords;
+    transform->transformMany(inPlace.constData(), inPlace.data(), inPlace.size());
+    for (int i=0; i<coords.size(); ++i)
+      QVERIFY(inPlace.at(i) == values.at(i) || (qIsNaN(inPlace.at(i)) && qIsNaN(values.at(i))));
+  }
+}
+
+void TestQCPScaleTransform::axisRoundTrip()
+{
+  QCPAxis *axis = mPlot->xAxis;
+  axis->setScaleType(QCPAxis::stCustom);
+  axis->setScaleTransform(QSharedPointer<QCPScaleTransform>(new QCPScaleTransformSymLog(1)));
+  axis->setRange(-100, 1000);
+  for (int reversed=0; reversed<2; ++reversed)
+  {
+    axis->setRangeReversed(reversed);
+    QVERIFY(qAbs(axis->coordToPixel(reversed ? 1000 : -100)-mPlot->axisRect()->left()) < 1e-9);
+    QVERIFY(qAbs(axis->coordToPixel(reversed ? -100 : 1000)-mPlot->axisRect()->right()-1) < 1e-9);
+    QVector<double> pixels;
+    for (int p=-20; p<=mPlot->axisRect()->width()+20; p+=7)
+      pixels << mPlot->axisRect()->left()+p+0.3;
+    QVector<double> coords(pixels.size()), backPixels(pixels.size());
+    axis->pixelsToCoords(pixels.constData(), coords.data(), pixels.size());
+    axis->coordsToPixels(coords.constData(), backPixels.data(), coords.size());
+    for (int i=0; i<pixels.size(); ++i)
+    {
+      QVERIFY(qAbs(coords.at(i)-axis->pixelToCoord(pixels.at(i))) <= 1e-9*qMax(1.0, qAbs(coords.at(i))));
+      QVERIFY(qAbs(axis->coordToPixel(coords.at(i))-pixels.at(i)) < 1e-6);
+      QVERIFY(qAbs(backPixels.at(i)-pixels.at(i)) < 1e-6);
+    }
+  }
+  
+  // the vertical axis maps upwards:
+  QCPAxis *yAxis = mPlot->yAxis;
+  yAxis->setScaleType(QCPAxis::stCustom);
+  yAxis->setScaleTransform(QSharedPointer<QCPScaleTransform>(new QCPScaleTransformSqrt));
+  yAxis->setRange(0, 100);
+  QVERIFY(yAxis->coordToPixel(25) < yAxis->coordToPixel(0));
+  QVERIFY(qAbs(yAxis->coordToPixel(25)-(yAxis->coordToPixel(0)+yAxis->coordToPixel(100))/2.0) < 1e-9); // sqrt(25) is half of sqrt(100)
+  QVERIFY(qAbs(yAxis->pixelToCoord(yAxis->coordToPixel(64))-64) < 1e-9);
+}
+
+void TestQCPScaleTransform::brokenGaps()
+{
+  QSharedPointer<QCPScaleTransformBroken> broken(new QCPScaleTransformBroken);
+  broken->setGaps(QVector<QCPRange>() << QCPRange(35, 30) << QCPRange(10, 20) << QCPRange(15, 25)); // unordered, reversed and overlapping
+  QCOMPARE(broken->gaps().size(), 2);
+  QCOMPARE(broken->gaps().at(0), QCPRange(10, 25));
+  QCOMPARE(broken->gaps().at(1), QCPRange(30, 35));
+  QCOMPARE(broken->transform(5), 5.0);
+  QCOMPARE(broken->transform(10), 10.0);
+  QCOMPARE(broken->transform(17), 10.0); // inside a gap
+  QCOMPARE(broken->transform(25), 10.0);
+  QCOMPARE(broken->transform(27), 12.0);
+  QCOMPARE(broken->transform(40), 20.0);
+  QVERIFY(broken->isVisible(9.9));
+  QVERIFY(!broken->isVisible(10));
+  QVERIFY(!broken->isVisible(24.9));
+  QVERIFY(broken->isVisible(25));
+  
+  QCPAxis *axis = mPlot->xAxis;
+  axis->setScaleType(QCPAxis::stCustom);
+  axis->setScaleTransform(broken);
+  axis->setRange(0, 40);
+  // coordinates on both sides of a gap are displayed next to each other, the gaps remove 15 of the 40 units:
+  QCOMPARE(axis->coordToPixel(10), axis->coordToPixel(25));
+  QVERIFY(qAbs(axis->coordToPixel(40)-axis->coordToPixel(0)-mPlot->axisRect()->width()) < 1e-9);
+  QVERIFY(qAbs(axis->coordToPixel(27)-axis->coordToPixel(0)-12/20.0*mPlot->axisRect()->width()) < 1e-9);
+  QVERIFY(qAbs(axis->pixelToCoord(axis->coordToPixel(28))-28) < 1e-9);
+  
+  broken->clearGaps();
+  QCOMPARE(broken->transform(17), 17.0);
+}
+
+void TestQCPScaleTransform::rangeInsideGap()
+{
+  QSharedPointer<QCPScaleTransformBroken> broken(new QCPScaleTransformBroken);
+  broken->addGap(QCPRange(10, 20));
+  QCPAxis *axis = mPlot->xAxis;
+  axis->setScaleType(QCPAxis::stCustom);
+  axis->setScaleTransform(broken);
+  axis->setRange(12, 18); // transforms to an empty range
+  
+  // the axis falls back to a linear mapping instead of dividing by zero:
+  QVERIFY(qAbs(axis->coordToPixel(12)-mPlot->axisRect()->left()) < 1e-9);
+  QVERIFY(qAbs(axis->coordToPixel(15)-(mPlot->axisRect()->left()+mPlot->axisRect()->width()*0.5)) < 1e-9);
+  QVERIFY(qAbs(axis->pixelToCoord(axis->coordToPixel(13))-13) < 1e-9);
+  QVector<double> coords = QVector<double>() << 5 << 12 << 15 << 18 << 25;
+  QVector<double> pixels(coords.size());
+  axis->coordsToPixels(coords.constData(), pixels.data(), coords.size());
+  for (int i=0; i<coords.size(); ++i)
+  {
+    QVERIFY(qIsFinite(pixels.at(i)));
+    QVERIFY(qAbs(pixels.at(i)-axis->coordToPixel(coords.at(i))) < 1e-9);
+  }
+  axis->pixelsToCoords(pixels.constData(), coords.data(), pixels.size());
+  QVERIFY(qAbs(coords.at(2)-15) < 1e-9);
+  
+  // drawing with such a range works:
+  QCPGraph *graph = mPlot->addGraph();
+  graph->setData(QVector<double>() << 0 << 15 << 30, QVector<double>() << 1 << 2 << 3);
+  mPlot->replot();
+}
+
+void TestQCPScaleTransform::ticksInGaps()
+{
+  QSharedPointer<QCPScaleTransformBroken> broken(new QCPScaleTransformBroken);
+  broken->addGap(QCPRange(12, 20));
+  QSharedPointer<QCPAxisTickerFixed> ticker(new QCPAxisTickerFixed);
+  ticker->setTickStep(2);
+  ticker->setScaleStrategy(QCPAxisTickerFixed::ssNone);
+  QCPAxis *axis = mPlot->xAxis;
+  axis->setTicker(ticker);
+  axis->setScaleType(QCPAxis::stCustom);
+  axis->setScaleTransform(broken);
+  axis->setRange(0, 40);
+  mPlot->replot();
+  
+  const QVector<double> ticks = axis->tickVector();
+  QCOMPARE(axis->tickVectorLabels().size(), ticks.size());
+  QVERIFY(ticks.contains(10));
+  QVERIFY(ticks.contains(20)); // marks the break
+  for (int i=0; i<ticks.size(); ++i)
+  {
+    QVERIFY2(ticks.at(i) < 12 || ticks.at(i) >= 20, qPrintable(QString::number(ticks.at(i))));
+    if (i > 0) // no two ticks at the same pixel
+      QVERIFY(axis->coordToPixel(ticks.at(i)) > axis->coordToPixel(ticks.at(i-1)));
+  }
+  
+  // without a custom scale, all ticks are kept:
+  axis->setScaleType(QCPAxis::stLinear);
+  mPlot->replot();
+  QVERIFY(axis->tickVector().contains(14));
+}
+
+void TestQCPScaleTransform::customAdaptiveSampling()
+{
+  QCPAxis *keyAxis = mPlot->xAxis;
+  keyAxis->setScaleType(QCPAxis::stCustom);
+  keyAxis->setScaleTransform(QSharedPointer<QCPScaleTransform>(new QCPScaleTransformSymLog(1)));
+  keyAxis->setRange(-1000, 1000);
+  mPlot->yAxis->setRange(-2, 2);
+  mPlot->replot();
+  
+  const int n = 200000;
+  QVector<double> keys(n), values(n);
+  for (int i=0; i<n; ++i)
+  {
+    keys[i] = -1000+i*0.01;
+    values[i] = qSin(i*0.37)*(1+(i%1000 == 0 ? 0.5 : 0));
+  }
+  GraphProbe *graph = new GraphProbe(keyAxis, mPlot->yAxis);
+  graph->setData(keys, values, true);
+  
+  QVector<QPointF> sampled, unsampled;
+  graph->lines(&sampled);
+  graph->setAdaptiveSampling(false);
+  graph->lines(&unsampled);
+  const int width = mPlot->axisRect()->width();
+  QCOMPARE(unsampled.size(), n);
+  QVERIFY2(sampled.size() <= 4*(width+2), qPrintable(QString::number(sampled.size())));
+  QVERIFY(sampled.size() >= width/2);
+  
+  // the sampled line covers the same key pixel span and value envelope, in ascending key pixels:
+  double sampledMin = std::numeric_limits<double>::max(), sampledMax = -std::numeric_limits<double>::max();
+  double unsampledMin = sampledMin, unsampledMax = sampledMax;
+  for (int i=0; i<sampled.size(); ++i)
+  {
+    sampledMin = qMin(sampledMin, sampled.at(i).y());
+    sampledMax = qMax(sampledMax, sampled.at(i).y());
+    if (i > 0)
+      QVERIFY(sampled.at(i).x() >= sampled.at(i-1).x()-1e-9);
+  }
+  for (int i=0; i<unsampled.size(); ++i)
+  {
+    unsampledMin = qMin(unsampledMin, unsampled.at(i).y());
+    unsampledMax = qMax(unsampledMax, unsampled.at(i).y());
+  }
+  QCOMPARE(sampledMin, unsampledMin);
+  QCOMPARE(sampledMax, unsampledMax);
+  QVERIFY(qAbs(sampled.first().x()-unsampled.first().x()) <= 1);
+  QVERIFY(qAbs(sampled.last().x()-unsampled.last().x()) <= 1);
+}
@@ -0,0 +1,21 @@
+#include <QtTest/QtTest>
+#include "../../../qcustomplot.h"
+
+class TestQCPScaleTransform : public QObject
+{
+  Q_OBJECT
+private slots:
+  void init();
+  void cleanup();
+  
+  void roundTrip();
+  void bulkTransforms();
+  void axisRoundTrip();
+  void brokenGaps();
+  void rangeInsideGap();
+  void ticksInGaps();
+  void customAdaptiveSampling();
+  
+private:
+  QCustomPlot *mPlot;
+};
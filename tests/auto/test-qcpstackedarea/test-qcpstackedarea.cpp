@@ -0,0 +1,193 @@
+#include "test-qcpstackedarea.h"
+
+void TestQCPStackedArea::init()
+{
+  mPlot = new QCustomPlot(0);
+  mPlot->setGeometry(0, 0, 500, 400);
+  mArea = new QCPStackedArea(mPlot->xAxis, mPlot->yAxis);
+}
+
+void TestQCPStackedArea::cleanup()
+{
+  delete mPlot;
+}
+
+void TestQCPStackedArea::stackedValue()
+{
+  QVector<QVector<double> > layers;
+  layers << (QVector<double>() << 1 << 2 << 3);
+  layers << (QVector<double>() << 10 << qQNaN() << 30);
+  layers << (QVector<double>() << 100 << 200);
+  mArea->setData(QVector<double>() << 0 << 1 << 2, layers, true);
+  QCOMPARE(mArea->layerCount(), 3);
+  QCOMPARE(mArea->stackedValue(0, 0), 1.0);
+  QCOMPARE(mArea->stackedValue(1, 0), 11.0);
+  QCOMPARE(mArea->stackedValue(2, 0), 111.0);
+  QCOMPARE(mArea->stackedValue(1, 1), 2.0); // NaN counts as zero
+  QCOMPARE(mArea->stackedValue(2, 1), 202.0);
+  QCOMPARE(mArea->stackedValue(2, 2), 33.0); // short layer is padded with zero
+  QCOMPARE(mArea->stackedValue(3, 0), 0.0); // out of bounds
+  QCOMPARE(mArea->stackedValue(0, 3), 0.0);
+  
+  // cumulative sums are updated after changes:
+  mArea->setLayerValues(0, QVector<double>() << 5 << 5 << 5);
+  QCOMPARE(mArea->stackedValue(2, 0), 115.0);
+  QVERIFY(mArea->removeLayer(1));
+  QCOMPARE(mArea->layerCount(), 2);
+  QCOMPARE(mArea->stackedValue(1, 2), 5.0);
+  QVERIFY(!mArea->removeLayer(2));
+  mArea->addLayer(QVector<double>() << 1 << 1 << 1, QLatin1String("top"));
+  QCOMPARE(mArea->layerName(2), QString(QLatin1String("top")));
+  QCOMPARE(mArea->stackedValue(2, 1), 206.0);
+}
+
+void TestQCPStackedArea::parallelSums()
+{
+  // large enough for the cumulative sums to be computed in parallel chunks:
+  const int n = 300000;
+  QVector<double> keys(n);
+  QVector<QVector<double> > layers(4, QVector<double>(n));
+  for (int k=0; k<n; ++k)
+  {
+    keys[k] = k;
+    for (int l=0; l<layers.size(); ++l)
+      layers[l][k] = (k*(l+3))%17 - 5;
+  }
+  mArea->setData(keys, layers, true);
+  for (int k=0; k<n; k+=997)
+  {
+    double sum = 0;
+    for (int l=0; l<layers.size(); ++l)
+    {
+      sum += layers.at(l).at(k);
+      QCOMPARE(mArea->stackedValue(l, k), sum);
+    }
+  }
+  QCOMPARE(mArea->stackedValue(3, n-1), layers.at(0).at(n-1)+layers.at(1).at(n-1)+layers.at(2).at(n-1)+layers.at(3).at(n-1));
+}
+
+void TestQCPStackedArea::setDataSorting()
+{
+  mArea->addLayer(QVector<double>(), QLatin1String("bottom"));
+  mArea->setLayerBrush(0, QBrush(Qt::red));
+  mArea->addLayer(QVector<double>(), QLatin1String("middle"));
+  mArea->addLayer(QVector<double>(), QLatin1String("surplus"));
+  
+  QVector<QVector<double> > layers;
+  layers << (QVector<double>() << 30 << 10 << 20 << 11);
+  layers << (QVector<double>() << 3 << 1 << 2); // shorter than keys
+  mArea->setData(QVector<double>() << 3 << 1 << 2 << 1, layers);
+  QCOMPARE(mArea->keys(), QVector<double>() << 1 << 1 << 2 << 3);
+  QCOMPARE(mArea->layerValues(0), QVector<double>() << 10 << 11 << 20 << 30); // stable for equal keys
+  QCOMPARE(mArea->layerValues(1), QVector<double>() << 1 << 0 << 2 << 3);
+  
+  // existing layers keep their appearance, surplus layers are removed:
+  QCOMPARE(mArea->layerCount(), 2);
+  QCOMPARE(mArea->layerName(0), QString(QLatin1String("bottom")));
+  QCOMPARE(mArea->layerBrush(0), QBrush(Qt::red));
+  QCOMPARE(mArea->layerName(1), QString(QLatin1String("middle")));
+  QCOMPARE(mArea->stackedValue(1, 3), 33.0);
+  
+  // additional layers are created:
+  layers << (QVector<double>() << 1 << 1 << 1 << 1);
+  mArea->setData(QVector<double>() << 0 << 1 << 2 << 3, layers, true);
+  QCOMPARE(mArea->layerCount(), 3);
+  QCOMPARE(mArea->keys(), QVector<double>() << 0 << 1 << 2 << 3);
+  QCOMPARE(mArea->layerValues(0), layers.at(0));
+}
+
+void TestQCPStackedArea::valueRange()
+{
+  QVector<QVector<double> > layers;
+  layers << (QVector<double>() << 1 << 2 << 3 << 4);
+  layers << (QVector<double>() << 1 << -5 << 1 << 1);
+  mArea->setData(QVector<double>() << -1 << 0 << 1 << 2, layers, true);
+  
+  bool found = false;
+  QCPRange range = mArea->getValueRange(found);
+  QVERIFY(found);
+  QCOMPARE(range.lower, -3.0); // stacked -5 on top of 2
+  QCOMPARE(range.upper, 5.0);
+  
+  range = mArea->getValueRange(found, QCP::sdPositive);
+  QVERIFY(found);
+  QCOMPARE(range.lower, 1.0);
+  QCOMPARE(range.upper, 5.0);
+  range = mArea->getValueRange(found, QCP::sdNegative);
+  QVERIFY(found);
+  QCOMPARE(range, QCPRange(-3, -3));
+  
+  // restricted key range; the first layer is filled down to zero, so zero is always included:
+  range = mArea->getValueRange(found, QCP::sdBoth, QCPRange(0.5, 1.5));
+  QVERIFY(found);
+  QCOMPARE(range.lower, 0.0);
+  QCOMPARE(range.upper, 4.0);
+  mArea->getValueRange(found, QCP::sdBoth, QCPRange(5, 6));
+  QVERIFY(!found);
+  
+  range = mArea->getKeyRange(found, QCP::sdPositive);
+  QVERIFY(found);
+  QCOMPARE(range, QCPRange(1, 2));
+  range = mArea->getKeyRange(found);
+  QCOMPARE(range, QCPRange(-1, 2));
+  
+  mArea->clearLayers();
+  mArea->getValueRange(found);
+  QVERIFY(!found);
+}
+
+void TestQCPStackedArea::layerAt()
+{
+  QVector<QVector<double> > layers;
+  layers << (QVector<double>() << 1 << 3);
+  layers << (QVector<double>() << 2 << 2);
+  mArea->setData(QVector<double>() << 0 << 10, layers, true);
+  mPlot->xAxis->setRange(-1, 11);
+  mPlot->yAxis->setRange(-1, 6);
+  mPlot->replot();
+  
+  QCPAxis *x = mPlot->xAxis, *y = mPlot->yAxis;
+  QCOMPARE(mArea->layerAt(QPointF(x->coordToPixel(0), y->coordToPixel(0.5))), 0);
+  QCOMPARE(mArea->layerAt(QPointF(x->coordToPixel(0), y->coordToPixel(2))), 1);
+  QCOMPARE(mArea->layerAt(QPointF(x->coordToPixel(0), y->coordToPixel(3.5))), -1);
+  // boundaries are interpolated linearly between keys (at key 5: layer 0 up to 2, layer 1 up to 4):
+  QCOMPARE(mArea->layerAt(QPointF(x->coordToPixel(5), y->coordToPixel(1.9))), 0);
+  QCOMPARE(mArea->layerAt(QPointF(x->coordToPixel(5), y->coordToPixel(2.1))), 1);
+  QCOMPARE(mArea->layerAt(QPointF(x->coordToPixel(5), y->coordToPixel(4.1))), -1);
+  QCOMPARE(mArea->layerAt(QPointF(x->coordToPixel(5), y->coordToPixel(-0.5))), -1);
+  // outside of the key range:
+  QCOMPARE(mArea->layerAt(QPointF(x->coordToPixel(-0.5), y->coordToPixel(0.5))), -1);
+  QCOMPARE(mArea->layerAt(QPointF(x->coordToPixel(10.5), y->coordToPixel(0.5))), -1);
+}
+
+void TestQCPStackedArea::selection()
+{
+  QVector<QVector<double> > layers;
+  layers << (QVector<double>() << 1 << 1);
+  layers << (QVector<double>() << 1 << 1);
+  mArea->setData(QVector<double>() << 0 << 10, layers, true);
+  mPlot->xAxis->setRange(-1, 11);
+  mPlot->yAxis->setRange(-1, 3);
+  mPlot->replot();
+  const QPointF inside(mPlot->xAxis->coordToPixel(5), mPlot->yAxis->coordToPixel(1.5));
+  const QPointF outside(mPlot->xAxis->coordToPixel(5), mPlot->yAxis->coordToPixel(2.5));
+  
+  QVariant details;
+  QVERIFY(mArea->selectTest(inside, true, &details) >= 0);
+  QCOMPARE(details.value<QCPDataSelection>(), QCPDataSelection(QCPDataRange(0, 1)));
+  QCOMPARE(mArea->selectTest(outside, true), -1.0);
+  
+  // only selectable as a whole:
+  QCOMPARE(mArea->selectable(), QCP::stWhole);
+  mPlot->setInteractions(QCP::iSelectPlottables);
+  QMouseEvent press(QEvent::MouseButtonPress, inside.toPoint(), Qt::LeftButton, Qt::LeftButton, Qt::NoModifier);
+  QMouseEvent release(QEvent::MouseButtonRelease, inside.toPoint(), Qt::LeftButton, Qt::LeftButton, Qt::NoModifier);
+  QApplication::sendEvent(mPlot, &press);
+  QApplication::sendEvent(mPlot, &release);
+  QVERIFY(mArea->selected());
+  QCOMPARE(mPlot->selectedPlottables(), QList<QCPAbstractPlottable*>() << mArea);
+  
+  mArea->setSelectable(QCP::stNone);
+  QCOMPARE(mArea->selectTest(inside, true), -1.0);
+  QVERIFY(mArea->selectTest(inside, false) >= 0);
+}
@@ -0,0 +1,21 @@
+#include <QtTest/QtTest>
+#include "../../../qcustomplot.h"
+
+class TestQCPStackedArea : public QObject
+{
+  Q_OBJECT
+private slots:
+  void init();
+  void cleanup();
+  
+  void stackedValue();
+  void parallelSums();
+  void setDataSorting();
+  void valueRange();
+  void layerAt();
+  void selection();
+  
+private:
+  QCustomPlot *mPlot;
+  QCPStackedArea *mArea;
+};
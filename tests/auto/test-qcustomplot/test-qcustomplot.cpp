@@ -1,4 +1,5 @@
 #include "test-qcustomplot.h"
+#include "../probes.h"
 
 void TestQCustomPlot::init()
 {
@@ -91,3 +92,523 @@ void TestQCustomPlot::rescaleAxes_MultipleFlatGraphs()
 
 
 
+
+void TestQCustomPlot::snapshotRoundTrip()
+{
+  const QString fileName = QDir::temp().filePath(QLatin1String("qcp-test-snapshot.qcps"));
+  mPlot->xAxis->setRange(-5, 15);
+  mPlot->yAxis->setScaleType(QCPAxis::stLogarithmic);
+  mPlot->yAxis->setRange(0.1, 1000);
+  QCPGraph *graph = mPlot->addGraph();
+  graph->setData(QVector<double>()<<1<<2<<3<<4, QVector<double>()<<1<<10<<100<<qQNaN());
+  graph->setLineStyle(QCPGraph::lsStepLeft);
+  graph->setName(QLatin1String("first"));
+  QCPGraph *graph2 = mPlot->addGraph();
+  graph2->setData(QVector<double>()<<0<<5, QVector<double>()<<2<<3);
+  graph2->setChannelFillGraph(graph);
+  QCPItemTracer *tracer = new QCPItemTracer(mPlot);
+  tracer->setGraph(graph);
+  tracer->setGraphKey(2);
+  QCPItemLine *line = new QCPItemLine(mPlot);
+  line->start->setCoords(1, 2);
+  line->end->setCoords(3, 4);
+  line->setHead(QCPLineEnding::esSpikeArrow);
+  QVERIFY(mPlot->saveSnapshot(fileName));
+  
+  mPlot->clearPlottables();
+  mPlot->clearItems();
+  mPlot->xAxis->setRange(0, 1);
+  mPlot->yAxis->setScaleType(QCPAxis::stLinear);
+  QVERIFY(mPlot->loadSnapshot(fileName));
+  QFile::remove(fileName);
+  
+  QCOMPARE(mPlot->xAxis->range().lower, -5.0);
+  QCOMPARE(mPlot->xAxis->range().upper, 15.0);
+  QCOMPARE(mPlot->yAxis->scaleType(), QCPAxis::stLogarithmic);
+  QCOMPARE(mPlot->yAxis->range().upper, 1000.0);
+  QCOMPARE(mPlot->graphCount(), 2);
+  QCOMPARE(mPlot->graph(0)->name(), QString(QLatin1String("first")));
+  QCOMPARE(mPlot->graph(0)->lineStyle(), QCPGraph::lsStepLeft);
+  QCOMPARE(mPlot->graph(0)->dataCount(), 4);
+  QCOMPARE(mPlot->graph(0)->dataMainValue(2), 100.0);
+  QVERIFY(qIsNaN(mPlot->graph(0)->dataMainValue(3)));
+  QCOMPARE(mPlot->graph(1)->channelFillGraph(), mPlot->graph(0));
+  QCOMPARE(mPlot->itemCount(), 2);
+  QCPItemTracer *restoredTracer = qobject_cast<QCPItemTracer*>(mPlot->item(0));
+  QVERIFY(restoredTracer);
+  QCOMPARE(restoredTracer->graph(), mPlot->graph(0));
+  QCOMPARE(restoredTracer->graphKey(), 2.0);
+  QCPItemLine *restoredLine = qobject_cast<QCPItemLine*>(mPlot->item(1));
+  QVERIFY(restoredLine);
+  QCOMPARE(restoredLine->end->coords(), QPointF(3, 4));
+  QCOMPARE(restoredLine->head().style(), QCPLineEnding::esSpikeArrow);
+}
+
+void TestQCustomPlot::axisLinkGroup()
+{
+  QCustomPlot plot2, plot3;
+  QCPAxisLinkGroup group;
+  qRegisterMetaType<QCPRange>("QCPRange");
+  QSignalSpy spy(&group, SIGNAL(rangeChanged(QCPRange)));
+  
+  mPlot->xAxis->setRange(2, 5);
+  QVERIFY(group.addAxis(mPlot->xAxis));
+  QVERIFY(group.addAxis(plot2.xAxis));
+  QVERIFY(group.addAxis(plot3.xAxis));
+  QVERIFY(!group.addAxis(plot3.xAxis));
+  QCOMPARE(group.axisCount(), 3);
+  // axes added later take over the range of the group:
+  QCOMPARE(plot2.xAxis->range(), QCPRange(2, 5));
+  QCOMPARE(plot3.xAxis->range(), QCPRange(2, 5));
+  QCOMPARE(spy.count(), 0);
+  
+  // a change of one member is propagated to all others in a single pass:
+  plot2.xAxis->setRange(-1, 1);
+  QCOMPARE(mPlot->xAxis->range(), QCPRange(-1, 1));
+  QCOMPARE(plot3.xAxis->range(), QCPRange(-1, 1));
+  QCOMPARE(spy.count(), 1);
+  
+  group.setRange(QCPRange(10, 20));
+  QCOMPARE(mPlot->xAxis->range(), QCPRange(10, 20));
+  QCOMPARE(plot2.xAxis->range(), QCPRange(10, 20));
+  QCOMPARE(plot3.xAxis->range(), QCPRange(10, 20));
+  QCOMPARE(spy.count(), 2);
+  
+  // removed axes aren't synchronized anymore:
+  QVERIFY(group.removeAxis(plot3.xAxis));
+  mPlot->xAxis->setRange(0, 3);
+  QCOMPARE(plot2.xAxis->range(), QCPRange(0, 3));
+  QCOMPARE(plot3.xAxis->range(), QCPRange(10, 20));
+  QCOMPARE(group.axisCount(), 2);
+}
+
+void TestQCustomPlot::deferHiddenReplots()
+{
+  mPlot->setPlottingHint(QCP::phDeferHiddenReplots);
+  QSignalSpy spy(mPlot, SIGNAL(afterReplot()));
+  
+  // replots of a visible plot happen as usual:
+  mPlot->replot();
+  QCOMPARE(spy.count(), 1);
+  
+  // replots of a hidden plot are skipped:
+  mPlot->hide();
+  mPlot->replot();
+  mPlot->replot();
+  mPlot->replot(QCustomPlot::rpQueuedReplot);
+  QCoreApplication::processEvents(); // would perform the queued replot
+  QCOMPARE(spy.count(), 1);
+  
+  // all skipped replots are caught up by a single replot once the plot is shown again, painting
+  // the plot doesn't replot it another time:
+  mPlot->show();
+  QTRY_COMPARE(spy.count(), 2);
+  QVERIFY(QTest::qWaitForWindowExposed(mPlot));
+  mPlot->repaint();
+  QCOMPARE(spy.count(), 2);
+  
+  // without the hint, hidden plots are replotted immediately:
+  mPlot->setPlottingHint(QCP::phDeferHiddenReplots, false);
+  mPlot->hide();
+  mPlot->replot();
+  QCOMPARE(spy.count(), 3);
+}
+
+void TestQCustomPlot::rectSelection()
+{
+  mPlot->setGeometry(50, 50, 500, 500);
+  mPlot->setInteractions(QCP::iSelectPlottables|QCP::iMultiSelect);
+  mPlot->setSelectionRectMode(QCP::srmSelect);
+  QVERIFY(!mPlot->selectionRect()->overlay()); // opt-in, subclasses may reimplement draw
+  mPlot->selectionRect()->setOverlay(true);
+  mPlot->setPlottingHint(QCP::phConcurrentRectSelection);
+  
+  // enough data points that the plottables are tested concurrently:
+  int n = 100000;
+  QVector<double> x(n), y1(n), y2(n);
+  for (int i=0; i<n; ++i)
+  {
+    x[i] = i/(double)n*10.0;
+    y1[i] = 1.0+0.1*qSin(x[i]);
+    y2[i] = -1.0;
+  }
+  QCPGraph *graph1 = mPlot->addGraph();
+  QCPGraph *graph2 = mPlot->addGraph();
+  graph1->setData(x, y1, true);
+  graph2->setData(x, y2, true);
+  graph1->setSelectable(QCP::stDataRange);
+  graph2->setSelectable(QCP::stDataRange);
+  mPlot->xAxis->setRange(0, 10);
+  mPlot->yAxis->setRange(-2, 2);
+  mPlot->replot();
+  
+  QPoint start(mPlot->xAxis->coordToPixel(2.5), mPlot->yAxis->coordToPixel(1.5));
+  QPoint end(mPlot->xAxis->coordToPixel(5.0), mPlot->yAxis->coordToPixel(0.5));
+  QCPDataSelection expected = graph1->selectTestRect(QRectF(start, end).normalized(), true);
+  QVERIFY(!expected.isEmpty());
+  
+  QSignalSpy spy(mPlot, SIGNAL(afterReplot()));
+  QMouseEvent pressEvent(QEvent::MouseButtonPress, start, Qt::LeftButton, Qt::LeftButton, Qt::NoModifier);
+  QCoreApplication::sendEvent(mPlot, &pressEvent);
+  for (int i=1; i<=10; ++i)
+  {
+    QMouseEvent moveEvent(QEvent::MouseMove, start+(end-start)*i/10, Qt::NoButton, Qt::LeftButton, Qt::NoModifier);
+    QCoreApplication::sendEvent(mPlot, &moveEvent);
+  }
+  QVERIFY(mPlot->selectionRect()->isActive());
+  QCOMPARE(spy.count(), 0); // overlay selection rect doesn't replot while dragging
+  
+  QMouseEvent releaseEvent(QEvent::MouseButtonRelease, end, Qt::LeftButton, Qt::NoButton, Qt::NoModifier);
+  QCoreApplication::sendEvent(mPlot, &releaseEvent);
+  QVERIFY(!mPlot->selectionRect()->isActive());
+  QCOMPARE(graph1->selection(), expected);
+  QVERIFY(graph2->selection().isEmpty());
+}
+
+void TestQCustomPlot::mouseMoveCoalescing()
+{
+  mPlot->setGeometry(50, 50, 500, 500);
+  mPlot->setMouseMoveCoalescing(50);
+  QSignalSpy spy(mPlot, SIGNAL(mouseMove(QMouseEvent*)));
+  
+  // the first move is dispatched immediately, following moves within the interval are held back:
+  for (int i=0; i<10; ++i)
+  {
+    QMouseEvent moveEvent(QEvent::MouseMove, QPoint(100+i, 100), Qt::NoButton, Qt::NoButton, Qt::NoModifier);
+    QCoreApplication::sendEvent(mPlot, &moveEvent);
+  }
+  QCOMPARE(spy.count(), 1);
+  
+  // only the latest held back move is dispatched once the interval passed:
+  QTRY_COMPARE(spy.count(), 2);
+  QTest::qWait(100);
+  QCOMPARE(spy.count(), 2);
+  
+  // a held back move is dispatched before a mouse press:
+  QSignalSpy pressSpy(mPlot, SIGNAL(mousePress(QMouseEvent*)));
+  QMouseEvent moveEvent1(QEvent::MouseMove, QPoint(200, 200), Qt::NoButton, Qt::NoButton, Qt::NoModifier);
+  QMouseEvent moveEvent2(QEvent::MouseMove, QPoint(210, 200), Qt::NoButton, Qt::NoButton, Qt::NoModifier);
+  QCoreApplication::sendEvent(mPlot, &moveEvent1);
+  QCoreApplication::sendEvent(mPlot, &moveEvent2);
+  QCOMPARE(spy.count(), 3);
+  QMouseEvent pressEvent(QEvent::MouseButtonPress, QPoint(210, 200), Qt::LeftButton, Qt::LeftButton, Qt::NoModifier);
+  QCoreApplication::sendEvent(mPlot, &pressEvent);
+  QCOMPARE(spy.count(), 4);
+  QCOMPARE(pressSpy.count(), 1);
+  QMouseEvent releaseEvent(QEvent::MouseButtonRelease, QPoint(210, 200), Qt::LeftButton, Qt::NoButton, Qt::NoModifier);
+  QCoreApplication::sendEvent(mPlot, &releaseEvent);
+}
+
+void TestQCustomPlot::overview()
+{
+  mPlot->setGeometry(50, 50, 500, 500);
+  QCPGraph *graph = mPlot->addGraph();
+  for (int i=0; i<100; ++i)
+    graph->addData(i, qSin(i/10.0));
+  QCPOverview *overview = new QCPOverview(mPlot);
+  mPlot->plotLayout()->addElement(1, 0, overview);
+  QVERIFY(overview->addPlottable(graph));
+  QVERIFY(!overview->addPlottable(graph));
+  overview->setLinkedAxis(mPlot->xAxis);
+  mPlot->xAxis->setRange(0, 20);
+  mPlot->replot();
+  QCOMPARE(overview->keyRange(), QCPRange(0, 99));
+  QVERIFY(overview->valueRange().lower >= -1 && overview->valueRange().lower < -0.99);
+  QVERIFY(overview->valueRange().upper <= 1 && overview->valueRange().upper > 0.99);
+  
+  // appended data beyond the column range is accumulated without rescanning:
+  for (int i=100; i<400; ++i)
+    graph->addData(i, 2*qSin(i/10.0));
+  mPlot->replot();
+  QCOMPARE(overview->keyRange(), QCPRange(0, 399));
+  QVERIFY(overview->valueRange().lower >= -2 && overview->valueRange().lower < -1.99);
+  
+  // replacing data is detected and causes a rescan:
+  graph->data()->clear();
+  graph->addData(10, 5);
+  graph->addData(20, 6);
+  mPlot->replot();
+  QCOMPARE(overview->keyRange(), QCPRange(10, 20));
+  QCOMPARE(overview->valueRange(), QCPRange(5, 6));
+  
+  // pressing beside the viewport centers it at the pressed key, dragging moves it:
+  mPlot->xAxis->setRange(10, 12);
+  mPlot->replot();
+  const QPoint center = overview->rect().center();
+  QMouseEvent pressEvent(QEvent::MouseButtonPress, center, Qt::LeftButton, Qt::LeftButton, Qt::NoModifier);
+  QCoreApplication::sendEvent(mPlot, &pressEvent);
+  QVERIFY(qAbs(mPlot->xAxis->range().center()-15) < 0.1);
+  QCOMPARE(mPlot->xAxis->range().size(), 2.0);
+  QMouseEvent moveEvent(QEvent::MouseMove, center+QPoint(overview->rect().width()/10, 0), Qt::NoButton, Qt::LeftButton, Qt::NoModifier);
+  QCoreApplication::sendEvent(mPlot, &moveEvent);
+  QVERIFY(qAbs(mPlot->xAxis->range().center()-16) < 0.1);
+  QMouseEvent releaseEvent(QEvent::MouseButtonRelease, center, Qt::LeftButton, Qt::NoButton, Qt::NoModifier);
+  QCoreApplication::sendEvent(mPlot, &releaseEvent);
+}
+
+void TestQCustomPlot::overviewStreaming()
+{
+  mPlot->setGeometry(50, 50, 500, 500);
+  QCPGraph *graph = mPlot->addGraph();
+  OverviewProbe *overview = new OverviewProbe(mPlot);
+  QCPOverview *reference = new QCPOverview(mPlot);
+  mPlot->plotLayout()->addElement(1, 0, overview);
+  mPlot->plotLayout()->addElement(2, 0, reference);
+  overview->setResolution(100);
+  reference->setResolution(100);
+  QVERIFY(overview->addPlottable(graph));
+  QVERIFY(reference->addPlottable(graph));
+  // the amplitude decreases with the key, so the value extrema of the data leave at the front:
+  for (int key=0; key<1000; ++key)
+    graph->addData(key, (7-key/1000.0)*qSin(key/30.0));
+  mPlot->replot();
+  QCOMPARE(overview->keyRange(), QCPRange(0, 999));
+  
+  // rolling buffer of constant size, compared with a reference overview that is rescanned every time:
+  for (int step=1; step<=50; ++step)
+  {
+    for (int key=900+step*100; key<1000+step*100; ++key)
+      graph->addData(key, (7-key/1000.0)*qSin(key/30.0));
+    graph->data()->removeBefore(step*100-0.5);
+    QCOMPARE(graph->dataCount(), 1000);
+    reference->invalidate();
+    mPlot->replot();
+    QCOMPARE(overview->keyRange(), QCPRange(step*100, step*100+999));
+    QCOMPARE(overview->valueRange(), reference->valueRange());
+  }
+  // the column range moved along with the data instead of growing with every step:
+  QVERIFY(overview->binRange().lower > 4000);
+  QVERIFY(overview->binRange().size() < 2100);
+  
+  // removing data at the end still causes a rescan:
+  graph->data()->removeAfter(5500);
+  reference->invalidate();
+  mPlot->replot();
+  QCOMPARE(overview->keyRange(), QCPRange(5000, 5500));
+  QCOMPARE(overview->valueRange(), reference->valueRange());
+}
+
+void TestQCustomPlot::selectionTransaction()
+{
+  QList<QCPGraph*> graphs;
+  for (int i=0; i<3; ++i)
+  {
+    QCPGraph *graph = mPlot->addGraph();
+    graph->setSelectable(QCP::stDataRange);
+    graph->addData(QVector<double>() << 1 << 2 << 3, QVector<double>() << 1 << 2 << 3);
+    graphs.append(graph);
+  }
+  QCPItemLine *item = new QCPItemLine(mPlot);
+  QSignalSpy graphSpy(graphs.first(), SIGNAL(selectionChanged(bool)));
+  QSignalSpy itemSpy(item, SIGNAL(selectionChanged(bool)));
+  QSignalSpy finishedSpy(mPlot, SIGNAL(selectionChangeFinished(QList<QCPAbstractPlottable*>,QList<QCPAbstractItem*>)));
+  
+  // nested transactions only finish with the outermost end:
+  mPlot->beginSelectionChange();
+  mPlot->beginSelectionChange();
+  QVERIFY(mPlot->isChangingSelection());
+  mPlot->selectAll();
+  graphs.first()->setSelection(QCPDataSelection(QCPDataRange(0, 1)));
+  mPlot->endSelectionChange();
+  QCOMPARE(finishedSpy.count(), 0);
+  mPlot->endSelectionChange();
+  QVERIFY(!mPlot->isChangingSelection());
+  QCOMPARE(graphSpy.count(), 0);
+  QCOMPARE(itemSpy.count(), 0);
+  QCOMPARE(finishedSpy.count(), 1);
+  QCOMPARE(graphs.first()->selection(), QCPDataSelection(QCPDataRange(0, 1)));
+  QCOMPARE(graphs.last()->selection(), QCPDataSelection(QCPDataRange(0, 3)));
+  QVERIFY(item->selected());
+  
+  // without the plotting hint, deselectAll emits the individual signals:
+  mPlot->deselectAll();
+  QCOMPARE(graphSpy.count(), 1);
+  QCOMPARE(itemSpy.count(), 1);
+  QCOMPARE(finishedSpy.count(), 1);
+  
+  // with the plotting hint, deselectAll is a transaction:
+  mPlot->selectAll();
+  QCOMPARE(finishedSpy.count(), 2);
+  mPlot->setPlottingHint(QCP::phBatchSelectionChanges, true);
+  mPlot->deselectAll();
+  QCOMPARE(graphSpy.count(), 1);
+  QCOMPARE(finishedSpy.count(), 3);
+  QVERIFY(mPlot->selectedPlottables().isEmpty());
+  QVERIFY(mPlot->selectedItems().isEmpty());
+}
+
+void TestQCustomPlot::snapshotTruncated()
+{
+  const QString fileName = QDir::temp().filePath(QLatin1String("qcp-test-snapshot-truncated.qcps"));
+  QCPGraph *graph = mPlot->addGraph();
+  QVector<double> keys, values;
+  for (int i=0; i<1000; ++i)
+  {
+    keys << i;
+    values << i*i;
+  }
+  graph->setData(keys, values);
+  new QCPItemLine(mPlot);
+  QVERIFY(mPlot->saveSnapshot(fileName));
+  
+  // cut the file in the middle of the graph data:
+  QFile file(fileName);
+  QVERIFY(file.open(QIODevice::ReadWrite));
+  QVERIFY(file.resize(file.size()/2));
+  file.close();
+  
+  mPlot->clearItems();
+  QCPGraph *otherGraph = mPlot->addGraph();
+  otherGraph->setData(QVector<double>()<<1<<2, QVector<double>()<<3<<4);
+  QCPItemText *text = new QCPItemText(mPlot);
+  QVERIFY(!mPlot->loadSnapshot(fileName));
+  QFile::remove(fileName);
+  
+  // the failed load must leave the plot unchanged:
+  QCOMPARE(mPlot->graphCount(), 2);
+  QCOMPARE(mPlot->graph(1), otherGraph);
+  QCOMPARE(mPlot->graph(0)->dataCount(), 1000);
+  QCOMPARE(mPlot->itemCount(), 1);
+  QCOMPARE(mPlot->item(0), (QCPAbstractItem*)text);
+}
+
+void TestQCustomPlot::snapshotInvalidIndex()
+{
+  const QString fileName = QDir::temp().filePath(QLatin1String("qcp-test-snapshot-invalid.qcps"));
+  QFile file(fileName);
+  QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+  QDataStream stream(&file);
+  stream.setVersion(QDataStream::Qt_4_6);
+  stream << (quint32)0x51435053 << (quint32)1 << (quint8)(QSysInfo::ByteOrder == QSysInfo::LittleEndian);
+  // axis rect section whose only axis has a negative index among the axes of its type:
+  QByteArray metaData;
+  QDataStream meta(&metaData, QIODevice::WriteOnly);
+  meta.setVersion(QDataStream::Qt_4_6);
+  meta << (qint32)0 << (qint32)0 << (qint32)0 << (qint32)0; // index, row, column, no properties
+  meta << (qint32)1 << (qint32)QCPAxis::atBottom << (qint32)-1 << (qint32)0 << 2.0 << 3.0;
+  stream << (quint32)1 << metaData << (quint32)0;
+  stream << (quint32)0xFFFF;
+  file.close();
+  
+  QCPGraph *graph = mPlot->addGraph();
+  graph->setData(QVector<double>()<<1<<2, QVector<double>()<<3<<4);
+  mPlot->xAxis->setRange(-1, 1);
+  QVERIFY(!mPlot->loadSnapshot(fileName));
+  
+  // an invalid axis type is rejected, too:
+  QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+  stream.setDevice(&file);
+  stream << (quint32)0x51435053 << (quint32)1 << (quint8)(QSysInfo::ByteOrder == QSysInfo::LittleEndian);
+  metaData.clear();
+  QDataStream invalidTypeMeta(&metaData, QIODevice::WriteOnly);
+  invalidTypeMeta.setVersion(QDataStream::Qt_4_6);
+  invalidTypeMeta << (qint32)0 << (qint32)0 << (qint32)0 << (qint32)0;
+  invalidTypeMeta << (qint32)1 << (qint32)0x30 << (qint32)0 << (qint32)0 << 2.0 << 3.0;
+  stream << (quint32)1 << metaData << (quint32)0;
+  stream << (quint32)0xFFFF;
+  file.close();
+  QVERIFY(!mPlot->loadSnapshot(fileName));
+  QFile::remove(fileName);
+  
+  // the failed loads must leave the plot unchanged:
+  QCOMPARE(mPlot->graphCount(), 1);
+  QCOMPARE(mPlot->graph(0), graph);
+  QCOMPARE(mPlot->xAxis->range().lower, -1.0);
+  QCOMPARE(mPlot->xAxis->range().upper, 1.0);
+  QCOMPARE(mPlot->axisRect()->axes(QCPAxis::atBottom).size(), 1);
+}
+
+/*
+  Counts in which threads the geometry of the graph was prepared by a QCPReplotCoordinator.
+*/
+class PrepareCountingGraph : public QCPGraph
+{
+public:
+  PrepareCountingGraph(QCPAxis *keyAxis, QCPAxis *valueAxis) : QCPGraph(keyAxis, valueAxis) {}
+  QAtomicInt preparedInWorker, preparedInGuiThread;
+protected:
+  virtual void prepareDraw() Q_DECL_OVERRIDE
+  {
+    if (QThread::currentThread() == QCoreApplication::instance()->thread())
+      preparedInGuiThread.ref();
+    else
+      preparedInWorker.ref();
+    QCPGraph::prepareDraw();
+  }
+};
+
+void TestQCustomPlot::replotCoordinator()
+{
+  QList<QCustomPlot*> plots;
+  QList<PrepareCountingGraph*> preparedGraphs;
+  QList<PrepareCountingGraph*> serialGraphs;
+  const int n = 50000;
+  for (int p=0; p<3; ++p)
+  {
+    QCustomPlot *plot = new QCustomPlot(0);
+    plot->setGeometry(50+p*20, 50, 400, 300);
+    plot->show();
+    QVector<double> keys(n), values(n), fillValues(n);
+    for (int i=0; i<n; ++i)
+    {
+      keys[i] = 1+i*0.01;
+      values[i] = qSin(i*0.013*(p+1))+0.2*qSin(i*0.7);
+      fillValues[i] = values[i]-0.5;
+    }
+    PrepareCountingGraph *graph = new PrepareCountingGraph(plot->xAxis, plot->yAxis);
+    PrepareCountingGraph *fillGraph = new PrepareCountingGraph(plot->xAxis, plot->yAxis);
+    graph->setData(keys, values, true);
+    fillGraph->setData(keys, fillValues, true);
+    graph->setChannelFillGraph(fillGraph);
+    graph->setBrush(QColor(0, 0, 255, 50));
+    graph->setConcurrentPreparation(true);
+    fillGraph->setConcurrentPreparation(p != 1); // in the second plot, the channel fill target doesn't opt in
+    if (p == 1)
+      plot->xAxis->setScaleType(QCPAxis::stLogarithmic);
+    else if (p == 2)
+      graph->setLineStyle(QCPGraph::lsStepCenter);
+    plot->rescaleAxes();
+    plots << plot;
+    preparedGraphs << graph;
+    if (p == 1)
+      serialGraphs << fillGraph;
+    else
+      preparedGraphs << fillGraph;
+  }
+  QTest::qWait(150);
+  
+  // replot all plots together, preparing the opted-in graphs in worker threads:
+  QCPReplotCoordinator coordinator;
+  coordinator.setThreadCount(3);
+  coordinator.setFrameBudget(1000);
+  QList<QSharedPointer<QSignalSpy> > spies;
+  foreach (QCustomPlot *plot, plots)
+  {
+    QVERIFY(coordinator.addPlot(plot));
+    spies << QSharedPointer<QSignalSpy>(new QSignalSpy(plot, SIGNAL(afterReplot())));
+    plot->replot(QCustomPlot::rpQueuedReplot);
+  }
+  for (int i=0; i<spies.size(); ++i)
+    QTRY_COMPARE(spies.at(i)->count(), 1);
+  foreach (PrepareCountingGraph *graph, preparedGraphs)
+  {
+    QCOMPARE(graph->preparedInWorker.load(), 1);
+    QCOMPARE(graph->preparedInGuiThread.load(), 0);
+  }
+  foreach (PrepareCountingGraph *graph, serialGraphs)
+    QCOMPARE(graph->preparedInWorker.load()+graph->preparedInGuiThread.load(), 0);
+  QList<QImage> threadedImages;
+  foreach (QCustomPlot *plot, plots)
+    threadedImages << plot->grab().toImage();
+  
+  // the same plots replotted serially on their own must look exactly the same:
+  for (int i=0; i<plots.size(); ++i)
+  {
+    QVERIFY(coordinator.removePlot(plots.at(i)));
+    plots.at(i)->replot();
+    QCOMPARE(plots.at(i)->grab().toImage(), threadedImages.at(i));
+  }
+  foreach (PrepareCountingGraph *graph, preparedGraphs)
+    QCOMPARE(graph->preparedInWorker.load(), 1);
+  qDeleteAll(plots);
+}
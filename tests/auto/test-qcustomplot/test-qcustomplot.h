@@ -11,6 +11,17 @@ private slots:
   void rescaleAxes_GraphVisibility();
   void rescaleAxes_FlatGraph();
   void rescaleAxes_MultipleFlatGraphs();
+  void snapshotRoundTrip();
+  void snapshotTruncated();
+  void snapshotInvalidIndex();
+  void axisLinkGroup();
+  void deferHiddenReplots();
+  void rectSelection();
+  void mouseMoveCoalescing();
+  void overview();
+  void overviewStreaming();
+  void selectionTransaction();
+  void replotCoordinator();
   
 private:
   QCustomPlot *mPlot;
@@ -11,6 +11,12 @@ private slots:
   
   void QCPGraph_Standard();
   void QCPGraph_ManyPoints();
+  void QCPGraph_DenseFill();
+  void QCPGraph_AntialiasedLines();
+  void QCPGraph_StepLines();
+  void QCPGraph_DenseImpulses();
+  void QCPGraph_LogAxis();
+  void QCPGraph_CustomScale();
   void QCPGraph_ManyLines();
   void QCPGraph_ManyOffScreenLines();
   void QCPGraph_RemoveDataBetween();
@@ -25,6 +31,12 @@ private slots:
   void QCPGraph_AddDataSingleAtEnd();
   void QCPGraph_AddDataSingleAtBegin();
   void QCPGraph_AddDataSingleRandom();
+  void QCPAsyncGraph_Pan();
+  void QCPAxisRect_BlitDragPan();
+  void QCPAxisRect_ZoomPreview();
+  void QCPReplotCoordinator_ManyPlots();
+  void QCPStackedArea_ManyLayers();
+  void QCPDigitalTrace_DenseTransitions();
 
   void QCPAxis_TickLabels();
   void QCPAxis_TickLabelsCached();
@@ -115,6 +127,144 @@ void Benchmark::QCPGraph_ManyPoints()
   }
 }
 
+void Benchmark::QCPGraph_DenseFill()
+{
+  QCPGraph *graph1 = mPlot->addGraph();
+  QCPGraph *graph2 = mPlot->addGraph();
+  graph1->setBrush(QBrush(QColor(100, 0, 0, 100)));
+  graph2->setBrush(QBrush(QColor(0, 0, 100, 100)));
+  graph2->setChannelFillGraph(graph1);
+  mPlot->setAntialiasedElements(QCP::aeAll);
+  int n = 500000;
+  QVector<double> x(n), y1(n), y2(n);
+  for (int i=0; i<n; ++i)
+  {
+    x[i] = i/(double)n;
+    y1[i] = qSin(x[i]*200*M_PI)+qSin(x[i]*3000*M_PI)*0.3;
+    y2[i] = y1[i]+1.0+qCos(x[i]*50*M_PI)*0.2;
+  }
+  graph1->setData(x, y1, true);
+  graph2->setData(x, y2, true);
+  mPlot->rescaleAxes();
+  
+  QBENCHMARK
+  {
+    mPlot->replot();
+  }
+}
+
+void Benchmark::QCPGraph_AntialiasedLines()
+{
+  mPlot->setAntialiasedElements(QCP::aePlottables);
+  mPlot->setPlottingHint(QCP::phFastAntialiasedLines);
+  int n = 100000;
+  QVector<double> x(n), y(n);
+  for (int i=0; i<n; ++i)
+  {
+    x[i] = i/(double)n;
+    y[i] = qSin(x[i]*500*M_PI)*qCos(x[i]*7*M_PI);
+  }
+  for (int g=0; g<5; ++g)
+  {
+    QCPGraph *graph = mPlot->addGraph();
+    graph->setAdaptiveSampling(false);
+    graph->setPen(QPen(QColor::fromHsv(g*60, 255, 200), 1.5));
+    graph->setData(x, y, true);
+  }
+  mPlot->rescaleAxes();
+  
+  QBENCHMARK
+  {
+    mPlot->replot();
+  }
+}
+
+void Benchmark::QCPGraph_StepLines()
+{
+  int n = 500000;
+  QVector<double> x(n), y(n);
+  for (int i=0; i<n; ++i)
+  {
+    x[i] = i;
+    y[i] = (i/1000)%7 + ((i*7919)%13 == 0 ? 1 : 0);
+  }
+  QCPGraph *graph = mPlot->addGraph();
+  graph->setAdaptiveSampling(false);
+  graph->setLineStyle(QCPGraph::lsStepLeft);
+  graph->setData(x, y, true);
+  mPlot->rescaleAxes();
+  
+  QBENCHMARK
+  {
+    mPlot->replot();
+  }
+}
+
+void Benchmark::QCPGraph_DenseImpulses()
+{
+  int n = 200000;
+  QVector<double> x(n), y(n), error(n);
+  for (int i=0; i<n; ++i)
+  {
+    x[i] = i;
+    y[i] = qAbs(qSin(i*0.001)*qCos(i*0.37))*100;
+    error[i] = 2+qAbs(qSin(i*0.013));
+  }
+  QCPGraph *graph = mPlot->addGraph();
+  graph->setLineStyle(QCPGraph::lsImpulse);
+  graph->setData(x, y, true);
+  QCPErrorBars *errorBars = new QCPErrorBars(mPlot->xAxis, mPlot->yAxis);
+  errorBars->setDataPlottable(graph);
+  errorBars->setData(error);
+  mPlot->rescaleAxes();
+  
+  QBENCHMARK
+  {
+    mPlot->replot();
+  }
+}
+
+void Benchmark::QCPGraph_LogAxis()
+{
+  int n = 500000;
+  QVector<double> x(n), y(n);
+  for (int i=0; i<n; ++i)
+  {
+    x[i] = qPow(10.0, i/(double)n*6); // 1 Hz to 1 MHz
+    y[i] = -20*qLn(1+qPow(x[i]/1000.0, 2))/qLn(10.0) + qSin(i*0.1);
+  }
+  QCPGraph *graph = mPlot->addGraph();
+  graph->setData(x, y, true);
+  mPlot->xAxis->setScaleType(QCPAxis::stLogarithmic);
+  mPlot->rescaleAxes();
+  
+  QBENCHMARK
+  {
+    mPlot->replot();
+  }
+}
+
+void Benchmark::QCPGraph_CustomScale()
+{
+  int n = 500000;
+  QVector<double> x(n), y(n);
+  for (int i=0; i<n; ++i)
+  {
+    x[i] = i/(double)n*100;
+    y[i] = qPow(x[i]-50, 3)*qSin(i*0.01);
+  }
+  QCPGraph *graph = mPlot->addGraph();
+  graph->setData(x, y, true);
+  mPlot->yAxis->setScaleTransform(QSharedPointer<QCPScaleTransform>(new QCPScaleTransformSymLog(10)));
+  mPlot->yAxis->setScaleType(QCPAxis::stCustom);
+  mPlot->rescaleAxes();
+  
+  QBENCHMARK
+  {
+    mPlot->replot();
+  }
+}
+
 void Benchmark::QCPGraph_ManyLines()
 {
   QCPGraph *graph1 = mPlot->addGraph();
@@ -519,6 +669,186 @@ void Benchmark::QCPGraph_AddDataSingleRandom()
   QTest::setBenchmarkResult(elapsed/1e3/(double)iteration, QTest::WalltimeMilliseconds); // 1e3 instead of 1e6 is intentional to get time of 1000 iterations (fits better to precision of benchmark script)
 }
 
+void Benchmark::QCPAsyncGraph_Pan()
+{
+  const QString fileName = QDir::temp().filePath(QLatin1String("qcp-benchmark-asyncgraph.bin"));
+  int n = 2e6;
+  QVector<double> x(n), y(n);
+  for (int i=0; i<n; ++i)
+  {
+    x[i] = i/(double)n*1000.0;
+    y[i] = qSin(x[i])+qSin(x[i]*37.0)*0.2;
+  }
+  QVERIFY(QCPBinaryFileDataProvider::writeFile(fileName, x, y));
+  QCPBinaryFileDataProvider *provider = new QCPBinaryFileDataProvider(fileName, mPlot);
+  QCPAsyncGraph *graph = new QCPAsyncGraph(mPlot->xAxis, mPlot->yAxis);
+  graph->setDataProvider(provider);
+  mPlot->yAxis->setRange(-1.5, 1.5);
+  mPlot->xAxis->setRange(0, 50);
+  mPlot->replot();
+  while (provider->isLoading())
+    QTest::qWait(10);
+  
+  // replots during panning never wait for the file, fetches happen in the background:
+  QBENCHMARK
+  {
+    mPlot->xAxis->moveRange(0.5);
+    mPlot->replot();
+  }
+  delete provider;
+  QFile::remove(fileName);
+}
+
+void Benchmark::QCPAxisRect_BlitDragPan()
+{
+  int n = 100000;
+  QVector<double> x(n), y(n);
+  for (int i=0; i<n; ++i)
+  {
+    x[i] = i/(double)n*100.0;
+    y[i] = qSin(x[i]*3.0)+qSin(x[i]*59.0)*0.3;
+  }
+  QCPGraph *graph = mPlot->addGraph();
+  graph->setData(x, y, true);
+  graph->setBrush(QColor(0, 0, 255, 50));
+  graph->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssCircle, 4));
+  graph->setAdaptiveSampling(false);
+  mPlot->layer("main")->setMode(QCPLayer::lmBuffered);
+  mPlot->setInteractions(QCP::iRangeDrag);
+  mPlot->axisRect()->setRangeDragBlitting(true);
+  mPlot->xAxis->setRange(0, 5);
+  mPlot->yAxis->setRange(-1.5, 1.5);
+  mPlot->replot();
+  
+  const QPoint startPos = mPlot->axisRect()->center();
+  QMouseEvent pressEvent(QEvent::MouseButtonPress, startPos, Qt::LeftButton, Qt::LeftButton, Qt::NoModifier);
+  QCoreApplication::sendEvent(mPlot, &pressEvent);
+  int offset = 0;
+  QBENCHMARK
+  {
+    offset = (offset+3)%300;
+    QMouseEvent moveEvent(QEvent::MouseMove, startPos-QPoint(offset, 0), Qt::NoButton, Qt::LeftButton, Qt::NoModifier);
+    QCoreApplication::sendEvent(mPlot, &moveEvent);
+    mPlot->replot();
+  }
+  QMouseEvent releaseEvent(QEvent::MouseButtonRelease, startPos-QPoint(offset, 0), Qt::LeftButton, Qt::NoButton, Qt::NoModifier);
+  QCoreApplication::sendEvent(mPlot, &releaseEvent);
+}
+
+void Benchmark::QCPAxisRect_ZoomPreview()
+{
+  int n = 1000000;
+  QVector<double> x(n), y(n);
+  for (int i=0; i<n; ++i)
+  {
+    x[i] = i/(double)n*100.0;
+    y[i] = qSin(x[i]*3.0)+qSin(x[i]*59.0)*0.3;
+  }
+  QCPGraph *graph = mPlot->addGraph();
+  graph->setData(x, y, true);
+  graph->setBrush(QColor(0, 0, 255, 50));
+  mPlot->layer("main")->setMode(QCPLayer::lmBuffered);
+  mPlot->setInteractions(QCP::iRangeZoom);
+  mPlot->axisRect()->setRangeZoomPreviewDelay(1000);
+  mPlot->rescaleAxes();
+  mPlot->replot();
+  
+  const QPoint pos = mPlot->axisRect()->center();
+  int step = 0;
+  QBENCHMARK
+  {
+    ++step;
+    QWheelEvent wheelEvent(pos, (step/10)%2 == 0 ? 120 : -120, Qt::NoButton, Qt::NoModifier); // zoom in and out alternately
+    QCoreApplication::sendEvent(mPlot, &wheelEvent);
+  }
+}
+
+void Benchmark::QCPReplotCoordinator_ManyPlots()
+{
+  int n = 200000;
+  int plotCount = 8;
+  QVector<double> x(n), y(n);
+  for (int i=0; i<n; ++i)
+  {
+    x[i] = i/(double)n*100.0;
+    y[i] = qSin(x[i]*3.0)+qSin(x[i]*59.0)*0.3;
+  }
+  QWidget dashboard;
+  dashboard.setGeometry(0, 0, 1280, 720);
+  QCPReplotCoordinator coordinator;
+  coordinator.setFrameInterval(0);
+  QList<QCustomPlot*> plots;
+  for (int p=0; p<plotCount; ++p)
+  {
+    QCustomPlot *plot = new QCustomPlot(&dashboard);
+    plot->setGeometry((p%4)*320, (p/4)*360, 320, 360);
+    QCPGraph *graph = plot->addGraph();
+    graph->setData(x, y, true);
+    graph->setBrush(QColor(0, 0, 255, 50));
+    plot->rescaleAxes();
+    coordinator.addPlot(plot);
+    plots.append(plot);
+  }
+  dashboard.show();
+  
+  QBENCHMARK
+  {
+    for (int p=0; p<plotCount; ++p)
+    {
+      plots.at(p)->xAxis->moveRange(0.01);
+      plots.at(p)->replot(QCustomPlot::rpQueuedReplot);
+    }
+    QCoreApplication::processEvents(); // runs the frame of the coordinator
+  }
+}
+
+void Benchmark::QCPStackedArea_ManyLayers()
+{
+  QCPStackedArea *area = new QCPStackedArea(mPlot->xAxis, mPlot->yAxis);
+  int n = 1e5;
+  int layerCount = 32;
+  QVector<double> x(n);
+  QVector<QVector<double> > values(layerCount, QVector<double>(n));
+  for (int i=0; i<n; ++i)
+  {
+    x[i] = i/(double)n*100.0;
+    for (int l=0; l<layerCount; ++l)
+      values[l][i] = 1.0+0.5*qSin(x[i]*(l+1)*0.37);
+  }
+  area->setData(x, values, true);
+  mPlot->rescaleAxes();
+  
+  QBENCHMARK
+  {
+    mPlot->xAxis->moveRange(0.01);
+    mPlot->replot();
+  }
+}
+
+void Benchmark::QCPDigitalTrace_DenseTransitions()
+{
+  QCPDigitalTrace *trace = new QCPDigitalTrace(mPlot->xAxis, mPlot->yAxis);
+  trace->setChannelCount(32);
+  trace->addBus(16, 16, "data");
+  int n = 2000000;
+  QVector<double> timestamps(n);
+  QVector<quint64> states(n);
+  quint64 state = 0;
+  for (int i=0; i<n; ++i)
+  {
+    state ^= Q_UINT64_C(1) << (i%3 == 0 ? 0 : 1+(i*7)%31); // fast clock on channel 0, other channels change less often
+    timestamps[i] = i;
+    states[i] = state;
+  }
+  trace->setData(timestamps, states, true);
+  mPlot->rescaleAxes();
+  
+  QBENCHMARK
+  {
+    mPlot->replot();
+  }
+}
+
 void Benchmark::QCPAxis_TickLabels()
 {
   mPlot->setPlottingHint(QCP::phCacheLabels, false);